@@ -5,6 +5,7 @@
 
 #include "Mesh.h"
 #include "MeshParamsControl.h"
+#include "Modules_LocalFields.h"
 
 #if COMPILECUDA == 1
 #include "AnisotropyCUDA.h"
@@ -118,26 +119,7 @@ double Anisotropy_Uniaxial::UpdateField(void)
 #pragma omp parallel for reduction(+:energy)
 		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
-
-				double Ms = pMesh->Ms;
-				double K1 = pMesh->K1;
-				double K2 = pMesh->K2;
-				DBL3 mcanis_ea1 = pMesh->mcanis_ea1;
-
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->K1, K1, pMesh->K2, K2, pMesh->mcanis_ea1, mcanis_ea1);
-
-				//calculate m.ea dot product
-				double dotprod = (pMesh->M[idx] * mcanis_ea1) / Ms;
-
-				//update effective field with the anisotropy field
-				DBL3 Heff_value = (2 / (MU0*Ms)) * dotprod * (K1 + 2 * K2 * (1 - dotprod * dotprod)) * mcanis_ea1;
-
-				pMesh->Heff[idx] += Heff_value;
-
-				//update energy (E/V) = K1 * sin^2(theta) + K2 * sin^4(theta) = K1 * [ 1 - dotprod*dotprod ] + K2 * [1 - dotprod * dotprod]^2
-				energy += (K1 + K2 * (1 - dotprod * dotprod)) * (1 - dotprod * dotprod);
-			}
+			if (pMesh->M.is_not_empty(idx)) pMesh->Heff[idx] += LocalField_FM(idx, energy);
 		}
 	}
 
@@ -172,6 +154,12 @@ double Anisotropy_Uniaxial::UpdateField(void)
 		}
 	}
 
+	return UpdateField_Finish(energy);
+}
+
+//final energy density value from energy density sum accumulated over the mesh; sets and returns module energy
+double Anisotropy_Uniaxial::UpdateField_Finish(double energy)
+{
 	if (pMesh->M.get_nonempty_cells()) energy /= pMesh->M.get_nonempty_cells();
 	else energy = 0;
 
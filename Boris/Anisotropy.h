@@ -42,6 +42,14 @@ public:
 
 	double UpdateField(void);
 
+	//-------------------Local field kernel : Modules_LocalFields.h
+
+	//uniaxial anisotropy field at non-empty cell idx in a ferromagnetic mesh, accumulating energy density sum
+	DBL3 LocalField_FM(int idx, double& energy);
+
+	//final energy density value from energy density sum accumulated over the mesh; sets and returns module energy
+	double UpdateField_Finish(double energy);
+
 	//-------------------Energy density methods
 
 	double GetEnergyDensity(Rect& avRect);
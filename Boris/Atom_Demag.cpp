@@ -187,23 +187,26 @@ double Atom_Demag::UpdateField(void)
 	///////////////////////////////////////// NO SPEEDUP //////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	else {
+	else UpdateField_NoSpeedup();
 
-		//don't use evaluation speedup
+	return energy;
+}
 
-		//transfer magnetic moments to magnetization mesh, converting from moment to magnetization in the process
-		M.transfer_in();
+//calculate field without evaluation speedup, adding it to the atomistic mesh effective field, and return energy : also used by Monte Carlo algorithms, which need the field for the current moments
+double Atom_Demag::UpdateField_NoSpeedup(void)
+{
+	//transfer magnetic moments to magnetization mesh, converting from moment to magnetization in the process
+	M.transfer_in();
 
-		//convolute and get "energy" value
-		energy = Convolute(M, Hdemag, true);
+	//convolute and get "energy" value
+	energy = Convolute(M, Hdemag, true);
 
-		//transfer demagnetising field to atomistic mesh effective field : all atomistic cells within the larger micromagnetic cell receive the same field
-		Hdemag.transfer_out();
+	//transfer demagnetising field to atomistic mesh effective field : all atomistic cells within the larger micromagnetic cell receive the same field
+	Hdemag.transfer_out();
 
-		//finish off energy value
-		if (non_empty_cells) energy *= -MU0 / (2 * non_empty_cells);
-		else energy = 0;
-	}
+	//finish off energy value
+	if (non_empty_cells) energy *= -MU0 / (2 * non_empty_cells);
+	else energy = 0;
 
 	return energy;
 }
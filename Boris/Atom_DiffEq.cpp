@@ -11,6 +11,9 @@ Atom_DifferentialEquation::Atom_DifferentialEquation(Atom_Mesh *paMesh) :
 	//store this pointer in the pODE vector and get a unique id so it can be erased later in the destructor
 	odeId.minor = pODE.push_back(this, odeId.major);
 
+	//each solver has its own random number stream for the same seed (atomistic streams are kept separate from micromagnetic ones)
+	prng.seed(stoch_seed ? stoch_seed : GetSystemTickCount(), STOCHSEED_ATOM_STREAM + odeId.minor);
+
 	this->paMesh = paMesh;
 }
 
@@ -53,8 +53,8 @@ protected:
 	//Thermal field, enabled only for the stochastic equations
 	VEC<DBL3> H_Thermal;
 
-	//random number generator
-	BorisRand prng;
+	//counter-based random number generator for thermal fields : values only depend on seed, cell index and generation step, so they don't depend on number of threads
+	BorisRandCB prng;
 
 	Atom_Mesh *paMesh;
 
@@ -72,6 +72,13 @@ protected:
 
 protected:
 
+	//---------------------------------------- LTE REDUCTION
+
+	//local truncation error reduction over cells for adaptive evaluation methods, using the set error norm (lte_norm) : result in lte_reduction.max
+	void new_lte_reduction(void) { if (lte_norm == LTENORM_RMS) lte_reduction.new_average_reduction(); else lte_reduction.new_minmax_reduction(); }
+	void reduce_lte(double value) { if (lte_norm == LTENORM_RMS) lte_reduction.reduce_average(value * value); else lte_reduction.reduce_max(value); }
+	void finish_lte_reduction(void) { if (lte_norm == LTENORM_RMS) lte_reduction.max = sqrt(lte_reduction.average()); else lte_reduction.maximum(); }
+
 	//---------------------------------------- SOLVER METHODS : Atom_DiffEq_Evals.cpp
 
 #ifdef ODE_EVAL_COMPILATION_EULER
@@ -96,6 +103,36 @@ protected:
 	virtual void RunAHeun_Step1(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	virtual void RunCayley_Step0_withReductions(void) = 0;
+	virtual void RunCayley_Step0(void) = 0;
+	virtual void RunCayley_Step1_withReductions(void) = 0;
+	virtual void RunCayley_Step1(void) = 0;
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE
+	virtual void RunROS2_Step0_withReductions(void) = 0;
+	virtual void RunROS2_Step0(void) = 0;
+	virtual void RunROS2_Step0_Advance(void) = 0;
+	virtual void RunROS2_Step1_withReductions(void) = 0;
+	virtual void RunROS2_Step1(void) = 0;
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev) evaluation of ODE
+	virtual void RunRKC_Step0_withReductions(void) = 0;
+	virtual void RunRKC_Step0(void) = 0;
+	virtual void RunRKC_Step0_Advance(void) = 0;
+	virtual void RunRKC_Step(void) = 0;
+	virtual void RunRKC_LastStep_withReductions(void) = 0;
+	virtual void RunRKC_LastStep(void) = 0;
+
+	//spectral radius estimate of the set equation linearized in the exchange field (units 1/s), used to set the number of RKC stages
+	virtual double RKC_SpectralRadius(void) = 0;
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	virtual void RunABM_Predictor_withReductions(void) = 0;
@@ -175,6 +212,19 @@ protected:
 	virtual void RunSD_Advance(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//NCG (nonlinear conjugate gradient) energy minimization : stages are run from the Iterate method, which controls the line search
+	//1. accumulate directional derivative of total energy along search direction at current line search point (in ncg_dE)
+	virtual void RunNCG_Evaluate_withReductions(void) = 0;
+	virtual void RunNCG_Evaluate(void) = 0;
+	//2. accumulate numerator and denominator of Polak-Ribiere beta at the accepted line search point
+	virtual void RunNCG_Beta(void) = 0;
+	//3. set new search direction using ncg_beta, and save magnetization as the start of the next line search (also accumulates directional derivative there in ncg_dE)
+	virtual void RunNCG_Direction(void) = 0;
+	//4. set magnetization at line search step ncg_alpha along search direction
+	virtual void RunNCG_Move(void) = 0;
+#endif
+
 	//---------------------------------------- OTHERS
 
 	//Restore atomic moments after a failed step for adaptive time-step methods
@@ -87,9 +87,23 @@ BError Atom_DifferentialEquationCubic::AllocateMemory(void)
 		if (!sEval5.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_CAYLEY:
+		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
+	case EVAL_RKC:
+		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
 	case EVAL_SD:
 		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
+
+	case EVAL_NCG:
+		if (!sEval0.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(paMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
 	}
 
 	//For stochastic equations must also allocate memory for thermal VECs
@@ -126,7 +140,10 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		evalMethod != EVAL_RKF &&
 		evalMethod != EVAL_RKCK &&
 		evalMethod != EVAL_RKDP &&
-		evalMethod != EVAL_SD) {
+		evalMethod != EVAL_SD &&
+		evalMethod != EVAL_CAYLEY &&
+		evalMethod != EVAL_RKC &&
+		evalMethod != EVAL_NCG) {
 
 		sEval0.clear();
 	}
@@ -136,7 +153,9 @@ void Atom_DifferentialEquationCubic::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF &&
 		evalMethod != EVAL_RKCK &&
-		evalMethod != EVAL_RKDP) {
+		evalMethod != EVAL_RKDP &&
+		evalMethod != EVAL_RKC &&
+		evalMethod != EVAL_NCG) {
 
 		sEval1.clear();
 	}
@@ -44,6 +44,35 @@ public:
 	void RunAHeun_Step1(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	void RunCayley_Step0_withReductions(void);
+	void RunCayley_Step0(void);
+	void RunCayley_Step1_withReductions(void);
+	void RunCayley_Step1(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE : only implemented for ferromagnetic meshes. These are never called : SuperMesh::Check_ODE_EvalMethod refuses to start a simulation with ROS2 set and this mesh type present, with an error naming the mesh.
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step0_Advance(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev)
+	void RunRKC_Step0_withReductions(void);
+	void RunRKC_Step0(void);
+	void RunRKC_Step0_Advance(void);
+	void RunRKC_Step(void);
+	void RunRKC_LastStep_withReductions(void);
+	void RunRKC_LastStep(void);
+
+	double RKC_SpectralRadius(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	void RunABM_Predictor_withReductions(void);
@@ -123,6 +152,19 @@ public:
 	void RunSD_Advance(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//NCG (nonlinear conjugate gradient) energy minimization : stages are run from the Iterate method, which controls the line search
+	//1. accumulate directional derivative of total energy along search direction at current line search point (in ncg_dE)
+	void RunNCG_Evaluate_withReductions(void);
+	void RunNCG_Evaluate(void);
+	//2. accumulate numerator and denominator of Polak-Ribiere beta at the accepted line search point
+	void RunNCG_Beta(void);
+	//3. set new search direction using ncg_beta, and save magnetization as the start of the next line search (also accumulates directional derivative there in ncg_dE)
+	void RunNCG_Direction(void);
+	//4. set magnetization at line search step ncg_alpha along search direction
+	void RunNCG_Move(void);
+#endif
+
 	//---------------------------------------- EQUATIONS : Atom_DiffEqCubic_Equations.cpp and Atom_DiffEqCubic_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -210,6 +252,35 @@ public:
 	void RunAHeun_Step1(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	void RunCayley_Step0_withReductions(void) {}
+	void RunCayley_Step0(void) {}
+	void RunCayley_Step1_withReductions(void) {}
+	void RunCayley_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE : mesh type not compiled, never called
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step0_Advance(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev)
+	void RunRKC_Step0_withReductions(void) {}
+	void RunRKC_Step0(void) {}
+	void RunRKC_Step0_Advance(void) {}
+	void RunRKC_Step(void) {}
+	void RunRKC_LastStep_withReductions(void) {}
+	void RunRKC_LastStep(void) {}
+
+	double RKC_SpectralRadius(void) { return 0.0; }
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	void RunABM_Predictor_withReductions(void) {}
@@ -289,6 +360,14 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	void RunNCG_Evaluate_withReductions(void) {}
+	void RunNCG_Evaluate(void) {}
+	void RunNCG_Beta(void) {}
+	void RunNCG_Direction(void) {}
+	void RunNCG_Move(void) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : Atom_DiffEqCubic_Equations.cpp and Atom_DiffEqCubic_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
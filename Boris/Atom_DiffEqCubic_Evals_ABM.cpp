@@ -87,7 +87,7 @@ void Atom_DifferentialEquationCubic::RunABM_Predictor(void)
 void Atom_DifferentialEquationCubic::RunABM_Corrector_withReductions(void)
 {
 	dmdt_reduction.new_minmax_reduction();
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
 
 	//multiplicative conversion factor from atomic moment (units of muB) to A/m
 	double conversion = MUB / paMesh->h.dim();
@@ -129,18 +129,18 @@ void Atom_DifferentialEquationCubic::RunABM_Corrector_withReductions(void)
 
 				//local truncation error (between predicted and corrected)
 				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+				reduce_lte(_lte);
 			}
 		}
 	}
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 	dmdt_reduction.maximum();
 }
 
 void Atom_DifferentialEquationCubic::RunABM_Corrector(void)
 {
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
 
 #pragma omp parallel for
 	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
@@ -174,12 +174,12 @@ void Atom_DifferentialEquationCubic::RunABM_Corrector(void)
 
 				//local truncation error (between predicted and corrected)
 				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+				reduce_lte(_lte);
 			}
 		}
 	}
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 }
 
 void Atom_DifferentialEquationCubic::RunABM_TEuler0(void)
@@ -74,7 +74,7 @@ void Atom_DifferentialEquationCubic::RunAHeun_Step0(void)
 void Atom_DifferentialEquationCubic::RunAHeun_Step1_withReductions(void)
 {
 	dmdt_av_reduction.new_average_reduction();
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
 
 	//multiplicative conversion factor from atomic moment (units of muB) to A/m
 	double conversion = MUB / paMesh->h.dim();
@@ -104,7 +104,7 @@ void Atom_DifferentialEquationCubic::RunAHeun_Step1_withReductions(void)
 
 				//local truncation error (between predicted and corrected)
 				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+				reduce_lte(_lte);
 
 				//obtained average dmdt term
 				double Mnorm = paMesh->M1[idx].norm();
@@ -113,13 +113,13 @@ void Atom_DifferentialEquationCubic::RunAHeun_Step1_withReductions(void)
 		}
 	}
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 	dmdt_reduction.max = GetMagnitude(dmdt_av_reduction.average());
 }
 
 void Atom_DifferentialEquationCubic::RunAHeun_Step1(void)
 {
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
 
 #pragma omp parallel for
 	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
@@ -146,12 +146,12 @@ void Atom_DifferentialEquationCubic::RunAHeun_Step1(void)
 
 				//local truncation error (between predicted and corrected)
 				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+				reduce_lte(_lte);
 			}
 		}
 	}
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 }
 
 #endif
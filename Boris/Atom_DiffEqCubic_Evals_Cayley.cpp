@@ -0,0 +1,168 @@
+#include "stdafx.h"
+#include "Atom_DiffEqCubic.h"
+
+#ifdef MESH_COMPILATION_ATOM_CUBIC
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+
+#include "Atom_Mesh_Cubic.h"
+#include "SuperMesh.h"
+#include "Atom_MeshParamsControl.h"
+
+#include "DiffEq_Cayley.h"
+
+//--------------------------------------------- CAYLEY (ADAPTIVE HEUN WITH CAYLEY TRANSFORM UPDATES)
+
+//Same steps as AHeun, but moments are advanced by rotations using angular velocities obtained from the equation rhs, rather than by adding rhs * dT to them.
+//Step 0 : predictor using angular velocity at start of time step (saved in sEval0).
+//Step 1 : corrector from start of time step using average of angular velocities at start and at predicted moment. lte is the difference between predicted and corrected moment.
+
+void Atom_DifferentialEquationCubic::RunCayley_Step0_withReductions(void)
+{
+	mxh_av_reduction.new_average_reduction();
+
+	//can be used for stochastic equations - generate thermal VECs at the start
+	if (H_Thermal.linear_size()) GenerateThermalField();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			//Save current moment for the next step
+			sM1[idx] = paMesh->M1[idx];
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//obtained average normalized torque term
+				double Mnorm = paMesh->M1[idx].norm();
+				mxh_av_reduction.reduce_average((paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm));
+
+				//First evaluate RHS of set equation at the current time step, and save angular velocity for the next step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+				sEval0[idx] = Cayley_AngularVelocity(paMesh->M1[idx], rhs);
+
+				//Now estimate moment for the next time step
+				paMesh->M1[idx] = Cayley_Rotate(paMesh->M1[idx], sEval0[idx], dT);
+			}
+		}
+	}
+
+	mxh_reduction.max = GetMagnitude(mxh_av_reduction.average());
+}
+
+void Atom_DifferentialEquationCubic::RunCayley_Step0(void)
+{
+	//can be used for stochastic equations - generate thermal VECs at the start
+	if (H_Thermal.linear_size()) GenerateThermalField();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			//Save current moment for the next step
+			sM1[idx] = paMesh->M1[idx];
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step, and save angular velocity for the next step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+				sEval0[idx] = Cayley_AngularVelocity(paMesh->M1[idx], rhs);
+
+				//Now estimate moment for the next time step
+				paMesh->M1[idx] = Cayley_Rotate(paMesh->M1[idx], sEval0[idx], dT);
+			}
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunCayley_Step1_withReductions(void)
+{
+	dmdt_av_reduction.new_average_reduction();
+	new_lte_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the predicted moment
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//First save predicted moment for lte calculation
+				DBL3 saveM = paMesh->M1[idx];
+
+				//Now rotate moment from start of time step using the average angular velocity
+				paMesh->M1[idx] = Cayley_Rotate(sM1[idx], (sEval0[idx] + Cayley_AngularVelocity(saveM, rhs)) / 2, dT);
+
+				//moment length is kept by the rotation : this only has an effect if mu_s has changed
+				if (renormalize) {
+
+					double mu_s = paMesh->mu_s;
+					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+					paMesh->M1[idx].renormalize(mu_s);
+				}
+
+				//local truncation error (between predicted and corrected)
+				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
+				reduce_lte(_lte);
+
+				//obtained average dmdt term
+				double Mnorm = paMesh->M1[idx].norm();
+				dmdt_av_reduction.reduce_average((paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm));
+			}
+		}
+	}
+
+	finish_lte_reduction();
+	dmdt_reduction.max = GetMagnitude(dmdt_av_reduction.average());
+}
+
+void Atom_DifferentialEquationCubic::RunCayley_Step1(void)
+{
+	new_lte_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the predicted moment
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//First save predicted moment for lte calculation
+				DBL3 saveM = paMesh->M1[idx];
+
+				//Now rotate moment from start of time step using the average angular velocity
+				paMesh->M1[idx] = Cayley_Rotate(sM1[idx], (sEval0[idx] + Cayley_AngularVelocity(saveM, rhs)) / 2, dT);
+
+				//moment length is kept by the rotation : this only has an effect if mu_s has changed
+				if (renormalize) {
+
+					double mu_s = paMesh->mu_s;
+					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+					paMesh->M1[idx].renormalize(mu_s);
+				}
+
+				//local truncation error (between predicted and corrected)
+				double _lte = GetMagnitude(paMesh->M1[idx] - saveM) / paMesh->M1[idx].norm();
+				reduce_lte(_lte);
+			}
+		}
+	}
+
+	finish_lte_reduction();
+}
+
+#endif
+#endif
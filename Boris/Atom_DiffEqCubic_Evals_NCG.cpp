@@ -0,0 +1,159 @@
+#include "stdafx.h"
+#include "Atom_DiffEqCubic.h"
+
+#ifdef MESH_COMPILATION_ATOM_CUBIC
+#ifdef ODE_EVAL_COMPILATION_NCG
+
+#include "Atom_Mesh_Cubic.h"
+#include "SuperMesh.h"
+#include "Atom_MeshParamsControl.h"
+
+#include "DiffEq_NCG.h"
+
+//--------------------------------------------- NCG (NONLINEAR CONJUGATE GRADIENT ENERGY MINIMIZATION)
+
+//The energy gradient with respect to M1 (units of muB) for a moment is -MUB_MU0 * Heff1.
+//sM1 : moments at start of line search, sEval0 : search direction, sEval1 : residual at start of line search (used for Polak-Ribiere beta at the end of the line search)
+
+void Atom_DifferentialEquationCubic::RunNCG_Evaluate_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+	if (calculate_dmdt) dmdt_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double mu_s = paMesh->mu_s;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+
+			DBL3 m = paMesh->M1[idx] / mu_s;
+			DBL3 H = paMesh->Heff1[idx];
+
+			//obtained maximum normalized torque term
+			double _mxh = GetMagnitude(m ^ H) / (conversion * paMesh->M1[idx].norm());
+			mxh_reduction.reduce_max(_mxh);
+
+			if (calculate_dmdt && ncg_alpha > 0.0) {
+
+				//obtained maximum dmdt term (from start of line search)
+				double Mnorm = paMesh->M1[idx].norm();
+				double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (ncg_alpha * GAMMA * Mnorm * conversion * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+			}
+
+			_dE -= MUB_MU0 * NCG_FieldDerivative(paMesh->M1[idx], H, sM1[idx], sEval0[idx], ncg_alpha, mu_s);
+		}
+	}
+
+	ncg_dE += _dE;
+
+	mxh_reduction.maximum();
+	if (calculate_dmdt) dmdt_reduction.maximum();
+}
+
+void Atom_DifferentialEquationCubic::RunNCG_Evaluate(void)
+{
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double mu_s = paMesh->mu_s;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+
+			_dE -= MUB_MU0 * NCG_FieldDerivative(paMesh->M1[idx], paMesh->Heff1[idx], sM1[idx], sEval0[idx], ncg_alpha, mu_s);
+		}
+	}
+
+	ncg_dE += _dE;
+}
+
+void Atom_DifferentialEquationCubic::RunNCG_Beta(void)
+{
+	double _beta_num = 0.0, _beta_den = 0.0;
+
+#pragma omp parallel for reduction(+:_beta_num, _beta_den)
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double mu_s = paMesh->mu_s;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+
+			DBL3 r = NCG_Residual(paMesh->M1[idx], paMesh->Heff1[idx], mu_s);
+
+			//inner products weighted by the inverse preconditioner (MUB_MU0 / mu_s, up to a constant factor)
+			_beta_num += (MUB_MU0 / mu_s) * (r * (r - sEval1[idx]));
+			_beta_den += (MUB_MU0 / mu_s) * (sEval1[idx] * sEval1[idx]);
+		}
+	}
+
+	ncg_beta_num += _beta_num;
+	ncg_beta_den += _beta_den;
+}
+
+void Atom_DifferentialEquationCubic::RunNCG_Direction(void)
+{
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			//save current moment as the start of the line search
+			sM1[idx] = paMesh->M1[idx];
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				double mu_s = paMesh->mu_s;
+				paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+
+				DBL3 r = NCG_Residual(paMesh->M1[idx], paMesh->Heff1[idx], mu_s);
+
+				//previous direction is projected perpendicular to the current moment (not needed if restarting with steepest descent, when the previous direction may not be set)
+				DBL3 d = r;
+
+				if (ncg_beta > 0.0) {
+
+					DBL3 m = paMesh->M1[idx].normalized();
+					d += ncg_beta * (sEval0[idx] - (sEval0[idx] * m) * m);
+				}
+
+				sEval0[idx] = d;
+				sEval1[idx] = r;
+
+				_dE -= MUB_MU0 * (paMesh->Heff1[idx] * d);
+			}
+		}
+	}
+
+	ncg_dE += _dE;
+}
+
+void Atom_DifferentialEquationCubic::RunNCG_Move(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double mu_s = paMesh->mu_s;
+			paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+
+			paMesh->M1[idx] = NCG_LinePoint(sM1[idx], sEval0[idx], ncg_alpha, mu_s);
+		}
+	}
+}
+
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "stdafx.h"
+#include "Atom_DiffEqCubic.h"
+
+#ifdef MESH_COMPILATION_ATOM_CUBIC
+#ifdef ODE_EVAL_COMPILATION_RKC
+
+#include "Atom_Mesh_Cubic.h"
+#include "SuperMesh.h"
+#include "Atom_MeshParamsControl.h"
+
+//--------------------------------------------- RUNGE KUTTA CHEBYSHEV (2nd order, damped, number of stages set each time step, with FSAL error estimate)
+
+//Y(0) is held in sM1, F(Y(0)) in sEval0, Y(j-2) in sEval1 and Y(j-1) in M1. Stage coefficients are set in ODECommon_Base::RKC_Set_Stages.
+//Error estimate, calculated at the start of the next time step since it needs F(Y(s)) : 0.8 * (Y(0) - Y(s)) + 0.4 * dT * (F(Y(0)) + F(Y(s)))
+
+void Atom_DifferentialEquationCubic::RunRKC_Step0_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+	new_lte_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//obtain maximum normalized torque term
+				double Mnorm = paMesh->M1[idx].norm();
+				double _mxh = GetMagnitude(paMesh->M1[idx] ^ paMesh->Heff1[idx]) / (conversion * Mnorm * Mnorm);
+				mxh_reduction.reduce_max(_mxh);
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//local truncation error estimate for the previous time step
+				double _lte = GetMagnitude(0.8 * (sM1[idx] - paMesh->M1[idx]) + 0.4 * dT * (sEval0[idx] + rhs)) / Mnorm;
+				reduce_lte(_lte);
+
+				//save evaluation for later use
+				sEval0[idx] = rhs;
+			}
+		}
+	}
+
+	finish_lte_reduction();
+	mxh_reduction.maximum();
+}
+
+void Atom_DifferentialEquationCubic::RunRKC_Step0(void)
+{
+	//lte reductions needed for adaptive time step
+	new_lte_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//local truncation error estimate for the previous time step
+				double _lte = GetMagnitude(0.8 * (sM1[idx] - paMesh->M1[idx]) + 0.4 * dT * (sEval0[idx] + rhs)) / paMesh->M1[idx].norm();
+				reduce_lte(_lte);
+
+				//save evaluation for later use
+				sEval0[idx] = rhs;
+			}
+		}
+	}
+
+	finish_lte_reduction();
+}
+
+void Atom_DifferentialEquationCubic::RunRKC_Step0_Advance(void)
+{
+	double mus = rkc_mus[1];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//Save current moment for later use
+				sM1[idx] = paMesh->M1[idx];
+				sEval1[idx] = paMesh->M1[idx];
+
+				//Now estimate moment using RKC first stage
+				paMesh->M1[idx] += sEval0[idx] * (dT * mus);
+			}
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunRKC_Step(void)
+{
+	//stage being computed : evalStep is incremented after this
+	int j = evalStep + 1;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			//First evaluate RHS of set equation at the current time step
+			DBL3 rhs = CALLFP(this, equation)(idx);
+
+			//Now estimate moment using RKC stage recurrence
+			DBL3 Mj = mu * paMesh->M1[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+
+			sEval1[idx] = paMesh->M1[idx];
+			paMesh->M1[idx] = Mj;
+		}
+	}
+}
+
+void Atom_DifferentialEquationCubic::RunRKC_LastStep_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+
+	//multiplicative conversion factor from atomic moment (units of muB) to A/m
+	double conversion = MUB / paMesh->h.dim();
+
+	int j = rkc_stages;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//Now calculate moment at end of time step using RKC stage recurrence
+				paMesh->M1[idx] = mu * paMesh->M1[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+
+				if (renormalize) {
+
+					double mu_s = paMesh->mu_s;
+					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+					paMesh->M1[idx].renormalize(mu_s);
+				}
+
+				//obtained maximum dmdt term
+				double Mnorm = paMesh->M1[idx].norm();
+				double _dmdt = GetMagnitude(paMesh->M1[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * conversion * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+			}
+		}
+	}
+
+	dmdt_reduction.maximum();
+}
+
+void Atom_DifferentialEquationCubic::RunRKC_LastStep(void)
+{
+	int j = rkc_stages;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx)) {
+
+			if (!paMesh->M1.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = CALLFP(this, equation)(idx);
+
+				//Now calculate moment at end of time step using RKC stage recurrence
+				paMesh->M1[idx] = mu * paMesh->M1[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+
+				if (renormalize) {
+
+					double mu_s = paMesh->mu_s;
+					paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
+					paMesh->M1[idx].renormalize(mu_s);
+				}
+			}
+		}
+	}
+}
+
+//RKC is enabled for LLGStatic : linearized in the exchange field this is (gamma/2) * (J / (muB * mu0)) times the lattice Laplacian on moment components perpendicular to M1,
+//where the simple cubic lattice Laplacian has largest eigenvalue magnitude twice the coordination number
+double Atom_DifferentialEquationCubic::RKC_SpectralRadius(void)
+{
+	if (!paMesh->ExchangeComputation_Enabled()) return 0.0;
+
+	int coordination = 2 * ((paMesh->n.x > 1) + (paMesh->n.y > 1) + (paMesh->n.z > 1));
+
+	OmpReduction<double> specrad_reduction;
+	specrad_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+
+		if (paMesh->M1.is_not_empty(idx) && !paMesh->M1.is_skipcell(idx)) {
+
+			double J = paMesh->J;
+			paMesh->update_parameters_mcoarse(idx, paMesh->J, J);
+
+			specrad_reduction.reduce_max((GAMMA / 2) * fabs(J) / MUB_MU0);
+		}
+	}
+
+	return specrad_reduction.maximum() * 2 * coordination;
+}
+
+#endif
+#endif
\ No newline at end of file
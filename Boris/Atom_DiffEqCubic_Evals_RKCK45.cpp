@@ -133,7 +133,7 @@ void Atom_DifferentialEquationCubic::RunRKCK45_Step4(void)
 void Atom_DifferentialEquationCubic::RunRKCK45_Step5_withReductions(void)
 {
 	dmdt_reduction.new_minmax_reduction();
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
 
 	//multiplicative conversion factor from atomic moment (units of muB) to A/m
 	double conversion = MUB / paMesh->h.dim();
@@ -168,18 +168,18 @@ void Atom_DifferentialEquationCubic::RunRKCK45_Step5_withReductions(void)
 
 				//local truncation error (between predicted and corrected)
 				double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+				reduce_lte(_lte);
 			}
 		}
 	}
 
 	dmdt_reduction.maximum();
-	lte_reduction.maximum();
+	finish_lte_reduction();
 }
 
 void Atom_DifferentialEquationCubic::RunRKCK45_Step5(void)
 {
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
 
 #pragma omp parallel for
 	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
@@ -206,12 +206,12 @@ void Atom_DifferentialEquationCubic::RunRKCK45_Step5(void)
 
 				//local truncation error (between predicted and corrected)
 				double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+				reduce_lte(_lte);
 			}
 		}
 	}
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 }
 
 #endif
@@ -13,7 +13,7 @@
 void Atom_DifferentialEquationCubic::RunRKDP54_Step0_withReductions(void)
 {
 	mxh_reduction.new_minmax_reduction();
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
 
 	//multiplicative conversion factor from atomic moment (units of muB) to A/m
 	double conversion = MUB / paMesh->h.dim();
@@ -38,7 +38,7 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step0_withReductions(void)
 
 				//local truncation error (between predicted and corrected)
 				double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / Mnorm;
-				lte_reduction.reduce_max(_lte);
+				reduce_lte(_lte);
 
 				//save evaluation for later use
 				sEval0[idx] = rhs;
@@ -47,12 +47,12 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step0_withReductions(void)
 	}
 
 	mxh_reduction.maximum();
-	lte_reduction.maximum();
+	finish_lte_reduction();
 }
 
 void Atom_DifferentialEquationCubic::RunRKDP54_Step0(void)
 {
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
 
 #pragma omp parallel for
 	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
@@ -69,7 +69,7 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step0(void)
 
 				//local truncation error (between predicted and corrected)
 				double _lte = GetMagnitude(paMesh->M1[idx] - prediction) / paMesh->M1[idx].norm();
-				lte_reduction.reduce_max(_lte);
+				reduce_lte(_lte);
 
 				//save evaluation for later use
 				sEval0[idx] = rhs;
@@ -77,7 +77,7 @@ void Atom_DifferentialEquationCubic::RunRKDP54_Step0(void)
 		}
 	}
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 }
 
 void Atom_DifferentialEquationCubic::RunRKDP54_Step0_Advance(void)
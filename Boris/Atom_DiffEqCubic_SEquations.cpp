@@ -23,21 +23,20 @@ void Atom_DifferentialEquationCubic::GenerateThermalField(void)
 	double deltaT = (link_dTstoch ? dT : GetTime() - time_stoch);
 	time_stoch = GetTime();
 
-	double Temperature = paMesh->GetBaseTemperature();
+	double base_Temperature = paMesh->GetBaseTemperature();
 
-#pragma omp parallel for
-	for (int idx = 0; idx < paMesh->n.dim(); idx++) {
+	prng.advance();
 
-		if (paMesh->Temp.linear_size()) Temperature = paMesh->Temp[H_Thermal.cellidx_to_position(idx)];
+	prng.fill_gauss3(H_Thermal.data(), paMesh->n.dim(), 0, [&](int idx) {
+
+		double Temperature = (paMesh->Temp.linear_size() ? paMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
 
 		double mu_s = paMesh->mu_s;
 		paMesh->update_parameters_mcoarse(idx, paMesh->mu_s, mu_s);
 
 		//do not include any damping here - this will be included in the stochastic equations
-		double Hth_const = sqrt(2 * BOLTZMANN * Temperature / (MUB_MU0 * GAMMA * mu_s * deltaT));
-				
-		H_Thermal[idx] = Hth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-	}
+		return sqrt(2 * BOLTZMANN * Temperature / (MUB_MU0 * GAMMA * mu_s * deltaT));
+	});
 }
 
 //------------------------------------------------------------------------------------------------------ STOCHASTIC EQUATIONS
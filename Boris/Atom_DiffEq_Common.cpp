@@ -48,7 +48,7 @@ Atom_ODECommon::Atom_ODECommon(bool called_from_derived) :
 			VINFO(dT), VINFO(dTstoch), VINFO(time_stoch), VINFO(link_dTstoch),
 			VINFO(dTspeedup), VINFO(time_speedup), VINFO(link_dTspeedup),
 			VINFO(err_high_fail), VINFO(err_high), VINFO(err_low), VINFO(dT_increase), VINFO(dT_min), VINFO(dT_max),
-			VINFO(use_evaluation_speedup),
+			VINFO(use_evaluation_speedup), VINFO(evalspeedup_extrapolation),
 			VINFO(moving_mesh), VINFO(moving_mesh_antisymmetric), VINFO(moving_mesh_threshold), VINFO(moving_mesh_dwshift)
 		}, {})
 {
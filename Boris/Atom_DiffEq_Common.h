@@ -31,7 +31,7 @@ class Atom_ODECommon :
 	double, double, double, bool,
 	double, double, bool,
 	double, double, double, double, double, double, 
-	int, 
+	int, int, 
 	bool, bool, double, double>,
 	std::tuple<>>,
 	public ODECommon_Base
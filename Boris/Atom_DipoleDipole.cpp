@@ -241,34 +241,37 @@ double Atom_DipoleDipole::UpdateField(void)
 	///////////////////////////////////////// NO SPEEDUP //////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	else {
+	else UpdateField_NoSpeedup();
 
-		//don't use evaluation speedup
+	return energy;
+}
 
-		if (using_macrocell) {
+//calculate field without evaluation speedup, adding it to the atomistic mesh effective field, and return energy : also used by Monte Carlo algorithms, which need the field for the current moments
+double Atom_DipoleDipole::UpdateField_NoSpeedup(void)
+{
+	if (using_macrocell) {
 
-			//transfer magnetic moments to macrocell mesh
-			M.transfer_in();
+		//transfer magnetic moments to macrocell mesh
+		M.transfer_in();
 
-			//convolute and get "energy" value
-			Convolute(M, Hd, true);
-			//energy not calculated in macrocell mode : would need to correct for use of self demag term in macrocell
-			energy = 0.0;
+		//convolute and get "energy" value
+		Convolute(M, Hd, true);
+		//energy not calculated in macrocell mode : would need to correct for use of self demag term in macrocell
+		energy = 0.0;
 
-			//transfer dipole-dipole field to atomistic mesh effective field : all atomistic cells within the larger micromagnetic cell receive the same field
-			Hd.transfer_out();
-		}
-		else {
+		//transfer dipole-dipole field to atomistic mesh effective field : all atomistic cells within the larger micromagnetic cell receive the same field
+		Hd.transfer_out();
+	}
+	else {
 
-			//not using macrocell so get moments directly from mesh
+		//not using macrocell so get moments directly from mesh
 
-			//convolute and get "energy" value
-			energy = Convolute(paMesh->M1, paMesh->Heff1, false);
+		//convolute and get "energy" value
+		energy = Convolute(paMesh->M1, paMesh->Heff1, false);
 
-			//finish off energy value
-			if (non_empty_volume) energy *= -MUB_MU0 / (2 * non_empty_volume);
-			else energy = 0;
-		}
+		//finish off energy value
+		if (non_empty_volume) energy *= -MUB_MU0 / (2 * non_empty_volume);
+		else energy = 0;
 	}
 
 	return energy;
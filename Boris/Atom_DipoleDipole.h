@@ -74,6 +74,9 @@ public:
 
 	double UpdateField(void);
 
+	//calculate field without evaluation speedup, adding it to the atomistic mesh effective field, and return energy : also used by Monte Carlo algorithms, which need the field for the current moments
+	double UpdateField_NoSpeedup(void);
+
 	//-------------------Setters
 
 	//Set PBC
@@ -113,6 +116,7 @@ public:
 	BError MakeCUDAModule(void) { return BError(); }
 
 	double UpdateField(void) { return 0.0; }
+	double UpdateField_NoSpeedup(void) { return 0.0; }
 
 	//-------------------Setters
 
@@ -15,15 +15,6 @@
 
 class SuperMesh;
 
-//Monte-Carlo Algorithm : minimum allowed cone angle
-#define MONTECARLO_CONEANGLEDEG_MIN		1.0
-//Monte-Carlo Algorithm : maximum allowed cone angle
-#define MONTECARLO_CONEANGLEDEG_MAX		180.0
-//Monte-Carlo Algorithm : change in cone angle per step
-#define MONTECARLO_CONEANGLEDEG_DELTA	1.0
-//Monte-Carlo Algorithm : target aceptance probability (vary cone angle to reach this)
-#define MONTECARLO_TARGETACCEPTANCE		0.5
-
 /////////////////////////////////////////////////////////////////////
 //
 //abstract base Atomic Mesh class - implement various types of atomic meshes using this base
@@ -58,6 +49,32 @@ protected:
 	//use constrained Monte-Carlo?
 	bool mc_constrain = false;
 
+	// Cluster MONTE-CARLO DATA
+
+	//use Wolff cluster Monte-Carlo (not used together with constrained Monte-Carlo)?
+	bool mc_cluster = false;
+
+	// Dipolar MONTE-CARLO DATA
+
+	//with a dipole-dipole or demag module set, the dipolar field used for Monte-Carlo energies is obtained with a full convolution every mc_dipolar_refresh steps.
+	//In between, accepted moves update the field using real-space dipolar corrections within mc_dipolar_radius cells (0 : no corrections).
+	int mc_dipolar_refresh = 1;
+	int mc_dipolar_radius = 2;
+
+	//also do a full convolution when the accumulated relative moment change since the last one exceeds this threshold (0 to disable)
+	double mc_dipolar_threshold = 0.0;
+
+	//relative rms difference between the incrementally updated and the fully convoluted dipolar field, measured at the last full convolution
+	double mc_dipolar_error = 0.0;
+
+	// Parallel tempering MONTE-CARLO DATA
+
+	//number of replicas at different temperatures (1 : parallel tempering disabled). The replica at base_temperature is held in M1.
+	int mc_pt_replicas = 1;
+
+	//highest temperature in the parallel tempering temperature ladder (temperatures spaced geometrically from base_temperature)
+	double mc_pt_Tmax = 0.0;
+
 public:
 
 #if COMPILECUDA == 1
@@ -224,6 +241,27 @@ public:
 	virtual void Set_MonteCarlo_Constrained(DBL3 cmc_n_) = 0;
 	virtual DBL3 Get_MonteCarlo_Constrained_Direction(void) = 0;
 
+	void Set_MonteCarlo_Cluster(bool status) { mc_cluster = status; }
+	bool Get_MonteCarlo_Cluster(void) { return mc_cluster; }
+
+	//dipolar field full convolution interval (Monte-Carlo steps), real-space correction radius (cells), and relative moment change threshold for early full convolution (0 to disable)
+	void Set_MonteCarlo_Dipolar(int refresh, int radius, double threshold) { mc_dipolar_refresh = (refresh > 1 ? refresh : 1); mc_dipolar_radius = (radius > 0 ? radius : 0); mc_dipolar_threshold = (threshold > 0.0 ? threshold : 0.0); }
+	int Get_MonteCarlo_Dipolar_Refresh(void) { return mc_dipolar_refresh; }
+	int Get_MonteCarlo_Dipolar_Radius(void) { return mc_dipolar_radius; }
+	double Get_MonteCarlo_Dipolar_Threshold(void) { return mc_dipolar_threshold; }
+	double Get_MonteCarlo_Dipolar_Error(void) { return mc_dipolar_error; }
+
+	//parallel tempering with given number of replicas (1 to disable), and highest temperature in the temperature ladder
+	void Set_MonteCarlo_Tempering(int replicas, double Tmax) { mc_pt_replicas = (replicas > 1 ? replicas : 1); mc_pt_Tmax = Tmax; }
+	int Get_MonteCarlo_Tempering_Replicas(void) { return mc_pt_replicas; }
+	double Get_MonteCarlo_Tempering_Tmax(void) { return mc_pt_Tmax; }
+
+	//average acceptance probability of replica swaps in the last parallel tempering step
+	virtual double Get_MonteCarlo_Tempering_SwapRate(void) = 0;
+
+	//for each parallel tempering replica, after the last step : temperature (K), total energy (J), average normalized moment magnitude, cone angle (deg.)
+	virtual std::vector<DBL4> Get_MonteCarlo_Tempering_Observables(void) = 0;
+
 	//----------------------------------- MODULES CONTROL (implement MeshBase) : Atom_MeshModules.cpp
 
 	//Add module to list of set modules, also deleting any exclusive modules to this one
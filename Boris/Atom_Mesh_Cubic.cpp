@@ -21,6 +21,8 @@ Atom_Mesh_Cubic::Atom_Mesh_Cubic(SuperMesh *pSMesh_) :
 			//Members in this derived class
 			VINFO(move_mesh_trigger), VINFO(exchange_couple_to_meshes),
 			VINFO(mc_cone_angledeg), VINFO(mc_acceptance_rate), VINFO(mc_parallel), VINFO(mc_constrain), VINFO(cmc_n),
+			VINFO(mc_pt_replicas), VINFO(mc_pt_Tmax), VINFO(mc_cluster),
+			VINFO(mc_dipolar_refresh), VINFO(mc_dipolar_radius), VINFO(mc_dipolar_threshold),
 			//Material Parameters
 			VINFO(alpha), VINFO(mu_s), VINFO(Nxy),
 			VINFO(J), VINFO(D),
@@ -53,6 +55,8 @@ Atom_Mesh_Cubic::Atom_Mesh_Cubic(Rect meshRect_, DBL3 h_, SuperMesh *pSMesh_) :
 			//Members in this derived class
 			VINFO(move_mesh_trigger), VINFO(exchange_couple_to_meshes),
 			VINFO(mc_cone_angledeg), VINFO(mc_acceptance_rate), VINFO(mc_parallel), VINFO(mc_constrain), VINFO(cmc_n),
+			VINFO(mc_pt_replicas), VINFO(mc_pt_Tmax), VINFO(mc_cluster),
+			VINFO(mc_dipolar_refresh), VINFO(mc_dipolar_radius), VINFO(mc_dipolar_threshold),
 			//Material Parameters
 			VINFO(alpha), VINFO(mu_s), VINFO(Nxy),
 			VINFO(J), VINFO(D),
@@ -42,6 +42,8 @@ class Atom_Mesh_Cubic :
 	//Members in this derived class
 	bool, bool,
 	double, double, bool, bool, DBL3,
+	int, double, bool,
+	int, int, double,
 	//Material Parameters
 	MatP<double, double>, MatP<double, double>, MatP<DBL2, double>,
 	MatP<double, double>, MatP<double, double>,
@@ -97,13 +99,133 @@ private:
 	//TO DO : Direct parallel shuffling is possible but a bit of a pain - probably best to use a bijective hash function to generate random permutations but need to look into this carefully. Probably not worth the effort for CPU code.
 	std::vector<std::pair<double, unsigned>> mc_indices_red, mc_indices_black;
 
+	//ids of modules contributing to Monte Carlo energy changes, and Zeeman module if set : set at the start of every Monte Carlo step (Setup_MonteCarlo_Modules)
+	std::vector<int> mc_modules;
+	Atom_Zeeman* pmc_Zeeman = nullptr;
+
+	//temperature used by Monte Carlo algorithms : base_temperature, or replica temperature with parallel tempering
+	double mc_temperature = 0.0;
+
+	// Parallel tempering MONTE-CARLO DATA
+
+	//atomic moments for replicas 1 to mc_pt_replicas - 1, in order of increasing temperature (replica 0, at base_temperature, is held in M1). Same shape and boundary conditions as M1.
+	std::vector<VEC_VC<DBL3>> mc_pt_M1;
+
+	//for each replica, when replicas are stepped concurrently : dipolar field buffers as mc_Hd, mc_M1_ref and mc_dM1 (empty if no dipolar contribution), and random number stream
+	std::vector<std::vector<DBL3>> mc_pt_Hd, mc_pt_M1_ref, mc_pt_dM1;
+	std::vector<BorisRandCB> mc_pt_prng;
+
+	//for each replica temperature : cone angle, and after the last step total energy (J) and average normalized moment magnitude
+	std::vector<double> mc_pt_cone_angledeg, mc_pt_energy, mc_pt_m;
+
+	//swaps are attempted between even and odd replica pairs in alternate steps
+	bool mc_pt_odd_pairs = false;
+
+	//average acceptance probability of replica swaps in the last step
+	double mc_pt_swap_rate = 0.0;
+
+	// Cluster MONTE-CARLO DATA
+
+	//marks spins added to the cluster being built (mc_indices holds the cluster spin indices)
+	std::vector<unsigned char> mc_cluster_marks;
+
+	// Dipolar MONTE-CARLO DATA
+
+	//dipole-dipole or demag module contributing to Monte Carlo energies (nullptr if not set) : set at the start of every Monte Carlo step
+	Atom_DipoleDipole* pmc_DipoleDipole = nullptr;
+	Atom_Demag* pmc_Demag = nullptr;
+
+	//dipolar field (A/m) used for Monte Carlo energies, and moments it was last updated for
+	std::vector<DBL3> mc_Hd, mc_M1_ref;
+
+	//moment changes since the last dipolar field update, used by the parallel algorithms after each pass
+	std::vector<DBL3> mc_dM1;
+
+	//real-space dipolar correction : field tensor (1/m^3) for each cell offset within the correction radius (zero offset excluded), and radius and cellsize these were computed for
+	std::vector<DBL33> mc_dipolar_kernel;
+	std::vector<INT3> mc_dipolar_offsets;
+	int mc_dipolar_kernel_radius = -1;
+	DBL3 mc_dipolar_kernel_h;
+
+	//Monte Carlo steps since the last full convolution, and accumulated relative moment change (sum of |dM1| / sum of |M1|) since then
+	int mc_dipolar_steps = 0;
+	double mc_dipolar_change = 0.0;
+
+	//sum of moment magnitudes at the last full convolution
+	double mc_dipolar_Mtotal = 0.0;
+
 private:
 
+	//set mc_modules and pmc_Zeeman from currently set modules
+	void Setup_MonteCarlo_Modules(void);
+
+	//Take a Monte Carlo step at mc_temperature with the set algorithm, then adapt cone angle for the target acceptance rate
+	void Iterate_MonteCarlo_Replica(double acceptance_rate);
+
+	//Take a parallel tempering Monte Carlo step : step every replica at its temperature, then attempt swaps between replicas at neighbouring temperatures
+	void Iterate_MonteCarlo_Tempering(double acceptance_rate);
+
+	//temperature of given parallel tempering replica : geometric spacing from base_temperature (replica 0) to mc_pt_Tmax
+	double Get_MonteCarlo_Tempering_Temperature(int replica);
+
+	//step all parallel tempering replicas concurrently with the checkerboard Metropolis algorithm, each on a team of threads with its own data and random number stream
+	void Iterate_MonteCarlo_Tempering_Concurrent(double acceptance_rate);
+
+	//checkerboard Metropolis step (as Iterate_MonteCarlo_Parallel_Classic) for parallel tempering replica ridx, using only data of this replica : return acceptance rate
+	double Iterate_MonteCarlo_Tempering_Replica(int ridx);
+
+	//free parallel tempering replicas memory if previously used
+	void MonteCarlo_Tempering_Free(void);
+
+	//local fields at spin_index (energy units) for contributions linear in the spin direction, such that the spin energy is -S.(h_pair + h_site), where S is the spin direction.
+	//pair interactions (exchange, DMI) are in h_pair, single-site contributions (Zeeman) in h_site. Mnorm is the moment magnitude at spin_index.
+	//M are the atomic moments (M1, or a parallel tempering replica) and Hd the dipolar field for them.
+	void Get_Atomistic_LocalFields_SC(const VEC_VC<DBL3>& M, const std::vector<DBL3>& Hd, int spin_index, double Mnorm, DBL3& h_pair, DBL3& h_site);
+	void Get_Atomistic_LocalFields_SC(int spin_index, double Mnorm, DBL3& h_pair, DBL3& h_site) { Get_Atomistic_LocalFields_SC(M1, mc_Hd, spin_index, Mnorm, h_pair, h_site); }
+
+	//energy change for contributions not linear in the spin direction (anisotropy) when changing the spin direction at spin_index from S_old to S_new. With S_old = DBL3() this is the energy for S_new.
+	double Get_Atomistic_AnisotropyEnergyChange_SC(int spin_index, const DBL3& S_old, const DBL3& S_new);
+
+	//energy change when moving the spin at spin_index from M_old (currently set in M1) to M_new, with same magnitude.
+	//For contributions linear in the spin direction (exchange, DMI, Zeeman) this is -(S_new - S_old).h, with h the local field obtained only once. Only anisotropy energies are evaluated explicitly for both spin directions.
+	double Get_Atomistic_EnergyChange_SC(const VEC_VC<DBL3>& M, const std::vector<DBL3>& Hd, int spin_index, const DBL3& M_old, const DBL3& M_new);
+	double Get_Atomistic_EnergyChange_SC(int spin_index, const DBL3& M_old, const DBL3& M_new) { return Get_Atomistic_EnergyChange_SC(M1, mc_Hd, spin_index, M_old, M_new); }
+
+	//total energy of contributing modules in this mesh (pair interactions counted once), for currently set mc_modules
+	double Get_Atomistic_TotalEnergy_SC(const VEC_VC<DBL3>& M, const std::vector<DBL3>& Hd);
+	double Get_Atomistic_TotalEnergy_SC(void) { return Get_Atomistic_TotalEnergy_SC(M1, mc_Hd); }
+
 	//Take a Monte Carlo step in this atomistic mesh : these functions implement the actual algorithms
 	void Iterate_MonteCarlo_Serial_Classic(void);
 	void Iterate_MonteCarlo_Serial_Constrained(void);
 	void Iterate_MonteCarlo_Parallel_Classic(void);
 	void Iterate_MonteCarlo_Parallel_Constrained(void);
+	void Iterate_MonteCarlo_Cluster(void);
+
+	//indices of exchange neighbors of spin_index (up to 6 on the simple cubic lattice, including periodic boundary conditions) : return number of neighbors
+	int Get_MonteCarlo_Cluster_Neighbors(int spin_index, int* ngbr_indices);
+
+	//full convolution of dipolar field used for Monte Carlo energies (measure error of incrementally updated field if required), and check if due
+	void MonteCarlo_Dipolar_Refresh(bool measure_error);
+	void MonteCarlo_Dipolar_CheckRefresh(void);
+
+	//free dipolar field memory if previously used (dipolar contribution not used)
+	void MonteCarlo_Dipolar_Free(void);
+
+	//real-space dipolar field correction for the moment change at spin_index since the last update, added to cells within the correction radius : used by serial algorithms after each accepted move.
+	//Moves of several spins (cluster and constrained moves) apply it after each tentative spin change, so later spins in the move see the field change, then again with revert = true for each spin restored on rejection.
+	void MonteCarlo_Dipolar_Update_Spin(int spin_index, bool revert = false);
+
+	//real-space dipolar field corrections for all moment changes since the last update, obtained for each cell from changes within the correction radius : used by parallel algorithms after each pass
+	//the version with arguments works on the given moments (M1 or a parallel tempering replica), dipolar field, and reference moments and moment changes buffers, and returns the sum of moment change magnitudes
+	void MonteCarlo_Dipolar_Update(void);
+	double MonteCarlo_Dipolar_Update(const VEC_VC<DBL3>& M, std::vector<DBL3>& Hd, std::vector<DBL3>& M_ref, std::vector<DBL3>& dM);
+
+	//set real-space dipolar correction kernel for current radius and cellsize
+	void MonteCarlo_Dipolar_SetKernel(void);
+
+	//cell index at offset from cell (i, j, k), with periodic boundary conditions if set : -1 if outside mesh
+	int MonteCarlo_Dipolar_OffsetIndex(int i, int j, int k, const INT3& offset);
 
 public:
 
@@ -203,6 +325,9 @@ public:
 	void Set_MonteCarlo_Constrained(DBL3 cmc_n_);
 	DBL3 Get_MonteCarlo_Constrained_Direction(void) { return cmc_n; }
 
+	double Get_MonteCarlo_Tempering_SwapRate(void) { return mc_pt_swap_rate; }
+	std::vector<DBL4> Get_MonteCarlo_Tempering_Observables(void);
+
 	//----------------------------------- OTHER CALCULATION METHODS : Atom_Mesh_Cubic_Compute.cpp
 
 	//compute topological charge density spatial dependence and have it available to display in Cust_S
@@ -318,6 +443,9 @@ public:
 	void Set_MonteCarlo_Constrained(DBL3 cmc_n_) {}
 	DBL3 Get_MonteCarlo_Constrained_Direction(void) { return DBL3(); }
 
+	double Get_MonteCarlo_Tempering_SwapRate(void) { return 0.0; }
+	std::vector<DBL4> Get_MonteCarlo_Tempering_Observables(void) { return {}; }
+
 	//----------------------------------- OTHER CALCULATION METHODS : Atom_Mesh_Cubic_Compute.cpp
 
 	//compute topological charge density spatial dependence and have it available to display in Cust_S
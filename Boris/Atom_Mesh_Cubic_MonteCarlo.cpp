@@ -3,6 +3,8 @@
 
 #ifdef MESH_COMPILATION_ATOM_CUBIC
 
+#include "Atom_MeshParamsControl.h"
+
 //defines std::execution::par_unseq used for parallel std::sort
 #include <execution>
 
@@ -12,6 +14,34 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo(double acceptance_rate)
 	//Not applicable at zero temperature
 	if (IsZ(base_temperature)) return;
 
+	Setup_MonteCarlo_Modules();
+
+	if (acceptance_rate < 0 || acceptance_rate > 1) acceptance_rate = MONTECARLO_TARGETACCEPTANCE;
+
+	if (mc_pt_replicas > 1) Iterate_MonteCarlo_Tempering(acceptance_rate);
+	else {
+
+		//parallel tempering disabled : free replicas memory if previously used
+		MonteCarlo_Tempering_Free();
+
+		mc_temperature = base_temperature;
+
+		MonteCarlo_Dipolar_CheckRefresh();
+
+		Iterate_MonteCarlo_Replica(acceptance_rate);
+	}
+}
+
+//Take a Monte Carlo step at mc_temperature with the set algorithm, then adapt cone angle for the target acceptance rate
+void Atom_Mesh_Cubic::Iterate_MonteCarlo_Replica(double acceptance_rate)
+{
+	if (mc_cluster && !mc_constrain) {
+
+		//cluster moves are reflections, so no cone angle to adapt
+		Iterate_MonteCarlo_Cluster();
+		return;
+	}
+
 	if (mc_constrain) {
 
 		if (mc_parallel) Iterate_MonteCarlo_Parallel_Constrained();
@@ -26,8 +56,6 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo(double acceptance_rate)
 	///////////////////////////////////////////////////////////////
 	// ADAPTIVE CONE ANGLE
 
-	if (acceptance_rate < 0 || acceptance_rate > 1) acceptance_rate = MONTECARLO_TARGETACCEPTANCE;
-
 	//adaptive cone angle - nice and simple, efficient for all temperatures; much better than MCM fixed cone angle variants, or cone angle set using a formula.
 	if (mc_acceptance_rate < acceptance_rate) {
 
@@ -43,6 +71,331 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo(double acceptance_rate)
 	}
 }
 
+//temperature of given parallel tempering replica : geometric spacing from base_temperature (replica 0) to mc_pt_Tmax
+double Atom_Mesh_Cubic::Get_MonteCarlo_Tempering_Temperature(int replica)
+{
+	if (mc_pt_replicas < 2 || mc_pt_Tmax <= base_temperature) return base_temperature;
+
+	return base_temperature * pow(mc_pt_Tmax / base_temperature, (double)replica / (mc_pt_replicas - 1));
+}
+
+//Take a parallel tempering Monte Carlo step : step every replica at its temperature, then attempt swaps between replicas at neighbouring temperatures
+void Atom_Mesh_Cubic::Iterate_MonteCarlo_Tempering(double acceptance_rate)
+{
+	///////////////////////////////////////////////////////////////
+	// REPLICAS ALLOCATION
+
+	//replicas (other than replica 0 held in M1) start from the current configuration, with the same shape and boundary conditions as M1
+	if (mc_pt_M1.size() != mc_pt_replicas - 1 || (mc_pt_M1.size() && mc_pt_M1[0].linear_size() != M1.linear_size())) {
+
+		mc_pt_M1.resize(mc_pt_replicas - 1);
+
+		for (int ridx = 0; ridx < mc_pt_M1.size(); ridx++) {
+
+			if (!mc_pt_M1[ridx].resize(h, meshRect, M1)) {
+
+				MonteCarlo_Tempering_Free();
+				return;
+			}
+
+			mc_pt_M1[ridx].set_pbc(M1.is_pbc_x(), M1.is_pbc_y(), M1.is_pbc_z());
+			std::copy(M1.data(), M1.data() + M1.linear_size(), mc_pt_M1[ridx].data());
+		}
+
+		mc_pt_cone_angledeg.assign(mc_pt_replicas, mc_cone_angledeg);
+		mc_pt_energy.assign(mc_pt_replicas, 0.0);
+		mc_pt_m.assign(mc_pt_replicas, 0.0);
+
+		//independent random number stream for each replica
+		mc_pt_prng.clear();
+		for (int ridx = 0; ridx < mc_pt_replicas; ridx++) mc_pt_prng.push_back(BorisRandCB(prng.randi(), ridx));
+
+		mc_pt_Hd.assign(mc_pt_replicas, std::vector<DBL3>());
+		mc_pt_M1_ref.assign(mc_pt_replicas, std::vector<DBL3>());
+		mc_pt_dM1.assign(mc_pt_replicas, std::vector<DBL3>());
+	}
+
+	///////////////////////////////////////////////////////////////
+	// REPLICAS MONTE-CARLO STEP
+
+	//cone angle and acceptance rate for replica 0 are those reported by the mesh
+	mc_pt_cone_angledeg[0] = mc_cone_angledeg;
+	double acceptance_rate_base = 0.0;
+
+	int num_spins = M1.get_nonempty_cells();
+
+	//the checkerboard Metropolis algorithm only uses data of the replica it steps, so replicas can be stepped concurrently. The other algorithms step one replica at a time, each held in M1 while stepped.
+	if (mc_parallel && !mc_constrain && !mc_cluster) {
+
+		Iterate_MonteCarlo_Tempering_Concurrent(acceptance_rate);
+		acceptance_rate_base = mc_acceptance_rate;
+	}
+	else for (int ridx = 0; ridx < mc_pt_replicas; ridx++) {
+
+		//bring replica into M1 so the Monte Carlo algorithms and energy modules work on it
+		if (ridx) std::swap_ranges(M1.data(), M1.data() + M1.linear_size(), mc_pt_M1[ridx - 1].data());
+
+		mc_temperature = Get_MonteCarlo_Tempering_Temperature(ridx);
+		mc_cone_angledeg = mc_pt_cone_angledeg[ridx];
+
+		//dipolar field for this replica
+		if (pmc_DipoleDipole || pmc_Demag) MonteCarlo_Dipolar_Refresh(false);
+		else MonteCarlo_Dipolar_Free();
+
+		Iterate_MonteCarlo_Replica(acceptance_rate);
+
+		mc_pt_cone_angledeg[ridx] = mc_cone_angledeg;
+		if (!ridx) acceptance_rate_base = mc_acceptance_rate;
+
+		//energy needed for swap acceptance probabilities
+		mc_pt_energy[ridx] = Get_Atomistic_TotalEnergy_SC();
+
+		//average normalized moment magnitude
+		double mx = 0.0, my = 0.0, mz = 0.0;
+
+#pragma omp parallel for reduction(+:mx, my, mz)
+		for (int idx = 0; idx < n.dim(); idx++) {
+
+			if (M1.is_not_empty(idx)) {
+
+				DBL3 S = M1[idx].normalized();
+				mx += S.x; my += S.y; mz += S.z;
+			}
+		}
+
+		mc_pt_m[ridx] = (num_spins ? DBL3(mx, my, mz).norm() / num_spins : 0.0);
+
+		if (ridx) std::swap_ranges(M1.data(), M1.data() + M1.linear_size(), mc_pt_M1[ridx - 1].data());
+	}
+
+	mc_cone_angledeg = mc_pt_cone_angledeg[0];
+	mc_acceptance_rate = acceptance_rate_base;
+	mc_temperature = base_temperature;
+
+	//dipolar field is for the last replica : make sure a full convolution is done before it's used again
+	mc_dipolar_steps = mc_dipolar_refresh;
+
+	///////////////////////////////////////////////////////////////
+	// REPLICA EXCHANGE
+
+	//attempt swaps between neighbouring temperatures (k, k + 1), for even k then odd k in alternate steps, so every swap is independent of the others in the same step
+	double swap_rate = 0.0;
+	int num_swaps = 0;
+
+	for (int ridx = (mc_pt_odd_pairs ? 1 : 0); ridx < mc_pt_replicas - 1; ridx += 2) {
+
+		double beta_k = 1.0 / (BOLTZMANN * Get_MonteCarlo_Tempering_Temperature(ridx));
+		double beta_kp1 = 1.0 / (BOLTZMANN * Get_MonteCarlo_Tempering_Temperature(ridx + 1));
+
+		//detailed balance for exchange of configurations between the two temperatures
+		double P_accept = exp((beta_k - beta_kp1) * (mc_pt_energy[ridx] - mc_pt_energy[ridx + 1]));
+		if (P_accept > 1.0) P_accept = 1.0;
+
+		swap_rate += P_accept;
+		num_swaps++;
+
+		if (prng.rand() <= P_accept) {
+
+			if (!ridx) std::swap_ranges(M1.data(), M1.data() + M1.linear_size(), mc_pt_M1[0].data());
+			else mc_pt_M1[ridx - 1].quantity_ref().swap(mc_pt_M1[ridx].quantity_ref());
+
+			std::swap(mc_pt_energy[ridx], mc_pt_energy[ridx + 1]);
+			std::swap(mc_pt_m[ridx], mc_pt_m[ridx + 1]);
+		}
+	}
+
+	mc_pt_odd_pairs = !mc_pt_odd_pairs;
+	if (num_swaps) mc_pt_swap_rate = swap_rate / num_swaps;
+}
+
+//step all parallel tempering replicas concurrently with the checkerboard Metropolis algorithm, each on a team of threads with its own data and random number stream
+void Atom_Mesh_Cubic::Iterate_MonteCarlo_Tempering_Concurrent(double acceptance_rate)
+{
+	///////////////////////////////////////////////////////////////
+	// DIPOLAR FIELDS
+
+	if (pmc_DipoleDipole || pmc_Demag) {
+
+		//full convolution for each replica in turn, as this uses the dipolar module buffers : each replica is brought into M1 for it, then the dipolar field buffers are exchanged with those of the replica
+		for (int ridx = 0; ridx < mc_pt_replicas; ridx++) {
+
+			if (ridx) std::swap_ranges(M1.data(), M1.data() + M1.linear_size(), mc_pt_M1[ridx - 1].data());
+
+			MonteCarlo_Dipolar_Refresh(false);
+
+			mc_pt_Hd[ridx].swap(mc_Hd);
+			mc_pt_M1_ref[ridx].swap(mc_M1_ref);
+			mc_pt_dM1[ridx].swap(mc_dM1);
+
+			if (ridx) std::swap_ranges(M1.data(), M1.data() + M1.linear_size(), mc_pt_M1[ridx - 1].data());
+		}
+	}
+	else {
+
+		for (int ridx = 0; ridx < mc_pt_replicas; ridx++) {
+
+			mc_pt_Hd[ridx].clear();
+			mc_pt_M1_ref[ridx].clear();
+			mc_pt_dM1[ridx].clear();
+		}
+
+		MonteCarlo_Dipolar_Free();
+	}
+
+	///////////////////////////////////////////////////////////////
+	// REPLICAS MONTE-CARLO STEP
+
+	int num_spins = M1.get_nonempty_cells();
+
+	//split threads between replicas : with more replicas than threads each replica gets a single thread
+	int num_threads = omp_get_max_threads();
+	int replica_threads = (num_threads >= 2 ? maximum(1, num_threads / mc_pt_replicas) : 0);
+
+	double acceptance_rate_base = 0.0;
+
+	Run_OmpTeams(mc_pt_replicas, replica_threads, [&](int ridx) -> double {
+
+		VEC_VC<DBL3>& M = (ridx ? mc_pt_M1[ridx - 1] : M1);
+
+		double replica_acceptance_rate = Iterate_MonteCarlo_Tempering_Replica(ridx);
+		if (!ridx) acceptance_rate_base = replica_acceptance_rate;
+
+		//adaptive cone angle for this replica, as in Iterate_MonteCarlo_Replica
+		if (replica_acceptance_rate < acceptance_rate) {
+
+			mc_pt_cone_angledeg[ridx] -= MONTECARLO_CONEANGLEDEG_DELTA;
+			if (mc_pt_cone_angledeg[ridx] < MONTECARLO_CONEANGLEDEG_MIN) mc_pt_cone_angledeg[ridx] = MONTECARLO_CONEANGLEDEG_MIN;
+		}
+		else {
+
+			mc_pt_cone_angledeg[ridx] += MONTECARLO_CONEANGLEDEG_DELTA;
+			if (mc_pt_cone_angledeg[ridx] > MONTECARLO_CONEANGLEDEG_MAX) mc_pt_cone_angledeg[ridx] = MONTECARLO_CONEANGLEDEG_MAX;
+		}
+
+		//energy needed for swap acceptance probabilities
+		mc_pt_energy[ridx] = Get_Atomistic_TotalEnergy_SC(M, mc_pt_Hd[ridx]);
+
+		//average normalized moment magnitude
+		double mx = 0.0, my = 0.0, mz = 0.0;
+
+#pragma omp parallel for reduction(+:mx, my, mz)
+		for (int idx = 0; idx < n.dim(); idx++) {
+
+			if (M.is_not_empty(idx)) {
+
+				DBL3 S = M[idx].normalized();
+				mx += S.x; my += S.y; mz += S.z;
+			}
+		}
+
+		mc_pt_m[ridx] = (num_spins ? DBL3(mx, my, mz).norm() / num_spins : 0.0);
+
+		return 0.0;
+	});
+
+	mc_cone_angledeg = mc_pt_cone_angledeg[0];
+	mc_acceptance_rate = acceptance_rate_base;
+}
+
+//checkerboard Metropolis step (as Iterate_MonteCarlo_Parallel_Classic) for parallel tempering replica ridx, using only data of this replica : return acceptance rate
+double Atom_Mesh_Cubic::Iterate_MonteCarlo_Tempering_Replica(int ridx)
+{
+	VEC_VC<DBL3>& M = (ridx ? mc_pt_M1[ridx - 1] : M1);
+	std::vector<DBL3>& Hd = mc_pt_Hd[ridx];
+	BorisRandCB& rng = mc_pt_prng[ridx];
+
+	double temperature = Get_MonteCarlo_Tempering_Temperature(ridx);
+	double cone_angledeg = mc_pt_cone_angledeg[ridx];
+
+	//number of moves in this step : one per each spin
+	int num_moves = M.get_nonempty_cells();
+
+	double replica_acceptance_rate = 0.0;
+
+	//red-black : two passes will be taken
+	for (int rb = 0; rb < 2; rb++) {
+
+		double acceptance_rate = 0.0;
+
+#pragma omp parallel for reduction(+:acceptance_rate)
+		for (int idx_jk = 0; idx_jk < M.n.y * M.n.z; idx_jk++) {
+
+			int j = idx_jk % M.n.y;
+			int k = (idx_jk / M.n.y) % M.n.z;
+
+			bool red_nudge = (((j % 2) == 1 && (k % 2) == 0) || (((j % 2) == 0 && (k % 2) == 1)));
+
+			for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < M.n.x; i += 2) {
+
+				int spin_idx = i + j * M.n.x + k * M.n.x*M.n.y;
+
+				if (M.is_not_empty(spin_idx)) {
+
+					DBL3 M_old = M[spin_idx];
+
+					//random numbers for this spin and pass from the replica stream : sub-streams for the cone polar and azimuthal angles, and the acceptance test
+					double theta_rot = rng.rand(spin_idx, 0) * cone_angledeg * PI / 180.0;
+					double phi_rot = rng.rand(spin_idx, 1) * 2 * PI;
+
+					DBL3 M_new = relrotate_polar(M_old, theta_rot, phi_rot);
+					M_new = M_new.normalized() * M_old.norm();
+
+					double energy_change = Get_Atomistic_EnergyChange_SC(M, Hd, spin_idx, M_old, M_new);
+
+					double P_accept = exp(-energy_change / (BOLTZMANN * temperature));
+
+					if (rng.rand(spin_idx, 2) <= P_accept) {
+
+						M[spin_idx] = M_new;
+						acceptance_rate += 1.0 / num_moves;
+					}
+				}
+			}
+		}
+
+		replica_acceptance_rate += acceptance_rate;
+
+		//new random numbers for the next pass
+		rng.advance();
+
+		//dipolar field corrections for moves accepted in this pass
+		if (Hd.size()) MonteCarlo_Dipolar_Update(M, Hd, mc_pt_M1_ref[ridx], mc_pt_dM1[ridx]);
+	}
+
+	return replica_acceptance_rate;
+}
+
+//free parallel tempering replicas memory if previously used
+void Atom_Mesh_Cubic::MonteCarlo_Tempering_Free(void)
+{
+	if (mc_pt_M1.size() || mc_pt_prng.size()) {
+
+		mc_pt_M1.clear();
+		mc_pt_M1.shrink_to_fit();
+		mc_pt_Hd.clear();
+		mc_pt_M1_ref.clear();
+		mc_pt_dM1.clear();
+		mc_pt_prng.clear();
+		mc_pt_cone_angledeg.clear();
+		mc_pt_energy.clear();
+		mc_pt_m.clear();
+		mc_pt_swap_rate = 0.0;
+	}
+}
+
+//for each parallel tempering replica, after the last step : temperature (K), total energy (J), average normalized moment magnitude, cone angle (deg.)
+std::vector<DBL4> Atom_Mesh_Cubic::Get_MonteCarlo_Tempering_Observables(void)
+{
+	std::vector<DBL4> observables;
+
+	for (int ridx = 0; ridx < mc_pt_energy.size(); ridx++) {
+
+		observables.push_back(DBL4(Get_MonteCarlo_Tempering_Temperature(ridx), mc_pt_energy[ridx], mc_pt_m[ridx], mc_pt_cone_angledeg[ridx]));
+	}
+
+	return observables;
+}
+
 #if COMPILECUDA == 1
 //Take a Monte Carlo step in this atomistic mesh
 void Atom_Mesh_Cubic::Iterate_MonteCarloCUDA(double acceptance_rate)
@@ -74,6 +427,194 @@ void Atom_Mesh_Cubic::Iterate_MonteCarloCUDA(double acceptance_rate)
 }
 #endif
 
+//set mc_modules and pmc_Zeeman from currently set modules
+void Atom_Mesh_Cubic::Setup_MonteCarlo_Modules(void)
+{
+	mc_modules.clear();
+	pmc_Zeeman = nullptr;
+	pmc_DipoleDipole = nullptr;
+	pmc_Demag = nullptr;
+
+	for (int idx = 0; idx < pMod.size(); idx++) {
+
+		int module_id = pMod.get_ID_from_index(idx);
+
+		switch (module_id) {
+
+		case MOD_ZEEMAN:
+			pmc_Zeeman = dynamic_cast<Atom_Zeeman*>(pMod[idx]);
+			if (pmc_Zeeman) mc_modules.push_back(module_id);
+			break;
+
+		case MOD_EXCHANGE:
+		case MOD_DMEXCHANGE:
+		case MOD_IDMEXCHANGE:
+		case MOD_ANIUNI:
+		case MOD_ANICUBI:
+			mc_modules.push_back(module_id);
+			break;
+
+		//dipolar field is obtained separately in mc_Hd
+		case MOD_ATOM_DIPOLEDIPOLE:
+			if (pMod[idx]->IsInitialized()) pmc_DipoleDipole = dynamic_cast<Atom_DipoleDipole*>(pMod[idx]);
+			break;
+
+		case MOD_DEMAG:
+			if (pMod[idx]->IsInitialized()) pmc_Demag = dynamic_cast<Atom_Demag*>(pMod[idx]);
+			break;
+
+		//other modules don't contribute to Monte Carlo energies
+		default:
+			break;
+		}
+	}
+}
+
+//local fields at spin_index (energy units) for contributions linear in the spin direction, such that the spin energy is -S.(h_pair + h_site), where S is the spin direction.
+//pair interactions (exchange, DMI, dipolar) are in h_pair, single-site contributions (Zeeman) in h_site. Mnorm is the moment magnitude at spin_index.
+//M are the atomic moments (M1, or a parallel tempering replica) and Hd the dipolar field for them.
+void Atom_Mesh_Cubic::Get_Atomistic_LocalFields_SC(const VEC_VC<DBL3>& M, const std::vector<DBL3>& Hd, int spin_index, double Mnorm, DBL3& h_pair, DBL3& h_site)
+{
+	for (int idx = 0; idx < mc_modules.size(); idx++) {
+
+		switch (mc_modules[idx]) {
+
+		//exchange: -J * Sum_over_neighbors_j (Si . Sj), where Si, Sj are unit vectors
+		case MOD_EXCHANGE:
+		{
+			double J = this->J;
+			update_parameters_mcoarse(spin_index, this->J, J);
+
+			h_pair += J * M.ngbr_dirsum(spin_index);
+		}
+			break;
+
+		//DM exchange: D * Sum_over_neighbors_j(rij . (Si x Sj)) = -D * Si . Sum_over_neighbors_j(rij x Sj), with exchange as above
+		case MOD_DMEXCHANGE:
+		{
+			double J = this->J;
+			double D = this->D;
+			update_parameters_mcoarse(spin_index, this->J, J, this->D, D);
+
+			h_pair += J * M.ngbr_dirsum(spin_index) + D * M.anisotropic_ngbr_dirsum(spin_index);
+		}
+			break;
+
+		//iDM exchange: D * Sum_over_neighbors_j((rij x z) . (Si x Sj)) = -D * Si . Sum_over_neighbors_j((rij x z) x Sj), with exchange as above
+		case MOD_IDMEXCHANGE:
+		{
+			double J = this->J;
+			double D = this->D;
+			update_parameters_mcoarse(spin_index, this->J, J, this->D, D);
+
+			h_pair += J * M.ngbr_dirsum(spin_index) + D * M.zanisotropic_ngbr_dirsum(spin_index);
+		}
+			break;
+
+		//Zeeman: -MUB * M1 . MU0 * Ha, where M1 = Mnorm * S
+		case MOD_ZEEMAN:
+			h_site += (MUB * MU0 * Mnorm) * pmc_Zeeman->Get_Atomistic_Field(spin_index);
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	//dipolar: -MUB * M1 . MU0 * Hd / 2 summed over all spins, with Hd the dipolar field from all other spins, so this is a pair interaction
+	if ((pmc_DipoleDipole || pmc_Demag) && Hd.size()) h_pair += (MUB * MU0 * Mnorm) * Hd[spin_index];
+}
+
+//energy change for contributions not linear in the spin direction (anisotropy) when changing the spin direction at spin_index from S_old to S_new. With S_old = DBL3() this is the energy for S_new.
+double Atom_Mesh_Cubic::Get_Atomistic_AnisotropyEnergyChange_SC(int spin_index, const DBL3& S_old, const DBL3& S_new)
+{
+	double energy_change = 0.0;
+
+	for (int idx = 0; idx < mc_modules.size(); idx++) {
+
+		switch (mc_modules[idx]) {
+
+		//uniaxial anisotropy: -Ku * (S * ea)^2
+		case MOD_ANIUNI:
+		{
+			double K = this->K;
+			DBL3 mcanis_ea1 = this->mcanis_ea1;
+			update_parameters_mcoarse(spin_index, this->K, K, this->mcanis_ea1, mcanis_ea1);
+
+			double dotprod_old = S_old * mcanis_ea1;
+			double dotprod_new = S_new * mcanis_ea1;
+
+			energy_change += -K * (dotprod_new * dotprod_new - dotprod_old * dotprod_old);
+		}
+			break;
+
+		//cubic anisotropy: K * (d1^2*d2^2 + d1^2*d3^2 + d2^2*d3^2), with di = S . eai
+		case MOD_ANICUBI:
+		{
+			double K = this->K;
+			DBL3 mcanis_ea1 = this->mcanis_ea1;
+			DBL3 mcanis_ea2 = this->mcanis_ea2;
+			update_parameters_mcoarse(spin_index, this->K, K, this->mcanis_ea1, mcanis_ea1, this->mcanis_ea2, mcanis_ea2);
+
+			//vector product of ea1 and ea2 : the third orthogonal axis
+			DBL3 mcanis_ea3 = mcanis_ea1 ^ mcanis_ea2;
+
+			auto cubic_energy = [&](const DBL3& S) -> double {
+
+				double d1 = S * mcanis_ea1;
+				double d2 = S * mcanis_ea2;
+				double d3 = S * mcanis_ea3;
+
+				return K * (d1*d1*d2*d2 + d1*d1*d3*d3 + d2*d2*d3*d3);
+			};
+
+			energy_change += cubic_energy(S_new) - cubic_energy(S_old);
+		}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return energy_change;
+}
+
+//energy change when moving the spin at spin_index from M_old (currently set in M1) to M_new, with same magnitude.
+//For contributions linear in the spin direction (exchange, DMI, Zeeman) this is -(S_new - S_old).h, with h the local field obtained only once. Only anisotropy energies are evaluated explicitly for both spin directions.
+double Atom_Mesh_Cubic::Get_Atomistic_EnergyChange_SC(const VEC_VC<DBL3>& M, const std::vector<DBL3>& Hd, int spin_index, const DBL3& M_old, const DBL3& M_new)
+{
+	DBL3 S_old = M_old.normalized();
+	DBL3 S_new = M_new.normalized();
+
+	DBL3 h_pair, h_site;
+	Get_Atomistic_LocalFields_SC(M, Hd, spin_index, M_old.norm(), h_pair, h_site);
+
+	return Get_Atomistic_AnisotropyEnergyChange_SC(spin_index, S_old, S_new) - (S_new - S_old) * (h_pair + h_site);
+}
+
+//total energy of contributing modules in this mesh (pair interactions counted once), for currently set mc_modules
+double Atom_Mesh_Cubic::Get_Atomistic_TotalEnergy_SC(const VEC_VC<DBL3>& M, const std::vector<DBL3>& Hd)
+{
+	double energy = 0.0;
+
+#pragma omp parallel for reduction(+:energy)
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		if (M.is_not_empty(idx)) {
+
+			DBL3 S = M[idx].normalized();
+
+			DBL3 h_pair, h_site;
+			Get_Atomistic_LocalFields_SC(M, Hd, idx, M[idx].norm(), h_pair, h_site);
+
+			energy += Get_Atomistic_AnisotropyEnergyChange_SC(idx, DBL3(), S) - S * (h_pair / 2 + h_site);
+		}
+	}
+
+	return energy;
+}
+
 //Take a Monte Carlo step in this atomistic mesh : these functions implement the actual algorithms
 void Atom_Mesh_Cubic::Iterate_MonteCarlo_Serial_Classic(void)
 {
@@ -122,32 +663,26 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Serial_Classic(void)
 			//Also using a Gaussian distribution to move spin around the initial spin is less efficient, requiring more steps to thermalize.
 			DBL3 M1_new = relrotate_polar(M1_old, theta_rot, phi_rot);
 
-			//Find energy for current spin by summing all contributing modules energies at given spin only
-			double old_energy = 0.0, new_energy = 0.0;
-			for (int mod_idx = 0; mod_idx < pMod.size(); mod_idx++) {
+			//M1_new has same length as M1[spin_idx], but reset length anyway to avoid floating point error creep
+			M1_new = M1_new.normalized() * M1_old.norm();
 
-				old_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx);
-			}
-
-			//Set new spin; M1_new has same length as M1[spin_idx], but reset length anyway to avoid floating point error creep
-			M1[spin_idx] = M1_new.normalized() * M1_old.norm();
-			for (int mod_idx = 0; mod_idx < pMod.size(); mod_idx++) {
-
-				new_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx);
-			}
+			//Find energy change for current spin from all contributing modules at given spin only
+			double energy_change = Get_Atomistic_EnergyChange_SC(spin_idx, M1_old, M1_new);
 
 			//Compute acceptance probability
-			double P_accept = exp(-(new_energy - old_energy) / (BOLTZMANN * base_temperature));
+			double P_accept = exp(-energy_change / (BOLTZMANN * mc_temperature));
 
 			//uniform random number between 0 and 1
 			double P = prng.rand();
 
-			if (P > P_accept) {
+			if (P <= P_accept) {
 
-				//reject move
-				M1[spin_idx] = M1_old;
+				//accept move : set new spin
+				M1[spin_idx] = M1_new;
+				mc_acceptance_rate += 1.0 / num_moves;
+
+				if (mc_Hd.size()) MonteCarlo_Dipolar_Update_Spin(spin_idx);
 			}
-			else mc_acceptance_rate += 1.0 / num_moves;
 		}
 	}
 }
@@ -220,6 +755,9 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Serial_Constrained(void)
 			double sq2 = Mrot_new2.y * Mrot_new2.y + Mrot_new2.z * Mrot_new2.z;
 			double sqnorm = M_old2.norm()*M_old2.norm();
 
+			//tentative dipolar field change applied for first spin
+			bool dipolar_tentative = false;
+
 			if (sq2 < sqnorm) {
 
 				Mrot_new2.x = get_sign(Mrot_old2.x) * sqrt(sqnorm - sq2);
@@ -230,31 +768,25 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Serial_Constrained(void)
 				M_new1 = M_new1.normalized() * M_old1.norm();
 				M_new2 = M_new2.normalized() * M_old2.norm();
 
-				//Find energy for current spin by summing all contributing modules energies at given spins only
-				double old_energy = 0.0, new_energy = 0.0;
-				for (int mod_idx = 0; mod_idx < pMod.size(); mod_idx++) {
+				//Find energy change by moving the spins one after the other, so any interaction between them is accounted for
+				//(for the dipolar interaction the field change due to the first spin is applied before the second spin energy change)
+				double energy_change = Get_Atomistic_EnergyChange_SC(spin_idx1, M_old1, M_new1);
+				M1[spin_idx1] = M_new1;
+				if (mc_Hd.size()) {
 
-					old_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx1);
-					old_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx2);
+					MonteCarlo_Dipolar_Update_Spin(spin_idx1);
+					dipolar_tentative = true;
 				}
 
-				//Set new spins
-				M1[spin_idx1] = M_new1;
+				energy_change += Get_Atomistic_EnergyChange_SC(spin_idx2, M_old2, M_new2);
 				M1[spin_idx2] = M_new2;
 
-				//Find new energy
-				for (int mod_idx = 0; mod_idx < pMod.size(); mod_idx++) {
-
-					new_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx1);
-					new_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx2);
-				}
-
 				double cmc_M_new = cmc_M + Mrot_new1.x + Mrot_new2.x - Mrot_old1.x - Mrot_old2.x;
 
 				if (cmc_M_new > 0.0) {
 
 					//Compute acceptance probability
-					double P_accept = (cmc_M_new / cmc_M) * (cmc_M_new / cmc_M) * (abs(Mrot_old2.x) / abs(Mrot_new2.x)) * exp(-(new_energy - old_energy) / (BOLTZMANN * base_temperature));
+					double P_accept = (cmc_M_new / cmc_M) * (cmc_M_new / cmc_M) * (abs(Mrot_old2.x) / abs(Mrot_new2.x)) * exp(-energy_change / (BOLTZMANN * mc_temperature));
 
 					//uniform random number between 0 and 1
 					double P = prng.rand();
@@ -268,6 +800,8 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Serial_Constrained(void)
 						//For the serial algorithm keep it, but for the parallel algorithm keeping this line is very problematic (there are solutions, e.g. atomic writes, but at the cost of performance).
 						cmc_M = cmc_M_new;
 
+						if (mc_Hd.size()) MonteCarlo_Dipolar_Update_Spin(spin_idx2);
+
 						//next iteration, don't fall through
 						continue;
 					}
@@ -278,6 +812,9 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Serial_Constrained(void)
 			M1[spin_idx1] = M_old1;
 			M1[spin_idx2] = M_old2;
 
+			//undo tentative dipolar field change
+			if (dipolar_tentative) MonteCarlo_Dipolar_Update_Spin(spin_idx1, true);
+
 			continue;
 		}
 	}
@@ -330,37 +867,33 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Classic(void)
 					//Also using a Gaussian distribution to move spin around the initial spin is less efficient, requiring more steps to thermalize.
 					DBL3 M1_new = relrotate_polar(M1_old, theta_rot, phi_rot);
 
-					//Find energy for current spin by summing all contributing modules energies at given spin only
-					double old_energy = 0.0, new_energy = 0.0;
-					for (int mod_idx = 0; mod_idx < pMod.size(); mod_idx++) {
-
-						old_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx);
-					}
-
-					//Set new spin; M1_new has same length as M1[spin_idx], but reset length anyway to avoid floating point error creep
-					M1[spin_idx] = M1_new.normalized() * M1_old.norm();
-					for (int mod_idx = 0; mod_idx < pMod.size(); mod_idx++) {
+					//M1_new has same length as M1[spin_idx], but reset length anyway to avoid floating point error creep
+					M1_new = M1_new.normalized() * M1_old.norm();
 
-						new_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx);
-					}
+					//Find energy change for current spin from all contributing modules at given spin only
+					double energy_change = Get_Atomistic_EnergyChange_SC(spin_idx, M1_old, M1_new);
 
 					//Compute acceptance probability
-					double P_accept = exp(-(new_energy - old_energy) / (BOLTZMANN * base_temperature));
+					double P_accept = exp(-energy_change / (BOLTZMANN * mc_temperature));
 
 					//uniform random number between 0 and 1
 					double P = prng.rand();
 
-					if (P > P_accept) {
+					if (P <= P_accept) {
 
-						//reject move
-						M1[spin_idx] = M1_old;
+						//accept move : set new spin
+						M1[spin_idx] = M1_new;
+						acceptance_rate += 1.0 / num_moves;
 					}
-					else acceptance_rate += 1.0 / num_moves;
 				}
 			}
 		}
 
 		mc_acceptance_rate += acceptance_rate;
+
+		//dipolar field corrections for moves accepted in this pass
+		if (mc_Hd.size()) MonteCarlo_Dipolar_Update();
+
 		rb++;
 	}
 }
@@ -530,31 +1063,19 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 					M_new1 = M_new1.normalized() * M_old1.norm();
 					M_new2 = M_new2.normalized() * M_old2.norm();
 
-					//Find energy for current spin by summing all contributing modules energies at given spins only
-					double old_energy = 0.0, new_energy = 0.0;
-					for (int mod_idx = 0; mod_idx < pMod.size(); mod_idx++) {
-
-						old_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx1);
-						old_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx2);
-					}
-
-					//Set new spins
+					//Find energy change by moving the spins one after the other, so any interaction between them is accounted for
+					double energy_change = Get_Atomistic_EnergyChange_SC(spin_idx1, M_old1, M_new1);
 					M1[spin_idx1] = M_new1;
-					M1[spin_idx2] = M_new2;
 
-					//Find new energy
-					for (int mod_idx = 0; mod_idx < pMod.size(); mod_idx++) {
-
-						new_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx1);
-						new_energy += pMod[mod_idx]->Get_Atomistic_Energy(spin_idx2);
-					}
+					energy_change += Get_Atomistic_EnergyChange_SC(spin_idx2, M_old2, M_new2);
+					M1[spin_idx2] = M_new2;
 
 					double cmc_M_new = cmc_M + Mrot_new1.x + Mrot_new2.x - Mrot_old1.x - Mrot_old2.x;
 
 					if (cmc_M_new > 0.0) {
 
 						//Compute acceptance probability
-						double P_accept = (cmc_M_new / cmc_M) * (cmc_M_new / cmc_M) * (abs(Mrot_old2.x) / abs(Mrot_new2.x)) * exp(-(new_energy - old_energy) / (BOLTZMANN * base_temperature));
+						double P_accept = (cmc_M_new / cmc_M) * (cmc_M_new / cmc_M) * (abs(Mrot_old2.x) / abs(Mrot_new2.x)) * exp(-energy_change / (BOLTZMANN * mc_temperature));
 
 						//uniform random number between 0 and 1
 						double P = prng.rand();
@@ -579,8 +1100,400 @@ void Atom_Mesh_Cubic::Iterate_MonteCarlo_Parallel_Constrained(void)
 		}
 
 		mc_acceptance_rate += acceptance_rate;
+
+		//dipolar field corrections for moves accepted in this pass
+		if (mc_Hd.size()) MonteCarlo_Dipolar_Update();
+
 		rb++;
 	}
 }
 
+//indices of exchange neighbors of spin_index (up to 6 on the simple cubic lattice, including periodic boundary conditions) : return number of neighbors
+int Atom_Mesh_Cubic::Get_MonteCarlo_Cluster_Neighbors(int spin_index, int* ngbr_indices)
+{
+	int num_ngbrs = 0;
+
+	int flags = M1.ngbrFlags_ref()[spin_index];
+
+	//same rules as for ngbr_dirsum : with pbc a cell at the end of an axis has its neighbor at the other end
+	if (flags & NF_NPX) ngbr_indices[num_ngbrs++] = spin_index + 1;
+	else if ((flags & NF_NNX) && (flags & NF_PBCX)) ngbr_indices[num_ngbrs++] = spin_index - (n.x - 1);
+
+	if (flags & NF_NNX) ngbr_indices[num_ngbrs++] = spin_index - 1;
+	else if ((flags & NF_NPX) && (flags & NF_PBCX)) ngbr_indices[num_ngbrs++] = spin_index + (n.x - 1);
+
+	if (flags & NF_NPY) ngbr_indices[num_ngbrs++] = spin_index + n.x;
+	else if ((flags & NF_NNY) && (flags & NF_PBCY)) ngbr_indices[num_ngbrs++] = spin_index - (n.y - 1) * n.x;
+
+	if (flags & NF_NNY) ngbr_indices[num_ngbrs++] = spin_index - n.x;
+	else if ((flags & NF_NPY) && (flags & NF_PBCY)) ngbr_indices[num_ngbrs++] = spin_index + (n.y - 1) * n.x;
+
+	if (flags & NF_NPZ) ngbr_indices[num_ngbrs++] = spin_index + n.x * n.y;
+	else if ((flags & NF_NNZ) && (flags & NF_PBCZ)) ngbr_indices[num_ngbrs++] = spin_index - (n.z - 1) * n.x * n.y;
+
+	if (flags & NF_NNZ) ngbr_indices[num_ngbrs++] = spin_index - n.x * n.y;
+	else if ((flags & NF_NPZ) && (flags & NF_PBCZ)) ngbr_indices[num_ngbrs++] = spin_index + (n.z - 1) * n.x * n.y;
+
+	return num_ngbrs;
+}
+
+//Wolff embedded cluster algorithm (PRL 62, 361 (1989)) : clusters are built using the isotropic exchange only, and all spins in a cluster are reflected in the plane perpendicular to a random direction r.
+//Remaining contributions (anisotropy, Zeeman, DMI) are included by accepting the cluster reflection with Metropolis probability for their energy change.
+//Clusters are built and reflected until the number of spins visited reaches the number of spins in the mesh.
+void Atom_Mesh_Cubic::Iterate_MonteCarlo_Cluster(void)
+{
+	//number of spins in this mesh
+	int num_spins = M1.get_nonempty_cells();
+	if (!num_spins) return;
+
+	//number of cells in this mesh
+	unsigned N = n.dim();
+
+	//make sure cluster arrays have correct memory allocated : mc_indices holds the cluster spin indices (also used by the serial algorithms, but always reset before use)
+	if (mc_indices.size() != N) if (!malloc_vector(mc_indices, N)) return;
+	if (mc_cluster_marks.size() != N) if (!malloc_vector(mc_cluster_marks, N, (unsigned char)0)) return;
+
+	//isotropic exchange modules set? Cluster bonds are only formed for these.
+	int num_exchange = 0;
+	for (int idx = 0; idx < mc_modules.size(); idx++) {
+
+		if (mc_modules[idx] == MOD_EXCHANGE || mc_modules[idx] == MOD_DMEXCHANGE || mc_modules[idx] == MOD_IDMEXCHANGE) num_exchange++;
+	}
+
+	double kT = BOLTZMANN * mc_temperature;
+
+	int spins_visited = 0, spins_accepted = 0;
+
+	///////////////////////////////////////////////////////////////
+	// WOLFF CLUSTER MONTE-CARLO
+
+	while (spins_visited < num_spins) {
+
+		//seed spin picked at random
+		int seed_idx = floor(prng.rand() * N);
+		if (seed_idx >= N) seed_idx = N - 1;
+		if (M1.is_empty(seed_idx)) continue;
+
+		//reflection direction picked uniformly on the unit sphere
+		double cos_theta = 2 * prng.rand() - 1.0;
+		double sin_theta = sqrt(1.0 - cos_theta * cos_theta);
+		double phi = prng.rand() * 2 * PI;
+		DBL3 r = DBL3(sin_theta * cos(phi), sin_theta * sin(phi), cos_theta);
+
+		///////////////////////////////////////////////////////////////
+		// BUILD CLUSTER
+
+		int cluster_size = 0;
+		mc_indices[cluster_size++] = seed_idx;
+		mc_cluster_marks[seed_idx] = 1;
+
+		if (num_exchange) {
+
+			for (int cidx = 0; cidx < cluster_size; cidx++) {
+
+				int spin_idx = mc_indices[cidx];
+
+				double J = this->J;
+				update_parameters_mcoarse(spin_idx, this->J, J);
+
+				double rSi = r * M1[spin_idx].normalized();
+
+				int ngbr_indices[6];
+				int num_ngbrs = Get_MonteCarlo_Cluster_Neighbors(spin_idx, ngbr_indices);
+
+				for (int nidx = 0; nidx < num_ngbrs; nidx++) {
+
+					int ngbr_idx = ngbr_indices[nidx];
+					if (mc_cluster_marks[ngbr_idx] || M1.is_empty(ngbr_idx)) continue;
+
+					//bond activation probability 1 - exp(min(0, -2 * J * (r.Si) * (r.Sj) / kT))
+					double bond_energy = 2 * num_exchange * J * rSi * (r * M1[ngbr_idx].normalized());
+
+					if (bond_energy > 0.0 && prng.rand() < 1.0 - exp(-bond_energy / kT)) {
+
+						mc_indices[cluster_size++] = ngbr_idx;
+						mc_cluster_marks[ngbr_idx] = 1;
+					}
+				}
+			}
+		}
+
+		///////////////////////////////////////////////////////////////
+		// REFLECT CLUSTER
+
+		//reflect spins one at a time, obtaining the total energy change as a sum of single spin energy changes, then remove the isotropic exchange contribution already accounted for by the cluster construction
+		//the dipolar field change due to each reflected spin is applied before the next spin energy change, so the dipolar coupling between spins in the cluster is included
+		double energy_change = 0.0;
+
+		for (int cidx = 0; cidx < cluster_size; cidx++) {
+
+			int spin_idx = mc_indices[cidx];
+
+			DBL3 M1_old = M1[spin_idx];
+			DBL3 M1_new = M1_old - 2 * (M1_old * r) * r;
+
+			energy_change += Get_Atomistic_EnergyChange_SC(spin_idx, M1_old, M1_new);
+
+			if (num_exchange) {
+
+				double J = this->J;
+				update_parameters_mcoarse(spin_idx, this->J, J);
+
+				energy_change += num_exchange * J * ((M1_new - M1_old) / M1_old.norm()) * M1.ngbr_dirsum(spin_idx);
+			}
+
+			M1[spin_idx] = M1_new;
+			if (mc_Hd.size()) MonteCarlo_Dipolar_Update_Spin(spin_idx);
+		}
+
+		//Metropolis acceptance for the remaining energy change
+		if (energy_change > 0.0 && prng.rand() > exp(-energy_change / kT)) {
+
+			//reject : reflect back
+			for (int cidx = 0; cidx < cluster_size; cidx++) {
+
+				int spin_idx = mc_indices[cidx];
+				M1[spin_idx] = M1[spin_idx] - 2 * (M1[spin_idx] * r) * r;
+				if (mc_Hd.size()) MonteCarlo_Dipolar_Update_Spin(spin_idx, true);
+			}
+		}
+		else spins_accepted += cluster_size;
+
+		for (int cidx = 0; cidx < cluster_size; cidx++) mc_cluster_marks[mc_indices[cidx]] = 0;
+
+		spins_visited += cluster_size;
+	}
+
+	//fraction of spins reflected in accepted clusters
+	mc_acceptance_rate = (double)spins_accepted / spins_visited;
+}
+
+//Dipolar field for Monte Carlo energies : a full convolution (using the dipole-dipole or demag module) is expensive, so it is done every mc_dipolar_refresh steps only, or when the accumulated moment change exceeds mc_dipolar_threshold.
+//In between, accepted moves update the field in nearby cells using point dipole fields (within mc_dipolar_radius cells), so moves see the field changes due to previous moves within short range.
+//The error of the incrementally updated field is measured at every full convolution (mc_dipolar_error) so the refresh interval and radius can be chosen for a required accuracy.
+
+//full convolution of dipolar field used for Monte Carlo energies (measure error of incrementally updated field if required)
+void Atom_Mesh_Cubic::MonteCarlo_Dipolar_Refresh(bool measure_error)
+{
+	unsigned N = n.dim();
+
+	if (mc_Hd.size() != N) {
+
+		if (!malloc_vector(mc_Hd, N) || !malloc_vector(mc_M1_ref, N) || !malloc_vector(mc_dM1, N)) {
+
+			//out of memory : dipolar contribution not included
+			mc_Hd.clear();
+			mc_M1_ref.clear();
+			mc_dM1.clear();
+			return;
+		}
+
+		//no previous field to compare with
+		measure_error = false;
+	}
+
+	MonteCarlo_Dipolar_SetKernel();
+
+	//dipolar modules add their field to Heff1 : Heff1 is not used by Monte Carlo algorithms, and is computed again at the start of the next ODE iteration
+	Heff1.set(DBL3());
+
+	if (pmc_DipoleDipole) pmc_DipoleDipole->UpdateField_NoSpeedup();
+	if (pmc_Demag) pmc_Demag->UpdateField_NoSpeedup();
+
+	double error_num = 0.0, error_den = 0.0, Mtotal = 0.0;
+
+#pragma omp parallel for reduction(+:error_num, error_den, Mtotal)
+	for (int idx = 0; idx < N; idx++) {
+
+		if (M1.is_not_empty(idx)) {
+
+			if (measure_error) {
+
+				error_num += (Heff1[idx] - mc_Hd[idx]) * (Heff1[idx] - mc_Hd[idx]);
+				error_den += Heff1[idx] * Heff1[idx];
+			}
+
+			Mtotal += M1[idx].norm();
+		}
+
+		mc_Hd[idx] = Heff1[idx];
+		mc_M1_ref[idx] = M1[idx];
+	}
+
+	if (measure_error) mc_dipolar_error = (error_den > 0.0 ? sqrt(error_num / error_den) : 0.0);
+
+	mc_dipolar_Mtotal = Mtotal;
+	mc_dipolar_steps = 0;
+	mc_dipolar_change = 0.0;
+}
+
+//check if full convolution of dipolar field is due, before a Monte Carlo step
+void Atom_Mesh_Cubic::MonteCarlo_Dipolar_CheckRefresh(void)
+{
+	if (!pmc_DipoleDipole && !pmc_Demag) {
+
+		MonteCarlo_Dipolar_Free();
+		return;
+	}
+
+	if (mc_Hd.size() != n.dim() || mc_dipolar_steps >= mc_dipolar_refresh || (mc_dipolar_threshold > 0.0 && mc_dipolar_change >= mc_dipolar_threshold)) {
+
+		MonteCarlo_Dipolar_Refresh(true);
+	}
+
+	mc_dipolar_steps++;
+}
+
+//free dipolar field memory if previously used (dipolar contribution not used)
+void Atom_Mesh_Cubic::MonteCarlo_Dipolar_Free(void)
+{
+	if (mc_Hd.size()) {
+
+		mc_Hd.clear();
+		mc_Hd.shrink_to_fit();
+		mc_M1_ref.clear();
+		mc_M1_ref.shrink_to_fit();
+		mc_dM1.clear();
+		mc_dM1.shrink_to_fit();
+	}
+
+	mc_dipolar_error = 0.0;
+}
+
+//set real-space dipolar correction kernel for current radius and cellsize
+void Atom_Mesh_Cubic::MonteCarlo_Dipolar_SetKernel(void)
+{
+	if (mc_dipolar_kernel_radius == mc_dipolar_radius && mc_dipolar_kernel_h == h) return;
+
+	mc_dipolar_kernel.clear();
+	mc_dipolar_offsets.clear();
+
+	int radius = mc_dipolar_radius;
+
+	for (int k = -radius; k <= radius; k++) {
+		for (int j = -radius; j <= radius; j++) {
+			for (int i = -radius; i <= radius; i++) {
+
+				//spherical cutoff, excluding the cell itself
+				if ((i == 0 && j == 0 && k == 0) || i * i + j * j + k * k > radius * radius) continue;
+
+				DBL3 r = DBL3(i * h.x, j * h.y, k * h.z);
+				double rnorm = r.norm();
+				DBL3 u = r / rnorm;
+
+				//point dipole field : H = (3 (mu . u) u - mu) / (4 * PI * r^3)
+				DBL33 D = DBL33(3 * u.x * u - DBL3(1, 0, 0), 3 * u.y * u - DBL3(0, 1, 0), 3 * u.z * u - DBL3(0, 0, 1)) * (1.0 / (4 * PI * rnorm * rnorm * rnorm));
+
+				mc_dipolar_kernel.push_back(D);
+				mc_dipolar_offsets.push_back(INT3(i, j, k));
+			}
+		}
+	}
+
+	mc_dipolar_kernel_radius = mc_dipolar_radius;
+	mc_dipolar_kernel_h = h;
+}
+
+//cell index at offset from cell (i, j, k), with periodic boundary conditions if set : -1 if outside mesh
+int Atom_Mesh_Cubic::MonteCarlo_Dipolar_OffsetIndex(int i, int j, int k, const INT3& offset)
+{
+	i += offset.i;
+	j += offset.j;
+	k += offset.k;
+
+	if (i < 0 || i >= n.x) {
+
+		if (!M1.is_pbc_x()) return -1;
+		i = (i % (int)n.x + n.x) % n.x;
+	}
+
+	if (j < 0 || j >= n.y) {
+
+		if (!M1.is_pbc_y()) return -1;
+		j = (j % (int)n.y + n.y) % n.y;
+	}
+
+	if (k < 0 || k >= n.z) {
+
+		if (!M1.is_pbc_z()) return -1;
+		k = (k % (int)n.z + n.z) % n.z;
+	}
+
+	return i + j * n.x + k * n.x * n.y;
+}
+
+//real-space dipolar field correction for the moment change at spin_index since the last update, added to cells within the correction radius : used by serial algorithms after each accepted move
+//revert : the moment change undoes a tentative change already applied, so it doesn't count towards the accumulated change
+void Atom_Mesh_Cubic::MonteCarlo_Dipolar_Update_Spin(int spin_index, bool revert)
+{
+	DBL3 dM1 = M1[spin_index] - mc_M1_ref[spin_index];
+	mc_M1_ref[spin_index] = M1[spin_index];
+
+	if (mc_dipolar_Mtotal > 0.0) mc_dipolar_change += (revert ? -1 : 1) * dM1.norm() / mc_dipolar_Mtotal;
+
+	int i = spin_index % n.x;
+	int j = (spin_index / n.x) % n.y;
+	int k = spin_index / (n.x * n.y);
+
+	//moment change in A m^2
+	DBL3 dmu = MUB * dM1;
+
+	for (int oidx = 0; oidx < mc_dipolar_offsets.size(); oidx++) {
+
+		int cell_idx = MonteCarlo_Dipolar_OffsetIndex(i, j, k, mc_dipolar_offsets[oidx]);
+
+		if (cell_idx >= 0 && M1.is_not_empty(cell_idx)) mc_Hd[cell_idx] += mc_dipolar_kernel[oidx] * dmu;
+	}
+}
+
+//real-space dipolar field corrections for all moment changes since the last update, obtained for each cell from changes within the correction radius : used by parallel algorithms after each pass
+void Atom_Mesh_Cubic::MonteCarlo_Dipolar_Update(void)
+{
+	double change = MonteCarlo_Dipolar_Update(M1, mc_Hd, mc_M1_ref, mc_dM1);
+
+	if (mc_dipolar_Mtotal > 0.0) mc_dipolar_change += change / mc_dipolar_Mtotal;
+}
+
+//the version with arguments works on the given moments (M1 or a parallel tempering replica), dipolar field, and reference moments and moment changes buffers, and returns the sum of moment change magnitudes
+double Atom_Mesh_Cubic::MonteCarlo_Dipolar_Update(const VEC_VC<DBL3>& M, std::vector<DBL3>& Hd, std::vector<DBL3>& M_ref, std::vector<DBL3>& dM)
+{
+	double change = 0.0;
+
+#pragma omp parallel for reduction(+:change)
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		dM[idx] = M[idx] - M_ref[idx];
+		M_ref[idx] = M[idx];
+
+		change += dM[idx].norm();
+	}
+
+	if (!change || !mc_dipolar_offsets.size()) return change;
+
+	//point dipole field tensor is the same for opposite offsets, so each cell can gather the corrections from its neighbors
+#pragma omp parallel for
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		if (M.is_not_empty(idx)) {
+
+			int i = idx % n.x;
+			int j = (idx / n.x) % n.y;
+			int k = idx / (n.x * n.y);
+
+			DBL3 dH;
+
+			for (int oidx = 0; oidx < mc_dipolar_offsets.size(); oidx++) {
+
+				int cell_idx = MonteCarlo_Dipolar_OffsetIndex(i, j, k, mc_dipolar_offsets[oidx]);
+
+				if (cell_idx >= 0 && !dM[cell_idx].IsNull()) dH += mc_dipolar_kernel[oidx] * dM[cell_idx];
+			}
+
+			Hd[idx] += MUB * dH;
+		}
+	}
+
+	return change;
+}
+
 #endif
\ No newline at end of file
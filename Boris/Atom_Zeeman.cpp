@@ -300,6 +300,20 @@ double Atom_Zeeman::Get_Atomistic_Energy(int spin_index)
 	else return 0.0;
 }
 
+//applied field at given spin index, including cHA spatial scaling. Energy is linear in the moment, so Monte Carlo energy changes can be obtained from this directly.
+DBL3 Atom_Zeeman::Get_Atomistic_Field(int spin_index)
+{
+	double cHA = paMesh->cHA;
+	paMesh->update_parameters_mcoarse(spin_index, paMesh->cHA, cHA);
+
+	if (!H_equation.is_set()) return cHA * Ha;
+	else {
+
+		DBL3 relpos = paMesh->M1.cellidx_to_position(spin_index);
+		return cHA * H_equation.evaluate_vector(relpos.x, relpos.y, relpos.z, pSMesh->GetStageTime());
+	}
+}
+
 //----------------------------------------------- Others
 
 void Atom_Zeeman::SetField(DBL3 Hxyz)
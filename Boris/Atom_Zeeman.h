@@ -74,6 +74,9 @@ public:
 	//For simple cubic mesh spin_index coincides with index in M1
 	double Get_Atomistic_Energy(int spin_index);
 
+	//applied field at given spin index, including cHA spatial scaling. Energy is linear in the moment, so Monte Carlo energy changes can be obtained from this directly.
+	DBL3 Get_Atomistic_Field(int spin_index);
+
 	//-------------------
 
 	void SetField(DBL3 Hxyz);
@@ -123,6 +126,12 @@ public:
 
 	//-------------------
 
+	//-------------------Energy methods
+
+	DBL3 Get_Atomistic_Field(int spin_index) { return DBL3(); }
+
+	//-------------------
+
 	void SetField(DBL3 Hxyz) {}
 	DBL3 GetField(void) { return DBL3(); }
 
@@ -949,6 +949,13 @@ void Simulation::Print_Threads(void)
 	BD.DisplayFormattedConsoleMessage(threads_info);
 }
 
+//---------------------------------------------------- DEMAG KERNEL CACHE
+
+void Simulation::Print_KernelCacheStatus(void)
+{
+	BD.DisplayConsoleListing("Demag kernel cache size limit (MB) : " + ToString(kernelcache_size_MB) + (kernelcache_size_MB ? "" : " (disabled)"));
+}
+
 //---------------------------------------------------- SCRIPT SERVER INFO
 
 void Simulation::Print_ServerInfo(void)
@@ -1142,6 +1149,47 @@ std::string Simulation::Build_MCSettings_ListLine(int meshIndex)
 	return mcsettings_line;
 }
 
+void Simulation::Print_MCTempering(void)
+{
+	for (int idxMesh = 0; idxMesh < (int)SMesh().size(); idxMesh++) {
+
+		if (!SMesh[idxMesh]->is_atomistic()) continue;
+
+		Atom_Mesh* paMesh = dynamic_cast<Atom_Mesh*>(SMesh[idxMesh]);
+
+		if (paMesh->Get_MonteCarlo_Tempering_Replicas() < 2) {
+
+			BD.DisplayConsoleListing(SMesh.key_from_meshIdx(idxMesh) + " : parallel tempering disabled");
+			continue;
+		}
+
+		BD.DisplayConsoleListing(SMesh.key_from_meshIdx(idxMesh) + " : parallel tempering with " + ToString(paMesh->Get_MonteCarlo_Tempering_Replicas()) + 
+			" replicas up to " + ToString(paMesh->Get_MonteCarlo_Tempering_Tmax()) + " K; swap acceptance rate : " + ToString(paMesh->Get_MonteCarlo_Tempering_SwapRate()));
+
+		std::vector<DBL4> observables = paMesh->Get_MonteCarlo_Tempering_Observables();
+
+		for (int ridx = 0; ridx < observables.size(); ridx++) {
+
+			BD.DisplayConsoleListing("T = " + ToString(observables[ridx].i) + " K : E = " + ToString(observables[ridx].j) + " J, |<m>| = " + ToString(observables[ridx].k) + ", cone angle = " + ToString(observables[ridx].l) + " deg.");
+		}
+	}
+}
+
+void Simulation::Print_MCDipolar(void)
+{
+	for (int idxMesh = 0; idxMesh < (int)SMesh().size(); idxMesh++) {
+
+		if (!SMesh[idxMesh]->is_atomistic() && SMesh[idxMesh]->GetMeshType() != MESH_FERROMAGNETIC) continue;
+
+		MeshBase* pMesh_mc = SMesh[idxMesh];
+
+		std::string threshold = (pMesh_mc->Get_MonteCarlo_Dipolar_Threshold() > 0.0 ? ToString(pMesh_mc->Get_MonteCarlo_Dipolar_Threshold()) : std::string("none"));
+
+		BD.DisplayConsoleListing(SMesh.key_from_meshIdx(idxMesh) + " : dipolar field refresh every " + ToString(pMesh_mc->Get_MonteCarlo_Dipolar_Refresh()) + 
+			" steps, correction radius " + ToString(pMesh_mc->Get_MonteCarlo_Dipolar_Radius()) + " cells, change threshold : " + threshold + "; relative rms error : " + ToString(pMesh_mc->Get_MonteCarlo_Dipolar_Error()));
+	}
+}
+
 //---------------------------------------------------- SHAPE MODIFIERS
 
 void Simulation::Print_ShapeSettings(void)
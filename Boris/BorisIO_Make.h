@@ -320,6 +320,8 @@ void Simulation::MakeIOInfo(void)
 	ioInfo.set(showdata_info_generic + std::string("<i><b>magnetization solver time step</i>"), INT2(IOI_SHOWDATA, DATA_DT));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>magnetization relaxation |mxh|</i>"), INT2(IOI_SHOWDATA, DATA_MXH));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>magnetization relaxation |dm/dt|</i>"), INT2(IOI_SHOWDATA, DATA_DMDT));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>evaluation speedup field extrapolation relative error</i>"), INT2(IOI_SHOWDATA, DATA_EVALSPEEDUPERR));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>adaptive time step method accepted and rejected steps</i>"), INT2(IOI_SHOWDATA, DATA_STEPSTATS));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Average magnetization</i>"), INT2(IOI_SHOWDATA, DATA_AVM));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Average magnetization sub-lattice B</i>"), INT2(IOI_SHOWDATA, DATA_AVM2));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Average squared X magnetization</i>"), INT2(IOI_SHOWDATA, DATA_AVMXSQ));
@@ -330,6 +332,10 @@ void Simulation::MakeIOInfo(void)
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Magnetization component y min-max</i>"), INT2(IOI_SHOWDATA, DATA_MY_MINMAX));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Magnetization component z min-max</i>"), INT2(IOI_SHOWDATA, DATA_MZ_MINMAX));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Monte-Carlo cone angle (deg.) and target acceptance.</i>"), INT2(IOI_SHOWDATA, DATA_MONTECARLOPARAMS));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Monte-Carlo parallel tempering swap acceptance rate.</i>"), INT2(IOI_SHOWDATA, DATA_MCPTSWAP));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Monte-Carlo dipolar field relative rms error before full recomputation.</i>"), INT2(IOI_SHOWDATA, DATA_MCDIPOLARERROR));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Monte-Carlo parallel tempering observables for each replica: temperature (K), energy (J), |<m>|.</i>"), INT2(IOI_SHOWDATA, DATA_MCPTOBSERVABLES));
+	ioInfo.set(showdata_info_generic + std::string("<i><b>Average magnetization for each ensemble replica.</i>"), INT2(IOI_SHOWDATA, DATA_ENSEMBLEM));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Applied magnetic field</i>"), INT2(IOI_SHOWDATA, DATA_HA));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Average charge current density</i>"), INT2(IOI_SHOWDATA, DATA_JC));
 	ioInfo.set(showdata_info_generic + std::string("<i><b>Average spin x-current density</i>"), INT2(IOI_SHOWDATA, DATA_JSX));
@@ -375,6 +381,8 @@ void Simulation::MakeIOInfo(void)
 	ioInfo.set(data_info_generic + std::string("<i><b>magnetization solver time step</i>"), INT2(IOI_DATA, DATA_DT));
 	ioInfo.set(data_info_generic + std::string("<i><b>magnetization relaxation |mxh|</i>"), INT2(IOI_DATA, DATA_MXH));
 	ioInfo.set(data_info_generic + std::string("<i><b>magnetization relaxation |dm/dt|</i>"), INT2(IOI_DATA, DATA_DMDT));
+	ioInfo.set(data_info_generic + std::string("<i><b>evaluation speedup field extrapolation relative error</i>"), INT2(IOI_DATA, DATA_EVALSPEEDUPERR));
+	ioInfo.set(data_info_generic + std::string("<i><b>adaptive time step method accepted and rejected steps</i>"), INT2(IOI_DATA, DATA_STEPSTATS));
 	ioInfo.set(data_info_generic + std::string("<i><b>Average magnetization</i>"), INT2(IOI_DATA, DATA_AVM));
 	ioInfo.set(data_info_generic + std::string("<i><b>Average magnetization sub-lattice B</i>"), INT2(IOI_DATA, DATA_AVM2));
 	ioInfo.set(data_info_generic + std::string("<i><b>Average squared X magnetization</i>"), INT2(IOI_DATA, DATA_AVMXSQ));
@@ -385,6 +393,10 @@ void Simulation::MakeIOInfo(void)
 	ioInfo.set(data_info_generic + std::string("<i><b>Magnetization component y min-max</i>"), INT2(IOI_DATA, DATA_MY_MINMAX));
 	ioInfo.set(data_info_generic + std::string("<i><b>Magnetization component z min-max</i>"), INT2(IOI_DATA, DATA_MZ_MINMAX));
 	ioInfo.set(data_info_generic + std::string("<i><b>Monte-Carlo cone angle (deg.) and target acceptance.</i>"), INT2(IOI_DATA, DATA_MONTECARLOPARAMS));
+	ioInfo.set(data_info_generic + std::string("<i><b>Monte-Carlo parallel tempering swap acceptance rate.</i>"), INT2(IOI_DATA, DATA_MCPTSWAP));
+	ioInfo.set(data_info_generic + std::string("<i><b>Monte-Carlo dipolar field relative rms error before full recomputation.</i>"), INT2(IOI_DATA, DATA_MCDIPOLARERROR));
+	ioInfo.set(data_info_generic + std::string("<i><b>Monte-Carlo parallel tempering observables for each replica: temperature (K), energy (J), |<m>|. 3 columns per replica.</i>"), INT2(IOI_DATA, DATA_MCPTOBSERVABLES));
+	ioInfo.set(data_info_generic + std::string("<i><b>Average magnetization for each ensemble replica. 3 columns per replica.</i>"), INT2(IOI_DATA, DATA_ENSEMBLEM));
 	ioInfo.set(data_info_generic + std::string("<i><b>Applied magnetic field</i>"), INT2(IOI_DATA, DATA_HA));
 	ioInfo.set(data_info_generic + std::string("<i><b>Average charge current density</i>"), INT2(IOI_DATA, DATA_JC));
 	ioInfo.set(data_info_generic + std::string("<i><b>Average spin x-current density</i>"), INT2(IOI_DATA, DATA_JSX));
@@ -1453,7 +1465,7 @@ void Simulation::MakeIOInfo(void)
 
 	ioInfo.push_back(IOI_MCCOMPUTATION_info, IOI_MCCOMPUTATION);
 
-	//Shows Monte-Carlo algorithm type : minorId is the unique mesh id number, auxId is the type (0 : classical, 1 : constrained, -1 : N/A), textId is the constrained DBL3 direction.
+	//Shows Monte-Carlo algorithm type : minorId is the unique mesh id number, auxId is the type (0 : classical, 1 : constrained, 2 : cluster, -1 : N/A), textId is the constrained DBL3 direction.
 	//IOI_MCTYPE
 
 	std::string IOI_MCTYPE_info =
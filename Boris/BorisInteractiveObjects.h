@@ -358,7 +358,7 @@ enum IOI_
 	//Shows Monte-Carlo computation type (serial/parallel) : minorId is the unique mesh id number, auxId is the status (0 : parallel, 1 : serial, -1 : N/A)
 	IOI_MCCOMPUTATION,
 	
-	//Shows Monte-Carlo algorithm type : minorId is the unique mesh id number, auxId is the type (0 : classical, 1 : constrained, -1 : N/A), textId is the constrained DBL3 direction.
+	//Shows Monte-Carlo algorithm type : minorId is the unique mesh id number, auxId is the type (0 : classical, 1 : constrained, 2 : cluster, -1 : N/A), textId is the constrained DBL3 direction.
 	IOI_MCTYPE,
 
 	//Shows shape rotation setting: textId is the value as text (DBL3)
@@ -2366,7 +2366,7 @@ InteractiveObjectActionOutcome Simulation::ConsoleActionHandler(int actionCode,
 	}
 	break;
 
-	//Shows Monte-Carlo algorithm type : minorId is the unique mesh id number, auxId is the type (0 : classical, 1 : constrained, -1 : N/A), textId is the constrained DBL3 direction.
+	//Shows Monte-Carlo algorithm type : minorId is the unique mesh id number, auxId is the type (0 : classical, 1 : constrained, 2 : cluster, -1 : N/A), textId is the constrained DBL3 direction.
 	case IOI_MCTYPE:
 	{
 		int meshId = iop.minorId;
@@ -2379,8 +2379,8 @@ InteractiveObjectActionOutcome Simulation::ConsoleActionHandler(int actionCode,
 		}
 		else if (type == 1) {
 
-			//Currently in constrained mode. Right-click to toggle, or double-click to edit direction
-			if (actionCode == AC_MOUSERIGHTDOWN) sendCommand_verbose(CMD_MCCONSTRAIN, DBL3(), SMesh.key_from_meshId(meshId));
+			//Currently in constrained mode. Right-click to toggle to cluster mode, or double-click to edit direction
+			if (actionCode == AC_MOUSERIGHTDOWN) sendCommand_verbose(CMD_MCCLUSTER, 1, SMesh.key_from_meshId(meshId));
 
 			//on double-click make popup edit box to edit the currently displayed value
 			else if (actionCode == AC_DOUBLECLICK) { actionOutcome = AO_STARTPOPUPEDITBOX; }
@@ -2394,6 +2394,11 @@ InteractiveObjectActionOutcome Simulation::ConsoleActionHandler(int actionCode,
 				sendCommand_verbose(CMD_MCCONSTRAIN, to_text, SMesh.key_from_meshId(meshId));
 			}
 		}
+		else if (type == 2) {
+
+			//Currently in cluster mode. Click to toggle to classical mode.
+			if (actionCode == AC_MOUSERIGHTDOWN) sendCommand_verbose(CMD_MCCLUSTER, 0, SMesh.key_from_meshId(meshId));
+		}
 	}
 	break;
 	//Shows shape rotation setting: textId is the value as text (DBL3)
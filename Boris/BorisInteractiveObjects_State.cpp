@@ -3333,7 +3333,7 @@ InteractiveObjectStateChange Simulation::ConsoleInteractiveObjectState(Interacti
 	}
 	break;
 
-	//Shows Monte-Carlo algorithm type : minorId is the unique mesh id number, auxId is the type (0 : classical, 1 : constrained, -1 : N/A), textId is the constrained DBL3 direction.
+	//Shows Monte-Carlo algorithm type : minorId is the unique mesh id number, auxId is the type (0 : classical, 1 : constrained, 2 : cluster, -1 : N/A), textId is the constrained DBL3 direction.
 	case IOI_MCTYPE:
 	{
 		int meshId = iop.minorId;
@@ -3352,14 +3352,22 @@ InteractiveObjectStateChange Simulation::ConsoleInteractiveObjectState(Interacti
 				iop.auxId = -1;
 			}
 			else if (type >= 0 && 
-				((bool)type != dynamic_cast<Atom_Mesh*>(SMesh[meshIdx])->Get_MonteCarlo_Constrained() || 
+				((type == 1) != dynamic_cast<Atom_Mesh*>(SMesh[meshIdx])->Get_MonteCarlo_Constrained() || 
+				(type == 2) != dynamic_cast<Atom_Mesh*>(SMesh[meshIdx])->Get_MonteCarlo_Cluster() ||
 				(type == 1 && (DBL3)ToNum(direction) != dynamic_cast<Atom_Mesh*>(SMesh[meshIdx])->Get_MonteCarlo_Constrained_Direction()))) {
 
-				iop.auxId = dynamic_cast<Atom_Mesh*>(SMesh[meshIdx])->Get_MonteCarlo_Constrained();
+				if (dynamic_cast<Atom_Mesh*>(SMesh[meshIdx])->Get_MonteCarlo_Constrained()) iop.auxId = 1;
+				else if (dynamic_cast<Atom_Mesh*>(SMesh[meshIdx])->Get_MonteCarlo_Cluster()) iop.auxId = 2;
+				else iop.auxId = 0;
+
 				if (iop.auxId == 0) {
 
 					iop.textId = "Classical";
 				}
+				else if (iop.auxId == 2) {
+
+					iop.textId = "Cluster";
+				}
 				else {
 
 					iop.textId = ToString(dynamic_cast<Atom_Mesh*>(SMesh[meshIdx])->Get_MonteCarlo_Constrained_Direction());
@@ -1525,6 +1525,83 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_EVALSPEEDUPEXTRAP:
+		{
+			int order;
+
+			error = commandSpec.GetParameters(command_fields, order);
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetEvaluationSpeedupExtrapolation(order);
+
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleMessage("Evaluation speedup extrapolation order : " + ToString(SMesh.GetEvaluationSpeedupExtrapolation()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetEvaluationSpeedupExtrapolation()));
+		}
+		break;
+
+		case CMD_PREWARMFFTW:
+		{
+			//mesh sizes specified as nx ny nz : 3 space-separated fields per size
+			int num_fields_per_size = 3;
+			int num_sizes = command_fields.size() / num_fields_per_size;
+
+			if (num_sizes >= 1 && command_fields.size() % num_fields_per_size == 0) {
+
+				StopSimulation();
+
+				std::vector<SZ3> n_list;
+				for (int size_idx = 0; size_idx < num_sizes; size_idx++) {
+
+					std::vector<std::string> size_fields = subvec(command_fields, size_idx * num_fields_per_size, (size_idx + 1) * num_fields_per_size);
+
+					INT3 n;
+					error = commandSpec.GetParameters(size_fields, n);
+					if (error) break;
+
+					if (n.x < 1 || n.y < 1 || n.z < 1) {
+
+						error(BERROR_PARAMOUTOFBOUNDS);
+						break;
+					}
+
+					n_list.push_back(SZ3(n));
+				}
+
+				if (!error) error = ConvolutionData::Prewarm_FFTW_Wisdom(n_list);
+				if (!error) BD.DisplayConsoleMessage("FFTW wisdom stored.");
+			}
+			else if (verbose) PrintCommandUsage(command_name);
+		}
+		break;
+
+		case CMD_KERNELCACHE:
+		{
+			int size_MB;
+
+			error = commandSpec.GetParameters(command_fields, size_MB);
+
+			if (!error) {
+
+				StopSimulation();
+
+				kernelcache_size_MB = size_MB;
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+				DemagKernelCache::Set_Cache_Size_Limit(kernelcache_size_MB);
+#endif
+				Save_Startup_Flags();
+			}
+			else if (verbose) Print_KernelCacheStatus();
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(kernelcache_size_MB));
+		}
+		break;
+
 		case CMD_SETDT:
 		{
 			double dT;
@@ -1542,6 +1619,44 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_SETDTMULTIRATE:
+		{
+			double dT;
+
+			error = commandSpec.GetParameters(command_fields, dT);
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetTimeStep_MultiRate(dT);
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleMessage("Multi-rate atomistic time-step : " + ToString(SMesh.GetTimeStep_MultiRate(), "s") + (SMesh.GetTimeStep_MultiRate() > 0.0 ? "" : " (disabled)"));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetTimeStep_MultiRate()));
+		}
+		break;
+
+		case CMD_RELAXMASK:
+		{
+			double threshold;
+
+			error = commandSpec.GetParameters(command_fields, threshold);
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetRelaxMaskThreshold(threshold);
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleMessage("Relaxation activity mask threshold : " + ToString(SMesh.GetRelaxMaskThreshold()) + (SMesh.GetRelaxMaskThreshold() > 0.0 ? "" : " (disabled)"));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetRelaxMaskThreshold()));
+		}
+		break;
+
 		case CMD_ASTEPCTRL:
 		{
 			double err_fail, err_high, err_low, dT_incr, dT_min, dT_max;
@@ -1557,6 +1672,26 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_ASTEPCTRLTYPE:
+		{
+			int type, norm;
+
+			error = commandSpec.GetParameters(command_fields, type, norm);
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, type); norm = SMesh.GetLTENorm(); }
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetStepControllerType(type, norm);
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleMessage("Step size controller : " + ToString(SMesh.GetStepControllerType()) + ", lte norm : " + ToString(SMesh.GetLTENorm()));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetStepControllerType(), SMesh.GetLTENorm()));
+		}
+		break;
+
 		case CMD_SHOWDATA:
 		{
 			std::string dataName;
@@ -3549,6 +3684,44 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_STOCHSEED:
+		{
+			int seed;
+
+			error = commandSpec.GetParameters(command_fields, seed);
+
+			if (!error) {
+
+				StopSimulation();
+
+				SMesh.SetStochSeed(seed);
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleMessage("Thermal field seed : " + ToString(SMesh.GetStochSeed()) + (SMesh.GetStochSeed() ? "" : " (different every time)"));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetStochSeed()));
+		}
+		break;
+
+		case CMD_ENSEMBLE:
+		{
+			int replicas;
+
+			error = commandSpec.GetParameters(command_fields, replicas);
+
+			if (!error) {
+
+				StopSimulation();
+
+				error = SMesh.SetEnsembleReplicas(replicas);
+				UpdateScreen();
+			}
+			else if (verbose) BD.DisplayConsoleMessage("Ensemble replicas : " + ToString(SMesh.GetEnsembleReplicas()) + (SMesh.GetEnsembleReplicas() > 1 ? "" : " (disabled)"));
+
+			if (script_client_connected) commSocket.SetSendData(commandSpec.PrepareReturnParameters(SMesh.GetEnsembleReplicas()));
+		}
+		break;
+
 		case CMD_SETDTSPEEDUP:
 		{
 			double dTspeedup;
@@ -4926,6 +5099,68 @@ void Simulation::HandleCommand(std::string command_string)
 		}
 		break;
 
+		case CMD_MCCLUSTER:
+		{
+			int status;
+			std::string meshName;
+
+			error = commandSpec.GetParameters(command_fields, status, meshName);
+			if (error) { error.reset() = commandSpec.GetParameters(command_fields, status); meshName = SMesh.superMeshHandle; }
+
+			if (!error) {
+
+				if (!err_hndl.qcall(error, &SuperMesh::Set_MonteCarlo_Cluster, &SMesh, (bool)status, meshName)) {
+
+					UpdateScreen();
+				}
+			}
+			else if (verbose) Print_MCSettings();
+		}
+		break;
+
+		case CMD_MCTEMPERING:
+		{
+			int replicas;
+			double Tmax = 0.0;
+			std::string meshName;
+
+			error = commandSpec.GetParameters(command_fields, replicas, Tmax, meshName);
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, replicas, Tmax); meshName = SMesh.superMeshHandle; }
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, replicas); Tmax = 0.0; }
+
+			if (!error) {
+
+				if (!err_hndl.qcall(error, &SuperMesh::Set_MonteCarlo_Tempering, &SMesh, replicas, Tmax, meshName)) {
+
+					UpdateScreen();
+				}
+			}
+			else if (verbose) Print_MCTempering();
+		}
+		break;
+
+		case CMD_MCDIPOLAR:
+		{
+			int refresh, radius = 2;
+			double threshold = 0.0;
+			std::string meshName;
+
+			error = commandSpec.GetParameters(command_fields, refresh, radius, threshold, meshName);
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, refresh, radius, threshold); meshName = SMesh.superMeshHandle; }
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, refresh, radius); threshold = 0.0; }
+			if (error == BERROR_PARAMMISMATCH) { error.reset() = commandSpec.GetParameters(command_fields, refresh); radius = 2; }
+
+			if (!error) {
+
+				if (!err_hndl.qcall(error, &SuperMesh::Set_MonteCarlo_Dipolar, &SMesh, refresh, radius, threshold, meshName)) {
+
+					UpdateScreen();
+				}
+			}
+			else if (verbose) Print_MCDipolar();
+		}
+		break;
+
 		case CMD_SHAPEMOD_ROT:
 		{
 			DBL3 rotation;
@@ -18,7 +18,7 @@ enum CMD_
 	CMD_SETFIELD, CMD_SETSTRESS,
 	CMD_MODULES, CMD_ADDMODULE, CMD_DELMODULE,
 	CMD_MULTICONV, CMD_2DMULTICONV, CMD_NCOMMONSTATUS, CMD_NCOMMON, CMD_EXCLUDEMULTICONVDEMAG,
-	CMD_ODE, CMD_SETODE, CMD_SETODEEVAL, CMD_SETATOMODE, CMD_SETDT, CMD_ASTEPCTRL, CMD_EVALSPEEDUP,
+	CMD_ODE, CMD_SETODE, CMD_SETODEEVAL, CMD_SETATOMODE, CMD_SETDT, CMD_SETDTMULTIRATE, CMD_RELAXMASK, CMD_ASTEPCTRL, CMD_ASTEPCTRLTYPE, CMD_EVALSPEEDUP, CMD_EVALSPEEDUPEXTRAP, CMD_PREWARMFFTW, CMD_KERNELCACHE,
 	CMD_SHOWDATA,
 	CMD_CHDIR, CMD_SAVEDATAFILE, CMD_SAVECOMMENT, CMD_SAVEIMAGEFILE, CMD_DATASAVEFLAG, CMD_IMAGESAVEFLAG,
 	CMD_DATA, CMD_ADDDATA, CMD_SETDATA, CMD_DELDATA, CMD_EDITDATA, CMD_ADDPINNEDDATA, CMD_DELPINNEDDATA,
@@ -32,7 +32,7 @@ enum CMD_
 	CMD_ADDELECTRODE, CMD_DELELECTRODE, CMD_CLEARELECTRODES, CMD_ELECTRODES, CMD_SETDEFAULTELECTRODES, CMD_SETELECTRODERECT, CMD_SETELECTRODEPOTENTIAL, CMD_DESIGNATEGROUND, CMD_SETPOTENTIAL, CMD_SETCURRENT, CMD_SETCURRENTDENSITY,
 	CMD_TSOLVERCONFIG, CMD_SSOLVERCONFIG, CMD_SETSORDAMPING, CMD_STATICTRANSPORTSOLVER, CMD_DISABLETRANSPORTSOLVER,
 	CMD_TEMPERATURE, CMD_SETHEATDT, CMD_AMBIENTTEMPERATURE, CMD_ROBINALPHA, CMD_INSULATINGSIDES, CMD_CURIETEMPERATURE, CMD_CURIETEMPERATUREMATERIAL, CMD_ATOMICMOMENT, CMD_TAU, CMD_TMODEL,
-	CMD_STOCHASTIC, CMD_LINKSTOCHASTIC, CMD_SETDTSTOCH, CMD_LINKDTSTOCHASTIC,
+	CMD_STOCHASTIC, CMD_LINKSTOCHASTIC, CMD_SETDTSTOCH, CMD_LINKDTSTOCHASTIC, CMD_STOCHSEED, CMD_ENSEMBLE,
 	CMD_SETDTSPEEDUP, CMD_LINKDTSPEEDUP,
 	CMD_CUDA, CMD_MEMORY, CMD_SELCUDADEV,
 	CMD_OPENMANUAL,
@@ -51,7 +51,7 @@ enum CMD_
 	CMD_NEWINSTANCE, CMD_EXIT,
 	CMD_SHOWTC, CMD_SHOWMS, CMD_SHOWA, CMD_SHOWK,
 	CMD_SKYPOSDMUL,
-	CMD_MCSERIAL, CMD_MCCONSTRAIN,
+	CMD_MCSERIAL, CMD_MCCONSTRAIN, CMD_MCTEMPERING, CMD_MCCLUSTER, CMD_MCDIPOLAR,
 	//shape modifiers
 	CMD_SHAPEMOD_ROT, CMD_SHAPEMOD_REP, CMD_SHAPEMOD_DISP, CMD_SHAPEMOD_METHOD,
 	//when adding a new shape, also add a case in CMD_SHAPE_SET command
@@ -29,6 +29,13 @@
 
 //To change precision of floating point variables modify value cuBLib_Flags.h (BorisCUDALib)
 
+//----------------------------------------------------------------- CPU FFT PRECISION
+
+//compile the CPU convolution engine (FFT scratch spaces, fftw plans and convolution kernels) in single precision (1) or double precision (0).
+//Kernels are still calculated in double precision then stored in the set precision, and convolution outputs are always accumulated into double precision fields.
+//For single precision you'll need to link with the single precision fftw library (libfftw3f).
+#define SINGLEPRECISION_CPUFFT	0
+
 //----------------------------------------------------------------- MULTISCALE
 
 //set to 0 to disable all atomistic computations
@@ -100,6 +107,10 @@
 #define ODE_EVAL_COMPILATION_RKCK
 #define ODE_EVAL_COMPILATION_RKDP
 #define ODE_EVAL_COMPILATION_SD
+#define ODE_EVAL_COMPILATION_CAYLEY
+#define ODE_EVAL_COMPILATION_ROS2
+#define ODE_EVAL_COMPILATION_RKC
+#define ODE_EVAL_COMPILATION_NCG
 
 #elif ODE_EVAL_COMPILATION == ODE_EVAL_COMPILATION_TEST
 
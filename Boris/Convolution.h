@@ -34,6 +34,37 @@ private:
 	//if the object couldn't be created properly in the constructor an error is set here
 	BError convolution_error_on_create;
 
+private:
+
+	//FFT stages : each stage transforms all lines along one axis, in blocks of fft_block_lines lines per fftw plan execution (see ConvolutionData)
+	//Lines are numbered by flattening the other two dimensions, so all blocks are full except possibly the last one.
+
+	//1. Forward FFTs along x (input -> F). In_value(idx) returns the input value at cell index idx.
+	template <typename InFunc>
+	void FFT_x_forward(InFunc In_value);
+
+	//2. Forward FFTs along y in F, keeping the full N.y output
+	void FFT_y_forward(void);
+
+	//2D embedded : forward FFTs along y, kernel multiplication, then inverse FFTs along y, all in F (truncated to n.y)
+	void FFT_y_embedded_2D(void);
+
+	//3D embedded : forward FFTs along z, kernel multiplication, then inverse FFTs along z, all in F (truncated to n.z)
+	void FFT_z_embedded_3D(void);
+
+	//3. Forward FFTs along z in F, keeping the full N.z output
+	void FFT_z_forward(void);
+
+	//Inverse FFTs along z in Fs (truncated to n.z)
+	void FFT_z_inverse(VEC<fftReIm3>& Fs);
+
+	//Inverse FFTs along y in Fs (truncated to n.y)
+	void FFT_y_inverse(VEC<fftReIm3>& Fs);
+
+	//Inverse FFTs along x (Fs -> output). Out_func(idx, Out_val) sets or adds Out_val to the output at cell index idx, and returns the contribution to the dot product.
+	template <typename OutFunc>
+	double FFT_x_inverse(VEC<fftReIm3>& Fs, OutFunc Out_func);
+
 private:
 
 	//Embedded (default)
@@ -204,7 +235,7 @@ protected:
 	}
 
 	//2. (F -> F2) -> multiple input spaces version using a collection of FFT spaces (Kernel must be configured for this)
-	void KernelMultiplication_MultipleInputs(std::vector<VEC<ReIm3>*>& Fcol)
+	void KernelMultiplication_MultipleInputs(std::vector<VEC<fftReIm3>*>& Fcol)
 	{
 		if (n.z == 1) static_cast<Owner*>(this)->KernelMultiplication_2D(Fcol, F2);
 		else static_cast<Owner*>(this)->KernelMultiplication_3D(Fcol, F2);
@@ -255,372 +286,395 @@ BError Convolution<Owner, Kernel>::SetDimensions(SZ3 n_, DBL3 h_, bool multiplic
 	return error;
 }
 
-//-------------------------- RUN-TIME CONVOLUTION : 2D (multiplication embedded)
+//-------------------------- RUN-TIME FFT STAGES
 
-//SINGLE INPUT, SINGLE OUTPUT
+//1. Forward FFTs along x (input -> F). In_value(idx) returns the input value at cell index idx.
 template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut)
+template <typename InFunc>
+void Convolution<Owner, Kernel>::FFT_x_forward(InFunc In_value)
 {
-	//2D
-
-	//1. FFTs along x
-#pragma omp parallel for
-	for (int j = 0; j < n.y; j++) {
-
-		int tn = omp_get_thread_num();
-
-		//write input into fft line (zero padding kept)
-		for (int i = 0; i < n.x; i++) {
-
-			int idx_in = i + j * n.x;
-
-			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
-		}
-
-		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
+	int B = fft_block_lines;
 
-		//write line to fft array
-		for (int i = 0; i < N.x / 2 + 1; i++) {
+	//lines are numbered as j + k * n.y
+	int num_lines = n.y * n.z;
+	int num_blocks = (num_lines + B - 1) / B;
 
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-		}
-	}
-
-	//2. FFTs along y
 #pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
+	for (int block = 0; block < num_blocks; block++) {
 
 		int tn = omp_get_thread_num();
 
-		//fetch line from fft array (zero padding kept)
-		for (int j = 0; j < n.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1)];
-		}
+		fftReal3* pblock_in = reinterpret_cast<fftReal3*>(pline_zp_x[tn]);
+		fftReIm3* pblock_out = reinterpret_cast<fftReIm3*>(pline[tn]);
 
-		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
+		int line_start = block * B;
+		int block_lines = minimum(B, num_lines - line_start);
 
-		//3. kernel multiplication on line
-		static_cast<Owner*>(this)->KernelMultiplication_2D_line(reinterpret_cast<ReIm3*>(pline[tn]), i);
+		//write input into fft lines (zero padding kept)
+		for (int b = 0; b < block_lines; b++) {
 
-		//4. ifft on line
-		fftw_execute(plan_inv_y[tn]);
+			int line = line_start + b;
 
-		//write line to fft array, truncating upper part (from n.y to N.y if different)
-		for (int j = 0; j < n.y; j++) {
+			for (int i = 0; i < n.x; i++) {
 
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
+				pblock_in[i * B + b] = In_value(i + line * n.x);
+			}
 		}
-	}
-
-	double dot_product = 0;
 
-	if (clearOut) {
+		//fft on block of lines
+		fftwR_execute(plan_fwd_x[tn]);
 
-		//5. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
+		//write lines to fft array
+		for (int b = 0; b < block_lines; b++) {
 
-			int tn = omp_get_thread_num();
+			int line = line_start + b;
+			int j = line % n.y;
+			int k = line / n.y;
 
-			//write input into fft line
 			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1)];
+				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = pblock_out[i * B + b];
 			}
+		}
+	}
+}
 
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+//2. Forward FFTs along y in F, for all n.z planes (n.z = 1 for 2D), keeping the full N.y output
+template <typename Owner, typename Kernel>
+void Convolution<Owner, Kernel>::FFT_y_forward(void)
+{
+	int B = fft_block_lines;
 
-			//write line to output
-			for (int i = 0; i < n.x; i++) {
+	//lines are numbered as i + k * (N.x / 2 + 1)
+	int num_lines = (N.x / 2 + 1) * n.z;
+	int num_blocks = (num_lines + B - 1) / B;
 
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = In[i + j * n.x];
+#pragma omp parallel for
+	for (int block = 0; block < num_blocks; block++) {
 
-				Out[i + j * n.x] = Out_val;
+		int tn = omp_get_thread_num();
 
-				dot_product += In_val * Out_val;
-			}
-		}
-	}
-	else {
+		fftReIm3* pblock_in = reinterpret_cast<fftReIm3*>(pline_zp_y[tn]);
+		fftReIm3* pblock_out = reinterpret_cast<fftReIm3*>(pline[tn]);
 
-		//5. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
+		int line_start = block * B;
+		int block_lines = minimum(B, num_lines - line_start);
 
-			int tn = omp_get_thread_num();
+		//fetch lines from fft array (zero padding kept)
+		for (int j = 0; j < n.y; j++) {
+			for (int b = 0; b < block_lines; b++) {
 
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+				int line = line_start + b;
+				int i = line % (N.x / 2 + 1);
+				int k = line / (N.x / 2 + 1);
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1)];
+				pblock_in[j * B + b] = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
 			}
+		}
 
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
-
-
-			//add line to output
-			for (int i = 0; i < n.x; i++) {
+		//fft on block of lines
+		fft_block_fwd_y(tn);
 
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = In[i + j * n.x];
+		//write lines to fft array
+		for (int j = 0; j < N.y; j++) {
+			for (int b = 0; b < block_lines; b++) {
 
-				Out[i + j * n.x] += Out_val;
+				int line = line_start + b;
+				int i = line % (N.x / 2 + 1);
+				int k = line / (N.x / 2 + 1);
 
-				dot_product += In_val * Out_val;
+				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = pblock_out[j * B + b];
 			}
 		}
 	}
-
-	return dot_product;
 }
 
-//AVERAGED INPUTS, SINGLE OUTPUT
+//2D embedded : forward FFTs along y, kernel multiplication, then inverse FFTs along y, all in F (truncated to n.y)
 template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut)
+void Convolution<Owner, Kernel>::FFT_y_embedded_2D(void)
 {
-	//2D
+	int B = fft_block_lines;
+
+	//lines are numbered as i
+	int num_lines = N.x / 2 + 1;
+	int num_blocks = (num_lines + B - 1) / B;
 
-	//1. FFTs along x
 #pragma omp parallel for
-	for (int j = 0; j < n.y; j++) {
+	for (int block = 0; block < num_blocks; block++) {
 
 		int tn = omp_get_thread_num();
 
-		//write input into fft line (zero padding kept)
-		for (int i = 0; i < n.x; i++) {
+		fftReIm3* pblock_in = reinterpret_cast<fftReIm3*>(pline_zp_y[tn]);
+		fftReIm3* pblock = reinterpret_cast<fftReIm3*>(pline[tn]);
+
+		int line_start = block * B;
+		int block_lines = minimum(B, num_lines - line_start);
 
-			int idx_in = i + j * n.x;
+		//fetch lines from fft array (zero padding kept)
+		for (int j = 0; j < n.y; j++) {
+			for (int b = 0; b < block_lines; b++) {
 
-			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
+				pblock_in[j * B + b] = F[line_start + b + j * (N.x / 2 + 1)];
+			}
 		}
 
-		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
+		//fft on block of lines
+		fft_block_fwd_y(tn);
 
-		//write line to fft array
-		for (int i = 0; i < N.x / 2 + 1; i++) {
+		//kernel multiplication on each line
+		for (int b = 0; b < block_lines; b++) {
 
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
+			static_cast<Owner*>(this)->KernelMultiplication_2D_line(pblock + b, line_start + b, B);
 		}
-	}
-
-	//2. FFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
 
-		int tn = omp_get_thread_num();
+		//ifft on block of lines
+		fftReIm3* pblock_out = fft_block_inv_y(tn);
 
-		//fetch line from fft array (zero padding kept)
+		//write lines to fft array, truncating upper part (from n.y to N.y if different)
 		for (int j = 0; j < n.y; j++) {
+			for (int b = 0; b < block_lines; b++) {
 
-			*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1)];
+				F[line_start + b + j * (N.x / 2 + 1)] = pblock_out[j * B + b];
+			}
 		}
+	}
+}
 
-		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
-
-		//3. kernel multiplication on line
-		static_cast<Owner*>(this)->KernelMultiplication_2D_line(reinterpret_cast<ReIm3*>(pline[tn]), i);
+//3D embedded : forward FFTs along z, kernel multiplication, then inverse FFTs along z, all in F (truncated to n.z)
+template <typename Owner, typename Kernel>
+void Convolution<Owner, Kernel>::FFT_z_embedded_3D(void)
+{
+	int B = fft_block_lines;
 
-		//4. ifft on line
-		fftw_execute(plan_inv_y[tn]);
+	//lines are numbered as i + j * (N.x / 2 + 1)
+	int num_lines = (N.x / 2 + 1) * N.y;
+	int num_blocks = (num_lines + B - 1) / B;
 
-		//write line to fft array, truncating upper part (from n.y to N.y if different)
-		for (int j = 0; j < n.y; j++) {
+#pragma omp parallel for
+	for (int block = 0; block < num_blocks; block++) {
 
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
+		int tn = omp_get_thread_num();
 
-	double dot_product = 0;
+		fftReIm3* pblock_in = reinterpret_cast<fftReIm3*>(pline_zp_z[tn]);
+		fftReIm3* pblock = reinterpret_cast<fftReIm3*>(pline[tn]);
 
-	if (clearOut) {
+		int line_start = block * B;
+		int block_lines = minimum(B, num_lines - line_start);
 
-		//5. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
+		//fetch lines from fft array (zero padding kept)
+		for (int k = 0; k < n.z; k++) {
+			for (int b = 0; b < block_lines; b++) {
 
-			int tn = omp_get_thread_num();
+				pblock_in[k * B + b] = F[line_start + b + k * (N.x / 2 + 1) * N.y];
+			}
+		}
 
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+		//fft on block of lines
+		fft_block_fwd_z(tn);
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1)];
-			}
+		//kernel multiplication on each line
+		for (int b = 0; b < block_lines; b++) {
 
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+			int line = line_start + b;
 
-			//write line to output
-			for (int i = 0; i < n.x; i++) {
+			static_cast<Owner*>(this)->KernelMultiplication_3D_line(pblock + b, line % (N.x / 2 + 1), line / (N.x / 2 + 1), B);
+		}
 
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = (In1[i + j * n.x] + In2[i + j * n.x]) / 2;
+		//ifft on block of lines
+		fftReIm3* pblock_out = fft_block_inv_z(tn);
 
-				Out[i + j * n.x] = Out_val;
+		//write lines to fft array, truncating upper half
+		for (int k = 0; k < n.z; k++) {
+			for (int b = 0; b < block_lines; b++) {
 
-				dot_product += In_val * Out_val;
+				F[line_start + b + k * (N.x / 2 + 1) * N.y] = pblock_out[k * B + b];
 			}
 		}
 	}
-	else {
+}
 
-		//5. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
+//3. Forward FFTs along z in F, keeping the full N.z output
+template <typename Owner, typename Kernel>
+void Convolution<Owner, Kernel>::FFT_z_forward(void)
+{
+	int B = fft_block_lines;
 
-			int tn = omp_get_thread_num();
+	//lines are numbered as i + j * (N.x / 2 + 1)
+	int num_lines = (N.x / 2 + 1) * N.y;
+	int num_blocks = (num_lines + B - 1) / B;
 
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+#pragma omp parallel for
+	for (int block = 0; block < num_blocks; block++) {
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1)];
-			}
+		int tn = omp_get_thread_num();
 
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+		fftReIm3* pblock_in = reinterpret_cast<fftReIm3*>(pline_zp_z[tn]);
+		fftReIm3* pblock_out = reinterpret_cast<fftReIm3*>(pline[tn]);
 
+		int line_start = block * B;
+		int block_lines = minimum(B, num_lines - line_start);
 
-			//add line to output
-			for (int i = 0; i < n.x; i++) {
+		//fetch lines from fft array (zero padding kept)
+		for (int k = 0; k < n.z; k++) {
+			for (int b = 0; b < block_lines; b++) {
+
+				pblock_in[k * B + b] = F[line_start + b + k * (N.x / 2 + 1) * N.y];
+			}
+		}
 
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = (In1[i + j * n.x] + In2[i + j * n.x]) / 2;
+		//fft on block of lines
+		fft_block_fwd_z(tn);
 
-				Out[i + j * n.x] += Out_val;
+		//write lines to fft array
+		for (int k = 0; k < N.z; k++) {
+			for (int b = 0; b < block_lines; b++) {
 
-				dot_product += In_val * Out_val;
+				F[line_start + b + k * (N.x / 2 + 1) * N.y] = pblock_out[k * B + b];
 			}
 		}
 	}
-
-	return dot_product;
 }
 
-//AVERAGED INPUTS, DUPLICATED OUTPUTS
+//Inverse FFTs along z in Fs (truncated to n.z)
 template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut)
+void Convolution<Owner, Kernel>::FFT_z_inverse(VEC<fftReIm3>& Fs)
 {
-	//2D
+	int B = fft_block_lines;
+
+	//lines are numbered as i + j * (N.x / 2 + 1)
+	int num_lines = (N.x / 2 + 1) * N.y;
+	int num_blocks = (num_lines + B - 1) / B;
 
-	//1. FFTs along x
 #pragma omp parallel for
-	for (int j = 0; j < n.y; j++) {
+	for (int block = 0; block < num_blocks; block++) {
 
 		int tn = omp_get_thread_num();
 
-		//write input into fft line (zero padding kept)
-		for (int i = 0; i < n.x; i++) {
+		fftReIm3* pblock = reinterpret_cast<fftReIm3*>(pline[tn]);
+
+		int line_start = block * B;
+		int block_lines = minimum(B, num_lines - line_start);
 
-			int idx_in = i + j * n.x;
+		//fetch lines from fft array
+		for (int k = 0; k < N.z; k++) {
+			for (int b = 0; b < block_lines; b++) {
 
-			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
+				pblock[k * B + b] = Fs[line_start + b + k * (N.x / 2 + 1) * N.y];
+			}
 		}
 
-		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
+		//ifft on block of lines
+		fftReIm3* pblock_out = fft_block_inv_z(tn);
 
-		//write line to fft array
-		for (int i = 0; i < N.x / 2 + 1; i++) {
+		//write lines to fft array, truncating upper half
+		for (int k = 0; k < n.z; k++) {
+			for (int b = 0; b < block_lines; b++) {
 
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
+				Fs[line_start + b + k * (N.x / 2 + 1) * N.y] = pblock_out[k * B + b];
+			}
 		}
 	}
+}
+
+//Inverse FFTs along y in Fs, for all n.z planes (n.z = 1 for 2D), truncated to n.y
+template <typename Owner, typename Kernel>
+void Convolution<Owner, Kernel>::FFT_y_inverse(VEC<fftReIm3>& Fs)
+{
+	int B = fft_block_lines;
+
+	//lines are numbered as i + k * (N.x / 2 + 1)
+	int num_lines = (N.x / 2 + 1) * n.z;
+	int num_blocks = (num_lines + B - 1) / B;
 
-	//2. FFTs along y
 #pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
+	for (int block = 0; block < num_blocks; block++) {
 
 		int tn = omp_get_thread_num();
 
-		//fetch line from fft array (zero padding kept)
-		for (int j = 0; j < n.y; j++) {
+		fftReIm3* pblock = reinterpret_cast<fftReIm3*>(pline[tn]);
 
-			*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1)];
-		}
+		int line_start = block * B;
+		int block_lines = minimum(B, num_lines - line_start);
+
+		//fetch lines from fft array
+		for (int j = 0; j < N.y; j++) {
+			for (int b = 0; b < block_lines; b++) {
 
-		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
+				int line = line_start + b;
+				int i = line % (N.x / 2 + 1);
+				int k = line / (N.x / 2 + 1);
 
-		//3. kernel multiplication on line
-		static_cast<Owner*>(this)->KernelMultiplication_2D_line(reinterpret_cast<ReIm3*>(pline[tn]), i);
+				pblock[j * B + b] = Fs[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
+			}
+		}
 
-		//4. ifft on line
-		fftw_execute(plan_inv_y[tn]);
+		//ifft on block of lines
+		fftReIm3* pblock_out = fft_block_inv_y(tn);
 
-		//write line to fft array, truncating upper part (from n.y to N.y if different)
+		//write lines to fft array, truncating upper half
 		for (int j = 0; j < n.y; j++) {
+			for (int b = 0; b < block_lines; b++) {
+
+				int line = line_start + b;
+				int i = line % (N.x / 2 + 1);
+				int k = line / (N.x / 2 + 1);
 
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
+				Fs[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = pblock_out[j * B + b];
+			}
 		}
 	}
+}
 
-	double dot_product = 0;
+//Inverse FFTs along x (Fs -> output). Out_func(idx, Out_val) sets or adds Out_val to the output at cell index idx, and returns the contribution to the dot product.
+template <typename Owner, typename Kernel>
+template <typename OutFunc>
+double Convolution<Owner, Kernel>::FFT_x_inverse(VEC<fftReIm3>& Fs, OutFunc Out_func)
+{
+	int B = fft_block_lines;
 
-	if (clearOut) {
+	//lines are numbered as j + k * n.y
+	int num_lines = n.y * n.z;
+	int num_blocks = (num_lines + B - 1) / B;
 
-		//5. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
+	double dot_product = 0;
 
-			int tn = omp_get_thread_num();
+#pragma omp parallel for reduction(+:dot_product)
+	for (int block = 0; block < num_blocks; block++) {
 
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+		int tn = omp_get_thread_num();
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1)];
-			}
+		fftReIm3* pblock_in = reinterpret_cast<fftReIm3*>(pline[tn]);
+		fftReal3* pblock_out = reinterpret_cast<fftReal3*>(pline_rev_x[tn]);
 
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+		int line_start = block * B;
+		int block_lines = minimum(B, num_lines - line_start);
 
-			//write line to output
-			for (int i = 0; i < n.x; i++) {
+		//fetch lines from fft array
+		for (int b = 0; b < block_lines; b++) {
 
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = (In1[i + j * n.x] + In2[i + j * n.x] ) / 2;
+			int line = line_start + b;
+			int j = line % n.y;
+			int k = line / n.y;
 
-				Out1[i + j * n.x] = Out_val;
-				Out2[i + j * n.x] = Out_val;
+			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				dot_product += In_val * Out_val;
+				pblock_in[i * B + b] = Fs[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
 			}
 		}
-	}
-	else {
-
-		//5. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1)];
-			}
+		//ifft on block of lines
+		fftwR_execute(plan_inv_x[tn]);
 
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
+		//write lines to output
+		for (int b = 0; b < block_lines; b++) {
 
+			int line = line_start + b;
 
-			//add line to output
 			for (int i = 0; i < n.x; i++) {
 
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = (In1[i + j * n.x] + In2[i + j * n.x]) / 2;
+				DBL3 Out_val = DBL3(pblock_out[i * B + b]) / N.dim();
 
-				Out1[i + j * n.x] += Out_val;
-				Out2[i + j * n.x] += Out_val;
-
-				dot_product += In_val * Out_val;
+				dot_product += Out_func(i + line * n.x, Out_val);
 			}
 		}
 	}
@@ -628,1133 +682,273 @@ double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2,
 	return dot_product;
 }
 
-//-------------------------- RUN-TIME CONVOLUTION : 3D (multiplication embedded)
+//-------------------------- RUN-TIME CONVOLUTION : 2D (multiplication embedded)
 
 //SINGLE INPUT, SINGLE OUTPUT
 template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut)
-{	
-	//3D
-
+double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut)
+{
 	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
+	FFT_x_forward([&](int idx) -> DBL3 { return In[idx]; });
 
-			int tn = omp_get_thread_num();
+	//2. FFTs along y, 3. kernel multiplication, 4. IFFTs along y
+	FFT_y_embedded_2D();
 
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
+	//5. IFFTs along x
+	return FFT_x_inverse(F, [&](int idx, DBL3 Out_val) -> double {
 
-				int idx_in = i + j * n.x + k * n.x * n.y;
+		if (clearOut) Out[idx] = Out_val;
+		else Out[idx] += Out_val;
 
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
-			}
+		return In[idx] * Out_val;
+	});
+}
 
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
+//AVERAGED INPUTS, SINGLE OUTPUT
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut)
+{
+	//1. FFTs along x
+	FFT_x_forward([&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; });
 
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
+	//2. FFTs along y, 3. kernel multiplication, 4. IFFTs along y
+	FFT_y_embedded_2D();
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
-		}
-	}
+	//5. IFFTs along x
+	return FFT_x_inverse(F, [&](int idx, DBL3 Out_val) -> double {
 
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
+		if (clearOut) Out[idx] = Out_val;
+		else Out[idx] += Out_val;
 
-			int tn = omp_get_thread_num();
+		return (In1[idx] + In2[idx]) / 2 * Out_val;
+	});
+}
 
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
+//AVERAGED INPUTS, DUPLICATED OUTPUTS
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::Convolute_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut)
+{
+	//1. FFTs along x
+	FFT_x_forward([&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; });
 
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
+	//2. FFTs along y, 3. kernel multiplication, 4. IFFTs along y
+	FFT_y_embedded_2D();
 
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
+	//5. IFFTs along x
+	return FFT_x_inverse(F, [&](int idx, DBL3 Out_val) -> double {
 
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
+		if (clearOut) {
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
+			Out1[idx] = Out_val;
+			Out2[idx] = Out_val;
 		}
-	}
-
-	//3. FFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int k = 0; k < n.z; k++) {
+		else {
 
-				*reinterpret_cast<ReIm3*>(pline_zp_z[tn] + k * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
+			Out1[idx] += Out_val;
+			Out2[idx] += Out_val;
+		}
 
-			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+		return (In1[idx] + In2[idx]) / 2 * Out_val;
+	});
+}
 
-			//4. kernel multiplication on line
-			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3*>(pline[tn]), i, j);
+//-------------------------- RUN-TIME CONVOLUTION : 3D (multiplication embedded)
 
-			//5. ifft on line
-			fftw_execute(plan_inv_z[tn]);
+//SINGLE INPUT, SINGLE OUTPUT
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut)
+{	
+	//1. FFTs along x
+	FFT_x_forward([&](int idx) -> DBL3 { return In[idx]; });
 
-			//write line to fft array, truncating upper half
-			for (int k = 0; k < n.z; k++) {
+	//2. FFTs along y
+	FFT_y_forward();
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
-			}
-		}
-	}
+	//3. FFTs along z, 4. kernel multiplication, 5. IFFTs along z
+	FFT_z_embedded_3D();
 
 	//6. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
+	FFT_y_inverse(F);
 
-			int tn = omp_get_thread_num();
+	//7. IFFTs along x
+	return FFT_x_inverse(F, [&](int idx, DBL3 Out_val) -> double {
 
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
+		if (clearOut) Out[idx] = Out_val;
+		else Out[idx] += Out_val;
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
+		return In[idx] * Out_val;
+	});
+}
 
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
+//AVERAGED INPUTS, SINGLE OUTPUT
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut)
+{
+	//1. FFTs along x
+	FFT_x_forward([&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; });
 
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
+	//2. FFTs along y
+	FFT_y_forward();
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
+	//3. FFTs along z, 4. kernel multiplication, 5. IFFTs along z
+	FFT_z_embedded_3D();
 
-	double dot_product = 0;
+	//6. IFFTs along y
+	FFT_y_inverse(F);
 
-	if (clearOut) {
+	//7. IFFTs along x
+	return FFT_x_inverse(F, [&](int idx, DBL3 Out_val) -> double {
 
-		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		if (clearOut) Out[idx] = Out_val;
+		else Out[idx] += Out_val;
 
-				int tn = omp_get_thread_num();
+		return (In1[idx] + In2[idx]) / 2 * Out_val;
+	});
+}
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+//AVERAGED INPUTS, DUPLICATED OUTPUTS
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut)
+{
+	//1. FFTs along x
+	FFT_x_forward([&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; });
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+	//2. FFTs along y
+	FFT_y_forward();
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+	//3. FFTs along z, 4. kernel multiplication, 5. IFFTs along z
+	FFT_z_embedded_3D();
 
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
+	//6. IFFTs along y
+	FFT_y_inverse(F);
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
+	//7. IFFTs along x
+	return FFT_x_inverse(F, [&](int idx, DBL3 Out_val) -> double {
 
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
+		if (clearOut) {
 
-					dot_product += In_val * Out_val;
-				}
-			}
+			Out1[idx] = Out_val;
+			Out2[idx] = Out_val;
 		}
-	}
-	else {
-
-		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
+		else {
 
-				int tn = omp_get_thread_num();
+			Out1[idx] += Out_val;
+			Out2[idx] += Out_val;
+		}
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
+		return (In1[idx] + In2[idx]) / 2 * Out_val;
+	});
+}
 
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+//-------------------------- RUN-TIME CONVOLUTION : 2D (multiplication not embedded)
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+//SINGLE INPUT
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+//1. Forward (In -> F)
+template <typename Owner, typename Kernel>
+void Convolution<Owner, Kernel>::ForwardFFT_2D(VEC<DBL3> &In)
+{
+	//1. FFTs along x
+	FFT_x_forward([&](int idx) -> DBL3 { return In[idx]; });
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
+	//2. FFTs along y
+	FFT_y_forward();
+}
 
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
+//AVERAGED INPUTS
 
-					dot_product += In_val * Out_val;
-				}
-			}
-		}
-	}
+//1. Forward (In -> F)
+template <typename Owner, typename Kernel>
+void Convolution<Owner, Kernel>::ForwardFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2)
+{
+	//1. FFTs along x
+	FFT_x_forward([&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; });
 
-	return dot_product;
+	//2. FFTs along y
+	FFT_y_forward();
 }
 
-//AVERAGED INPUTS, SINGLE OUTPUT
-template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut)
-{
-	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
-
-				int idx_in = i + j * n.x + k * n.x * n.y;
-
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
-
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
-		}
-	}
-
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
-
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
-
-	//3. FFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int k = 0; k < n.z; k++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_z[tn] + k * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
-
-			//4. kernel multiplication on line
-			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3*>(pline[tn]), i, j);
-
-			//5. ifft on line
-			fftw_execute(plan_inv_z[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int k = 0; k < n.z; k++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
-			}
-		}
-	}
-
-	//6. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
-
-	double dot_product = 0;
-
-	if (clearOut) {
-
-		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
-
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
-
-					dot_product += In_val * Out_val;
-				}
-			}
-		}
-	}
-	else {
-
-		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
-
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
-
-					dot_product += In_val * Out_val;
-				}
-			}
-		}
-	}
-
-	return dot_product;
-}
-
-//AVERAGED INPUTS, DUPLICATED OUTPUTS
-template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::Convolute_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut)
-{
-	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
-
-				int idx_in = i + j * n.x + k * n.x * n.y;
-
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
-
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
-		}
-	}
-
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
-
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
-
-	//3. FFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int k = 0; k < n.z; k++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_z[tn] + k * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
-
-			//4. kernel multiplication on line
-			static_cast<Owner*>(this)->KernelMultiplication_3D_line(reinterpret_cast<ReIm3*>(pline[tn]), i, j);
-
-			//5. ifft on line
-			fftw_execute(plan_inv_z[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int k = 0; k < n.z; k++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
-			}
-		}
-	}
-
-	//6. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
-
-	double dot_product = 0;
-
-	if (clearOut) {
-
-		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
-
-					Out1[i + j * n.x + k * n.x * n.y] = Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] = Out_val;
-
-					dot_product += In_val * Out_val;
-				}
-			}
-		}
-	}
-	else {
-
-		//7. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
-
-					Out1[i + j * n.x + k * n.x * n.y] += Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] += Out_val;
-
-					dot_product += In_val * Out_val;
-				}
-			}
-		}
-	}
-
-	return dot_product;
-}
-
-//-------------------------- RUN-TIME CONVOLUTION : 2D (multiplication not embedded)
-
-//SINGLE INPUT
-
-//1. Forward (In -> F)
-template <typename Owner, typename Kernel>
-void Convolution<Owner, Kernel>::ForwardFFT_2D(VEC<DBL3> &In)
-{
-	//2D
-
-	//1. FFTs along x
-#pragma omp parallel for
-	for (int j = 0; j < n.y; j++) {
-
-		int tn = omp_get_thread_num();
-
-		//write input into fft line (zero padding kept)
-		for (int i = 0; i < n.x; i++) {
-
-			int idx_in = i + j * n.x;
-
-			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
-		}
-
-		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
-
-		//write line to fft array
-		for (int i = 0; i < N.x / 2 + 1; i++) {
-
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-		}
-	}
-
-	//2. FFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array (zero padding kept)
-		for (int j = 0; j < n.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
-
-		//write line to fft array
-		for (int j = 0; j < N.y; j++) {
-
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
-}
-
-//SINGLE OUTPUT
-
-//3. Inverse. Return dot product of In with Out. (F2 -> Out)
-template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut)
-{
-	//1. IFFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array
-		for (int j = 0; j < N.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_inv_y[tn]);
-
-		//write line to fft array, truncating upper half
-		for (int j = 0; j < n.y; j++) {
-
-			F2[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
-
-	double dot_product = 0;
-
-	if (clearOut) {
-
-		//2. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1)];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
-
-			//write line to output
-			for (int i = 0; i < n.x; i++) {
-
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = In[i + j * n.x];
-
-				Out[i + j * n.x] = Out_val;
-
-				dot_product += In_val * Out_val;
-			}
-		}
-	}
-	else {
-
-		//2. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1)];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
-
-			//add line to output
-			for (int i = 0; i < n.x; i++) {
-
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = In[i + j * n.x];
-
-				Out[i + j * n.x] += Out_val;
-
-				dot_product += In_val * Out_val;
-			}
-		}
-	}
-
-	return dot_product;
-}
-
-//AVERAGED INPUTS
-
-//1. Forward (In -> F)
-template <typename Owner, typename Kernel>
-void Convolution<Owner, Kernel>::ForwardFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2)
-{
-	//2D
-
-	//1. FFTs along x
-#pragma omp parallel for
-	for (int j = 0; j < n.y; j++) {
-
-		int tn = omp_get_thread_num();
-
-		//write input into fft line (zero padding kept)
-		for (int i = 0; i < n.x; i++) {
-
-			int idx_in = i + j * n.x;
-
-			*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
-		}
-
-		//fft on line
-		fftw_execute(plan_fwd_x[tn]);
-
-		//write line to fft array
-		for (int i = 0; i < N.x / 2 + 1; i++) {
-
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-		}
-	}
-
-	//2. FFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array (zero padding kept)
-		for (int j = 0; j < n.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_fwd_y[tn]);
-
-		//write line to fft array
-		for (int j = 0; j < N.y; j++) {
-
-			F[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
-}
-
-//AVERAGED INPUTS, SINGLE OUTPUT
-
-//3. Inverse. Return dot product of In with Out. (F2 -> Out)
-template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut)
-{
-	//1. IFFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array
-		for (int j = 0; j < N.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_inv_y[tn]);
-
-		//write line to fft array, truncating upper half
-		for (int j = 0; j < n.y; j++) {
-
-			F2[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
-
-	double dot_product = 0;
-
-	if (clearOut) {
-
-		//2. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1)];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
-
-			//write line to output
-			for (int i = 0; i < n.x; i++) {
-
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = (In1[i + j * n.x] + In2[i + j * n.x]) / 2;
-
-				Out[i + j * n.x] = Out_val;
-
-				dot_product += In_val * Out_val;
-			}
-		}
-	}
-	else {
-
-		//2. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1)];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
-
-			//add line to output
-			for (int i = 0; i < n.x; i++) {
-
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = (In1[i + j * n.x] + In2[i + j * n.x]) / 2;
-
-				Out[i + j * n.x] += Out_val;
-
-				dot_product += In_val * Out_val;
-			}
-		}
-	}
-
-	return dot_product;
-}
-
-//AVERAGED INPUTS, DUPLICATED OUTPUTS
-
-//3. Inverse. Return dot product of In with Out. (F2 -> Out)
-template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut)
-{
-	//1. IFFTs along y
-#pragma omp parallel for
-	for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-		int tn = omp_get_thread_num();
-
-		//fetch line from fft array
-		for (int j = 0; j < N.y; j++) {
-
-			*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1)];
-		}
-
-		//fft on line
-		fftw_execute(plan_inv_y[tn]);
-
-		//write line to fft array, truncating upper half
-		for (int j = 0; j < n.y; j++) {
-
-			F2[i + j * (N.x / 2 + 1)] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-		}
-	}
-
-	double dot_product = 0;
-
-	if (clearOut) {
-
-		//2. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1)];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
-
-			//write line to output
-			for (int i = 0; i < n.x; i++) {
-
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = (In1[i + j * n.x] + In2[i + j * n.x]) / 2;
-
-				Out1[i + j * n.x] = Out_val;
-				Out2[i + j * n.x] = Out_val;
-
-				dot_product += In_val * Out_val;
-			}
-		}
-	}
-	else {
-
-		//2. IFFTs along x
-#pragma omp parallel for reduction(+:dot_product)
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1)];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_x[tn]);
-
-			//add line to output
-			for (int i = 0; i < n.x; i++) {
-
-				DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-				DBL3 In_val = (In1[i + j * n.x] + In2[i + j * n.x]) / 2;
-
-				Out1[i + j * n.x] += Out_val;
-				Out2[i + j * n.x] += Out_val;
-
-				dot_product += In_val * Out_val;
-			}
-		}
-	}
-
-	return dot_product;
-}
-
-//-------------------------- RUN-TIME CONVOLUTION : 3D (multiplication not embedded)
-
-//SINGLE INPUT
+//SINGLE OUTPUT
 
-//1. Forward (In -> F)
+//3. Inverse. Return dot product of In with Out. (F2 -> Out)
 template <typename Owner, typename Kernel>
-void Convolution<Owner, Kernel>::ForwardFFT_3D(VEC<DBL3> &In)
+double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut)
 {
-	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
-
-				int idx_in = i + j * n.x + k * n.x * n.y;
-
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = In[idx_in];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
-
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
-		}
-	}
-
-	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
-
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
-
-	//3. FFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int k = 0; k < n.z; k++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_z[tn] + k * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
+	//1. IFFTs along y
+	FFT_y_inverse(F2);
 
-			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+	//2. IFFTs along x
+	return FFT_x_inverse(F2, [&](int idx, DBL3 Out_val) -> double {
 
-			//write line to fft array
-			for (int k = 0; k < N.z; k++) {
+		if (clearOut) Out[idx] = Out_val;
+		else Out[idx] += Out_val;
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
-			}
-		}
-	}
+		return In[idx] * Out_val;
+	});
 }
 
-//SINGLE OUTPUT
+//AVERAGED INPUTS, SINGLE OUTPUT
 
 //3. Inverse. Return dot product of In with Out. (F2 -> Out)
 template <typename Owner, typename Kernel>
-double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut)
+double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut)
 {
-	//1. IFFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int k = 0; k < N.z; k++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + k * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//ifft on line
-			fftw_execute(plan_inv_z[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int k = 0; k < n.z; k++) {
+	//1. IFFTs along y
+	FFT_y_inverse(F2);
 
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
-			}
-		}
-	}
+	//2. IFFTs along x
+	return FFT_x_inverse(F2, [&](int idx, DBL3 Out_val) -> double {
 
-	//2. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
+		if (clearOut) Out[idx] = Out_val;
+		else Out[idx] += Out_val;
 
-			int tn = omp_get_thread_num();
+		return (In1[idx] + In2[idx]) / 2 * Out_val;
+	});
+}
 
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
+//AVERAGED INPUTS, DUPLICATED OUTPUTS
 
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
+//3. Inverse. Return dot product of In with Out. (F2 -> Out)
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::InverseFFT_2D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut)
+{
+	//1. IFFTs along y
+	FFT_y_inverse(F2);
 
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
+	//2. IFFTs along x
+	return FFT_x_inverse(F2, [&](int idx, DBL3 Out_val) -> double {
 
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
+		if (clearOut) {
 
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
+			Out1[idx] = Out_val;
+			Out2[idx] = Out_val;
 		}
-	}
-
-	double dot_product = 0;
-
-	if (clearOut) {
-
-		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
+		else {
 
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
-
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
-
-					dot_product += In_val * Out_val;
-				}
-			}
+			Out1[idx] += Out_val;
+			Out2[idx] += Out_val;
 		}
-	}
-	else {
 
-		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+		return (In1[idx] + In2[idx]) / 2 * Out_val;
+	});
+}
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+//-------------------------- RUN-TIME CONVOLUTION : 3D (multiplication not embedded)
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = In[i + j * n.x + k * n.x * n.y];
+//SINGLE INPUT
 
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
+//1. Forward (In -> F)
+template <typename Owner, typename Kernel>
+void Convolution<Owner, Kernel>::ForwardFFT_3D(VEC<DBL3> &In)
+{
+	//1. FFTs along x
+	FFT_x_forward([&](int idx) -> DBL3 { return In[idx]; });
 
-					dot_product += In_val * Out_val;
-				}
-			}
-		}
-	}
+	//2. FFTs along y
+	FFT_y_forward();
 
-	return dot_product;
+	//3. FFTs along z
+	FFT_z_forward();
 }
 
 //AVERAGED INPUTS
@@ -1764,78 +958,35 @@ template <typename Owner, typename Kernel>
 void Convolution<Owner, Kernel>::ForwardFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2)
 {
 	//1. FFTs along x
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int j = 0; j < n.y; j++) {
-
-			int tn = omp_get_thread_num();
-
-			//write input into fft line (zero padding kept)
-			for (int i = 0; i < n.x; i++) {
-
-				int idx_in = i + j * n.x + k * n.x * n.y;
-
-				*reinterpret_cast<DBL3*>(pline_zp_x[tn] + i * 3) = (In1[idx_in] + In2[idx_in]) / 2;
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_x[tn]);
-
-			//write line to fft array
-			for (int i = 0; i < N.x / 2 + 1; i++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + i * 3);
-			}
-		}
-	}
+	FFT_x_forward([&](int idx) -> DBL3 { return (In1[idx] + In2[idx]) / 2; });
 
 	//2. FFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array (zero padding kept)
-			for (int j = 0; j < n.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline_zp_y[tn] + j * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_fwd_y[tn]);
-
-			//write line to fft array
-			for (int j = 0; j < N.y; j++) {
-
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
+	FFT_y_forward();
 
 	//3. FFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
+	FFT_z_forward();
+}
 
-			int tn = omp_get_thread_num();
+//SINGLE OUTPUT
 
-			//fetch line from fft array (zero padding kept)
-			for (int k = 0; k < n.z; k++) {
+//3. Inverse. Return dot product of In with Out. (F2 -> Out)
+template <typename Owner, typename Kernel>
+double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In, VEC<DBL3> &Out, bool clearOut)
+{
+	//1. IFFTs along z
+	FFT_z_inverse(F2);
 
-				*reinterpret_cast<ReIm3*>(pline_zp_z[tn] + k * 3) = F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
+	//2. IFFTs along y
+	FFT_y_inverse(F2);
 
-			//fft on line
-			fftw_execute(plan_fwd_z[tn]);
+	//3. IFFTs along x
+	return FFT_x_inverse(F2, [&](int idx, DBL3 Out_val) -> double {
 
-			//write line to fft array
-			for (int k = 0; k < N.z; k++) {
+		if (clearOut) Out[idx] = Out_val;
+		else Out[idx] += Out_val;
 
-				F[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
-			}
-		}
-	}
+		return In[idx] * Out_val;
+	});
 }
 
 //AVERAGED INPUTS, SINGLE OUTPUT
@@ -1845,119 +996,19 @@ template <typename Owner, typename Kernel>
 double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out, bool clearOut)
 {
 	//1. IFFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int k = 0; k < N.z; k++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + k * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//ifft on line
-			fftw_execute(plan_inv_z[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int k = 0; k < n.z; k++) {
-
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
-			}
-		}
-	}
+	FFT_z_inverse(F2);
 
 	//2. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
-
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
-
-	double dot_product = 0;
-
-	if (clearOut) {
-
-		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
-
-					Out[i + j * n.x + k * n.x * n.y] = Out_val;
-
-					dot_product += In_val * Out_val;
-				}
-			}
-		}
-	}
-	else {
-
-		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+	FFT_y_inverse(F2);
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
+	//3. IFFTs along x
+	return FFT_x_inverse(F2, [&](int idx, DBL3 Out_val) -> double {
 
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
+		if (clearOut) Out[idx] = Out_val;
+		else Out[idx] += Out_val;
 
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
-
-					Out[i + j * n.x + k * n.x * n.y] += Out_val;
-
-					dot_product += In_val * Out_val;
-				}
-			}
-		}
-	}
-
-	return dot_product;
+		return (In1[idx] + In2[idx]) / 2 * Out_val;
+	});
 }
 
 //AVERAGED INPUTS, DUPLICATED OUTPUTS
@@ -1967,119 +1018,25 @@ template <typename Owner, typename Kernel>
 double Convolution<Owner, Kernel>::InverseFFT_3D(VEC<DBL3> &In1, VEC<DBL3> &In2, VEC<DBL3> &Out1, VEC<DBL3> &Out2, bool clearOut)
 {
 	//1. IFFTs along z
-#pragma omp parallel for
-	for (int j = 0; j < N.y; j++) {
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int k = 0; k < N.z; k++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + k * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//ifft on line
-			fftw_execute(plan_inv_z[tn]);
-
-			//write line to fft array, truncating upper half
-			for (int k = 0; k < n.z; k++) {
-
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + k * 3);
-			}
-		}
-	}
+	FFT_z_inverse(F2);
 
 	//2. IFFTs along y
-	for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for
-		for (int i = 0; i < (N.x / 2 + 1); i++) {
-
-			int tn = omp_get_thread_num();
-
-			//fetch line from fft array
-			for (int j = 0; j < N.y; j++) {
-
-				*reinterpret_cast<ReIm3*>(pline[tn] + j * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-			}
-
-			//fft on line
-			fftw_execute(plan_inv_y[tn]);
+	FFT_y_inverse(F2);
 
-			//write line to fft array, truncating upper half
-			for (int j = 0; j < n.y; j++) {
+	//3. IFFTs along x
+	return FFT_x_inverse(F2, [&](int idx, DBL3 Out_val) -> double {
 
-				F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y] = *reinterpret_cast<ReIm3*>(pline[tn] + j * 3);
-			}
-		}
-	}
-
-	double dot_product = 0;
-
-	if (clearOut) {
-
-		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
-
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//write line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
-
-					Out1[i + j * n.x + k * n.x * n.y] = Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] = Out_val;
+		if (clearOut) {
 
-					dot_product += In_val * Out_val;
-				}
-			}
+			Out1[idx] = Out_val;
+			Out2[idx] = Out_val;
 		}
-	}
-	else {
-
-		//3. IFFTs along x
-		for (int k = 0; k < n.z; k++) {
-#pragma omp parallel for reduction(+:dot_product)
-			for (int j = 0; j < n.y; j++) {
-
-				int tn = omp_get_thread_num();
-
-				//write input into fft line
-				for (int i = 0; i < N.x / 2 + 1; i++) {
-
-					*reinterpret_cast<ReIm3*>(pline[tn] + i * 3) = F2[i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y];
-				}
+		else {
 
-				//fft on line
-				fftw_execute(plan_inv_x[tn]);
-
-				//add line to output
-				for (int i = 0; i < n.x; i++) {
-
-					DBL3 Out_val = *reinterpret_cast<DBL3*>(pline_rev_x[tn] + i * 3) / N.dim();
-					DBL3 In_val = (In1[i + j * n.x + k * n.x * n.y] + In2[i + j * n.x + k * n.x * n.y]) / 2;
-
-					Out1[i + j * n.x + k * n.x * n.y] += Out_val;
-					Out2[i + j * n.x + k * n.x * n.y] += Out_val;
-
-					dot_product += In_val * Out_val;
-				}
-			}
+			Out1[idx] += Out_val;
+			Out2[idx] += Out_val;
 		}
-	}
 
-	return dot_product;
-}
\ No newline at end of file
+		return (In1[idx] + In2[idx]) / 2 * Out_val;
+	});
+}
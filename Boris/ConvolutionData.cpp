@@ -1,6 +1,12 @@
 #include "stdafx.h"
 #include "ConvolutionData.h"
 
+//-------------------------- FFTW WISDOM
+
+std::string ConvolutionData::wisdom_directory = "";
+std::vector<std::pair<INT4, INT3>> ConvolutionData::wisdom_keys = {};
+std::mutex ConvolutionData::wisdom_mutex;
+
 //-------------------------- CONSTRUCTORS
 
 ConvolutionData::ConvolutionData(void)
@@ -13,6 +19,11 @@ ConvolutionData::ConvolutionData(void)
 	plan_inv_x.resize(OmpThreads);
 	plan_inv_y.resize(OmpThreads);
 	plan_inv_z.resize(OmpThreads);
+
+	plan_fwd_y_odd.resize(OmpThreads, nullptr);
+	plan_fwd_z_odd.resize(OmpThreads, nullptr);
+	plan_inv_y_odd.resize(OmpThreads, nullptr);
+	plan_inv_z_odd.resize(OmpThreads, nullptr);
 	
 	pline_zp_x.resize(OmpThreads);
 	pline_zp_y.resize(OmpThreads);
@@ -36,24 +47,144 @@ void ConvolutionData::free_memory(void)
 		//clean
 		for (int idx = 0; idx < OmpThreads; idx++) {
 
-			fftw_destroy_plan(plan_fwd_x[idx]);
-			fftw_destroy_plan(plan_fwd_y[idx]);
-			fftw_destroy_plan(plan_fwd_z[idx]);
-			fftw_destroy_plan(plan_inv_x[idx]);
-			fftw_destroy_plan(plan_inv_y[idx]);
-			fftw_destroy_plan(plan_inv_z[idx]);
-
-			fftw_free((double*)pline_zp_x[idx]);
-			fftw_free((fftw_complex*)pline_zp_y[idx]);
-			fftw_free((fftw_complex*)pline_zp_z[idx]);
-			fftw_free((fftw_complex*)pline[idx]);
-			fftw_free((double*)pline_rev_x[idx]);
+			fftwR_destroy_plan(plan_fwd_x[idx]);
+			fftwR_destroy_plan(plan_fwd_y[idx]);
+			fftwR_destroy_plan(plan_fwd_z[idx]);
+			fftwR_destroy_plan(plan_inv_x[idx]);
+			fftwR_destroy_plan(plan_inv_y[idx]);
+			fftwR_destroy_plan(plan_inv_z[idx]);
+
+			//pruned fft plans only made in directions without pbc
+			if (plan_fwd_y_odd[idx]) { fftwR_destroy_plan(plan_fwd_y_odd[idx]); plan_fwd_y_odd[idx] = nullptr; }
+			if (plan_fwd_z_odd[idx]) { fftwR_destroy_plan(plan_fwd_z_odd[idx]); plan_fwd_z_odd[idx] = nullptr; }
+			if (plan_inv_y_odd[idx]) { fftwR_destroy_plan(plan_inv_y_odd[idx]); plan_inv_y_odd[idx] = nullptr; }
+			if (plan_inv_z_odd[idx]) { fftwR_destroy_plan(plan_inv_z_odd[idx]); plan_inv_z_odd[idx] = nullptr; }
+
+			fftwR_free((fftReal*)pline_zp_x[idx]);
+			fftwR_free((fftwR_complex*)pline_zp_y[idx]);
+			fftwR_free((fftwR_complex*)pline_zp_z[idx]);
+			fftwR_free((fftwR_complex*)pline[idx]);
+			fftwR_free((fftReal*)pline_rev_x[idx]);
 		}
 	}
 
 	fftw_plans_created = false;
 }
 
+//64-bit FNV-1a hash of wisdom file text, as stored in the keys file
+std::string ConvolutionData::Hash_FFTW_Wisdom(const std::string& wisdom_text)
+{
+	uint64_t hash = 14695981039346656037ULL;
+
+	for (int idx = 0; idx < wisdom_text.size(); idx++) {
+
+		hash ^= (unsigned char)wisdom_text[idx];
+		hash *= 1099511628211ULL;
+	}
+
+	std::stringstream ss;
+	ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+	return ss.str();
+}
+
+//save fftw wisdom and list of planned transform sizes to file (call with wisdom_mutex locked)
+void ConvolutionData::Save_FFTW_Wisdom(void)
+{
+	if (!wisdom_directory.length()) return;
+
+	//write both to temporary files then move them into place : other Boris instances sharing the wisdom directory, or an interrupted save, must not leave truncated files to be loaded
+	//the keys file starts with the hash of the wisdom file, so if only one of them was moved into place the keys are not used when loaded
+	std::string wisdom_file = wisdom_directory + FFTW_WISDOM_FILE;
+	std::string wisdom_temp = GetTemporaryFileName(wisdom_file);
+
+	std::string keys_file = wisdom_directory + FFTW_WISDOM_KEYS_FILE;
+	std::string keys_temp = GetTemporaryFileName(keys_file);
+
+	std::error_code ec;
+
+	if (!fftwR_export_wisdom_to_filename(wisdom_temp.c_str())) {
+
+		std::filesystem::remove(wisdom_temp, ec);
+		return;
+	}
+
+	std::ifstream wisdom_stream(wisdom_temp, std::ios::binary);
+	std::string wisdom_text((std::istreambuf_iterator<char>(wisdom_stream)), std::istreambuf_iterator<char>());
+	wisdom_stream.close();
+
+	std::string keys_text = "wisdom\t" + Hash_FFTW_Wisdom(wisdom_text) + "\n";
+	for (int idx = 0; idx < wisdom_keys.size(); idx++) {
+
+		INT4 N_key = wisdom_keys[idx].first;
+		INT3 variant_key = wisdom_keys[idx].second;
+
+		keys_text += ToString(N_key.x) + "\t" + ToString(N_key.y) + "\t" + ToString(N_key.z) + "\t" + ToString(N_key.t) + "\t";
+		keys_text += ToString(variant_key.x) + "\t" + ToString(variant_key.y) + "\t" + ToString(variant_key.z) + "\n";
+	}
+
+	if (!SaveTextToFile(keys_temp, keys_text)) {
+
+		std::filesystem::remove(wisdom_temp, ec);
+		std::filesystem::remove(keys_temp, ec);
+		return;
+	}
+
+	//both files written : move them into place
+	if (MoveFileReplace(wisdom_temp, wisdom_file)) MoveFileReplace(keys_temp, keys_file);
+	else std::filesystem::remove(keys_temp, ec);
+}
+
+//make twiddle factors exp(-i * PI * p / n_axis), p = 0 to n_axis - 1, for pruned ffts
+void ConvolutionData::make_twiddles(std::vector<fftReIm>& twiddle, int n_axis)
+{
+	twiddle.resize(n_axis);
+
+	for (int p = 0; p < n_axis; p++) {
+
+		twiddle[p] = fftReIm(cos(PI * p / n_axis), -sin(PI * p / n_axis));
+	}
+}
+
+//pruned forward fft on a block of lines : input in the lower half of pblock_in. Fills the upper half with the twiddled input then runs the even and odd half-length ffts.
+void ConvolutionData::execute_fwd_pruned(fftwR_plan plan_even, fftwR_plan plan_odd, fftReIm3* pblock_in, std::vector<fftReIm>& twiddle)
+{
+	int B = fft_block_lines;
+	int n_axis = twiddle.size();
+
+	for (int p = 0; p < n_axis; p++) {
+		for (int b = 0; b < B; b++) {
+
+			fftReIm3 value = pblock_in[p * B + b];
+			pblock_in[(n_axis + p) * B + b] = fftReIm3(value.x * twiddle[p], value.y * twiddle[p], value.z * twiddle[p]);
+		}
+	}
+
+	fftwR_execute(plan_even);
+	fftwR_execute(plan_odd);
+}
+
+//pruned inverse fft on a block of lines : runs the even and odd half-length iffts into pblock_out, then combines them in its lower half.
+void ConvolutionData::execute_inv_pruned(fftwR_plan plan_even, fftwR_plan plan_odd, fftReIm3* pblock_out, std::vector<fftReIm>& twiddle)
+{
+	int B = fft_block_lines;
+	int n_axis = twiddle.size();
+
+	fftwR_execute(plan_even);
+	fftwR_execute(plan_odd);
+
+	for (int p = 0; p < n_axis; p++) {
+
+		fftReIm twiddle_conj = ~twiddle[p];
+
+		for (int b = 0; b < B; b++) {
+
+			fftReIm3 value_odd = pblock_out[(n_axis + p) * B + b];
+			pblock_out[p * B + b] = pblock_out[p * B + b] + fftReIm3(value_odd.x * twiddle_conj, value_odd.y * twiddle_conj, value_odd.z * twiddle_conj);
+		}
+	}
+}
+
 //Allocate memory for F and F2 (if needed) scratch spaces)
 BError ConvolutionData::AllocateScratchSpaces(void)
 {
@@ -155,61 +286,147 @@ BError ConvolutionData::SetConvolutionDimensions(SZ3 n_, DBL3 h_, bool embed_mul
 	//first clean any previously allocated memory
 	free_memory();
 
+	//number of lines per fft block : the x and y stages have the fewest lines, so make sure these can still be shared between all threads
+	int min_stage_lines = minimum((int)(n.y * n.z), (int)((N.x / 2 + 1) * n.z));
+	fft_block_lines = maximum(1, minimum(FFT_BLOCK_LINES, min_stage_lines / OmpThreads));
+
 	//allocate new fft lines
 	for (int idx = 0; idx < OmpThreads; idx++) {
 
-		pline_zp_x[idx] = fftw_alloc_real(N.x * 3);
-		pline_rev_x[idx] = fftw_alloc_real(N.x * 3);
+		pline_zp_x[idx] = fftwR_alloc_real(N.x * fft_block_lines * 3);
+		pline_rev_x[idx] = fftwR_alloc_real(N.x * fft_block_lines * 3);
 
-		pline_zp_y[idx] = fftw_alloc_complex(N.y * 3);
-		pline_zp_z[idx] = fftw_alloc_complex(N.z * 3);
+		pline_zp_y[idx] = fftwR_alloc_complex(N.y * fft_block_lines * 3);
+		pline_zp_z[idx] = fftwR_alloc_complex(N.z * fft_block_lines * 3);
 
-		pline[idx] = fftw_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * 3);
+		pline[idx] = fftwR_alloc_complex(maximum(N.x / 2 + 1, N.y, N.z) * fft_block_lines * 3);
 	}
 
 	//zero fft lines
 	zero_fft_lines();
 
-	//make fft plans
+	//make fft plans : each plan transforms a block of fft_block_lines lines with 3 components each, all interleaved
 	int dims_x[1] = { (int)N.x };
 	int dims_y[1] = { (int)N.y };
 	int dims_z[1] = { (int)N.z };
 
+	int howmany = fft_block_lines * 3;
+
+	//prune ffts along y and z in directions without pbc (N = 2n). Not needed for 2D along z (N.z = 1).
+	prune_y = !pbc_images.y;
+	prune_z = !pbc_images.z && n.z > 1;
+
+	if (prune_y) make_twiddles(twiddle_y, n.y);
+	else twiddle_y.clear();
+
+	if (prune_z) make_twiddles(twiddle_z, n.z);
+	else twiddle_z.clear();
+
+	//half-length dimensions for pruned ffts
+	int dims_y_half[1] = { (int)n.y };
+	int dims_z_half[1] = { (int)n.z };
+
+	//fftw planner and wisdom keys are shared between convolution objects
+	std::lock_guard<std::mutex> wisdom_lock(wisdom_mutex);
+
 	for (int idx = 0; idx < OmpThreads; idx++) {
 
-		plan_fwd_x[idx] = fftw_plan_many_dft_r2c(1, dims_x, 3,
-			pline_zp_x[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
+		plan_fwd_x[idx] = fftwR_plan_many_dft_r2c(1, dims_x, howmany,
+			pline_zp_x[idx], nullptr, howmany, 1,
+			pline[idx], nullptr, howmany, 1,
 			FFTW_PATIENT);
 
-		plan_fwd_y[idx] = fftw_plan_many_dft(1, dims_y, 3,
-			pline_zp_y[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_FORWARD, FFTW_PATIENT);
-
-		plan_fwd_z[idx] = fftw_plan_many_dft(1, dims_z, 3,
-			pline_zp_z[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_FORWARD, FFTW_PATIENT);
-
-		plan_inv_z[idx] = fftw_plan_many_dft(1, dims_z, 3,
-			pline[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_BACKWARD, FFTW_PATIENT);
-
-		plan_inv_y[idx] = fftw_plan_many_dft(1, dims_y, 3,
-			pline[idx], nullptr, 3, 1,
-			pline[idx], nullptr, 3, 1,
-			FFTW_BACKWARD, FFTW_PATIENT);
-
-		plan_inv_x[idx] = fftw_plan_many_dft_c2r(1, dims_x, 3,
-			pline[idx], nullptr, 3, 1,
-			pline_rev_x[idx], nullptr, 3, 1,
+		if (prune_y) {
+
+			//even outputs from the input, odd outputs from the twiddled input (upper half of pline_zp_y) : interleaved in pline
+			plan_fwd_y[idx] = fftwR_plan_many_dft(1, dims_y_half, howmany,
+				pline_zp_y[idx], nullptr, howmany, 1,
+				pline[idx], nullptr, 2 * howmany, 1,
+				FFTW_FORWARD, FFTW_PATIENT);
+
+			plan_fwd_y_odd[idx] = fftwR_plan_many_dft(1, dims_y_half, howmany,
+				pline_zp_y[idx] + n.y * howmany, nullptr, howmany, 1,
+				pline[idx] + howmany, nullptr, 2 * howmany, 1,
+				FFTW_FORWARD, FFTW_PATIENT);
+
+			//iffts of even and odd inputs in pline, to lower and upper halves of pline_zp_y respectively
+			plan_inv_y[idx] = fftwR_plan_many_dft(1, dims_y_half, howmany,
+				pline[idx], nullptr, 2 * howmany, 1,
+				pline_zp_y[idx], nullptr, howmany, 1,
+				FFTW_BACKWARD, FFTW_PATIENT);
+
+			plan_inv_y_odd[idx] = fftwR_plan_many_dft(1, dims_y_half, howmany,
+				pline[idx] + howmany, nullptr, 2 * howmany, 1,
+				pline_zp_y[idx] + n.y * howmany, nullptr, howmany, 1,
+				FFTW_BACKWARD, FFTW_PATIENT);
+		}
+		else {
+
+			plan_fwd_y[idx] = fftwR_plan_many_dft(1, dims_y, howmany,
+				pline_zp_y[idx], nullptr, howmany, 1,
+				pline[idx], nullptr, howmany, 1,
+				FFTW_FORWARD, FFTW_PATIENT);
+
+			plan_inv_y[idx] = fftwR_plan_many_dft(1, dims_y, howmany,
+				pline[idx], nullptr, howmany, 1,
+				pline[idx], nullptr, howmany, 1,
+				FFTW_BACKWARD, FFTW_PATIENT);
+		}
+
+		if (prune_z) {
+
+			//as for y
+			plan_fwd_z[idx] = fftwR_plan_many_dft(1, dims_z_half, howmany,
+				pline_zp_z[idx], nullptr, howmany, 1,
+				pline[idx], nullptr, 2 * howmany, 1,
+				FFTW_FORWARD, FFTW_PATIENT);
+
+			plan_fwd_z_odd[idx] = fftwR_plan_many_dft(1, dims_z_half, howmany,
+				pline_zp_z[idx] + n.z * howmany, nullptr, howmany, 1,
+				pline[idx] + howmany, nullptr, 2 * howmany, 1,
+				FFTW_FORWARD, FFTW_PATIENT);
+
+			plan_inv_z[idx] = fftwR_plan_many_dft(1, dims_z_half, howmany,
+				pline[idx], nullptr, 2 * howmany, 1,
+				pline_zp_z[idx], nullptr, howmany, 1,
+				FFTW_BACKWARD, FFTW_PATIENT);
+
+			plan_inv_z_odd[idx] = fftwR_plan_many_dft(1, dims_z_half, howmany,
+				pline[idx] + howmany, nullptr, 2 * howmany, 1,
+				pline_zp_z[idx] + n.z * howmany, nullptr, howmany, 1,
+				FFTW_BACKWARD, FFTW_PATIENT);
+		}
+		else {
+
+			plan_fwd_z[idx] = fftwR_plan_many_dft(1, dims_z, howmany,
+				pline_zp_z[idx], nullptr, howmany, 1,
+				pline[idx], nullptr, howmany, 1,
+				FFTW_FORWARD, FFTW_PATIENT);
+
+			plan_inv_z[idx] = fftwR_plan_many_dft(1, dims_z, howmany,
+				pline[idx], nullptr, howmany, 1,
+				pline[idx], nullptr, howmany, 1,
+				FFTW_BACKWARD, FFTW_PATIENT);
+		}
+
+		plan_inv_x[idx] = fftwR_plan_many_dft_c2r(1, dims_x, howmany,
+			pline[idx], nullptr, howmany, 1,
+			pline_rev_x[idx], nullptr, howmany, 1,
 			FFTW_PATIENT);
 	}
 	
 	fftw_plans_created = true;
 
+	//if this transform size (and block size) was not planned before with the same plan variant (pruned y and z ffts, embedded multiplication) then new wisdom has been accumulated : save it
+	//e.g. a mesh with pbc and n = 64 and one without pbc and n = 32 have the same N, but different plans
+	std::pair<INT4, INT3> wisdom_key = { INT4(N.x, N.y, N.z, fft_block_lines), INT3(prune_y, prune_z, embed_multiplication) };
+
+	if (!vector_contains(wisdom_keys, wisdom_key)) {
+
+		wisdom_keys.push_back(wisdom_key);
+		Save_FFTW_Wisdom();
+	}
+
 	return error;
 }
 
@@ -218,27 +435,79 @@ void ConvolutionData::zero_fft_lines(void)
 {
 	for (int idx = 0; idx < OmpThreads; idx++) {
 
-		for (int i = 0; i < N.x; i++) {
+		for (int i = 0; i < N.x * fft_block_lines; i++) {
 
-			*reinterpret_cast<DBL3*>(pline_zp_x[idx] + i * 3) = DBL3();
-			*reinterpret_cast<DBL3*>(pline_rev_x[idx] + i * 3) = DBL3();
+			*reinterpret_cast<fftReal3*>(pline_zp_x[idx] + i * 3) = fftReal3();
+			*reinterpret_cast<fftReal3*>(pline_rev_x[idx] + i * 3) = fftReal3();
 		}
 
-		for (int j = 0; j < N.y; j++) {
+		for (int j = 0; j < N.y * fft_block_lines; j++) {
 
-			*reinterpret_cast<ReIm3*>(pline_zp_y[idx] + j * 3) = ReIm3();
+			*reinterpret_cast<fftReIm3*>(pline_zp_y[idx] + j * 3) = fftReIm3();
 		}
 
-		for (int k = 0; k < N.z; k++) {
+		for (int k = 0; k < N.z * fft_block_lines; k++) {
 
-			*reinterpret_cast<ReIm3*>(pline_zp_z[idx] + k * 3) = ReIm3();
+			*reinterpret_cast<fftReIm3*>(pline_zp_z[idx] + k * 3) = fftReIm3();
 		}
 
-		for (int i = 0; i < maximum(N.x / 2 + 1, N.y, N.z); i++) {
+		for (int i = 0; i < maximum(N.x / 2 + 1, N.y, N.z) * fft_block_lines; i++) {
 
-			*reinterpret_cast<ReIm3*>(pline[idx] + i * 3) = ReIm3();
+			*reinterpret_cast<fftReIm3*>(pline[idx] + i * 3) = fftReIm3();
 		}
 	}
 }
 
+//-------------------------- FFTW WISDOM
+
+//load fftw wisdom from given directory (call on program startup). Updated wisdom will be saved in the same directory.
+void ConvolutionData::Load_FFTW_Wisdom(std::string directory)
+{
+	std::lock_guard<std::mutex> wisdom_lock(wisdom_mutex);
+
+	wisdom_directory = directory;
+	wisdom_keys.clear();
+
+	//only use list of transform sizes if the wisdom file itself could be imported
+	std::string wisdom_file = wisdom_directory + FFTW_WISDOM_FILE;
+	if (!fftwR_import_wisdom_from_filename(wisdom_file.c_str())) return;
+
+	std::ifstream wisdom_stream(wisdom_file, std::ios::binary);
+	std::string wisdom_text((std::istreambuf_iterator<char>(wisdom_stream)), std::istreambuf_iterator<char>());
+	wisdom_stream.close();
+
+	std::vector<std::vector<std::string>> keys_data;
+	ReadData(wisdom_directory + FFTW_WISDOM_KEYS_FILE, "\t", keys_data);
+
+	//keys saved with a different wisdom file are not used : these transform sizes will be saved again when planned
+	if (!keys_data.size() || keys_data[0].size() != 2 || keys_data[0][0] != "wisdom" || keys_data[0][1] != Hash_FFTW_Wisdom(wisdom_text)) return;
+
+	for (int idx = 1; idx < keys_data.size(); idx++) {
+
+		//keys without plan variant are not used : these transform sizes will be saved again when planned
+		if (keys_data[idx].size() != 7) continue;
+
+		INT4 N_key = INT4(ToNum(keys_data[idx][0]), ToNum(keys_data[idx][1]), ToNum(keys_data[idx][2]), ToNum(keys_data[idx][3]));
+		INT3 variant_key = INT3(ToNum(keys_data[idx][4]), ToNum(keys_data[idx][5]), ToNum(keys_data[idx][6]));
+
+		wisdom_keys.push_back({ N_key, variant_key });
+	}
+}
+
+//make fftw plans for the given list of mesh dimensions (without pbc) so they are stored in wisdom
+BError ConvolutionData::Prewarm_FFTW_Wisdom(std::vector<SZ3> n_list)
+{
+	BError error(__FUNCTION__);
+
+	for (int idx = 0; idx < n_list.size(); idx++) {
+
+		//cellsize not relevant for planning
+		ConvolutionData convdata;
+		error = convdata.SetConvolutionDimensions(n_list[idx], DBL3(1.0));
+		if (error) return error;
+	}
+
+	return error;
+}
+
 //-------------------------- RUN-TIME METHODS
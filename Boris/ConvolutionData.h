@@ -3,11 +3,73 @@
 #include "BorisLib.h"
 
 #include "ErrorHandler.h"
+#include "CompileFlags.h"
 
 #include "fftw3.h"
 
+#if SINGLEPRECISION_CPUFFT == 1
+
+#pragma comment(lib, "libfftw3f-3.lib")
+
+//floating point types used in CPU FFT scratch spaces and kernels
+typedef float fftReal;
+typedef FLT3 fftReal3;
+typedef __ReIm<float> fftReIm;
+typedef __ReIm3<float> fftReIm3;
+
+//fftw types and methods matching fftReal
+typedef fftwf_plan fftwR_plan;
+typedef fftwf_complex fftwR_complex;
+
+#define fftwR_alloc_real fftwf_alloc_real
+#define fftwR_alloc_complex fftwf_alloc_complex
+#define fftwR_free fftwf_free
+#define fftwR_execute fftwf_execute
+#define fftwR_destroy_plan fftwf_destroy_plan
+#define fftwR_plan_many_dft fftwf_plan_many_dft
+#define fftwR_plan_many_dft_r2c fftwf_plan_many_dft_r2c
+#define fftwR_plan_many_dft_c2r fftwf_plan_many_dft_c2r
+#define fftwR_import_wisdom_from_filename fftwf_import_wisdom_from_filename
+#define fftwR_export_wisdom_to_filename fftwf_export_wisdom_to_filename
+
+//fftw wisdom file (in Boris Data directory), and file with list of transform sizes stored in it
+#define FFTW_WISDOM_FILE	"fftwf_wisdom.txt"
+#define FFTW_WISDOM_KEYS_FILE	"fftwf_wisdom_keys.txt"
+
+#else
+
 #pragma comment(lib, "libfftw3-3.lib")
 
+//floating point types used in CPU FFT scratch spaces and kernels
+typedef double fftReal;
+typedef DBL3 fftReal3;
+typedef ReIm fftReIm;
+typedef ReIm3 fftReIm3;
+
+//fftw types and methods matching fftReal
+typedef fftw_plan fftwR_plan;
+typedef fftw_complex fftwR_complex;
+
+#define fftwR_alloc_real fftw_alloc_real
+#define fftwR_alloc_complex fftw_alloc_complex
+#define fftwR_free fftw_free
+#define fftwR_execute fftw_execute
+#define fftwR_destroy_plan fftw_destroy_plan
+#define fftwR_plan_many_dft fftw_plan_many_dft
+#define fftwR_plan_many_dft_r2c fftw_plan_many_dft_r2c
+#define fftwR_plan_many_dft_c2r fftw_plan_many_dft_c2r
+#define fftwR_import_wisdom_from_filename fftw_import_wisdom_from_filename
+#define fftwR_export_wisdom_to_filename fftw_export_wisdom_to_filename
+
+//fftw wisdom file (in Boris Data directory), and file with list of transform sizes stored in it
+#define FFTW_WISDOM_FILE	"fftw_wisdom.txt"
+#define FFTW_WISDOM_KEYS_FILE	"fftw_wisdom_keys.txt"
+
+#endif
+
+//maximum number of lines transformed together by a single fftw plan execution : lines in a block are interleaved so fftw can vectorize across them
+#define FFT_BLOCK_LINES	16
+
 class ConvolutionData
 {
 
@@ -32,7 +94,8 @@ protected:
 	INT3 pbc_images;
 
 	//FFT calculation spaces : dimensions (N.x/2 + 1) * N.y * n.z. for 3D and (N.x/2 + 1) * n.y * 1 for 2D
-	VEC<ReIm3> F;
+	//precision set by SINGLEPRECISION_CPUFFT : single precision halves the FFT memory traffic
+	VEC<fftReIm3> F;
 
 	//by default embed the kernel multiplication with the z-axis fft / ifft
 	//you may want to disable this if you want to keep the full 3D/2D fft result in the F scratch space
@@ -41,20 +104,35 @@ protected:
 	bool embed_multiplication = true;
 
 	//additional scratch space used when kernel multiplication is not embedded (embed_multiplication = false)
-	VEC<ReIm3> F2;
+	VEC<fftReIm3> F2;
+
+	std::vector<fftwR_plan> plan_fwd_x, plan_fwd_y, plan_fwd_z;
+	std::vector<fftwR_plan> plan_inv_x, plan_inv_y, plan_inv_z;
+
+	//pruned ffts along y and z : used in directions without pbc, where N = 2n, so the upper half of every forward fft input is zero and only the lower half of every inverse fft output is kept.
+	//In these directions a length N fft is computed as 2 half-length ffts, one for the even and one for the odd outputs; the odd one acts on the input multiplied by the twiddle factors exp(-i * PI * p / n).
+	//For the inverse ffts the even and odd half-length ffts are combined using the conjugate twiddle factors. plan_fwd_y etc. are then the even half-length ffts.
+	//The real x-direction ffts are not pruned : the odd half of a pruned real fft needs a complex fft, which costs more than the full length real fft.
+	bool prune_y = false, prune_z = false;
 
-	std::vector<fftw_plan> plan_fwd_x, plan_fwd_y, plan_fwd_z;
-	std::vector<fftw_plan> plan_inv_x, plan_inv_y, plan_inv_z;
+	std::vector<fftReIm> twiddle_y, twiddle_z;
+
+	std::vector<fftwR_plan> plan_fwd_y_odd, plan_fwd_z_odd;
+	std::vector<fftwR_plan> plan_inv_y_odd, plan_inv_z_odd;
+
+	//number of lines in each fft block (at most FFT_BLOCK_LINES, reduced for small meshes so all threads still get work)
+	//All the fft lines below are blocks of fft_block_lines interleaved lines : element p of line b is at index p * fft_block_lines + b (in units of fftReal3 or fftReIm3)
+	int fft_block_lines = 1;
 
 	//forward fft lines with constant zero padding
-	std::vector<double*> pline_zp_x;
-	std::vector<fftw_complex*> pline_zp_y, pline_zp_z;
+	std::vector<fftReal*> pline_zp_x;
+	std::vector<fftwR_complex*> pline_zp_y, pline_zp_z;
 
 	//fft and ifft line without zero padding
-	std::vector<fftw_complex*> pline;
+	std::vector<fftwR_complex*> pline;
 
 	//ifft line for real output, to be truncated
-	std::vector<double*> pline_rev_x;
+	std::vector<fftReal*> pline_rev_x;
 	
 	//the flow is:
 	//input -> pline_zp_x -fft-> pline -> F
@@ -63,9 +141,28 @@ protected:
 	//
 	//F -> pline -ifft-> pline -> F
 	//F -> pline -ifft-> pline_rev_x -> output
+	//
+	//with pruned ffts along y (z) the ifft outputs go to pline_zp_y (pline_zp_z) instead, and the upper half of pline_zp_y (pline_zp_z) holds the twiddled fft inputs or the odd ifft outputs.
 
 	bool fftw_plans_created = false;
 
+private:
+
+	//-------------------------- FFTW WISDOM
+
+	//fftw wisdom is shared by all convolution objects : loaded from file on program startup, and saved to file every time a new transform size is planned.
+	//This avoids repeating the FFTW_PATIENT planning every time a convolution object is (re)initialized, or the program is restarted.
+
+	//directory for fftw wisdom files (Boris Data directory). Wisdom not saved if empty.
+	static std::string wisdom_directory;
+
+	//transform sizes already planned and stored in wisdom, as (N.x, N.y, N.z, lines per block) and plan variant (prune_y, prune_z, embed_multiplication)
+	//the keys file starts with a hash of the wisdom file it was saved with, so keys are only used with the same wisdom (e.g. not if a save was interrupted between moving the two files into place)
+	static std::vector<std::pair<INT4, INT3>> wisdom_keys;
+
+	//guards wisdom_keys, wisdom files, and fftw planning (the fftw planner is not thread-safe)
+	static std::mutex wisdom_mutex;
+
 private:
 
 	//-------------------------- HELPERS
@@ -73,6 +170,21 @@ private:
 	//free memmory allocated for fftw
 	void free_memory(void);
 
+	//save fftw wisdom and list of planned transform sizes to file (call with wisdom_mutex locked)
+	static void Save_FFTW_Wisdom(void);
+
+	//64-bit FNV-1a hash of wisdom file text, as stored in the keys file
+	static std::string Hash_FFTW_Wisdom(const std::string& wisdom_text);
+
+	//make twiddle factors exp(-i * PI * p / n_axis), p = 0 to n_axis - 1, for pruned ffts
+	void make_twiddles(std::vector<fftReIm>& twiddle, int n_axis);
+
+	//pruned forward fft on a block of lines : input in the lower half of pblock_in. Fills the upper half with the twiddled input then runs the even and odd half-length ffts.
+	void execute_fwd_pruned(fftwR_plan plan_even, fftwR_plan plan_odd, fftReIm3* pblock_in, std::vector<fftReIm>& twiddle);
+
+	//pruned inverse fft on a block of lines : runs the even and odd half-length iffts into pblock_out, then combines them in its lower half.
+	void execute_inv_pruned(fftwR_plan plan_even, fftwR_plan plan_odd, fftReIm3* pblock_out, std::vector<fftReIm>& twiddle);
+
 	//Allocate memory for F and F2 (if needed) scratch spaces)
 	BError AllocateScratchSpaces(void);
 
@@ -94,11 +206,58 @@ protected:
 	//-------------------------- GETTERS
 
 	//Get pointer to the F scratch space
-	VEC<ReIm3>* Get_Input_Scratch_Space(void) { return &F; }
+	VEC<fftReIm3>* Get_Input_Scratch_Space(void) { return &F; }
 
 	//Get pointer to the F2 scratch space
-	VEC<ReIm3>* Get_Output_Scratch_Space(void) { return &F2; }
+	VEC<fftReIm3>* Get_Output_Scratch_Space(void) { return &F2; }
 
 	//-------------------------- RUN-TIME METHODS
 
+	//forward fft along y (z) on the block of lines for thread tn : input in the first n.y (n.z) points of pline_zp_y (pline_zp_z), output in pline
+	void fft_block_fwd_y(int tn)
+	{
+		if (prune_y) execute_fwd_pruned(plan_fwd_y[tn], plan_fwd_y_odd[tn], reinterpret_cast<fftReIm3*>(pline_zp_y[tn]), twiddle_y);
+		else fftwR_execute(plan_fwd_y[tn]);
+	}
+
+	void fft_block_fwd_z(int tn)
+	{
+		if (prune_z) execute_fwd_pruned(plan_fwd_z[tn], plan_fwd_z_odd[tn], reinterpret_cast<fftReIm3*>(pline_zp_z[tn]), twiddle_z);
+		else fftwR_execute(plan_fwd_z[tn]);
+	}
+
+	//inverse fft along y (z) on the block of lines for thread tn : input in pline. Return the block holding the output, valid in the first n.y (n.z) points.
+	fftReIm3* fft_block_inv_y(int tn)
+	{
+		if (prune_y) {
+
+			execute_inv_pruned(plan_inv_y[tn], plan_inv_y_odd[tn], reinterpret_cast<fftReIm3*>(pline_zp_y[tn]), twiddle_y);
+			return reinterpret_cast<fftReIm3*>(pline_zp_y[tn]);
+		}
+		
+		fftwR_execute(plan_inv_y[tn]);
+		return reinterpret_cast<fftReIm3*>(pline[tn]);
+	}
+
+	fftReIm3* fft_block_inv_z(int tn)
+	{
+		if (prune_z) {
+
+			execute_inv_pruned(plan_inv_z[tn], plan_inv_z_odd[tn], reinterpret_cast<fftReIm3*>(pline_zp_z[tn]), twiddle_z);
+			return reinterpret_cast<fftReIm3*>(pline_zp_z[tn]);
+		}
+
+		fftwR_execute(plan_inv_z[tn]);
+		return reinterpret_cast<fftReIm3*>(pline[tn]);
+	}
+
+public:
+
+	//-------------------------- FFTW WISDOM
+
+	//load fftw wisdom from given directory (call on program startup). Updated wisdom will be saved in the same directory.
+	static void Load_FFTW_Wisdom(std::string directory);
+
+	//make fftw plans for the given list of mesh dimensions (without pbc) so they are stored in wisdom
+	static BError Prewarm_FFTW_Wisdom(std::vector<SZ3> n_list);
 };
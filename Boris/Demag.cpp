@@ -64,10 +64,13 @@ BError Demag::Initialize(void)
 	if (pMesh->pSMesh->GetEvaluationSpeedup()) {
 
 		Hdemag.resize(pMesh->h, pMesh->meshRect);
+
+		if (!Hdemag_extrapolation.Initialize(pMesh->pSMesh->GetEvaluationSpeedupExtrapolation(), pMesh->h, pMesh->meshRect)) return error(BERROR_OUTOFMEMORY_CRIT);
 	}
 	else {
 
 		Hdemag.clear();
+		Hdemag_extrapolation.Clear();
 	}
 
 	Hdemag_calculated = false;
@@ -90,6 +93,7 @@ BError Demag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 	//if memory needs to be allocated for Hdemag, it will be done through Initialize 
 	Hdemag.clear();
+	Hdemag_extrapolation.Clear();
 	Hdemag_calculated = false;
 
 	//------------------------ CUDA UpdateConfiguration if set
@@ -170,6 +174,13 @@ double Demag::UpdateField(void)
 
 				Hdemag_calculated = true;
 
+				//keep evaluation for extrapolation on skipped steps if enabled, and report extrapolation error
+				if (Hdemag_extrapolation.Enabled()) {
+
+					Hdemag_extrapolation.Save(Hdemag, pMesh->pSMesh->Get_EvalStep_Time(), pMesh->pSMesh->GetTime(), pMesh->pSMesh->GetTimeStep());
+					if (Hdemag_extrapolation.Get_Error() >= 0.0) pMesh->pSMesh->Report_EvalSpeedup_Error(Hdemag_extrapolation.Get_Error());
+				}
+
 				//finish off energy value
 				if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
 				else energy = 0;
@@ -199,6 +210,11 @@ double Demag::UpdateField(void)
 				return energy;
 			}
 		}
+		else if (Hdemag_extrapolation.Enabled()) {
+
+			//skipped step : extrapolate Hdemag to this evaluation step time from previous evaluations instead of re-using the last one
+			Hdemag_extrapolation.Extrapolate(Hdemag, pMesh->pSMesh->Get_EvalStep_Time(), pMesh->pSMesh->GetTime(), pMesh->pSMesh->GetTimeStep());
+		}
 
 		if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
@@ -229,22 +245,29 @@ double Demag::UpdateField(void)
 	else {
 
 		//don't use evaluation speedup, so no need to use Hdemag (this won't have memory allocated anyway)
+		UpdateField_NoSpeedup();
+	}
 
-		//convolute and get "energy" value
-		if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+	return energy;
+}
 
-			energy = Convolute_AveragedInputs_DuplicatedOutputs(pMesh->M, pMesh->M2, pMesh->Heff, pMesh->Heff2, false);
-		}
-		else {
+//calculate field without evaluation speedup, adding it to the mesh effective field, and return energy : also used by Monte Carlo algorithms, which need the field for the current magnetization
+double Demag::UpdateField_NoSpeedup(void)
+{
+	//convolute and get "energy" value
+	if (pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
 
-			energy = Convolute(pMesh->M, pMesh->Heff, false);
-		}
+		energy = Convolute_AveragedInputs_DuplicatedOutputs(pMesh->M, pMesh->M2, pMesh->Heff, pMesh->Heff2, false);
+	}
+	else {
 
-		//finish off energy value
-		if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
-		else energy = 0;
+		energy = Convolute(pMesh->M, pMesh->Heff, false);
 	}
 
+	//finish off energy value
+	if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / (2 * pMesh->M.get_nonempty_cells());
+	else energy = 0;
+
 	return energy;
 }
 
@@ -13,6 +13,7 @@ class Mesh;
 
 #include "Convolution.h"
 #include "DemagKernel.h"
+#include "EvalSpeedupExtrapolation.h"
 
 class Demag : 
 	public Modules,
@@ -33,6 +34,9 @@ private:
 	//when using the evaluation speedup method we must ensure we have a previous Hdemag evaluation available
 	bool Hdemag_calculated = false;
 
+	//previous Hdemag evaluations used to extrapolate Hdemag on skipped steps, if enabled for evaluation speedup (otherwise the last Hdemag evaluation is re-used)
+	EvalSpeedupExtrapolation Hdemag_extrapolation;
+
 public:
 
 	Demag(Mesh *pMesh_);
@@ -55,6 +59,9 @@ public:
 
 	double UpdateField(void);
 
+	//calculate field without evaluation speedup, adding it to the mesh effective field, and return energy : also used by Monte Carlo algorithms, which need the field for the current magnetization
+	double UpdateField_NoSpeedup(void);
+
 	//-------------------Setters
 
 	//Set PBC
@@ -94,6 +101,7 @@ public:
 	BError MakeCUDAModule(void) { return BError(); }
 
 	double UpdateField(void) { return 0.0; }
+	double UpdateField_NoSpeedup(void) { return 0.0; }
 
 	//-------------------Setters
 
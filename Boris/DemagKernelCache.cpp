@@ -0,0 +1,189 @@
+#include "stdafx.h"
+#include "DemagKernelCache.h"
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+
+#include <filesystem>
+
+//kernel cache file termination
+#define DEMAGKERNELCACHE_TERMINATION	".bkc"
+
+std::string DemagKernelCache::cache_directory = "";
+size_t DemagKernelCache::cache_size_limit_MB = DEMAGKERNELCACHE_DEFAULTSIZEMB;
+
+//-------------------------- HELPERS
+
+//cache file name (with directory) from key
+std::string DemagKernelCache::Make_FileName(const std::string& key)
+{
+	//64-bit FNV-1a hash of key
+	uint64_t hash = 14695981039346656037ULL;
+
+	for (int idx = 0; idx < key.size(); idx++) {
+
+		hash ^= (unsigned char)key[idx];
+		hash *= 1099511628211ULL;
+	}
+
+	std::stringstream ss;
+	ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+	return cache_directory + ss.str() + DEMAGKERNELCACHE_TERMINATION;
+}
+
+//delete least recently used cache files until total size is within the set limit
+void DemagKernelCache::Enforce_Size_Limit(void)
+{
+	std::error_code ec;
+
+	//collect cache files with their last write times and sizes
+	std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> files;
+	uintmax_t total_size = 0;
+
+	//temporary files left by interrupted saves are removed once they are old enough not to belong to a save in progress
+	auto stale_time = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+
+	for (auto& entry : std::filesystem::directory_iterator(cache_directory, ec)) {
+
+		if (entry.path().extension() == ".tmp") {
+
+			if (std::filesystem::last_write_time(entry.path(), ec) < stale_time) std::filesystem::remove(entry.path(), ec);
+			continue;
+		}
+
+		if (entry.path().extension() != DEMAGKERNELCACHE_TERMINATION) continue;
+
+		files.push_back(std::make_pair(std::filesystem::last_write_time(entry.path(), ec), entry.path()));
+		total_size += std::filesystem::file_size(entry.path(), ec);
+	}
+
+	//oldest first
+	std::sort(files.begin(), files.end());
+
+	uintmax_t size_limit = (uintmax_t)cache_size_limit_MB * 1024 * 1024;
+
+	for (int idx = 0; idx < files.size() && total_size > size_limit; idx++) {
+
+		uintmax_t file_size = std::filesystem::file_size(files[idx].second, ec);
+		if (std::filesystem::remove(files[idx].second, ec)) total_size -= file_size;
+	}
+}
+
+//-------------------------- CONFIGURATION
+
+//set directory for kernel cache files (will be created if needed)
+void DemagKernelCache::Set_Cache_Directory(std::string directory)
+{
+	if (directory.length() && !MakeDirectory(directory)) directory = "";
+
+	cache_directory = directory;
+}
+
+//set maximum total size of kernel cache files in MB (0 disables the cache)
+void DemagKernelCache::Set_Cache_Size_Limit(size_t size_MB)
+{
+	cache_size_limit_MB = size_MB;
+
+	if (cache_directory.length()) Enforce_Size_Limit();
+}
+
+//-------------------------- LOAD / SAVE
+
+//load kernels for given key into the given buffers (memory already allocated, given as pointer and size in bytes). Return true if loaded.
+bool DemagKernelCache::Load(const std::string& key, const std::vector<std::pair<char*, size_t>>& buffers)
+{
+	if (!Cache_Enabled()) return false;
+
+	std::string fileName = Make_FileName(key);
+
+	std::ifstream bdin;
+	bdin.open(fileName.c_str(), std::ios::in | std::ios::binary);
+	if (!bdin.is_open()) return false;
+
+	//header : cache version, key length, key, then total size of kernel data
+	uint32_t version = 0;
+	bdin.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+	if (!bdin || version != DEMAGKERNELCACHE_VERSION) {
+
+		//written by a build with a different file format or kernel code : never usable, so delete it
+		bdin.close();
+		std::error_code ec;
+		std::filesystem::remove(fileName, ec);
+		return false;
+	}
+
+	uint64_t key_length = 0;
+	bdin.read(reinterpret_cast<char*>(&key_length), sizeof(uint64_t));
+	if (!bdin || key_length != key.size()) return false;
+
+	std::string stored_key(key_length, '\0');
+	bdin.read(&stored_key[0], key_length);
+	if (!bdin || stored_key != key) return false;
+
+	uint64_t data_size = 0, expected_size = 0;
+	for (int idx = 0; idx < buffers.size(); idx++) expected_size += buffers[idx].second;
+
+	bdin.read(reinterpret_cast<char*>(&data_size), sizeof(uint64_t));
+	if (!bdin || data_size != expected_size) return false;
+
+	for (int idx = 0; idx < buffers.size(); idx++) {
+
+		bdin.read(buffers[idx].first, buffers[idx].second);
+		if (!bdin) return false;
+	}
+
+	bdin.close();
+
+	//mark as recently used
+	std::error_code ec;
+	std::filesystem::last_write_time(fileName, std::filesystem::file_time_type::clock::now(), ec);
+
+	return true;
+}
+
+//save kernels for given key from given buffers (pointer and size in bytes), then enforce the cache size limit
+void DemagKernelCache::Save(const std::string& key, const std::vector<std::pair<char*, size_t>>& buffers)
+{
+	if (!Cache_Enabled()) return;
+
+	std::string fileName = Make_FileName(key);
+
+	//write to a temporary file then move it into place : other Boris instances sharing the cache, or an interrupted save, must not leave truncated cache files to be loaded
+	std::string tempFileName = GetTemporaryFileName(fileName);
+
+	std::ofstream bdout;
+	bdout.open(tempFileName.c_str(), std::ios::out | std::ios::binary);
+	if (!bdout.is_open()) return;
+
+	uint32_t version = DEMAGKERNELCACHE_VERSION;
+	bdout.write(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+
+	uint64_t key_length = key.size();
+	bdout.write(reinterpret_cast<char*>(&key_length), sizeof(uint64_t));
+	bdout.write(key.data(), key_length);
+
+	uint64_t data_size = 0;
+	for (int idx = 0; idx < buffers.size(); idx++) data_size += buffers[idx].second;
+	bdout.write(reinterpret_cast<char*>(&data_size), sizeof(uint64_t));
+
+	for (int idx = 0; idx < buffers.size(); idx++) {
+
+		bdout.write(buffers[idx].first, buffers[idx].second);
+	}
+
+	bdout.flush();
+	bool success = (bool)bdout;
+	bdout.close();
+
+	//don't leave incomplete files in the cache
+	if (success) MoveFileReplace(tempFileName, fileName);
+	else {
+
+		std::error_code ec;
+		std::filesystem::remove(tempFileName, ec);
+	}
+
+	Enforce_Size_Limit();
+}
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Boris_Enums_Defs.h"
+
+//default maximum total size of kernel cache files (MB)
+#define DEMAGKERNELCACHE_DEFAULTSIZEMB	2048
+
+//kernel cache version : increment whenever the cache file format or the kernel calculation code (DemagTFunc, DemagKernel, DemagKernelCollection, and their CUDA versions) changes, so kernels cached by older builds are not reused
+#define DEMAGKERNELCACHE_VERSION	1
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+
+#include "BorisLib.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// On-disk cache for demag kernels
+
+//Kernels are stored in binary files named by a hash of the key, where the key is made from all the values the kernel calculation depends on (dimensions, cellsizes, shifts, pbc images, etc.)
+//The full key is also stored in the file header so hash collisions are detected, after the cache version : files with a different version are rejected and deleted. Files are read straight into the already allocated kernel memory.
+//Total size of cache files is capped : when exceeded the least recently used files are deleted first (file modification time is updated on every cache hit).
+
+class DemagKernelCache
+{
+
+private:
+
+	//directory for kernel cache files. Cache disabled if empty.
+	static std::string cache_directory;
+
+	//maximum total size of kernel cache files in MB (0 disables the cache)
+	static size_t cache_size_limit_MB;
+
+private:
+
+	//cache file name (with directory) from key
+	static std::string Make_FileName(const std::string& key);
+
+	//delete least recently used cache files until total size is within the set limit
+	static void Enforce_Size_Limit(void);
+
+public:
+
+	//-------------------------- CONFIGURATION
+
+	//set directory for kernel cache files (will be created if needed)
+	static void Set_Cache_Directory(std::string directory);
+
+	//set maximum total size of kernel cache files in MB (0 disables the cache)
+	static void Set_Cache_Size_Limit(size_t size_MB);
+	static size_t Get_Cache_Size_Limit(void) { return cache_size_limit_MB; }
+
+	static bool Cache_Enabled(void) { return cache_directory.length() && cache_size_limit_MB; }
+
+	//-------------------------- KEY
+
+	//make key from all values the kernel depends on : these must have a fixed binary representation (fundamental types, VAL3 types). The cache version is part of the key.
+	template <typename ... PType>
+	static std::string Make_Key(const std::string& kernel_type, PType ... params)
+	{
+		uint32_t version = DEMAGKERNELCACHE_VERSION;
+		std::string key(reinterpret_cast<const char*>(&version), sizeof(version));
+		key += kernel_type;
+		(key.append(reinterpret_cast<const char*>(&params), sizeof(params)), ...);
+		return key;
+	}
+
+	//-------------------------- LOAD / SAVE
+
+	//load kernels for given key into the given buffers (memory already allocated, given as pointer and size in bytes). Return true if loaded.
+	static bool Load(const std::string& key, const std::vector<std::pair<char*, size_t>>& buffers);
+
+	//save kernels for given key from given buffers (pointer and size in bytes), then enforce the cache size limit
+	static void Save(const std::string& key, const std::vector<std::pair<char*, size_t>>& buffers);
+};
+
+#endif
@@ -82,6 +82,20 @@ BError KerType::AllocateKernels(Rect from_rect, Rect this_rect, SZ3 N_)
 	return error;
 }
 
+//get all kernel storage as pointers and sizes in bytes (unallocated kernels have zero size) : used for kernel cache
+std::vector<std::pair<char*, size_t>> KerType::Get_Kernel_Buffers(void)
+{
+	std::vector<std::pair<char*, size_t>> buffers;
+
+	buffers.push_back(std::make_pair(reinterpret_cast<char*>(K2D_odiag.data()), K2D_odiag.size() * sizeof(fftReal)));
+	buffers.push_back(std::make_pair(reinterpret_cast<char*>(Kdiag_cmpl.data()), Kdiag_cmpl.linear_size() * sizeof(fftReIm3)));
+	buffers.push_back(std::make_pair(reinterpret_cast<char*>(Kodiag_cmpl.data()), Kodiag_cmpl.linear_size() * sizeof(fftReIm3)));
+	buffers.push_back(std::make_pair(reinterpret_cast<char*>(Kdiag_real.data()), Kdiag_real.linear_size() * sizeof(fftReal3)));
+	buffers.push_back(std::make_pair(reinterpret_cast<char*>(Kodiag_real.data()), Kodiag_real.linear_size() * sizeof(fftReal3)));
+
+	return buffers;
+}
+
 void KerType::FreeKernels(void)
 {
 	K2D_odiag.clear();
@@ -5,6 +5,7 @@
 
 #include "BorisLib.h"
 #include "DemagTFunc.h"
+#include "DemagKernelCache.h"
 
 #include "ConvolutionData.h"
 
@@ -40,13 +41,13 @@
 struct KerType {
 
 	//2D off-diagonal for self-demag (only need real version)
-	std::vector<double> K2D_odiag;
+	std::vector<fftReal> K2D_odiag;
 
 	//3D Complex
-	VEC<ReIm3> Kdiag_cmpl, Kodiag_cmpl;
+	VEC<fftReIm3> Kdiag_cmpl, Kodiag_cmpl;
 
 	//3D Real
-	VEC<DBL3> Kdiag_real, Kodiag_real;
+	VEC<fftReal3> Kdiag_real, Kodiag_real;
 
 	//internal_demag == true -> use real kernels with reduced memory usage, 2D or 3D.
 	//internal_demag == false -> use complex kernels 3D only.
@@ -71,6 +72,9 @@ struct KerType {
 	BError AllocateKernels(Rect from_rect, Rect this_rect, SZ3 N_);
 
 	void FreeKernels(void);
+
+	//get all kernel storage as pointers and sizes in bytes (unallocated kernels have zero size) : used for kernel cache
+	std::vector<std::pair<char*, size_t>> Get_Kernel_Buffers(void);
 };
 
 //This must be used as a template parameter in Convolution class.
@@ -133,16 +137,16 @@ private:
 
 	//These compute the self contributions using the real kernels with full use of symmetries
 	//These set the output, not add into it, so always call it first -> each kernel collection has exactly one self contribution
-	void KernelMultiplication_2D_Self(VEC<ReIm3>& In, VEC<ReIm3>& Out);
-	void KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReIm3>& Out);
+	void KernelMultiplication_2D_Self(VEC<fftReIm3>& In, VEC<fftReIm3>& Out);
+	void KernelMultiplication_3D_Self(VEC<fftReIm3>& In, VEC<fftReIm3>& Out);
 
 	//z shifted regular version
-	void KernelMultiplication_2D_zShifted(VEC<ReIm3>& In, VEC<ReIm3>& Out, VEC<DBL3>& Kdiag, VEC<DBL3>& Kodiag);
+	void KernelMultiplication_2D_zShifted(VEC<fftReIm3>& In, VEC<fftReIm3>& Out, VEC<fftReal3>& Kdiag, VEC<fftReal3>& Kodiag);
 	//z shifted but with kernel calculated for the other direction shift, so adjust multiplications
-	void KernelMultiplication_2D_inversezShifted(VEC<ReIm3>& In, VEC<ReIm3>& Out, VEC<DBL3>& Kdiag, VEC<DBL3>& Kodiag);
+	void KernelMultiplication_2D_inversezShifted(VEC<fftReIm3>& In, VEC<fftReIm3>& Out, VEC<fftReal3>& Kdiag, VEC<fftReal3>& Kodiag);
 
 	//z shifted for 3D : complex kernels, but use kernel symmetries
-	void KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC<ReIm3>& Out, VEC<ReIm3>& Kdiag, VEC<ReIm3>& Kodiag);
+	void KernelMultiplication_3D_zShifted(VEC<fftReIm3>& In, VEC<fftReIm3>& Out, VEC<fftReIm3>& Kdiag, VEC<fftReIm3>& Kodiag);
 
 protected:
 
@@ -180,16 +184,16 @@ protected:
 
 	//These versions should be used when not embedding the kernel multiplication
 	//not used here
-	void KernelMultiplication_2D(VEC<ReIm3>& In, VEC<ReIm3>& Out) {}
-	void KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>& Out) {}
+	void KernelMultiplication_2D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out) {}
+	void KernelMultiplication_3D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out) {}
 
 	//multiple input spaces version, used without embedding the kernel multiplication
-	void KernelMultiplication_2D(std::vector<VEC<ReIm3>*>& Incol, VEC<ReIm3>& Out);
-	void KernelMultiplication_3D(std::vector<VEC<ReIm3>*>& Incol, VEC<ReIm3>& Out);
+	void KernelMultiplication_2D(std::vector<VEC<fftReIm3>*>& Incol, VEC<fftReIm3>& Out);
+	void KernelMultiplication_3D(std::vector<VEC<fftReIm3>*>& Incol, VEC<fftReIm3>& Out);
 
 	//kernel multiplications for a single line : used for embedding. Not used by DemagKernelCollection.
-	void KernelMultiplication_2D_line(ReIm3* pline, int i) {}
-	void KernelMultiplication_3D_line(ReIm3* pline, int i, int j) {}
+	void KernelMultiplication_2D_line(fftReIm3* pline, int i, int stride) {}
+	void KernelMultiplication_3D_line(fftReIm3* pline, int i, int j, int stride) {}
 };
 
 #endif
\ No newline at end of file
@@ -55,16 +55,12 @@ BError DemagKernelCollection::Calculate_Demag_Kernels(std::vector<DemagKernelCol
 				error = kernels[index]->AllocateKernels(Rect_collection[index], this_rect, N);
 				if (error) return error;
 
-				//now compute it
+				//set kernel geometry
 				if (kernels[index]->internal_demag) {
 
 					kernels[index]->shift = DBL3();
 					kernels[index]->h_dst = h;
 					kernels[index]->h_src = h;
-
-					//use self versions
-					if (n.z == 1) error = Calculate_Demag_Kernels_2D_Self(index);
-					else error = Calculate_Demag_Kernels_3D_Self(index);
 				}
 				else {
 
@@ -72,33 +68,56 @@ BError DemagKernelCollection::Calculate_Demag_Kernels(std::vector<DemagKernelCol
 					kernels[index]->shift = (this_rect.s - Rect_collection[index].s);
 					kernels[index]->h_dst = h;
 					kernels[index]->h_src = kernelCollection[index]->h;
+				}
 
-					if (n.z == 1) {
+				//load it from the kernel cache if available, else compute it then save it in the cache
+				//key contains everything the kernel depends on (lengths only through ratios), including precision of stored kernels
+				std::string key = DemagKernelCache::Make_Key(
+					"DemagKernelCollection", sizeof(fftReal), kernels[index]->internal_demag, n, N, h / h_max,
+					kernels[index]->shift / h_max, kernels[index]->h_src / h_max, kernels[index]->h_dst / h_max, pbc_images, (int)ASYMPTOTIC_DISTANCE);
 
-						if (IsZ(kernels[index]->shift.x) && IsZ(kernels[index]->shift.y)) {
+				std::vector<std::pair<char*, size_t>> buffers = kernels[index]->Get_Kernel_Buffers();
 
-							//z-shifted kernels for 2D
-							error = Calculate_Demag_Kernels_2D_zShifted(index);
-						}
-						else {
+				if (!DemagKernelCache::Load(key, buffers)) {
 
-							//general 2D kernels (not z-shifted)
-							error = Calculate_Demag_Kernels_2D_Complex_Full(index);
-						}
+					//now compute it
+					if (kernels[index]->internal_demag) {
+
+						//use self versions
+						if (n.z == 1) error = Calculate_Demag_Kernels_2D_Self(index);
+						else error = Calculate_Demag_Kernels_3D_Self(index);
 					}
 					else {
 
-						if (IsZ(kernels[index]->shift.x) && IsZ(kernels[index]->shift.y)) {
+						if (n.z == 1) {
 
-							//z-shifted kernels for 3D
-							error = Calculate_Demag_Kernels_3D_zShifted(index);
+							if (IsZ(kernels[index]->shift.x) && IsZ(kernels[index]->shift.y)) {
+
+								//z-shifted kernels for 2D
+								error = Calculate_Demag_Kernels_2D_zShifted(index);
+							}
+							else {
+
+								//general 2D kernels (not z-shifted)
+								error = Calculate_Demag_Kernels_2D_Complex_Full(index);
+							}
 						}
 						else {
 
-							//general 3D kernels (not z-shifted)
-							error = Calculate_Demag_Kernels_3D_Complex_Full(index);
+							if (IsZ(kernels[index]->shift.x) && IsZ(kernels[index]->shift.y)) {
+
+								//z-shifted kernels for 3D
+								error = Calculate_Demag_Kernels_3D_zShifted(index);
+							}
+							else {
+
+								//general 3D kernels (not z-shifted)
+								error = Calculate_Demag_Kernels_3D_Complex_Full(index);
+							}
 						}
 					}
+
+					if (!error) DemagKernelCache::Save(key, buffers);
 				}
 
 				//set flag to say it's been computed so it could be reused if needed
@@ -331,7 +350,7 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_zShifted(int index)
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//lambda used to transform an input tensor into an output kernel
-	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<DBL3>& kernel, bool off_diagonal) -> void {
+	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<fftReal3>& kernel, bool off_diagonal) -> void {
 
 		//1. FFTs along x
 		for (int j = 0; j < N.y; j++) {
@@ -486,7 +505,7 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_2D_Complex_Full(int index)
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//lambda used to transform an input tensor into an output kernel
-	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<ReIm3>& kernel) -> void {
+	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<fftReIm3>& kernel) -> void {
 
 		//1. FFTs along x
 		for (int j = 0; j < N.y; j++) {
@@ -628,7 +647,7 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Self(int index)
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//lambda used to transform an input tensor into an output kernel
-	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<DBL3>& kernel, bool off_diagonal) -> void {
+	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<fftReal3>& kernel, bool off_diagonal) -> void {
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
@@ -834,7 +853,7 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_zShifted(int index)
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//lambda used to transform an input tensor into an output kernel
-	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<ReIm3>& kernel) -> void {
+	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<fftReIm3>& kernel) -> void {
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
@@ -1010,7 +1029,7 @@ BError DemagKernelCollection::Calculate_Demag_Kernels_3D_Complex_Full(int index)
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//lambda used to transform an input tensor into an output kernel
-	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<ReIm3>& kernel) -> void {
+	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<fftReIm3>& kernel) -> void {
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
@@ -9,18 +9,18 @@
 
 //These compute the self contributions using the real kernels with full use of symmetries
 //These set the output, not add into it, so always call it first -> each kernel collection has exactly one self contribution
-void DemagKernelCollection::KernelMultiplication_2D_Self(VEC<ReIm3>& In, VEC<ReIm3>& Out)
+void DemagKernelCollection::KernelMultiplication_2D_Self(VEC<fftReIm3>& In, VEC<fftReIm3>& Out)
 {
 	//Full multiplication with use of kernel symmetries -> re-arranged for better cache use compared to the line versions
 
-	VEC<DBL3>& Kdiag = kernels[self_contribution_index]->Kdiag_real;
-	std::vector<double>& K2D_odiag = kernels[self_contribution_index]->K2D_odiag;
+	VEC<fftReal3>& Kdiag = kernels[self_contribution_index]->Kdiag_real;
+	std::vector<fftReal>& K2D_odiag = kernels[self_contribution_index]->K2D_odiag;
 
 	//zero-th line
 #pragma omp parallel for
 	for (int i = 0; i < (N.x / 2 + 1); i++) {
 
-		ReIm3 FM = In[i];
+		fftReIm3 FM = In[i];
 
 		Out[i].x = (Kdiag[i].x  * FM.x) + (K2D_odiag[i] * FM.y);
 		Out[i].y = (K2D_odiag[i] * FM.x) + (Kdiag[i].y  * FM.y);
@@ -34,8 +34,8 @@ void DemagKernelCollection::KernelMultiplication_2D_Self(VEC<ReIm3>& In, VEC<ReI
 			int idx_l = i + j * (N.x / 2 + 1);
 			int idx_h = i + (N.y - j) * (N.x / 2 + 1);
 
-			ReIm3 FM_l = In[idx_l];
-			ReIm3 FM_h = In[idx_h];
+			fftReIm3 FM_l = In[idx_l];
+			fftReIm3 FM_h = In[idx_h];
 
 			Out[idx_l].x = (Kdiag[idx_l].x  * FM_l.x) + (K2D_odiag[idx_l] * FM_l.y);
 			Out[idx_l].y = (K2D_odiag[idx_l] * FM_l.x) + (Kdiag[idx_l].y  * FM_l.y);
@@ -53,7 +53,7 @@ void DemagKernelCollection::KernelMultiplication_2D_Self(VEC<ReIm3>& In, VEC<ReI
 
 		int idx = i + (N.y / 2) * (N.x / 2 + 1);
 
-		ReIm3 FM = In[idx];
+		fftReIm3 FM = In[idx];
 
 		Out[idx].x = (Kdiag[idx].x  * FM.x) + (K2D_odiag[idx] * FM.y);
 		Out[idx].y = (K2D_odiag[idx] * FM.x) + (Kdiag[idx].y  * FM.y);
@@ -61,10 +61,10 @@ void DemagKernelCollection::KernelMultiplication_2D_Self(VEC<ReIm3>& In, VEC<ReI
 	}
 }
 
-void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReIm3>& Out)
+void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<fftReIm3>& In, VEC<fftReIm3>& Out)
 {
-	VEC<DBL3>& Kdiag = kernels[self_contribution_index]->Kdiag_real;
-	VEC<DBL3>& Kodiag = kernels[self_contribution_index]->Kodiag_real;
+	VEC<fftReal3>& Kdiag = kernels[self_contribution_index]->Kdiag_real;
+	VEC<fftReal3>& Kodiag = kernels[self_contribution_index]->Kodiag_real;
 
 	//Full multiplication with use of kernel symmetries -> re-arranged for better cache use compared to the line versions
 
@@ -76,7 +76,7 @@ void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReI
 
 			int idx = i + k * (N.x / 2 + 1) * N.y;
 
-			ReIm3 FM = In[idx];
+			fftReIm3 FM = In[idx];
 
 			int ker_index = i + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -92,8 +92,8 @@ void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReI
 				int idx_l = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 				int idx_h = i + (N.y - j) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-				ReIm3 FM_l = In[idx_l];
-				ReIm3 FM_h = In[idx_h];
+				fftReIm3 FM_l = In[idx_l];
+				fftReIm3 FM_h = In[idx_h];
 
 				int ker_index = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -112,7 +112,7 @@ void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReI
 
 			int idx = i + (N.y / 2) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-			ReIm3 FM = In[idx];
+			fftReIm3 FM = In[idx];
 
 			int ker_index = i + (N.y / 2) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -131,7 +131,7 @@ void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReI
 
 			int idx = i + k * (N.x / 2 + 1) * N.y;
 
-			ReIm3 FM = In[idx];
+			fftReIm3 FM = In[idx];
 
 			int ker_index = i + (N.z - k) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -147,8 +147,8 @@ void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReI
 				int idx_l = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 				int idx_h = i + (N.y - j) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-				ReIm3 FM_l = In[idx_l];
-				ReIm3 FM_h = In[idx_h];
+				fftReIm3 FM_l = In[idx_l];
+				fftReIm3 FM_h = In[idx_h];
 
 				int ker_index = i + j * (N.x / 2 + 1) + (N.z - k) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -167,7 +167,7 @@ void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReI
 
 			int idx = i + (N.y / 2) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-			ReIm3 FM = In[idx];
+			fftReIm3 FM = In[idx];
 
 			int ker_index = i + (N.y / 2) * (N.x / 2 + 1) + (N.z - k) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -180,7 +180,7 @@ void DemagKernelCollection::KernelMultiplication_3D_Self(VEC<ReIm3>& In, VEC<ReI
 
 //MULTIPLICATION FOR Z-SHIFTED DEMAG
 
-void DemagKernelCollection::KernelMultiplication_2D_zShifted(VEC<ReIm3>& In, VEC<ReIm3>& Out, VEC<DBL3>& Kdiag, VEC<DBL3>& Kodiag)
+void DemagKernelCollection::KernelMultiplication_2D_zShifted(VEC<fftReIm3>& In, VEC<fftReIm3>& Out, VEC<fftReal3>& Kdiag, VEC<fftReal3>& Kodiag)
 {
 	//Full multiplication with use of kernel symmetries, z-shifted version
 
@@ -188,7 +188,7 @@ void DemagKernelCollection::KernelMultiplication_2D_zShifted(VEC<ReIm3>& In, VEC
 #pragma omp parallel for
 	for (int i = 0; i < (N.x / 2 + 1); i++) {
 
-		ReIm3 FM = In[i];
+		fftReIm3 FM = In[i];
 
 		Out[i].x += (Kdiag[i].x * FM.x) + (Kodiag[i].x * FM.y) + !(Kodiag[i].y * FM.z);
 		Out[i].y += (Kodiag[i].x * FM.x) + (Kdiag[i].y * FM.y) + !(Kodiag[i].z * FM.z);
@@ -202,8 +202,8 @@ void DemagKernelCollection::KernelMultiplication_2D_zShifted(VEC<ReIm3>& In, VEC
 			int idx_l = i + j * (N.x / 2 + 1);
 			int idx_h = i + (N.y - j) * (N.x / 2 + 1);
 
-			ReIm3 FM_l = In[idx_l];
-			ReIm3 FM_h = In[idx_h];
+			fftReIm3 FM_l = In[idx_l];
+			fftReIm3 FM_h = In[idx_h];
 
 			Out[idx_l].x += (Kdiag[idx_l].x * FM_l.x) + (Kodiag[idx_l].x * FM_l.y) + !(Kodiag[idx_l].y * FM_l.z);
 			Out[idx_l].y += (Kodiag[idx_l].x * FM_l.x) + (Kdiag[idx_l].y * FM_l.y) + !(Kodiag[idx_l].z * FM_l.z);
@@ -221,7 +221,7 @@ void DemagKernelCollection::KernelMultiplication_2D_zShifted(VEC<ReIm3>& In, VEC
 
 		int idx = i + (N.y / 2) * (N.x / 2 + 1);
 
-		ReIm3 FM = In[idx];
+		fftReIm3 FM = In[idx];
 
 		Out[idx].x += (Kdiag[idx].x * FM.x) + (Kodiag[idx].x * FM.y) + !(Kodiag[idx].y * FM.z);
 		Out[idx].y += (Kodiag[idx].x * FM.x) + (Kdiag[idx].y * FM.y) + !(Kodiag[idx].z * FM.z);
@@ -230,7 +230,7 @@ void DemagKernelCollection::KernelMultiplication_2D_zShifted(VEC<ReIm3>& In, VEC
 }
 
 //z shifted but with kernel calculated for the other direction shift, so adjust multiplications
-void DemagKernelCollection::KernelMultiplication_2D_inversezShifted(VEC<ReIm3>& In, VEC<ReIm3>& Out, VEC<DBL3>& Kdiag, VEC<DBL3>& Kodiag)
+void DemagKernelCollection::KernelMultiplication_2D_inversezShifted(VEC<fftReIm3>& In, VEC<fftReIm3>& Out, VEC<fftReal3>& Kdiag, VEC<fftReal3>& Kodiag)
 {
 	//Full multiplication with use of kernel symmetries, inverse z-shifted version
 	
@@ -238,7 +238,7 @@ void DemagKernelCollection::KernelMultiplication_2D_inversezShifted(VEC<ReIm3>&
 #pragma omp parallel for
 	for (int i = 0; i < (N.x / 2 + 1); i++) {
 
-		ReIm3 FM = In[i];
+		fftReIm3 FM = In[i];
 
 		Out[i].x += (Kdiag[i].x * FM.x) + (Kodiag[i].x * FM.y) + !(-Kodiag[i].y * FM.z);
 		Out[i].y += (Kodiag[i].x * FM.x) + (Kdiag[i].y * FM.y) + !(-Kodiag[i].z * FM.z);
@@ -252,8 +252,8 @@ void DemagKernelCollection::KernelMultiplication_2D_inversezShifted(VEC<ReIm3>&
 			int idx_l = i + j * (N.x / 2 + 1);
 			int idx_h = i + (N.y - j) * (N.x / 2 + 1);
 
-			ReIm3 FM_l = In[idx_l];
-			ReIm3 FM_h = In[idx_h];
+			fftReIm3 FM_l = In[idx_l];
+			fftReIm3 FM_h = In[idx_h];
 
 			Out[idx_l].x += (Kdiag[idx_l].x * FM_l.x) + (Kodiag[idx_l].x * FM_l.y) + !(-Kodiag[idx_l].y * FM_l.z);
 			Out[idx_l].y += (Kodiag[idx_l].x * FM_l.x) + (Kdiag[idx_l].y * FM_l.y) + !(-Kodiag[idx_l].z * FM_l.z);
@@ -271,7 +271,7 @@ void DemagKernelCollection::KernelMultiplication_2D_inversezShifted(VEC<ReIm3>&
 
 		int idx = i + (N.y / 2) * (N.x / 2 + 1);
 
-		ReIm3 FM = In[idx];
+		fftReIm3 FM = In[idx];
 
 		Out[idx].x += (Kdiag[idx].x * FM.x) + (Kodiag[idx].x * FM.y) + !(-Kodiag[idx].y * FM.z);
 		Out[idx].y += (Kodiag[idx].x * FM.x) + (Kdiag[idx].y * FM.y) + !(-Kodiag[idx].z * FM.z);
@@ -280,7 +280,7 @@ void DemagKernelCollection::KernelMultiplication_2D_inversezShifted(VEC<ReIm3>&
 }
 
 //z shifted for 3D : complex kernels, but use kernel symmetries
-void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC<ReIm3>& Out, VEC<ReIm3>& Kdiag, VEC<ReIm3>& Kodiag)
+void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<fftReIm3>& In, VEC<fftReIm3>& Out, VEC<fftReIm3>& Kdiag, VEC<fftReIm3>& Kodiag)
 {
 	//z shifted for 3D : can use kernels of reduced dimensions but must be complex
 	//
@@ -300,7 +300,7 @@ void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC
 
 			int idx = i + k * (N.x / 2 + 1) * N.y;
 
-			ReIm3 FM = In[idx];
+			fftReIm3 FM = In[idx];
 
 			int ker_index = i + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -317,8 +317,8 @@ void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC
 				int idx_l = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 				int idx_h = i + (N.y - j) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-				ReIm3 FM_l = In[idx_l];
-				ReIm3 FM_h = In[idx_h];
+				fftReIm3 FM_l = In[idx_l];
+				fftReIm3 FM_h = In[idx_h];
 
 				int ker_index = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -340,7 +340,7 @@ void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC
 
 			int idx = i + (N.y / 2) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-			ReIm3 FM = In[idx];
+			fftReIm3 FM = In[idx];
 
 			int ker_index = i + (N.y / 2) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -359,7 +359,7 @@ void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC
 
 			int idx = i + k * (N.x / 2 + 1) * N.y;
 
-			ReIm3 FM = In[idx];
+			fftReIm3 FM = In[idx];
 
 			int ker_index = i + (N.z - k) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -376,8 +376,8 @@ void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC
 				int idx_l = i + j * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 				int idx_h = i + (N.y - j) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-				ReIm3 FM_l = In[idx_l];
-				ReIm3 FM_h = In[idx_h];
+				fftReIm3 FM_l = In[idx_l];
+				fftReIm3 FM_h = In[idx_h];
 
 				int ker_index = i + j * (N.x / 2 + 1) + (N.z - k) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -398,7 +398,7 @@ void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC
 
 			int idx = i + (N.y / 2) * (N.x / 2 + 1) + k * (N.x / 2 + 1) * N.y;
 
-			ReIm3 FM = In[idx];
+			fftReIm3 FM = In[idx];
 
 			int ker_index = i + (N.y / 2) * (N.x / 2 + 1) + (N.z - k) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
@@ -412,7 +412,7 @@ void DemagKernelCollection::KernelMultiplication_3D_zShifted(VEC<ReIm3>& In, VEC
 //MULTIPLE INPUTS
 
 //multiple input spaces version, used when not embedding the kenel multiplication
-void DemagKernelCollection::KernelMultiplication_2D(std::vector<VEC<ReIm3>*>& Incol, VEC<ReIm3>& Out)
+void DemagKernelCollection::KernelMultiplication_2D(std::vector<VEC<fftReIm3>*>& Incol, VEC<fftReIm3>& Out)
 {
 	//first compute the self contribution -> this sets Out
 	KernelMultiplication_2D_Self(*Incol[self_contribution_index], Out);
@@ -440,7 +440,7 @@ void DemagKernelCollection::KernelMultiplication_2D(std::vector<VEC<ReIm3>*>& In
 #pragma omp parallel for
 			for (int index = 0; index < (N.x / 2 + 1)*N.y; index++) {
 
-				ReIm3 FM = (*Incol[mesh_index])[index];
+				fftReIm3 FM = (*Incol[mesh_index])[index];
 
 				Out[index].x += (kernels[mesh_index]->Kdiag_cmpl[index].x * FM.x) + (kernels[mesh_index]->Kodiag_cmpl[index].x * FM.y) + (kernels[mesh_index]->Kodiag_cmpl[index].y * FM.z);
 				Out[index].y += (kernels[mesh_index]->Kodiag_cmpl[index].x * FM.x) + (kernels[mesh_index]->Kdiag_cmpl[index].y * FM.y) + (kernels[mesh_index]->Kodiag_cmpl[index].z * FM.z);
@@ -450,7 +450,7 @@ void DemagKernelCollection::KernelMultiplication_2D(std::vector<VEC<ReIm3>*>& In
 	}
 }
 
-void DemagKernelCollection::KernelMultiplication_3D(std::vector<VEC<ReIm3>*>& Incol, VEC<ReIm3>& Out)
+void DemagKernelCollection::KernelMultiplication_3D(std::vector<VEC<fftReIm3>*>& Incol, VEC<fftReIm3>& Out)
 {
 	//first compute the self contribution -> this sets Out
 	KernelMultiplication_3D_Self(*Incol[self_contribution_index], Out);
@@ -470,7 +470,7 @@ void DemagKernelCollection::KernelMultiplication_3D(std::vector<VEC<ReIm3>*>& In
 #pragma omp parallel for
 			for (int index = 0; index < (N.x / 2 + 1)*N.y*N.z; index++) {
 
-				ReIm3 FM = (*Incol[mesh_index])[index];
+				fftReIm3 FM = (*Incol[mesh_index])[index];
 
 				Out[index].x += (kernels[mesh_index]->Kdiag_cmpl[index].x * FM.x) + (kernels[mesh_index]->Kodiag_cmpl[index].x * FM.y) + (kernels[mesh_index]->Kodiag_cmpl[index].y * FM.z);
 				Out[index].y += (kernels[mesh_index]->Kodiag_cmpl[index].x * FM.x) + (kernels[mesh_index]->Kdiag_cmpl[index].y * FM.y) + (kernels[mesh_index]->Kodiag_cmpl[index].z * FM.z);
@@ -44,6 +44,11 @@ public:
 	BError MakeCUDAModule(void);
 
 	double UpdateField(void);
+
+	//-------------------Local field kernel : Modules_LocalFields.h
+
+	//demagnetizing field at non-empty cell idx in a ferromagnetic mesh, accumulating energy density sum
+	DBL3 LocalField_FM(int idx, double& energy);
 };
 
 #else
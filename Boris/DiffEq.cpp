@@ -11,6 +11,9 @@ DifferentialEquation::DifferentialEquation(Mesh *pMesh) :
 	//store this pointer in the pODE vector and get a unique id so it can be erased later in the destructor
 	odeId.minor = pODE.push_back(this, odeId.major);
 
+	//each solver has its own random number stream for the same seed
+	prng.seed(stoch_seed ? stoch_seed : GetSystemTickCount(), odeId.minor);
+
 	this->pMesh = pMesh;
 }
 
@@ -31,4 +34,193 @@ DifferentialEquation::~DifferentialEquation()
 	}
 	pmeshODECUDA = nullptr;
 #endif
-}
\ No newline at end of file
+}
+//---------------------------------------- MULTI-RATE TIME STEPPING
+
+//save magnetization and effective field at end of time step before atomistic meshes sub-cycle within it (sM1 holds the start of time step values)
+BError DifferentialEquation::MultiRate_Save(void)
+{
+	BError error(CLASS_STR(DifferentialEquation));
+
+	if (!sM_end.resize(pMesh->n) || !sHeff_end.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		sM_end[idx] = pMesh->M[idx];
+		sHeff_end[idx] = pMesh->Heff[idx];
+	}
+
+	return error;
+}
+
+//set magnetization interpolated between start (fraction = 0) and end (fraction = 1) of time step
+void DifferentialEquation::MultiRate_Interpolate(double fraction)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			//interpolate direction and magnitude separately so the magnetization length is not reduced between the end points
+			DBL3 M = sM1[idx] + (sM_end[idx] - sM1[idx]) * fraction;
+			double Mnorm = sM1[idx].norm() + (sM_end[idx].norm() - sM1[idx].norm()) * fraction;
+
+			if (M.norm()) pMesh->M[idx] = M.normalized() * Mnorm;
+		}
+	}
+}
+
+//set back magnetization and effective field at end of time step
+void DifferentialEquation::MultiRate_Restore(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		pMesh->M[idx] = sM_end[idx];
+		pMesh->Heff[idx] = sHeff_end[idx];
+	}
+}
+
+//---------------------------------------- ENSEMBLE RUNS
+
+//size storage for ensemble replicas 1 to ensemble_replicas - 1 : new replicas start from the current magnetization and thermal field, each with its own random number stream
+//all replicas start again if reset is true, or if the mesh dimensions or thermal field storage changed
+BError DifferentialEquation::Ensemble_Allocate(bool reset)
+{
+	BError error(CLASS_STR(DifferentialEquation));
+
+	int replicas = (ensemble_replicas > 1 ? ensemble_replicas - 1 : 0);
+
+	for (int ridx = 0; ridx < (int)ensemble_M.size(); ridx++) {
+
+		if (ensemble_M[ridx].size() != pMesh->M.linear_size() || ensemble_M2[ridx].size() != pMesh->M2.linear_size() ||
+			ensemble_H_Thermal[ridx].size() != H_Thermal.linear_size() || ensemble_Torque_Thermal[ridx].size() != Torque_Thermal.linear_size()) reset = true;
+	}
+
+	if (reset || replicas < (int)ensemble_M.size()) {
+
+		int keep = (reset ? 0 : replicas);
+
+		ensemble_M.resize(keep);
+		ensemble_M2.resize(keep);
+		ensemble_H_Thermal.resize(keep);
+		ensemble_Torque_Thermal.resize(keep);
+		ensemble_prng.erase(ensemble_prng.begin() + keep, ensemble_prng.end());
+
+		if (!replicas) {
+
+			ensemble_M.shrink_to_fit();
+			ensemble_M2.shrink_to_fit();
+			ensemble_H_Thermal.shrink_to_fit();
+			ensemble_Torque_Thermal.shrink_to_fit();
+			ensemble_prng.shrink_to_fit();
+		}
+	}
+
+	unsigned seed = (stoch_seed ? stoch_seed : GetSystemTickCount());
+
+	while ((int)ensemble_M.size() < replicas) {
+
+		ensemble_M.push_back(std::vector<DBL3>());
+		ensemble_M2.push_back(std::vector<DBL3>());
+		ensemble_H_Thermal.push_back(std::vector<DBL3>());
+		ensemble_Torque_Thermal.push_back(std::vector<DBL3>());
+
+		if (!malloc_vector(ensemble_M.back(), pMesh->M.linear_size()) || !malloc_vector(ensemble_M2.back(), pMesh->M2.linear_size()) ||
+			!malloc_vector(ensemble_H_Thermal.back(), H_Thermal.linear_size()) || !malloc_vector(ensemble_Torque_Thermal.back(), Torque_Thermal.linear_size())) {
+
+			ensemble_M.pop_back();
+			ensemble_M2.pop_back();
+			ensemble_H_Thermal.pop_back();
+			ensemble_Torque_Thermal.pop_back();
+
+			return error(BERROR_OUTOFMEMORY_NCRIT);
+		}
+
+		std::vector<DBL3>& M = ensemble_M.back();
+		std::vector<DBL3>& M2 = ensemble_M2.back();
+		std::vector<DBL3>& Hth = ensemble_H_Thermal.back();
+		std::vector<DBL3>& Tth = ensemble_Torque_Thermal.back();
+
+#pragma omp parallel for
+		for (int idx = 0; idx < (int)M.size(); idx++) {
+
+			M[idx] = pMesh->M[idx];
+			if (M2.size()) M2[idx] = pMesh->M2[idx];
+		}
+
+#pragma omp parallel for
+		for (int idx = 0; idx < (int)Hth.size(); idx++) {
+
+			Hth[idx] = H_Thermal[idx];
+			if (Tth.size()) Tth[idx] = Torque_Thermal[idx];
+		}
+
+		//replica r uses stream odeId + r * STOCHSEED_ENSEMBLE_STREAM
+		ensemble_prng.push_back(BorisRandCB(seed, odeId.minor + (unsigned)ensemble_M.size() * STOCHSEED_ENSEMBLE_STREAM));
+	}
+
+	return error;
+}
+
+//seed random number streams of ensemble replicas, starting again from the first generation step
+void DifferentialEquation::Ensemble_Seed(unsigned seed)
+{
+	for (int ridx = 0; ridx < (int)ensemble_prng.size(); ridx++) {
+
+		ensemble_prng[ridx].seed(seed, odeId.minor + (unsigned)(ridx + 1) * STOCHSEED_ENSEMBLE_STREAM);
+	}
+}
+
+//swap replica (1 to ensemble_replicas - 1) with the magnetization, thermal field and random number stream held in the mesh and this solver : calling it again swaps it back
+void DifferentialEquation::Ensemble_Swap(int replica)
+{
+	int ridx = replica - 1;
+	if (ridx < 0 || ridx >= (int)ensemble_M.size()) return;
+
+	std::vector<DBL3>& M = ensemble_M[ridx];
+	std::vector<DBL3>& M2 = ensemble_M2[ridx];
+	std::vector<DBL3>& Hth = ensemble_H_Thermal[ridx];
+	std::vector<DBL3>& Tth = ensemble_Torque_Thermal[ridx];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < (int)M.size(); idx++) {
+
+		std::swap(pMesh->M[idx], M[idx]);
+		if (M2.size()) std::swap(pMesh->M2[idx], M2[idx]);
+	}
+
+#pragma omp parallel for
+	for (int idx = 0; idx < (int)Hth.size(); idx++) {
+
+		std::swap(H_Thermal[idx], Hth[idx]);
+		if (Tth.size()) std::swap(Torque_Thermal[idx], Tth[idx]);
+	}
+
+	std::swap(prng, ensemble_prng[ridx]);
+}
+
+//average magnetization of each ensemble replica, starting with replica 0 (held in the mesh)
+std::vector<DBL3> DifferentialEquation::Get_Ensemble_AverageM(void)
+{
+	std::vector<DBL3> averages(1, pMesh->M.average_nonempty_omp());
+
+	for (int ridx = 0; ridx < (int)ensemble_M.size(); ridx++) {
+
+		std::vector<DBL3>& M = ensemble_M[ridx];
+
+		OmpReduction<DBL3> M_reduction;
+		M_reduction.new_average_reduction();
+
+#pragma omp parallel for
+		for (int idx = 0; idx < (int)M.size(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) M_reduction.reduce_average(M[idx]);
+		}
+
+		averages.push_back(M_reduction.average());
+	}
+
+	return averages;
+}
@@ -49,14 +49,22 @@ protected:
 	//Used to save starting magnetization - all evaluation methods do this, even when not needed by the method itself, so we can calculate dM/dt when needed.
 	VEC<DBL3> sM1;
 
+	//magnetization and effective field at end of time step, saved whilst atomistic meshes sub-cycle within it (multi-rate time stepping)
+	//the effective field is saved since super-mesh modules (e.g. SDemag) also add to it at every atomistic evaluation
+	VEC<DBL3> sM_end, sHeff_end;
+
 	//evalution scratch spaces
 	VEC<DBL3> sEval0, sEval1, sEval2, sEval3, sEval4, sEval5;
 
 	//Thermal field and torques, enabled only for the stochastic equations
 	VEC<DBL3> H_Thermal, Torque_Thermal;
 
-	//random number generator
-	BorisRand prng;
+	//counter-based random number generator for thermal fields : values only depend on seed, cell index and generation step, so they don't depend on number of threads
+	BorisRandCB prng;
+
+	//ensemble replicas 1 to ensemble_replicas - 1 (replica 0 is held in the mesh and this solver) : magnetization (and second sub-lattice in antiferromagnetic meshes), thermal field and torque, and random number stream
+	std::vector<std::vector<DBL3>> ensemble_M, ensemble_M2, ensemble_H_Thermal, ensemble_Torque_Thermal;
+	std::vector<BorisRandCB> ensemble_prng;
 
 	Mesh *pMesh;
 
@@ -74,6 +82,13 @@ protected:
 
 protected:
 
+	//---------------------------------------- LTE REDUCTION
+
+	//local truncation error reduction over cells for adaptive evaluation methods, using the set error norm (lte_norm) : result in lte_reduction.max
+	void new_lte_reduction(void) { if (lte_norm == LTENORM_RMS) lte_reduction.new_average_reduction(); else lte_reduction.new_minmax_reduction(); }
+	void reduce_lte(double value) { if (lte_norm == LTENORM_RMS) lte_reduction.reduce_average(value * value); else lte_reduction.reduce_max(value); }
+	void finish_lte_reduction(void) { if (lte_norm == LTENORM_RMS) lte_reduction.max = sqrt(lte_reduction.average()); else lte_reduction.maximum(); }
+
 	//---------------------------------------- SOLVER METHODS : DiffEq_Evals.cpp
 
 #ifdef ODE_EVAL_COMPILATION_EULER
@@ -98,6 +113,36 @@ protected:
 	virtual void RunAHeun_Step1(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	virtual void RunCayley_Step0_withReductions(void) = 0;
+	virtual void RunCayley_Step0(void) = 0;
+	virtual void RunCayley_Step1_withReductions(void) = 0;
+	virtual void RunCayley_Step1(void) = 0;
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE
+	virtual void RunROS2_Step0_withReductions(void) = 0;
+	virtual void RunROS2_Step0(void) = 0;
+	virtual void RunROS2_Step0_Advance(void) = 0;
+	virtual void RunROS2_Step1_withReductions(void) = 0;
+	virtual void RunROS2_Step1(void) = 0;
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev) evaluation of ODE
+	virtual void RunRKC_Step0_withReductions(void) = 0;
+	virtual void RunRKC_Step0(void) = 0;
+	virtual void RunRKC_Step0_Advance(void) = 0;
+	virtual void RunRKC_Step(void) = 0;
+	virtual void RunRKC_LastStep_withReductions(void) = 0;
+	virtual void RunRKC_LastStep(void) = 0;
+
+	//spectral radius estimate of the set equation linearized in the exchange field (units 1/s), used to set the number of RKC stages
+	virtual double RKC_SpectralRadius(void) = 0;
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	virtual void RunABM_Predictor_withReductions(void) = 0;
@@ -177,11 +222,50 @@ protected:
 	virtual void RunSD_Advance(void) = 0;
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//NCG (nonlinear conjugate gradient) energy minimization : stages are run from the Iterate method, which controls the line search
+	//1. accumulate directional derivative of total energy along search direction at current line search point (in ncg_dE)
+	virtual void RunNCG_Evaluate_withReductions(void) = 0;
+	virtual void RunNCG_Evaluate(void) = 0;
+	//2. accumulate numerator and denominator of Polak-Ribiere beta at the accepted line search point
+	virtual void RunNCG_Beta(void) = 0;
+	//3. set new search direction using ncg_beta, and save magnetization as the start of the next line search (also accumulates directional derivative there in ncg_dE)
+	virtual void RunNCG_Direction(void) = 0;
+	//4. set magnetization at line search step ncg_alpha along search direction
+	virtual void RunNCG_Move(void) = 0;
+#endif
+
 	//---------------------------------------- OTHERS
 
 	//Restore magnetization after a failed step for adaptive time-step methods
 	virtual void Restoremagnetization(void) = 0;
 
+	//---------------------------------------- MULTI-RATE TIME STEPPING : DiffEq.cpp
+
+	//save magnetization at end of time step before atomistic meshes sub-cycle within it (sM1 holds the start of time step values)
+	virtual BError MultiRate_Save(void);
+
+	//set magnetization interpolated between start (fraction = 0) and end (fraction = 1) of time step
+	virtual void MultiRate_Interpolate(double fraction);
+
+	//set back magnetization at end of time step
+	virtual void MultiRate_Restore(void);
+
+	//---------------------------------------- ENSEMBLE RUNS : DiffEq.cpp
+
+	//size storage for ensemble replicas 1 to ensemble_replicas - 1 : new replicas start from the current magnetization and thermal field, each with its own random number stream
+	//all replicas start again if reset is true, or if the mesh dimensions or thermal field storage changed
+	virtual BError Ensemble_Allocate(bool reset);
+
+	//seed random number streams of ensemble replicas, starting again from the first generation step
+	virtual void Ensemble_Seed(unsigned seed);
+
+	//swap replica (1 to ensemble_replicas - 1) with the magnetization, thermal field and random number stream held in the mesh and this solver : calling it again swaps it back
+	virtual void Ensemble_Swap(int replica);
+
+	//average magnetization of each ensemble replica, starting with replica 0 (held in the mesh)
+	std::vector<DBL3> Get_Ensemble_AverageM(void);
+
 	//---------------------------------------- OTHER CALCULATION METHODS
 
 	//called when using stochastic equations
@@ -32,6 +32,139 @@ void DifferentialEquationAFM::Restoremagnetization(void)
 	}
 }
 
+//---------------------------------------- MULTI-RATE TIME STEPPING
+
+//save magnetization and effective field at end of time step before atomistic meshes sub-cycle within it (sM1, sM1_2 hold the start of time step values)
+BError DifferentialEquationAFM::MultiRate_Save(void)
+{
+	BError error(CLASS_STR(DifferentialEquationAFM));
+
+	if (!sM_end_2.resize(pMesh->n) || !sHeff_end_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+
+	error = DifferentialEquation::MultiRate_Save();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		sM_end_2[idx] = pMesh->M2[idx];
+		sHeff_end_2[idx] = pMesh->Heff2[idx];
+	}
+
+	return error;
+}
+
+//set magnetization interpolated between start (fraction = 0) and end (fraction = 1) of time step, on both sub-lattices
+void DifferentialEquationAFM::MultiRate_Interpolate(double fraction)
+{
+	DifferentialEquation::MultiRate_Interpolate(fraction);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M2.is_not_empty(idx)) {
+
+			DBL3 M2 = sM1_2[idx] + (sM_end_2[idx] - sM1_2[idx]) * fraction;
+			double M2norm = sM1_2[idx].norm() + (sM_end_2[idx].norm() - sM1_2[idx].norm()) * fraction;
+
+			if (M2.norm()) pMesh->M2[idx] = M2.normalized() * M2norm;
+		}
+	}
+}
+
+//set back magnetization and effective field at end of time step on both sub-lattices
+void DifferentialEquationAFM::MultiRate_Restore(void)
+{
+	DifferentialEquation::MultiRate_Restore();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		pMesh->M2[idx] = sM_end_2[idx];
+		pMesh->Heff2[idx] = sHeff_end_2[idx];
+	}
+}
+
+//---------------------------------------- ENSEMBLE RUNS
+
+//as for DifferentialEquation, also with sub-lattice B thermal field and torque for each replica
+BError DifferentialEquationAFM::Ensemble_Allocate(bool reset)
+{
+	BError error(CLASS_STR(DifferentialEquationAFM));
+
+	for (int ridx = 0; ridx < (int)ensemble_H_Thermal_2.size(); ridx++) {
+
+		if (ensemble_H_Thermal_2[ridx].size() != H_Thermal_2.linear_size() || ensemble_Torque_Thermal_2[ridx].size() != Torque_Thermal_2.linear_size()) reset = true;
+	}
+
+	if (reset) {
+
+		ensemble_H_Thermal_2.clear();
+		ensemble_Torque_Thermal_2.clear();
+	}
+
+	error = DifferentialEquation::Ensemble_Allocate(reset);
+
+	//same replicas as held by DifferentialEquation (fewer if it ran out of memory)
+	int replicas = ensemble_M.size();
+
+	if (replicas < (int)ensemble_H_Thermal_2.size()) {
+
+		ensemble_H_Thermal_2.resize(replicas);
+		ensemble_Torque_Thermal_2.resize(replicas);
+	}
+
+	if (!replicas) {
+
+		ensemble_H_Thermal_2.shrink_to_fit();
+		ensemble_Torque_Thermal_2.shrink_to_fit();
+	}
+
+	//new replicas start from the current thermal field, as for sub-lattice A
+	while ((int)ensemble_H_Thermal_2.size() < replicas) {
+
+		ensemble_H_Thermal_2.push_back(std::vector<DBL3>());
+		ensemble_Torque_Thermal_2.push_back(std::vector<DBL3>());
+
+		if (!malloc_vector(ensemble_H_Thermal_2.back(), H_Thermal_2.linear_size()) || !malloc_vector(ensemble_Torque_Thermal_2.back(), Torque_Thermal_2.linear_size())) {
+
+			ensemble_H_Thermal_2.pop_back();
+			ensemble_Torque_Thermal_2.pop_back();
+
+			return error(BERROR_OUTOFMEMORY_NCRIT);
+		}
+
+		std::vector<DBL3>& Hth = ensemble_H_Thermal_2.back();
+		std::vector<DBL3>& Tth = ensemble_Torque_Thermal_2.back();
+
+#pragma omp parallel for
+		for (int idx = 0; idx < (int)Hth.size(); idx++) {
+
+			Hth[idx] = H_Thermal_2[idx];
+			if (Tth.size()) Tth[idx] = Torque_Thermal_2[idx];
+		}
+	}
+
+	return error;
+}
+
+void DifferentialEquationAFM::Ensemble_Swap(int replica)
+{
+	DifferentialEquation::Ensemble_Swap(replica);
+
+	int ridx = replica - 1;
+	if (ridx < 0 || ridx >= (int)ensemble_H_Thermal_2.size()) return;
+
+	std::vector<DBL3>& Hth = ensemble_H_Thermal_2[ridx];
+	std::vector<DBL3>& Tth = ensemble_Torque_Thermal_2[ridx];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < (int)Hth.size(); idx++) {
+
+		std::swap(H_Thermal_2[idx], Hth[idx]);
+		if (Tth.size()) std::swap(Torque_Thermal_2[idx], Tth[idx]);
+	}
+}
+
 //---------------------------------------- SET-UP METHODS
 
 BError DifferentialEquationAFM::AllocateMemory(void)
@@ -119,10 +252,29 @@ BError DifferentialEquationAFM::AllocateMemory(void)
 		if (!sEval5_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_CAYLEY:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
+	case EVAL_RKC:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
 	case EVAL_SD:
 		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
+
+	case EVAL_NCG:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval0_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1_2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
 	}
 
 	//For stochastic equations must also allocate memory for thermal VECs
@@ -170,7 +322,10 @@ void DifferentialEquationAFM::CleanupMemory(void)
 		evalMethod != EVAL_RKF &&
 		evalMethod != EVAL_RKCK &&
 		evalMethod != EVAL_RKDP &&
-		evalMethod != EVAL_SD) {
+		evalMethod != EVAL_SD &&
+		evalMethod != EVAL_CAYLEY &&
+		evalMethod != EVAL_RKC &&
+		evalMethod != EVAL_NCG) {
 
 		sEval0.clear();
 		sEval0_2.clear();
@@ -181,7 +336,9 @@ void DifferentialEquationAFM::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF &&
 		evalMethod != EVAL_RKCK &&
-		evalMethod != EVAL_RKDP) {
+		evalMethod != EVAL_RKDP &&
+		evalMethod != EVAL_RKC &&
+		evalMethod != EVAL_NCG) {
 
 		sEval1.clear();
 		sEval1_2.clear();
@@ -27,12 +27,18 @@ private:
 	//Used to save starting magnetization - all evaluation methods do this, even when not needed by the method itself, so we can calculate dM/dt when needed.
 	VEC<DBL3> sM1_2;
 
+	//magnetization and effective field at end of time step, saved whilst atomistic meshes sub-cycle within it (multi-rate time stepping)
+	VEC<DBL3> sM_end_2, sHeff_end_2;
+
 	//evalution scratch spaces
 	VEC<DBL3> sEval0_2, sEval1_2, sEval2_2, sEval3_2, sEval4_2, sEval5_2;
 
 	//Thermal field and torques, enabled only for the stochastic equations
 	VEC<DBL3> H_Thermal_2, Torque_Thermal_2;
 
+	//ensemble replicas 1 to ensemble_replicas - 1 : sub-lattice B thermal field and torque
+	std::vector<std::vector<DBL3>> ensemble_H_Thermal_2, ensemble_Torque_Thermal_2;
+
 	//When calling an equation to evaluate it only the sub-lattice A value is returned.
 	//The additional sub-lattice B value is set here so we can read it
 	std::vector<DBL3> Equation_Eval_2;
@@ -66,6 +72,35 @@ public:
 	void RunAHeun_Step1(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	void RunCayley_Step0_withReductions(void);
+	void RunCayley_Step0(void);
+	void RunCayley_Step1_withReductions(void);
+	void RunCayley_Step1(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE : only implemented for ferromagnetic meshes. These are never called : SuperMesh::Check_ODE_EvalMethod refuses to start a simulation with ROS2 set and this mesh type present, with an error naming the mesh.
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step0_Advance(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev)
+	void RunRKC_Step0_withReductions(void);
+	void RunRKC_Step0(void);
+	void RunRKC_Step0_Advance(void);
+	void RunRKC_Step(void);
+	void RunRKC_LastStep_withReductions(void);
+	void RunRKC_LastStep(void);
+
+	double RKC_SpectralRadius(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	void RunABM_Predictor_withReductions(void);
@@ -145,6 +180,19 @@ public:
 	void RunSD_Advance(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//NCG (nonlinear conjugate gradient) energy minimization : stages are run from the Iterate method, which controls the line search
+	//1. accumulate directional derivative of total energy along search direction at current line search point (in ncg_dE)
+	void RunNCG_Evaluate_withReductions(void);
+	void RunNCG_Evaluate(void);
+	//2. accumulate numerator and denominator of Polak-Ribiere beta at the accepted line search point
+	void RunNCG_Beta(void);
+	//3. set new search direction using ncg_beta, and save magnetization as the start of the next line search (also accumulates directional derivative there in ncg_dE)
+	void RunNCG_Direction(void);
+	//4. set magnetization at line search step ncg_alpha along search direction
+	void RunNCG_Move(void);
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -174,10 +222,33 @@ public:
 	//Stochastic Landau-Lifshitz-Bloch equation with Zhang-Li STT
 	DBL3 SLLBSTT(int idx);
 
+	//---------------------------------------- EQUATION KERNELS : DiffEqAFM_Equations.h
+
+	//inlineable versions of the most used equations, so stage loops can be instantiated for them : the equations above just call these
+	DBL3 LLG_Kernel(int idx);
+	DBL3 LLGStatic_Kernel(int idx);
+	DBL3 LLGSTT_Kernel(int idx);
+
+	//run stage_loop with a callable evaluating the set equation for a cell index : set equation checked once here, not per cell
+	template <typename Stage_Loop>
+	void Dispatch_Equation(Stage_Loop stage_loop);
+
 	//---------------------------------------- OTHERS : DiffEqFM.cpp
 
 	void Restoremagnetization(void);
 
+	//---------------------------------------- MULTI-RATE TIME STEPPING : DiffEqAFM.cpp
+
+	BError MultiRate_Save(void);
+	void MultiRate_Interpolate(double fraction);
+	void MultiRate_Restore(void);
+
+	//---------------------------------------- ENSEMBLE RUNS : DiffEqAFM.cpp
+
+	//as for DifferentialEquation, also with sub-lattice B thermal field and torque for each replica
+	BError Ensemble_Allocate(bool reset);
+	void Ensemble_Swap(int replica);
+
 	//---------------------------------------- OTHER CALCULATION METHODS : DiffEqFM_SEquations.cpp
 
 	//called when using stochastic equations
@@ -243,6 +314,35 @@ public:
 	void RunAHeun_Step1(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	void RunCayley_Step0_withReductions(void) {}
+	void RunCayley_Step0(void) {}
+	void RunCayley_Step1_withReductions(void) {}
+	void RunCayley_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE : mesh type not compiled, never called
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step0_Advance(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev)
+	void RunRKC_Step0_withReductions(void) {}
+	void RunRKC_Step0(void) {}
+	void RunRKC_Step0_Advance(void) {}
+	void RunRKC_Step(void) {}
+	void RunRKC_LastStep_withReductions(void) {}
+	void RunRKC_LastStep(void) {}
+
+	double RKC_SpectralRadius(void) { return 0.0; }
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	void RunABM_Predictor_withReductions(void) {}
@@ -322,6 +422,14 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	void RunNCG_Evaluate_withReductions(void) {}
+	void RunNCG_Evaluate(void) {}
+	void RunNCG_Beta(void) {}
+	void RunNCG_Direction(void) {}
+	void RunNCG_Move(void) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -7,93 +7,26 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqAFM_Equations.h"
+
 //------------------------------------------------------------------------------------------------------
 
 DBL3 DifferentialEquationAFM::LLG(int idx)
 {
-	//gamma = -mu0 * gamma_e = mu0 * g e / 2m_e = 2.212761569e5 m/As
-
-	//LLG in explicit form : dm/dt = [mu0*gamma_e/(1+alpha^2)] * [m*H + alpha * m*(m*H)]
-	
-	DBL2 Ms_AFM = pMesh->Ms_AFM;
-	DBL2 alpha_AFM = pMesh->alpha_AFM;
-	DBL2 grel_AFM = pMesh->grel_AFM;
-	pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->alpha_AFM, alpha_AFM, pMesh->grel_AFM, grel_AFM);
-
-	int tn = omp_get_thread_num();
-
-	//sub-lattice B value so we can read it after
-	Equation_Eval_2[tn] = (-GAMMA * grel_AFM.j / (1 + alpha_AFM.j*alpha_AFM.j)) * ((pMesh->M2[idx] ^ pMesh->Heff2[idx]) + alpha_AFM.j * ((pMesh->M2[idx] / Ms_AFM.j) ^ (pMesh->M2[idx] ^ pMesh->Heff2[idx])));
-
-	//return the sub-lattice A value as normal
-	return (-GAMMA * grel_AFM.i / (1 + alpha_AFM.i*alpha_AFM.i)) * ((pMesh->M[idx] ^ pMesh->Heff[idx]) + alpha_AFM.i * ((pMesh->M[idx] / Ms_AFM.i) ^ (pMesh->M[idx] ^ pMesh->Heff[idx])));
+	return LLG_Kernel(idx);
 }
 
 //Landau-Lifshitz-Gilbert equation but with no precession term and damping set to 1 : faster relaxation for static problems
 DBL3 DifferentialEquationAFM::LLGStatic(int idx)
 {
-	DBL2 Ms_AFM = pMesh->Ms_AFM;
-	pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-
-	int tn = omp_get_thread_num();
-
-	//sub-lattice B value so we can read it after
-	Equation_Eval_2[tn] = (-GAMMA / 2) * ((pMesh->M2[idx] / Ms_AFM.j) ^ (pMesh->M2[idx] ^ pMesh->Heff2[idx]));
-
-	//return the sub-lattice A value as normal
-	return (-GAMMA / 2) * ((pMesh->M[idx] / Ms_AFM.i) ^ (pMesh->M[idx] ^ pMesh->Heff[idx]));
+	return LLGStatic_Kernel(idx);
 }
 
 //------------------------------------------------------------------------------------------------------
 
 DBL3 DifferentialEquationAFM::LLGSTT(int idx)
 {
-	//gmub_2e is -hbar * gamma_e / 2e = g mu_b / 2e)
-
-	// LLG with STT in explicit form : dm/dt = [mu0*gamma_e/(1+alpha^2)] * [m*H + alpha * m*(m*H)] + (1+alpha*beta)/((1+alpha^2)*(1+beta^2)) * (u.del)m - (beta - alpha)/(1+alpha^2) * m * (u.del) m
-	// where u = j * P g mu_b / 2e Ms = -(hbar * gamma_e * P / 2 *e * Ms) * j, j is the current density = conductivity * E (A/m^2)
-
-	// STT is Zhang-Li equationtion (not Thiaville, the velocity used by Thiaville needs to be divided by (1+beta^2) to obtain Zhang-Li, also Thiaville's EPL paper has wrong STT signs!!)
-
-	DBL2 Ms_AFM = pMesh->Ms_AFM;
-	DBL2 alpha_AFM = pMesh->alpha_AFM;
-	DBL2 grel_AFM = pMesh->grel_AFM;
-	double P = pMesh->P;
-	double beta = pMesh->beta;
-	pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->alpha_AFM, alpha_AFM, pMesh->grel_AFM, grel_AFM, pMesh->P, P, pMesh->beta, beta);
-
-	int tn = omp_get_thread_num();
-
-	DBL3 LLGSTT_Eval_A = (-GAMMA * grel_AFM.i / (1 + alpha_AFM.i * alpha_AFM.i)) * ((pMesh->M[idx] ^ pMesh->Heff[idx]) + alpha_AFM.i * ((pMesh->M[idx] / Ms_AFM.i) ^ (pMesh->M[idx] ^ pMesh->Heff[idx])));
-	DBL3 LLGSTT_Eval_B = (-GAMMA * grel_AFM.j / (1 + alpha_AFM.j * alpha_AFM.j)) * ((pMesh->M2[idx] ^ pMesh->Heff2[idx]) + alpha_AFM.j * ((pMesh->M2[idx] / Ms_AFM.j) ^ (pMesh->M2[idx] ^ pMesh->Heff2[idx])));
-
-	if (pMesh->E.linear_size()) {
-
-		DBL33 grad_M_A = pMesh->M.grad_neu(idx);
-		DBL33 grad_M_B = pMesh->M2.grad_neu(idx);
-
-		DBL3 position = pMesh->M.cellidx_to_position(idx);
-
-		DBL3 u_A = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms_AFM.i * (1 + beta * beta));
-		DBL3 u_B = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms_AFM.j * (1 + beta * beta));
-
-		DBL3 u_dot_del_M_A = (u_A.x * grad_M_A.x) + (u_A.y * grad_M_A.y) + (u_A.z * grad_M_A.z);
-		DBL3 u_dot_del_M_B = (u_B.x * grad_M_B.x) + (u_B.y * grad_M_B.y) + (u_B.z * grad_M_B.z);
-
-		LLGSTT_Eval_A +=
-			(((1 + alpha_AFM.i * alpha_AFM.i) * u_dot_del_M_A) -
-			((beta - alpha_AFM.i) * ((pMesh->M[idx] / Ms_AFM.i) ^ u_dot_del_M_A))) / (1 + alpha_AFM.i * alpha_AFM.i);
-
-		LLGSTT_Eval_B +=
-			(((1 + alpha_AFM.j * alpha_AFM.j) * u_dot_del_M_B) -
-			((beta - alpha_AFM.j) * ((pMesh->M2[idx] / Ms_AFM.j) ^ u_dot_del_M_B))) / (1 + alpha_AFM.j * alpha_AFM.j);
-	}
-
-	//sub-lattice B value so we can read it after
-	Equation_Eval_2[tn] = LLGSTT_Eval_B;
-
-	//return the sub-lattice A value as normal
-	return LLGSTT_Eval_A;
+	return LLGSTT_Kernel(idx);
 }
 
 //------------------------------------------------------------------------------------------------------
@@ -8,6 +8,8 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqAFM_Equations.h"
+
 //--------------------------------------------- TRAPEZOIDAL EULER
 
 void DifferentialEquationAFM::RunAHeun_Step0_withReductions(void)
@@ -18,31 +20,34 @@ void DifferentialEquationAFM::RunAHeun_Step0_withReductions(void)
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//obtained average normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+					//obtained average normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
-				pMesh->M2[idx] += rhs_2 * dT;
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+					pMesh->M2[idx] += rhs_2 * dT;
+				}
 			}
 		}
-	}
+	});
 
 	//magnitude of average mxh torque, set in mxh_reduction.max as this will be used to set the mxh value in ODECommon
 	if (pMesh->grel.get0()) {
@@ -59,80 +64,86 @@ void DifferentialEquationAFM::RunAHeun_Step0(void)
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
-				pMesh->M2[idx] += rhs_2 * dT;
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+					pMesh->M2[idx] += rhs_2 * dT;
+				}
 			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationAFM::RunAHeun_Step1_withReductions(void)
 {
 	dmdt_av_reduction.new_average_reduction();
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
 
-			if (!pMesh->M.is_skipcell(idx)) {
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+					DBL3 saveM2 = pMesh->M2[idx];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+					//Now estimate magnetization using the second trapezoidal Euler step equation
+					pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+					pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
-				DBL3 saveM2 = pMesh->M2[idx];
+					if (renormalize) {
 
-				//Now estimate magnetization using the second trapezoidal Euler step equation
-				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
-				pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
 
-				if (renormalize) {
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					reduce_lte(_lte);
+
+					//obtained average dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-
-				//obtained average dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
-	}
+	});
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 
 	if (pMesh->grel.get0()) {
 
@@ -147,50 +158,53 @@ void DifferentialEquationAFM::RunAHeun_Step1_withReductions(void)
 
 void DifferentialEquationAFM::RunAHeun_Step1(void)
 {
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+					DBL3 saveM2 = pMesh->M2[idx];
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
-				DBL3 saveM2 = pMesh->M2[idx];
+					//Now estimate magnetization using the second trapezoidal Euler step equation
+					pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+					pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
 
-				//Now estimate magnetization using the second trapezoidal Euler step equation
-				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
-				pMesh->M2[idx] = (sM1_2[idx] + pMesh->M2[idx] + rhs_2 * dT) / 2;
+					if (renormalize) {
 
-				if (renormalize) {
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					reduce_lte(_lte);
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
-	}
+	});
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 }
 
 #endif
@@ -8,6 +8,8 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqAFM_Equations.h"
+
 //--------------------------------------------- EULER
 
 void DifferentialEquationAFM::RunEuler_withReductions(void)
@@ -19,48 +21,51 @@ void DifferentialEquationAFM::RunEuler_withReductions(void)
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-		if (pMesh->M.is_not_empty(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-			//Save current magnetization
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+					//obtained average normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
-			if (!pMesh->M.is_skipcell(idx)) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
 
-				//obtained average normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+					pMesh->M2[idx] += rhs_2 * dT;
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+					if (renormalize) {
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
-				pMesh->M2[idx] += rhs_2 * dT;
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
 
-				if (renormalize) {
+					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
 					pMesh->M[idx].renormalize(Ms_AFM.i);
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
-
-				dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
 			}
 		}
-	}
+	});
 
 	//magnitude of average mxh torque, set in mxh_reduction.max as this will be used to set the mxh value in ODECommon
 	if (pMesh->grel.get0()) {
@@ -82,26 +87,36 @@ void DifferentialEquationAFM::RunEuler(void)
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization
-			sM1[idx] = pMesh->M[idx];
-			sM1_2[idx] = pMesh->M2[idx];
+				//Save current magnetization
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
-				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
-				pMesh->M2[idx] += rhs_2 * dT;
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
+					pMesh->M2[idx] += rhs_2 * dT;
 
-				if (renormalize) {
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+				}
+				else {
 
 					DBL2 Ms_AFM = pMesh->Ms_AFM;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
@@ -109,15 +124,8 @@ void DifferentialEquationAFM::RunEuler(void)
 					pMesh->M2[idx].renormalize(Ms_AFM.j);
 				}
 			}
-			else {
-
-				DBL2 Ms_AFM = pMesh->Ms_AFM;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
-				pMesh->M[idx].renormalize(Ms_AFM.i);
-				pMesh->M2[idx].renormalize(Ms_AFM.j);
-			}
 		}
-	}
+	});
 }
 
 #endif
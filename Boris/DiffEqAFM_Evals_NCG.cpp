@@ -0,0 +1,191 @@
+#include "stdafx.h"
+#include "DiffEqAFM.h"
+
+#ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_NCG
+
+#include "Mesh_AntiFerromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEq_NCG.h"
+
+//--------------------------------------------- NCG (NONLINEAR CONJUGATE GRADIENT ENERGY MINIMIZATION)
+
+//The energy gradient with respect to M (and M2) in a cell is -MU0 * V * Heff / 2 (and -MU0 * V * Heff2 / 2), with V the cell volume, since the energy density is averaged over the 2 sub-lattices.
+//sM1, sM1_2 : magnetization at start of line search, sEval0, sEval0_2 : search direction, sEval1, sEval1_2 : residual at start of line search (used for Polak-Ribiere beta at the end of the line search)
+
+void DifferentialEquationAFM::RunNCG_Evaluate_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+	if (calculate_dmdt) dmdt_reduction.new_minmax_reduction();
+
+	double grad_scale = MU0 * pMesh->h.dim() / 2;
+
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+
+			DBL3 m = pMesh->M[idx] / Ms_AFM.i;
+			DBL3 H = pMesh->Heff[idx];
+
+			//obtained maximum normalized torque term
+			double _mxh = GetMagnitude(m ^ H) / pMesh->M[idx].norm();
+			mxh_reduction.reduce_max(_mxh);
+
+			if (calculate_dmdt && ncg_alpha > 0.0) {
+
+				//obtained maximum dmdt term (from start of line search)
+				double Mnorm = pMesh->M[idx].norm();
+				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (ncg_alpha * GAMMA * Mnorm * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+			}
+
+			_dE -= grad_scale * NCG_FieldDerivative(pMesh->M[idx], H, sM1[idx], sEval0[idx], ncg_alpha, Ms_AFM.i);
+			_dE -= grad_scale * NCG_FieldDerivative(pMesh->M2[idx], pMesh->Heff2[idx], sM1_2[idx], sEval0_2[idx], ncg_alpha, Ms_AFM.j);
+		}
+	}
+
+	ncg_dE += _dE;
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+		if (calculate_dmdt) dmdt_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+		if (calculate_dmdt) dmdt_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationAFM::RunNCG_Evaluate(void)
+{
+	double grad_scale = MU0 * pMesh->h.dim() / 2;
+
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+
+			_dE -= grad_scale * NCG_FieldDerivative(pMesh->M[idx], pMesh->Heff[idx], sM1[idx], sEval0[idx], ncg_alpha, Ms_AFM.i);
+			_dE -= grad_scale * NCG_FieldDerivative(pMesh->M2[idx], pMesh->Heff2[idx], sM1_2[idx], sEval0_2[idx], ncg_alpha, Ms_AFM.j);
+		}
+	}
+
+	ncg_dE += _dE;
+}
+
+void DifferentialEquationAFM::RunNCG_Beta(void)
+{
+	double grad_scale = MU0 * pMesh->h.dim() / 2;
+
+	double _beta_num = 0.0, _beta_den = 0.0;
+
+#pragma omp parallel for reduction(+:_beta_num, _beta_den)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+
+			DBL3 r = NCG_Residual(pMesh->M[idx], pMesh->Heff[idx], Ms_AFM.i);
+			DBL3 r2 = NCG_Residual(pMesh->M2[idx], pMesh->Heff2[idx], Ms_AFM.j);
+
+			//inner products weighted by the inverse preconditioner (grad_scale / Ms, up to a constant factor)
+			_beta_num += (grad_scale / Ms_AFM.i) * (r * (r - sEval1[idx])) + (grad_scale / Ms_AFM.j) * (r2 * (r2 - sEval1_2[idx]));
+			_beta_den += (grad_scale / Ms_AFM.i) * (sEval1[idx] * sEval1[idx]) + (grad_scale / Ms_AFM.j) * (sEval1_2[idx] * sEval1_2[idx]);
+		}
+	}
+
+	ncg_beta_num += _beta_num;
+	ncg_beta_den += _beta_den;
+}
+
+void DifferentialEquationAFM::RunNCG_Direction(void)
+{
+	double grad_scale = MU0 * pMesh->h.dim() / 2;
+
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			//save current magnetization as the start of the line search
+			sM1[idx] = pMesh->M[idx];
+			sM1_2[idx] = pMesh->M2[idx];
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				DBL2 Ms_AFM = pMesh->Ms_AFM;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+
+				DBL3 r = NCG_Residual(pMesh->M[idx], pMesh->Heff[idx], Ms_AFM.i);
+				DBL3 r2 = NCG_Residual(pMesh->M2[idx], pMesh->Heff2[idx], Ms_AFM.j);
+
+				//previous direction is projected perpendicular to the current magnetization (not needed if restarting with steepest descent, when the previous direction may not be set)
+				DBL3 d = r, d2 = r2;
+
+				if (ncg_beta > 0.0) {
+
+					DBL3 m = pMesh->M[idx].normalized();
+					DBL3 m2 = pMesh->M2[idx].normalized();
+					d += ncg_beta * (sEval0[idx] - (sEval0[idx] * m) * m);
+					d2 += ncg_beta * (sEval0_2[idx] - (sEval0_2[idx] * m2) * m2);
+				}
+
+				sEval0[idx] = d;
+				sEval1[idx] = r;
+				sEval0_2[idx] = d2;
+				sEval1_2[idx] = r2;
+
+				_dE -= grad_scale * (pMesh->Heff[idx] * d + pMesh->Heff2[idx] * d2);
+			}
+		}
+	}
+
+	ncg_dE += _dE;
+}
+
+void DifferentialEquationAFM::RunNCG_Move(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				pMesh->M[idx] = NCG_LinePoint(sM1[idx], sEval0[idx], ncg_alpha, Ms_AFM.i);
+				pMesh->M2[idx] = NCG_LinePoint(sM1_2[idx], sEval0_2[idx], ncg_alpha, Ms_AFM.j);
+			}
+			else {
+
+				pMesh->M[idx].renormalize(Ms_AFM.i);
+				pMesh->M2[idx].renormalize(Ms_AFM.j);
+			}
+		}
+	}
+}
+
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "stdafx.h"
+#include "DiffEqAFM.h"
+
+#ifdef MESH_COMPILATION_ANTIFERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_RKC
+
+#include "Mesh_AntiFerromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEqAFM_Equations.h"
+
+//--------------------------------------------- RUNGE KUTTA CHEBYSHEV (2nd order, damped, number of stages set each time step, with FSAL error estimate)
+
+//Y(0) is held in sM1, F(Y(0)) in sEval0, Y(j-2) in sEval1 and Y(j-1) in M (sub-lattice B : sM1_2, sEval0_2, sEval1_2, M2). Stage coefficients are set in ODECommon_Base::RKC_Set_Stages.
+//Error estimate, calculated at the start of the next time step since it needs F(Y(s)) : 0.8 * (Y(0) - Y(s)) + 0.4 * dT * (F(Y(0)) + F(Y(s)))
+
+void DifferentialEquationAFM::RunRKC_Step0_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+
+					//local truncation error estimate for the previous time step
+					double _lte = GetMagnitude(0.8 * (sM1[idx] - pMesh->M[idx]) + 0.4 * dT * (sEval0[idx] + rhs)) / Mnorm;
+					reduce_lte(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+					sEval0_2[idx] = rhs_2;
+				}
+			}
+		}
+	});
+
+	finish_lte_reduction();
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationAFM::RunRKC_Step0(void)
+{
+	//lte reductions needed for adaptive time step
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+
+					//local truncation error estimate for the previous time step
+					double _lte = GetMagnitude(0.8 * (sM1[idx] - pMesh->M[idx]) + 0.4 * dT * (sEval0[idx] + rhs)) / pMesh->M[idx].norm();
+					reduce_lte(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+					sEval0_2[idx] = rhs_2;
+				}
+			}
+		}
+	});
+
+	finish_lte_reduction();
+}
+
+void DifferentialEquationAFM::RunRKC_Step0_Advance(void)
+{
+	double mus = rkc_mus[1];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sM1_2[idx] = pMesh->M2[idx];
+				sEval1[idx] = pMesh->M[idx];
+				sEval1_2[idx] = pMesh->M2[idx];
+
+				//Now estimate magnetization using RKC first stage
+				pMesh->M[idx] += sEval0[idx] * (dT * mus);
+				pMesh->M2[idx] += sEval0_2[idx] * (dT * mus);
+			}
+		}
+	}
+}
+
+void DifferentialEquationAFM::RunRKC_Step(void)
+{
+	//stage being computed : evalStep is incremented after this
+	int j = evalStep + 1;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = equation_eval(idx);
+				DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+
+				//Now estimate magnetization using RKC stage recurrence
+				DBL3 Mj = mu * pMesh->M[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+				DBL3 Mj_2 = mu * pMesh->M2[idx] + nu * sEval1_2[idx] + (1 - mu - nu) * sM1_2[idx] + (mus * rhs_2 + gms * sEval0_2[idx]) * dT;
+
+				sEval1[idx] = pMesh->M[idx];
+				sEval1_2[idx] = pMesh->M2[idx];
+				pMesh->M[idx] = Mj;
+				pMesh->M2[idx] = Mj_2;
+			}
+		}
+	});
+}
+
+void DifferentialEquationAFM::RunRKC_LastStep_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+
+	int j = rkc_stages;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+
+					//Now calculate magnetization at end of time step using RKC stage recurrence
+					pMesh->M[idx] = mu * pMesh->M[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+					pMesh->M2[idx] = mu * pMesh->M2[idx] + nu * sEval1_2[idx] + (1 - mu - nu) * sM1_2[idx] + (mus * rhs_2 + gms * sEval0_2[idx]) * dT;
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
+				else {
+
+					DBL2 Ms_AFM = pMesh->Ms_AFM;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+					pMesh->M[idx].renormalize(Ms_AFM.i);
+					pMesh->M2[idx].renormalize(Ms_AFM.j);
+				}
+			}
+		}
+	});
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationAFM::RunRKC_LastStep(void)
+{
+	int j = rkc_stages;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+					DBL3 rhs_2 = Equation_Eval_2[omp_get_thread_num()];
+
+					//Now calculate magnetization at end of time step using RKC stage recurrence
+					pMesh->M[idx] = mu * pMesh->M[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+					pMesh->M2[idx] = mu * pMesh->M2[idx] + nu * sEval1_2[idx] + (1 - mu - nu) * sM1_2[idx] + (mus * rhs_2 + gms * sEval0_2[idx]) * dT;
+
+					if (renormalize) {
+
+						DBL2 Ms_AFM = pMesh->Ms_AFM;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+						pMesh->M[idx].renormalize(Ms_AFM.i);
+						pMesh->M2[idx].renormalize(Ms_AFM.j);
+					}
+				}
+				else {
+
+					DBL2 Ms_AFM = pMesh->Ms_AFM;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM);
+					pMesh->M[idx].renormalize(Ms_AFM.i);
+					pMesh->M2[idx].renormalize(Ms_AFM.j);
+				}
+			}
+		}
+	});
+}
+
+//RKC is enabled for LLGStatic : linearized in the exchange field this is (gamma/2) * (2A / (mu0 * Ms)) * delsq on magnetization components perpendicular to M for each sub-lattice,
+//with contributions from the non-homogeneous (Anh) and homogeneous (Ah) inter-lattice exchange terms, the latter not diffusive but usually the stiffest contribution
+double DifferentialEquationAFM::RKC_SpectralRadius(void)
+{
+	if (!pMesh->ExchangeComputation_Enabled()) return 0.0;
+
+	//largest eigenvalue magnitude of the discrete Laplacian, counting only dimensions with more than one cell
+	double delsq_max = 0.0;
+	if (pMesh->n.x > 1) delsq_max += 4 / (pMesh->h.x * pMesh->h.x);
+	if (pMesh->n.y > 1) delsq_max += 4 / (pMesh->h.y * pMesh->h.y);
+	if (pMesh->n.z > 1) delsq_max += 4 / (pMesh->h.z * pMesh->h.z);
+
+	OmpReduction<double> specrad_reduction;
+	specrad_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			DBL2 Ms_AFM = pMesh->Ms_AFM;
+			DBL2 A_AFM = pMesh->A_AFM;
+			DBL2 Ah = pMesh->Ah;
+			DBL2 Anh = pMesh->Anh;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms_AFM, Ms_AFM, pMesh->A_AFM, A_AFM, pMesh->Ah, Ah, pMesh->Anh, Anh);
+
+			double specrad_A = (GAMMA / 2) * ((2 * fabs(A_AFM.i) / Ms_AFM.i + fabs(Anh.i) / Ms_AFM.j) * delsq_max + 4 * fabs(Ah.i) / Ms_AFM.j) / MU0;
+			double specrad_B = (GAMMA / 2) * ((2 * fabs(A_AFM.j) / Ms_AFM.j + fabs(Anh.j) / Ms_AFM.i) * delsq_max + 4 * fabs(Ah.j) / Ms_AFM.i) / MU0;
+
+			specrad_reduction.reduce_max(maximum(specrad_A, specrad_B));
+		}
+	}
+
+	return specrad_reduction.maximum();
+}
+
+#endif
+#endif
\ No newline at end of file
@@ -21,20 +21,22 @@ void DifferentialEquationAFM::GenerateThermalField(void)
 
 	if (IsNZ(grel.i + grel.j)) {
 
-		double Temperature = pMesh->GetBaseTemperature();
+		double base_Temperature = pMesh->GetBaseTemperature();
 
-#pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n_s.dim(); idx++) {
+		prng.advance();
 
-			if (pMesh->Temp.linear_size()) Temperature = pMesh->Temp[H_Thermal.cellidx_to_position(idx)];
+		//do not include any damping here - this will be included in the stochastic equations
+		prng.fill_gauss3(H_Thermal.data(), pMesh->n_s.dim(), 0, [&](int idx) {
 
-			//do not include any damping here - this will be included in the stochastic equations
-			double Hth_const = sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.i * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().i * deltaT));
-			double Hth_const_2 = sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.j * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().j * deltaT));
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
+			return sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.i * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().i * deltaT));
+		});
 
-			H_Thermal[idx] = Hth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-			H_Thermal_2[idx] = Hth_const_2 * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-		}
+		prng.fill_gauss3(H_Thermal_2.data(), pMesh->n_s.dim(), 2, [&](int idx) {
+
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
+			return sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.j * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().j * deltaT));
+		});
 	}
 }
 
@@ -50,31 +52,39 @@ void DifferentialEquationAFM::GenerateThermalField_and_Torque(void)
 
 	if (IsNZ(grel.i + grel.j)) {
 
-		double Temperature = pMesh->GetBaseTemperature();
+		double base_Temperature = pMesh->GetBaseTemperature();
 
-#pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n_s.dim(); idx++) {
+		prng.advance();
 
-			if (pMesh->Temp.linear_size()) Temperature = pMesh->Temp[H_Thermal.cellidx_to_position(idx)];
+		//1. Thermal Field
 
-			//1. Thermal Field
+		//do not include any damping here - this will be included in the stochastic equations
+		prng.fill_gauss3(H_Thermal.data(), pMesh->n_s.dim(), 0, [&](int idx) {
 
-			//do not include any damping here - this will be included in the stochastic equations
-			double Hth_const = sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.i * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().i * deltaT));
-			double Hth_const_2 = sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.j * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().j * deltaT));
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
+			return sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.i * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().i * deltaT));
+		});
 
-			H_Thermal[idx] = Hth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-			H_Thermal_2[idx] = Hth_const_2 * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
+		prng.fill_gauss3(H_Thermal_2.data(), pMesh->n_s.dim(), 2, [&](int idx) {
 
-			//2. Thermal Torque
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
+			return sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel.j * pMesh->h_s.dim() * MU0 * pMesh->Ms_AFM.get0().j * deltaT));
+		});
 
-			//do not include any damping here - this will be included in the stochastic equations
-			double Tth_const = sqrt(2 * BOLTZMANN * Temperature * GAMMA * grel.i * pMesh->Ms_AFM.get0().i / (MU0 * pMesh->h_s.dim() * deltaT));
-			double Tth_const_2 = sqrt(2 * BOLTZMANN * Temperature * GAMMA * grel.j * pMesh->Ms_AFM.get0().j / (MU0 * pMesh->h_s.dim() * deltaT));
+		//2. Thermal Torque
 
-			Torque_Thermal[idx] = Tth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-			Torque_Thermal_2[idx] = Tth_const_2 * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-		}
+		//do not include any damping here - this will be included in the stochastic equations
+		prng.fill_gauss3(Torque_Thermal.data(), pMesh->n_s.dim(), 1, [&](int idx) {
+
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
+			return sqrt(2 * BOLTZMANN * Temperature * GAMMA * grel.i * pMesh->Ms_AFM.get0().i / (MU0 * pMesh->h_s.dim() * deltaT));
+		});
+
+		prng.fill_gauss3(Torque_Thermal_2.data(), pMesh->n_s.dim(), 3, [&](int idx) {
+
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
+			return sqrt(2 * BOLTZMANN * Temperature * GAMMA * grel.j * pMesh->Ms_AFM.get0().j / (MU0 * pMesh->h_s.dim() * deltaT));
+		});
 	}
 }
 
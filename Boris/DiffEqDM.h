@@ -44,6 +44,35 @@ public:
 	void RunAHeun_Step1(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	void RunCayley_Step0_withReductions(void);
+	void RunCayley_Step0(void);
+	void RunCayley_Step1_withReductions(void);
+	void RunCayley_Step1(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE : only implemented for ferromagnetic meshes. These are never called : SuperMesh::Check_ODE_EvalMethod refuses to start a simulation with ROS2 set and this mesh type present, with an error naming the mesh.
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step0_Advance(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev)
+	void RunRKC_Step0_withReductions(void);
+	void RunRKC_Step0(void);
+	void RunRKC_Step0_Advance(void);
+	void RunRKC_Step(void);
+	void RunRKC_LastStep_withReductions(void);
+	void RunRKC_LastStep(void);
+
+	double RKC_SpectralRadius(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	void RunABM_Predictor_withReductions(void);
@@ -123,6 +152,19 @@ public:
 	void RunSD_Advance(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//NCG (nonlinear conjugate gradient) energy minimization : stages are run from the Iterate method, which controls the line search
+	//1. accumulate directional derivative of total energy along search direction at current line search point (in ncg_dE)
+	void RunNCG_Evaluate_withReductions(void);
+	void RunNCG_Evaluate(void);
+	//2. accumulate numerator and denominator of Polak-Ribiere beta at the accepted line search point
+	void RunNCG_Beta(void);
+	//3. set new search direction using ncg_beta, and save magnetization as the start of the next line search (also accumulates directional derivative there in ncg_dE)
+	void RunNCG_Direction(void);
+	//4. set magnetization at line search step ncg_alpha along search direction
+	void RunNCG_Move(void);
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -152,6 +194,15 @@ public:
 	//Stochastic Landau-Lifshitz-Bloch equation with Zhang-Li STT
 	DBL3 SLLBSTT(int idx);
 
+	//---------------------------------------- EQUATION KERNELS : DiffEqDM_Equations.h
+
+	//inlineable versions of the most used equations, so stage loops can be instantiated for them : the equations above just call these
+	DBL3 LLG_Kernel(int idx);
+
+	//run stage_loop with a callable evaluating the set equation for a cell index : set equation checked once here, not per cell
+	template <typename Stage_Loop>
+	void Dispatch_Equation(Stage_Loop stage_loop);
+
 	//---------------------------------------- OTHERS : DiffEqDM.cpp
 
 	void Restoremagnetization(void);
@@ -220,6 +271,35 @@ public:
 	void RunAHeun_Step1(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	void RunCayley_Step0_withReductions(void) {}
+	void RunCayley_Step0(void) {}
+	void RunCayley_Step1_withReductions(void) {}
+	void RunCayley_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE : mesh type not compiled, never called
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step0_Advance(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev)
+	void RunRKC_Step0_withReductions(void) {}
+	void RunRKC_Step0(void) {}
+	void RunRKC_Step0_Advance(void) {}
+	void RunRKC_Step(void) {}
+	void RunRKC_LastStep_withReductions(void) {}
+	void RunRKC_LastStep(void) {}
+
+	double RKC_SpectralRadius(void) { return 0.0; }
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	void RunABM_Predictor_withReductions(void) {}
@@ -299,6 +379,14 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	void RunNCG_Evaluate_withReductions(void) {}
+	void RunNCG_Evaluate(void) {}
+	void RunNCG_Beta(void) {}
+	void RunNCG_Direction(void) {}
+	void RunNCG_Move(void) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
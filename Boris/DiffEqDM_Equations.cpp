@@ -7,14 +7,13 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqDM_Equations.h"
+
 //------------------------------------------------------------------------------------------------------
 
 DBL3 DifferentialEquationDM::LLG(int idx)
 {
-	double susrel = pMesh->susrel;
-	pMesh->update_parameters_mcoarse(idx, pMesh->susrel, susrel);
-
-	return susrel * pMesh->Heff[idx];
+	return LLG_Kernel(idx);
 }
 
 DBL3 DifferentialEquationDM::LLGStatic(int idx)
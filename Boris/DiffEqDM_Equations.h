@@ -0,0 +1,47 @@
+#pragma once
+
+#include "DiffEqDM.h"
+
+#ifdef MESH_COMPILATION_DIAMAGNETIC
+
+//Defines inlineable versions of the most used equations (equation kernels), and the equation dispatch used by the evaluation methods stage loops.
+//Include this in files defining evaluation methods and equations only.
+
+#include "Mesh_Diamagnetic.h"
+#include "MeshParamsControl.h"
+
+//----------------------------------------- EQUATION KERNELS
+
+//------------------------------------------------------------------------------------------------------
+
+//diamagnetic susceptibility relation : all non-stochastic equations reduce to this for a diamagnetic mesh
+inline DBL3 DifferentialEquationDM::LLG_Kernel(int idx)
+{
+	double susrel = pMesh->susrel;
+	pMesh->update_parameters_mcoarse(idx, pMesh->susrel, susrel);
+
+	return susrel * pMesh->Heff[idx];
+}
+
+//----------------------------------------- EQUATION DISPATCH
+
+//Run stage_loop, passing it a callable which evaluates the set equation for a given cell index. The set equation is checked once per call, not per cell :
+//stage loops are instantiated for each equation kernel so the equation can be inlined in them. All other equations are evaluated through the equation function pointer (CALLFP).
+template <typename Stage_Loop>
+void DifferentialEquationDM::Dispatch_Equation(Stage_Loop stage_loop)
+{
+	switch (equation_kernel) {
+
+	case EQKERNEL_LLG:
+	case EQKERNEL_LLGSTATIC:
+	case EQKERNEL_LLGSTT:
+		stage_loop([this](int idx) { return LLG_Kernel(idx); });
+		break;
+
+	default:
+		stage_loop([this](int idx) { return CALLFP(this, equation)(idx); });
+		break;
+	}
+}
+
+#endif
@@ -7,95 +7,115 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqDM_Equations.h"
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 
 //--------------------------------------------- ADAMS-BASHFORTH-MOULTON
 
 void DifferentialEquationDM::RunABM_Predictor_withReductions(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization in case we need to restore it due to evaluations in other meshes
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunABM_Predictor(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization in case we need to restore it due to evaluations in other meshes
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunABM_Corrector_withReductions(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunABM_Corrector(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunABM_TEuler0(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization in case we need to restore it due to evaluations in other meshes
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunABM_TEuler1(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 #endif
@@ -7,66 +7,80 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqDM_Equations.h"
+
 #ifdef ODE_EVAL_COMPILATION_AHEUN
 
 //--------------------------------------------- TRAPEZOIDAL EULER
 
 void DifferentialEquationDM::RunAHeun_Step0_withReductions(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization in case we need to restore it due to evaluations in other meshes
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunAHeun_Step0(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization in case we need to restore it due to evaluations in other meshes
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunAHeun_Step1_withReductions(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunAHeun_Step1(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 #endif
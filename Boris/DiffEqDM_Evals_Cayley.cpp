@@ -0,0 +1,89 @@
+#include "stdafx.h"
+#include "DiffEqDM.h"
+
+#ifdef MESH_COMPILATION_DIAMAGNETIC
+
+#include "Mesh_Diamagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEqDM_Equations.h"
+
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+
+//--------------------------------------------- CAYLEY (ADAPTIVE HEUN WITH CAYLEY TRANSFORM UPDATES)
+
+//Diamagnetic meshes : M is set directly from the susceptibility at every step, as for the other evaluation methods
+
+void DifferentialEquationDM::RunCayley_Step0_withReductions(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+void DifferentialEquationDM::RunCayley_Step0(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+void DifferentialEquationDM::RunCayley_Step1_withReductions(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+void DifferentialEquationDM::RunCayley_Step1(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+#endif
+#endif
\ No newline at end of file
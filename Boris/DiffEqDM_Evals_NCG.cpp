@@ -0,0 +1,60 @@
+#include "stdafx.h"
+#include "DiffEqDM.h"
+
+#ifdef MESH_COMPILATION_DIAMAGNETIC
+
+#include "Mesh_Diamagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEqDM_Equations.h"
+
+#ifdef ODE_EVAL_COMPILATION_NCG
+
+//--------------------------------------------- NCG (NONLINEAR CONJUGATE GRADIENT ENERGY MINIMIZATION)
+
+//Diamagnetic magnetization is set from the effective field at each line search point, so it does not contribute to the search direction or energy derivatives.
+
+void DifferentialEquationDM::RunNCG_Evaluate_withReductions(void)
+{
+}
+
+void DifferentialEquationDM::RunNCG_Evaluate(void)
+{
+}
+
+void DifferentialEquationDM::RunNCG_Beta(void)
+{
+}
+
+void DifferentialEquationDM::RunNCG_Direction(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			//Save current magnetization in case we need to restore it due to a failed line search
+			sM1[idx] = pMesh->M[idx];
+		}
+	}
+}
+
+void DifferentialEquationDM::RunNCG_Move(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+#endif
+#endif
\ No newline at end of file
@@ -7,92 +7,112 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqDM_Equations.h"
+
 #ifdef ODE_EVAL_COMPILATION_RK23
 
 //--------------------------------------------- RUNGE KUTTA 23 (Bogacki-Shampine) (2nd order adaptive step with FSAL, 3rd order evaluation)
 
 void DifferentialEquationDM::RunRK23_Step0_withReductions(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization in case we need to restore it due to evaluations in other meshes
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunRK23_Step0(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization in case we need to restore it due to evaluations in other meshes
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunRK23_Step0_Advance(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunRK23_Step1(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunRK23_Step2_withReductions(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationDM::RunRK23_Step2(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Set M from diamagnetic susceptibility
-			pMesh->M[idx] = CALLFP(this, equation)(idx);
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
 		}
-	}
+	});
 }
 
 #endif
@@ -0,0 +1,125 @@
+#include "stdafx.h"
+#include "DiffEqDM.h"
+
+#ifdef MESH_COMPILATION_DIAMAGNETIC
+
+#include "Mesh_Diamagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEqDM_Equations.h"
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+
+//--------------------------------------------- RUNGE KUTTA CHEBYSHEV (2nd order, damped, number of stages set each time step, with FSAL error estimate)
+
+void DifferentialEquationDM::RunRKC_Step0_withReductions(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+void DifferentialEquationDM::RunRKC_Step0(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization in case we need to restore it due to evaluations in other meshes
+				sM1[idx] = pMesh->M[idx];
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+void DifferentialEquationDM::RunRKC_Step0_Advance(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+void DifferentialEquationDM::RunRKC_Step(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+void DifferentialEquationDM::RunRKC_LastStep_withReductions(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+void DifferentialEquationDM::RunRKC_LastStep(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Set M from diamagnetic susceptibility
+				pMesh->M[idx] = equation_eval(idx);
+			}
+		}
+	});
+}
+
+//no exchange in diamagnetic meshes
+double DifferentialEquationDM::RKC_SpectralRadius(void)
+{
+	return 0.0;
+}
+
+#endif
+#endif
\ No newline at end of file
@@ -87,9 +87,40 @@ BError DifferentialEquationFM::AllocateMemory(void)
 		if (!sEval5.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
 
+	case EVAL_CAYLEY:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
+	case EVAL_RKC:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	case EVAL_ROS2:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval2.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval3.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!ROS2_Set_Shape()) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!ros2_p.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!ros2_s.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!ros2_r.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!ros2_r0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!ros2_v.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!ros2_t.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!malloc_vector(ros2_prec, pMesh->n.dim())) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
+#endif
+
 	case EVAL_SD:
 		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
 		break;
+
+	case EVAL_NCG:
+		if (!sEval0.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		if (!sEval1.resize(pMesh->n)) return error(BERROR_OUTOFMEMORY_CRIT);
+		break;
 	}
 
 	//For stochastic equations must also allocate memory for thermal VECs
@@ -133,7 +164,11 @@ void DifferentialEquationFM::CleanupMemory(void)
 		evalMethod != EVAL_RKF &&
 		evalMethod != EVAL_RKCK &&
 		evalMethod != EVAL_RKDP &&
-		evalMethod != EVAL_SD) {
+		evalMethod != EVAL_SD &&
+		evalMethod != EVAL_CAYLEY &&
+		evalMethod != EVAL_ROS2 &&
+		evalMethod != EVAL_RKC &&
+		evalMethod != EVAL_NCG) {
 
 		sEval0.clear();
 	}
@@ -143,16 +178,45 @@ void DifferentialEquationFM::CleanupMemory(void)
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF &&
 		evalMethod != EVAL_RKCK &&
-		evalMethod != EVAL_RKDP) {
+		evalMethod != EVAL_RKDP &&
+		evalMethod != EVAL_ROS2 &&
+		evalMethod != EVAL_RKC &&
+		evalMethod != EVAL_NCG) {
 
 		sEval1.clear();
 	}
 
+#ifdef ODE_EVAL_COMPILATION_SD
+	if (evalMethod != EVAL_SD) {
+
+		relax_active.clear();
+		relax_mxh.clear();
+		relax_frozen = 0;
+	}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	if (evalMethod != EVAL_ROS2) {
+
+		ros2_ph.clear();
+		ros2_sh.clear();
+		ros2_p.clear();
+		ros2_s.clear();
+		ros2_r.clear();
+		ros2_r0.clear();
+		ros2_v.clear();
+		ros2_t.clear();
+		ros2_prec.clear();
+		ros2_prec.shrink_to_fit();
+	}
+#endif
+
 	if (evalMethod != EVAL_RK4 &&
 		evalMethod != EVAL_RK23 &&
 		evalMethod != EVAL_RKF &&
 		evalMethod != EVAL_RKCK &&
-		evalMethod != EVAL_RKDP) {
+		evalMethod != EVAL_RKDP &&
+		evalMethod != EVAL_ROS2) {
 
 		sEval2.clear();
 	}
@@ -160,9 +224,17 @@ void DifferentialEquationFM::CleanupMemory(void)
 	if (evalMethod != EVAL_RK4 &&
 		evalMethod != EVAL_RKF &&
 		evalMethod != EVAL_RKCK &&
-		evalMethod != EVAL_RKDP) {
+		evalMethod != EVAL_RKDP &&
+		evalMethod != EVAL_ROS2) {
 
 		sEval3.clear();
+	}
+
+	if (evalMethod != EVAL_RK4 &&
+		evalMethod != EVAL_RKF &&
+		evalMethod != EVAL_RKCK &&
+		evalMethod != EVAL_RKDP) {
+
 		sEval4.clear();
 	}
 
@@ -220,6 +292,21 @@ BError DifferentialEquationFM::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 		error = AllocateMemory();
 	}
 
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 linear solver work space takes its shape from M
+	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHSHAPECHANGE) && evalMethod == EVAL_ROS2) {
+
+		if (!error && !ROS2_Set_Shape()) error(BERROR_OUTOFMEMORY_CRIT);
+	}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_SD
+	//SD relaxation activity mask is rebuilt when the SD solver is primed again : all cells active until then
+	relax_active.clear();
+	relax_mxh.clear();
+	relax_frozen = 0;
+#endif
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_ODE_MOVEMESH)) {
 
 		if (!error) {
@@ -292,4 +379,25 @@ DBL3 DifferentialEquationFM::dMdt(int idx)
 	return (pMesh->M[idx] - sM1[idx]) / dT_last;
 }
 
+//SD relaxation activity mask for local field computations : nullptr if all cells must be computed, else only cells with non-zero entries
+//mask only valid once the SD solver is primed for the current stage (RunSD_Start resets it), and for the current mesh dimensions
+const char* DifferentialEquationFM::Get_RelaxMask(void)
+{
+#ifdef ODE_EVAL_COMPILATION_SD
+	return (relax_frozen && evalMethod == EVAL_SD && primed && relax_active.size() == pMesh->n.dim() ? relax_active.data() : nullptr);
+#else
+	return nullptr;
+#endif
+}
+
+//is the SD relaxation activity mask in use for the current stage? (cells may be frozen after the next step, so energy density contributions of active cells must be kept for them)
+bool DifferentialEquationFM::RelaxMask_Enabled(void)
+{
+#ifdef ODE_EVAL_COMPILATION_SD
+	return (evalMethod == EVAL_SD && primed && relax_active.size() == pMesh->n.dim());
+#else
+	return false;
+#endif
+}
+
 #endif
@@ -15,6 +15,29 @@ class DifferentialEquationFM :
 {
 private:
 
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 linear solver work space : ros2_ph and ros2_sh are used as inputs to the exchange operator so need the mesh shape (taken from M when memory is allocated or the mesh shape changes)
+	VEC_VC<DBL3> ros2_ph, ros2_sh;
+	VEC<DBL3> ros2_p, ros2_s, ros2_r, ros2_r0, ros2_v, ros2_t;
+
+	//block Jacobi preconditioner for the ROS2 linear solver : inverse of the approximate 3x3 diagonal block of W in each cell, set when the magnetization is advanced
+	std::vector<DBL33> ros2_prec;
+
+	//linear solver failed to converge in the current time step : time step will be rejected
+	bool ros2_solver_failed = false;
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_SD
+	//SD relaxation activity mask, used if relax_mask_threshold is set : only active cells (1) are updated, frozen cells (0) keep their magnetization
+	std::vector<char> relax_active;
+
+	//normalized torque |mxh| of each cell when it was last updated (frozen cells keep the value they were frozen with) : active cells are those with |mxh| above relax_mask_threshold and their nearest neighbors
+	std::vector<double> relax_mxh;
+
+	//number of frozen cells in relax_active (0 : all cells active)
+	int relax_frozen = 0;
+#endif
+
 public:
 
 	DifferentialEquationFM(FMesh *pMesh);
@@ -44,6 +67,35 @@ public:
 	void RunAHeun_Step1(void);
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	void RunCayley_Step0_withReductions(void);
+	void RunCayley_Step0(void);
+	void RunCayley_Step1_withReductions(void);
+	void RunCayley_Step1(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE, with exchange treated implicitly
+	void RunROS2_Step0_withReductions(void);
+	void RunROS2_Step0(void);
+	void RunROS2_Step0_Advance(void);
+	void RunROS2_Step1_withReductions(void);
+	void RunROS2_Step1(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev)
+	void RunRKC_Step0_withReductions(void);
+	void RunRKC_Step0(void);
+	void RunRKC_Step0_Advance(void);
+	void RunRKC_Step(void);
+	void RunRKC_LastStep_withReductions(void);
+	void RunRKC_LastStep(void);
+
+	double RKC_SpectralRadius(void);
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	void RunABM_Predictor_withReductions(void);
@@ -121,6 +173,22 @@ public:
 	//3. set new magnetization vectors
 	void RunSD_Advance_withReductions(void);
 	void RunSD_Advance(void);
+
+	//set activity mask from relax_mxh after an SD step, with all cells made active every RELAXMASK_SWEEP_ITERS iterations
+	void Update_RelaxMask(void);
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_NCG
+	//NCG (nonlinear conjugate gradient) energy minimization : stages are run from the Iterate method, which controls the line search
+	//1. accumulate directional derivative of total energy along search direction at current line search point (in ncg_dE)
+	void RunNCG_Evaluate_withReductions(void);
+	void RunNCG_Evaluate(void);
+	//2. accumulate numerator and denominator of Polak-Ribiere beta at the accepted line search point
+	void RunNCG_Beta(void);
+	//3. set new search direction using ncg_beta, and save magnetization as the start of the next line search (also accumulates directional derivative there in ncg_dE)
+	void RunNCG_Direction(void);
+	//4. set magnetization at line search step ncg_alpha along search direction
+	void RunNCG_Move(void);
 #endif
 
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
@@ -152,6 +220,42 @@ public:
 	//Stochastic Landau-Lifshitz-Bloch equation with Zhang-Li STT
 	DBL3 SLLBSTT(int idx);
 
+	//---------------------------------------- EQUATION KERNELS : DiffEqFM_Equations.h
+
+	//inlineable versions of the most used equations, so stage loops can be instantiated for them : the equations above just call these
+	DBL3 LLG_Kernel(int idx);
+	DBL3 LLGStatic_Kernel(int idx);
+	DBL3 LLGSTT_Kernel(int idx);
+
+	//run stage_loop with a callable evaluating the set equation for a cell index : set equation checked once here, not per cell
+	template <typename Stage_Loop>
+	void Dispatch_Equation(Stage_Loop stage_loop);
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//---------------------------------------- ROS2 LINEAR SOLVER : DiffEqFM_Evals_ROS2.cpp
+
+	//set ROS2 linear solver work space shape from M (and its periodic boundary conditions) : false if out of memory
+	bool ROS2_Set_Shape(void);
+
+	//WX = (I - ROS2_GAMMA * dT * J) X, where J is the Jacobian of the set equation with respect to the exchange field, with magnetization frozen at the start of the time step (sM1)
+	void ROS2_Apply_W(VEC_VC<DBL3>& X, VEC<DBL3>& WX);
+
+	//set ros2_prec from sM1 and dT : exchange operator diagonal approximated by its bulk value -2 * sum(1/h^2) over dimensions with more than 1 cell
+	void ROS2_Set_Preconditioner(void);
+
+	//Y = P X, with P the block Jacobi preconditioner
+	void ROS2_Apply_Preconditioner(VEC<DBL3>& X, VEC<DBL3>& Y);
+
+	//dot product over non-empty cells
+	double ROS2_Dot(VEC<DBL3>& X, VEC<DBL3>& Y);
+
+	//solve W k = b using right preconditioned BiCGStab (matrix-free), with b in k on entry (initial guess P b); return false if not converged
+	bool ROS2_Solve(VEC<DBL3>& k);
+
+	//solve the error estimate stage (right hand side in sEval1) and set lte for the time step just taken : rejected if any linear solver failed
+	void ROS2_Set_lte(void);
+#endif
+
 	//---------------------------------------- OTHERS : DiffEqFM.cpp
 
 	void Restoremagnetization(void);
@@ -182,6 +286,13 @@ public:
 
 	//return dM by dT - should only be used when evaluation sequence has ended (TimeStepSolved() == true)
 	DBL3 dMdt(int idx);
+
+	//SD relaxation activity mask for local field computations : nullptr if all cells must be computed, else only cells with non-zero entries
+	//mask only valid once the SD solver is primed for the current stage (RunSD_Start resets it), and for the current mesh dimensions
+	const char* Get_RelaxMask(void);
+
+	//is the SD relaxation activity mask in use for the current stage? (cells may be frozen after the next step, so energy density contributions of active cells must be kept for them)
+	bool RelaxMask_Enabled(void);
 };
 
 #else
@@ -220,6 +331,35 @@ public:
 	void RunAHeun_Step1(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+	//Adaptive Heun with Cayley transform updates (norm-preserving)
+	void RunCayley_Step0_withReductions(void) {}
+	void RunCayley_Step0(void) {}
+	void RunCayley_Step1_withReductions(void) {}
+	void RunCayley_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_ROS2
+	//ROS2 (Rosenbrock-W) evaluation of ODE : mesh type not compiled, never called
+	void RunROS2_Step0_withReductions(void) {}
+	void RunROS2_Step0(void) {}
+	void RunROS2_Step0_Advance(void) {}
+	void RunROS2_Step1_withReductions(void) {}
+	void RunROS2_Step1(void) {}
+#endif
+
+#ifdef ODE_EVAL_COMPILATION_RKC
+	//RKC (Runge-Kutta-Chebyshev)
+	void RunRKC_Step0_withReductions(void) {}
+	void RunRKC_Step0(void) {}
+	void RunRKC_Step0_Advance(void) {}
+	void RunRKC_Step(void) {}
+	void RunRKC_LastStep_withReductions(void) {}
+	void RunRKC_LastStep(void) {}
+
+	double RKC_SpectralRadius(void) { return 0.0; }
+#endif
+
 #ifdef ODE_EVAL_COMPILATION_ABM
 	//ABM
 	void RunABM_Predictor_withReductions(void) {}
@@ -299,6 +439,14 @@ public:
 	void RunSD_Advance(void) {}
 #endif
 
+#ifdef ODE_EVAL_COMPILATION_NCG
+	void RunNCG_Evaluate_withReductions(void) {}
+	void RunNCG_Evaluate(void) {}
+	void RunNCG_Beta(void) {}
+	void RunNCG_Direction(void) {}
+	void RunNCG_Move(void) {}
+#endif
+
 	//---------------------------------------- EQUATIONS : DiffEq_Equations.cpp and DiffEq_SEquations.cpp
 
 	//Landau-Lifshitz-Gilbert equation
@@ -7,67 +7,26 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqFM_Equations.h"
+
 //------------------------------------------------------------------------------------------------------
 
 DBL3 DifferentialEquationFM::LLG(int idx)
 {
-	//gamma = -mu0 * gamma_e = mu0 * g e / 2m_e = 2.212761569e5 m/As
-
-	//LLG in explicit form : dm/dt = [mu0*gamma_e/(1+alpha^2)] * [m*H + alpha * m*(m*H)]
-	
-	double Ms = pMesh->Ms;
-	double alpha = pMesh->alpha;
-	double grel = pMesh->grel;
-	pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->alpha, alpha, pMesh->grel, grel);
-
-	return (-GAMMA * grel / (1 + alpha*alpha)) * ((pMesh->M[idx] ^ pMesh->Heff[idx]) + alpha * ((pMesh->M[idx] / Ms) ^ (pMesh->M[idx] ^ pMesh->Heff[idx])));
+	return LLG_Kernel(idx);
 }
 
 //Landau-Lifshitz-Gilbert equation but with no precession term and damping set to 1 : faster relaxation for static problems
 DBL3 DifferentialEquationFM::LLGStatic(int idx)
 {
-	double Ms = pMesh->Ms;
-	pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-
-	return (-GAMMA / 2) * ((pMesh->M[idx] / Ms) ^ (pMesh->M[idx] ^ pMesh->Heff[idx]));
+	return LLGStatic_Kernel(idx);
 }
 
 //------------------------------------------------------------------------------------------------------
 
 DBL3 DifferentialEquationFM::LLGSTT(int idx)
 {
-	//gmub_2e is -hbar * gamma_e / 2e = g mu_b / 2e)
-
-	// LLG with STT in explicit form : dm/dt = [mu0*gamma_e/(1+alpha^2)] * [m*H + alpha * m*(m*H)] + (1+alpha*beta)/((1+alpha^2)*(1+beta^2)) * (u.del)m - (beta - alpha)/(1+alpha^2) * m * (u.del) m
-	// where u = j * P g mu_b / 2e Ms = -(hbar * gamma_e * P / 2 *e * Ms) * j, j is the current density = conductivity * E (A/m^2)
-
-	// STT is Zhang-Li equationtion (not Thiaville, the velocity used by Thiaville needs to be divided by (1+beta^2) to obtain Zhang-Li, also Thiaville's EPL paper has wrong STT signs!!)
-
-	double Ms = pMesh->Ms;
-	double alpha = pMesh->alpha;
-	double grel = pMesh->grel;
-	double P = pMesh->P;
-	double beta = pMesh->beta;
-	pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->alpha, alpha, pMesh->grel, grel, pMesh->P, P, pMesh->beta, beta);
-
-	DBL3 LLGSTT_Eval = (-GAMMA * grel / (1 + alpha*alpha)) * ((pMesh->M[idx] ^ pMesh->Heff[idx]) + alpha * ((pMesh->M[idx] / Ms) ^ (pMesh->M[idx] ^ pMesh->Heff[idx])));
-
-	if (pMesh->E.linear_size()) {
-
-		DBL33 grad_M = pMesh->M.grad_neu(idx);
-
-		DBL3 position = pMesh->M.cellidx_to_position(idx);
-
-		DBL3 u = (pMesh->elC[position] * pMesh->E.weighted_average(position, pMesh->h) * P * GMUB_2E) / (Ms * (1 + beta*beta));
-
-		DBL3 u_dot_del_M = (u.x * grad_M.x) + (u.y * grad_M.y) + (u.z * grad_M.z);
-
-		LLGSTT_Eval +=
-			(((1 + alpha * beta) * u_dot_del_M) -
-			((beta - alpha) * ((pMesh->M[idx] / Ms) ^ u_dot_del_M))) / (1 + alpha * alpha);
-	}
-
-	return LLGSTT_Eval;
+	return LLGSTT_Kernel(idx);
 }
 
 //------------------------------------------------------------------------------------------------------
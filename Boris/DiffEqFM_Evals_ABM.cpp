@@ -8,44 +8,49 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqFM_Equations.h"
+
 //--------------------------------------------- ADAMS-BASHFORTH-MOULTON
 
 void DifferentialEquationFM::RunABM_Predictor_withReductions(void)
 {
 	mxh_reduction.new_minmax_reduction();
 
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//obtained maximum normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
-				mxh_reduction.reduce_max(_mxh);
+					//obtained maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
 
-				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
-				if (alternator) {
+					//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
+					if (alternator) {
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
-					sEval1[idx] = rhs;
-				}
-				else {
+						pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
+						sEval1[idx] = rhs;
+					}
+					else {
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
-					sEval0[idx] = rhs;
+						pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
+						sEval0[idx] = rhs;
+					}
 				}
 			}
 		}
-	}
+	});
 
 	if (pMesh->grel.get0()) {
 
@@ -60,89 +65,95 @@ void DifferentialEquationFM::RunABM_Predictor_withReductions(void)
 
 void DifferentialEquationFM::RunABM_Predictor(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
 
-				//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
-				if (alternator) {
+					//ABM predictor : pk+1 = mk + (dt/2) * (3*fk - fk-1)
+					if (alternator) {
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
-					sEval1[idx] = rhs;
-				}
-				else {
+						pMesh->M[idx] += dT * (3 * rhs - sEval0[idx]) / 2;
+						sEval1[idx] = rhs;
+					}
+					else {
 
-					pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
-					sEval0[idx] = rhs;
+						pMesh->M[idx] += dT * (3 * rhs - sEval1[idx]) / 2;
+						sEval0[idx] = rhs;
+					}
 				}
 			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
 {
 	dmdt_reduction.new_minmax_reduction();
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
 
-				//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
-				if (alternator) {
+					//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
+					if (alternator) {
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
-				}
-				else {
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
+					}
+					else {
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
-				}
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
+					}
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
 
-				if (renormalize) {
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					reduce_lte(_lte);
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
-
-				//obtained maximum dmdt term
-				double Mnorm = pMesh->M[idx].norm();
-				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
-				dmdt_reduction.reduce_max(_dmdt);
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
 			}
 		}
-	}
+	});
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 
 	if (pMesh->grel.get0()) {
 
@@ -157,90 +168,99 @@ void DifferentialEquationFM::RunABM_Corrector_withReductions(void)
 
 void DifferentialEquationFM::RunABM_Corrector(void)
 {
-	lte_reduction.new_minmax_reduction();
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
 
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
 
-				//First save predicted magnetization for lte calculation
-				DBL3 saveM = pMesh->M[idx];
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
 
-				//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
-				if (alternator) {
+					//ABM corrector : mk+1 = mk + (dt/2) * (fk+1 + fk)
+					if (alternator) {
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
-				}
-				else {
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval1[idx]) / 2;
+					}
+					else {
 
-					pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
-				}
+						pMesh->M[idx] = sM1[idx] + dT * (rhs + sEval0[idx]) / 2;
+					}
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
 
-				if (renormalize) {
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					reduce_lte(_lte);
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
 					pMesh->M[idx].renormalize(Ms);
 				}
-
-				//local truncation error (between predicted and corrected)
-				double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
-				lte_reduction.reduce_max(_lte);
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);
 			}
 		}
-	}
+	});
 
-	lte_reduction.maximum();
+	finish_lte_reduction();
 }
 
 void DifferentialEquationFM::RunABM_TEuler0(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization for the next step
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				sEval0[idx] = CALLFP(this, equation)(idx);
+					//First evaluate RHS of set equation at the current time step
+					sEval0[idx] = equation_eval(idx);
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += sEval0[idx] * dT;
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += sEval0[idx] * dT;
+				}
 			}
 		}
-	}
+	});
 }
 
 void DifferentialEquationFM::RunABM_TEuler1(void)
 {
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
 
-			//First evaluate RHS of set equation at the current time step
-			DBL3 rhs = CALLFP(this, equation)(idx);
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = equation_eval(idx);
 
-			//Now estimate magnetization using the second trapezoidal Euler step equation
-			pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+				//Now estimate magnetization using the second trapezoidal Euler step equation
+				pMesh->M[idx] = (sM1[idx] + pMesh->M[idx] + rhs * dT) / 2;
+			}
 		}
-	}
+	});
 }
 
 #endif
@@ -0,0 +1,204 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEqFM_Equations.h"
+#include "DiffEq_Cayley.h"
+
+//--------------------------------------------- CAYLEY (ADAPTIVE HEUN WITH CAYLEY TRANSFORM UPDATES)
+
+//Same steps as AHeun, but the magnetization is advanced by rotations using angular velocities obtained from the equation rhs, rather than by adding rhs * dT to it.
+//Step 0 : predictor using angular velocity at start of time step (saved in sEval0).
+//Step 1 : corrector from start of time step using average of angular velocities at start and at predicted magnetization. lte is the difference between predicted and corrected magnetization.
+
+void DifferentialEquationFM::RunCayley_Step0_withReductions(void)
+{
+	mxh_av_reduction.new_average_reduction();
+
+	//can be used for stochastic equations - generate thermal VECs at the start
+	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
+	else if (H_Thermal.linear_size()) GenerateThermalField();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtained average normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+
+					//First evaluate RHS of set equation at the current time step, and save angular velocity for the next step
+					DBL3 rhs = equation_eval(idx);
+					sEval0[idx] = Cayley_AngularVelocity(pMesh->M[idx], rhs);
+
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] = Cayley_Rotate(pMesh->M[idx], sEval0[idx], dT);
+				}
+			}
+		}
+	});
+
+	//magnitude of average mxh torque, set in mxh_reduction.max as this will be used to set the mxh value in ODECommon
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.max = GetMagnitude(mxh_av_reduction.average());
+	}
+	else mxh_reduction.max = 0.0;
+}
+
+void DifferentialEquationFM::RunCayley_Step0(void)
+{
+	//can be used for stochastic equations - generate thermal VECs at the start
+	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
+	else if (H_Thermal.linear_size()) GenerateThermalField();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization for the next step
+				sM1[idx] = pMesh->M[idx];
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step, and save angular velocity for the next step
+					DBL3 rhs = equation_eval(idx);
+					sEval0[idx] = Cayley_AngularVelocity(pMesh->M[idx], rhs);
+
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] = Cayley_Rotate(pMesh->M[idx], sEval0[idx], dT);
+				}
+			}
+		}
+	});
+}
+
+void DifferentialEquationFM::RunCayley_Step1_withReductions(void)
+{
+	dmdt_av_reduction.new_average_reduction();
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the predicted magnetization
+					DBL3 rhs = equation_eval(idx);
+
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+
+					//Now rotate magnetization from start of time step using the average angular velocity
+					pMesh->M[idx] = Cayley_Rotate(sM1[idx], (sEval0[idx] + Cayley_AngularVelocity(saveM, rhs)) / 2, dT);
+
+					//magnetization length is kept by the rotation : this only has an effect if Ms has changed (e.g. temperature dependence)
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					reduce_lte(_lte);
+
+					//obtained average dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+				}
+				else {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+			}
+		}
+	});
+
+	finish_lte_reduction();
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.max = GetMagnitude(dmdt_av_reduction.average());
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationFM::RunCayley_Step1(void)
+{
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the predicted magnetization
+					DBL3 rhs = equation_eval(idx);
+
+					//First save predicted magnetization for lte calculation
+					DBL3 saveM = pMesh->M[idx];
+
+					//Now rotate magnetization from start of time step using the average angular velocity
+					pMesh->M[idx] = Cayley_Rotate(sM1[idx], (sEval0[idx] + Cayley_AngularVelocity(saveM, rhs)) / 2, dT);
+
+					//magnetization length is kept by the rotation : this only has an effect if Ms has changed (e.g. temperature dependence)
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//local truncation error (between predicted and corrected)
+					double _lte = GetMagnitude(pMesh->M[idx] - saveM) / pMesh->M[idx].norm();
+					reduce_lte(_lte);
+				}
+				else {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+			}
+		}
+	});
+
+	finish_lte_reduction();
+}
+
+#endif
+#endif
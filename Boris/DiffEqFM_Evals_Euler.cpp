@@ -8,6 +8,8 @@
 #include "SuperMesh.h"
 #include "MeshParamsControl.h"
 
+#include "DiffEqFM_Equations.h"
+
 //--------------------------------------------- EULER
 
 void DifferentialEquationFM::RunEuler_withReductions(void)
@@ -19,43 +21,46 @@ void DifferentialEquationFM::RunEuler_withReductions(void)
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				//Save current magnetization
+				sM1[idx] = pMesh->M[idx];
 
-		if (pMesh->M.is_not_empty(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-			//Save current magnetization
-			sM1[idx] = pMesh->M[idx];
+					//obtained average normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
 
-			if (!pMesh->M.is_skipcell(idx)) {
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
 
-				//obtained average normalized torque term
-				double Mnorm = pMesh->M[idx].norm();
-				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+					if (renormalize) {
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
 
-				if (renormalize) {
+					dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-					pMesh->M[idx].renormalize(Ms);
+					pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
 				}
-
-				dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
-			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
 			}
 		}
-	}
+	});
 
 	//magnitude of average mxh torque, set in mxh_reduction.max as this will be used to set the mxh value in ODECommon
 	if (pMesh->grel.get0()) {
@@ -77,37 +82,40 @@ void DifferentialEquationFM::RunEuler(void)
 	if (H_Thermal.linear_size() && Torque_Thermal.linear_size()) GenerateThermalField_and_Torque();
 	else if (H_Thermal.linear_size()) GenerateThermalField();
 
+	Dispatch_Equation([&](auto equation_eval) {
+
 #pragma omp parallel for
-	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+			if (pMesh->M.is_not_empty(idx)) {
 
-			//Save current magnetization
-			sM1[idx] = pMesh->M[idx];
+				//Save current magnetization
+				sM1[idx] = pMesh->M[idx];
 
-			if (!pMesh->M.is_skipcell(idx)) {
+				if (!pMesh->M.is_skipcell(idx)) {
 
-				//First evaluate RHS of set equation at the current time step
-				DBL3 rhs = CALLFP(this, equation)(idx);
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
 
-				//Now estimate magnetization for the next time step
-				pMesh->M[idx] += rhs * dT;
+					//Now estimate magnetization for the next time step
+					pMesh->M[idx] += rhs * dT;
 
-				if (renormalize) {
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+				}
+				else {
 
 					double Ms = pMesh->Ms;
 					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-					pMesh->M[idx].renormalize(Ms);
+					pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
 				}
 			}
-			else {
-
-				double Ms = pMesh->Ms;
-				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
-				pMesh->M[idx].renormalize(Ms);		//re-normalize the skipped cells no matter what - temperature can change
-			}
 		}
-	}
+	});
 }
 
 #endif
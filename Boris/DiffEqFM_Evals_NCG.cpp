@@ -0,0 +1,177 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_NCG
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEq_NCG.h"
+
+//--------------------------------------------- NCG (NONLINEAR CONJUGATE GRADIENT ENERGY MINIMIZATION)
+
+//The energy gradient with respect to M in a cell is -MU0 * V * Heff, with V the cell volume.
+//sM1 : magnetization at start of line search, sEval0 : search direction, sEval1 : residual at start of line search (used for Polak-Ribiere beta at the end of the line search)
+
+void DifferentialEquationFM::RunNCG_Evaluate_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+	if (calculate_dmdt) dmdt_reduction.new_minmax_reduction();
+
+	double grad_scale = MU0 * pMesh->h.dim();
+
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+
+			DBL3 m = pMesh->M[idx] / Ms;
+			DBL3 H = pMesh->Heff[idx];
+
+			//obtained maximum normalized torque term
+			double _mxh = GetMagnitude(m ^ H) / pMesh->M[idx].norm();
+			mxh_reduction.reduce_max(_mxh);
+
+			if (calculate_dmdt && ncg_alpha > 0.0) {
+
+				//obtained maximum dmdt term (from start of line search)
+				double Mnorm = pMesh->M[idx].norm();
+				double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (ncg_alpha * GAMMA * Mnorm * Mnorm);
+				dmdt_reduction.reduce_max(_dmdt);
+			}
+
+			_dE -= grad_scale * NCG_FieldDerivative(pMesh->M[idx], H, sM1[idx], sEval0[idx], ncg_alpha, Ms);
+		}
+	}
+
+	ncg_dE += _dE;
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+		if (calculate_dmdt) dmdt_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+		if (calculate_dmdt) dmdt_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationFM::RunNCG_Evaluate(void)
+{
+	double grad_scale = MU0 * pMesh->h.dim();
+
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+
+			_dE -= grad_scale * NCG_FieldDerivative(pMesh->M[idx], pMesh->Heff[idx], sM1[idx], sEval0[idx], ncg_alpha, Ms);
+		}
+	}
+
+	ncg_dE += _dE;
+}
+
+void DifferentialEquationFM::RunNCG_Beta(void)
+{
+	double grad_scale = MU0 * pMesh->h.dim();
+
+	double _beta_num = 0.0, _beta_den = 0.0;
+
+#pragma omp parallel for reduction(+:_beta_num, _beta_den)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+
+			DBL3 r = NCG_Residual(pMesh->M[idx], pMesh->Heff[idx], Ms);
+
+			//inner products weighted by the inverse preconditioner (grad_scale / Ms, up to a constant factor)
+			_beta_num += (grad_scale / Ms) * (r * (r - sEval1[idx]));
+			_beta_den += (grad_scale / Ms) * (sEval1[idx] * sEval1[idx]);
+		}
+	}
+
+	ncg_beta_num += _beta_num;
+	ncg_beta_den += _beta_den;
+}
+
+void DifferentialEquationFM::RunNCG_Direction(void)
+{
+	double grad_scale = MU0 * pMesh->h.dim();
+
+	double _dE = 0.0;
+
+#pragma omp parallel for reduction(+:_dE)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			//save current magnetization as the start of the line search
+			sM1[idx] = pMesh->M[idx];
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+
+				DBL3 r = NCG_Residual(pMesh->M[idx], pMesh->Heff[idx], Ms);
+
+				//previous direction is projected perpendicular to the current magnetization (not needed if restarting with steepest descent, when the previous direction may not be set)
+				DBL3 d = r;
+
+				if (ncg_beta > 0.0) {
+
+					DBL3 m = pMesh->M[idx].normalized();
+					d += ncg_beta * (sEval0[idx] - (sEval0[idx] * m) * m);
+				}
+
+				sEval0[idx] = d;
+				sEval1[idx] = r;
+
+				_dE -= grad_scale * (pMesh->Heff[idx] * d);
+			}
+		}
+	}
+
+	ncg_dE += _dE;
+}
+
+void DifferentialEquationFM::RunNCG_Move(void)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			double Ms = pMesh->Ms;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				pMesh->M[idx] = NCG_LinePoint(sM1[idx], sEval0[idx], ncg_alpha, Ms);
+			}
+			else pMesh->M[idx].renormalize(Ms);
+		}
+	}
+}
+
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_RKC
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEqFM_Equations.h"
+
+//--------------------------------------------- RUNGE KUTTA CHEBYSHEV (2nd order, damped, number of stages set each time step, with FSAL error estimate)
+
+//Y(0) is held in sM1, F(Y(0)) in sEval0, Y(j-2) in sEval1 and Y(j-1) in M. Stage coefficients are set in ODECommon_Base::RKC_Set_Stages.
+//Error estimate, calculated at the start of the next time step since it needs F(Y(s)) : 0.8 * (Y(0) - Y(s)) + 0.4 * dT * (F(Y(0)) + F(Y(s)))
+
+void DifferentialEquationFM::RunRKC_Step0_withReductions(void)
+{
+	mxh_reduction.new_minmax_reduction();
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//obtain maximum normalized torque term
+					double Mnorm = pMesh->M[idx].norm();
+					double _mxh = GetMagnitude(pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm);
+					mxh_reduction.reduce_max(_mxh);
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+
+					//local truncation error estimate for the previous time step
+					double _lte = GetMagnitude(0.8 * (sM1[idx] - pMesh->M[idx]) + 0.4 * dT * (sEval0[idx] + rhs)) / Mnorm;
+					reduce_lte(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+				}
+			}
+		}
+	});
+
+	finish_lte_reduction();
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.maximum();
+	}
+	else {
+
+		mxh_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationFM::RunRKC_Step0(void)
+{
+	//lte reductions needed for adaptive time step
+	new_lte_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+
+					//local truncation error estimate for the previous time step
+					double _lte = GetMagnitude(0.8 * (sM1[idx] - pMesh->M[idx]) + 0.4 * dT * (sEval0[idx] + rhs)) / pMesh->M[idx].norm();
+					reduce_lte(_lte);
+
+					//save evaluation for later use
+					sEval0[idx] = rhs;
+				}
+			}
+		}
+	});
+
+	finish_lte_reduction();
+}
+
+void DifferentialEquationFM::RunRKC_Step0_Advance(void)
+{
+	double mus = rkc_mus[1];
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//Save current magnetization for later use
+				sM1[idx] = pMesh->M[idx];
+				sEval1[idx] = pMesh->M[idx];
+
+				//Now estimate magnetization using RKC first stage
+				pMesh->M[idx] += sEval0[idx] * (dT * mus);
+			}
+		}
+	}
+}
+
+void DifferentialEquationFM::RunRKC_Step(void)
+{
+	//stage being computed : evalStep is incremented after this
+	int j = evalStep + 1;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = equation_eval(idx);
+
+				//Now estimate magnetization using RKC stage recurrence
+				DBL3 Mj = mu * pMesh->M[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+
+				sEval1[idx] = pMesh->M[idx];
+				pMesh->M[idx] = Mj;
+			}
+		}
+	});
+}
+
+void DifferentialEquationFM::RunRKC_LastStep_withReductions(void)
+{
+	dmdt_reduction.new_minmax_reduction();
+
+	int j = rkc_stages;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+
+					//Now calculate magnetization at end of time step using RKC stage recurrence
+					pMesh->M[idx] = mu * pMesh->M[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+
+					//obtained maximum dmdt term
+					double Mnorm = pMesh->M[idx].norm();
+					double _dmdt = GetMagnitude(pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm);
+					dmdt_reduction.reduce_max(_dmdt);
+				}
+				else {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+			}
+		}
+	});
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.maximum();
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationFM::RunRKC_LastStep(void)
+{
+	int j = rkc_stages;
+
+	double mu = rkc_mu[j], nu = rkc_nu[j], mus = rkc_mus[j], gms = rkc_gms[j];
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx)) {
+
+				if (!pMesh->M.is_skipcell(idx)) {
+
+					//First evaluate RHS of set equation at the current time step
+					DBL3 rhs = equation_eval(idx);
+
+					//Now calculate magnetization at end of time step using RKC stage recurrence
+					pMesh->M[idx] = mu * pMesh->M[idx] + nu * sEval1[idx] + (1 - mu - nu) * sM1[idx] + (mus * rhs + gms * sEval0[idx]) * dT;
+
+					if (renormalize) {
+
+						double Ms = pMesh->Ms;
+						pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+						pMesh->M[idx].renormalize(Ms);
+					}
+				}
+				else {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+			}
+		}
+	});
+}
+
+//RKC is enabled for LLGStatic : linearized in the exchange field this is (gamma/2) * (2A / (mu0 * Ms)) * delsq on magnetization components perpendicular to M
+double DifferentialEquationFM::RKC_SpectralRadius(void)
+{
+	if (!pMesh->ExchangeComputation_Enabled()) return 0.0;
+
+	//largest eigenvalue magnitude of the discrete Laplacian, counting only dimensions with more than one cell
+	double delsq_max = 0.0;
+	if (pMesh->n.x > 1) delsq_max += 4 / (pMesh->h.x * pMesh->h.x);
+	if (pMesh->n.y > 1) delsq_max += 4 / (pMesh->h.y * pMesh->h.y);
+	if (pMesh->n.z > 1) delsq_max += 4 / (pMesh->h.z * pMesh->h.z);
+
+	OmpReduction<double> specrad_reduction;
+	specrad_reduction.new_minmax_reduction();
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			double A = pMesh->A;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->A, A);
+
+			specrad_reduction.reduce_max(GAMMA * fabs(A) / (MU0 * Ms));
+		}
+	}
+
+	return specrad_reduction.maximum() * delsq_max;
+}
+
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,473 @@
+#include "stdafx.h"
+#include "DiffEqFM.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+#ifdef ODE_EVAL_COMPILATION_ROS2
+
+#include "Mesh_Ferromagnetic.h"
+#include "SuperMesh.h"
+#include "MeshParamsControl.h"
+
+#include "DiffEqFM_Equations.h"
+
+//--------------------------------------------- ROS2 (ROS2(3)W ROSENBROCK-W, 2nd order adaptive step with FSAL 3rd order error estimate, EXCHANGE TREATED IMPLICITLY)
+
+//W = I - d * dT * J, d = ROS2_GAMMA, with J the Jacobian of the set equation with respect to the exchange field only, magnetization frozen at the start of the time step (sM1).
+//The method is second order for any W so J needn't be exact, but the stiff exchange part is damped (L-stable) so the time step is not limited by exchange for small cellsizes.
+//Storage : sEval0 = F0 = f(M0), sEval1 = F1 = f(M0 + dT * k1 / 2), sEval2 = k1, sEval3 = k2
+//Step0_Advance : W k1 = F0, M = M0 + dT * k1 / 2
+//Step1 : W (k2 - k1) = F1 - k1, M = M0 + dT * k2
+//Step0 (next time step, FSAL) : F2 = f(M), W k3 = F2 - e32 * (k2 - F1) - 2 * (k1 - F0), lte = |dT * (k1 - 2 * k2 + k3) / 6|
+//W linear systems are solved with block Jacobi preconditioned, matrix-free BiCGStab; if the solver fails the time step is rejected.
+
+//Jacobian of the set equation applied to the exchange field Hexch, with magnetization M0 : LLGStatic has no precession term, all other equations use the LLG torque
+inline DBL3 ROS2_Jacobian(int setODE, const DBL3& M0, const DBL3& Hexch, double Ms, double alpha, double grel)
+{
+	DBL3 mxH = M0 ^ Hexch;
+
+	if (setODE == ODE_LLGSTATIC) return (-GAMMA / 2) * ((M0 / Ms) ^ mxH);
+	else return (-GAMMA * grel / (1 + alpha * alpha)) * (mxH + alpha * ((M0 / Ms) ^ mxH));
+}
+
+bool DifferentialEquationFM::ROS2_Set_Shape(void)
+{
+	if (!ros2_ph.resize(pMesh->h, pMesh->meshRect, pMesh->M)) return false;
+	if (!ros2_sh.resize(pMesh->h, pMesh->meshRect, pMesh->M)) return false;
+
+	ros2_ph.set_pbc(pMesh->M.is_pbc_x(), pMesh->M.is_pbc_y(), pMesh->M.is_pbc_z());
+	ros2_sh.set_pbc(pMesh->M.is_pbc_x(), pMesh->M.is_pbc_y(), pMesh->M.is_pbc_z());
+
+	return true;
+}
+
+void DifferentialEquationFM::ROS2_Apply_W(VEC_VC<DBL3>& X, VEC<DBL3>& WX)
+{
+	double gamma_dT = ROS2_GAMMA * dT;
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			double A = pMesh->A;
+			double alpha = pMesh->alpha;
+			double grel = pMesh->grel;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->A, A, pMesh->alpha, alpha, pMesh->grel, grel);
+
+			//exchange field of X, and the torque it produces with magnetization frozen at the start of the time step
+			DBL3 Hexch = (2 * A / (MU0*Ms*Ms)) * X.delsq_neu(idx);
+
+			WX[idx] = X[idx] - gamma_dT * ROS2_Jacobian(setODE, sM1[idx], Hexch, Ms, alpha, grel);
+		}
+		else WX[idx] = X[idx];
+	}
+}
+
+void DifferentialEquationFM::ROS2_Set_Preconditioner(void)
+{
+	double gamma_dT = ROS2_GAMMA * dT;
+
+	//bulk value of the exchange operator diagonal (delsq X at cell idx has -diag * X[idx] as its local part)
+	DBL3 h = pMesh->h;
+	double diag = 2 * ((pMesh->n.x > 1 ? 1 / (h.x*h.x) : 0) + (pMesh->n.y > 1 ? 1 / (h.y*h.y) : 0) + (pMesh->n.z > 1 ? 1 / (h.z*h.z) : 0));
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			double Ms = pMesh->Ms;
+			double A = pMesh->A;
+			double alpha = pMesh->alpha;
+			double grel = pMesh->grel;
+			pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->A, A, pMesh->alpha, alpha, pMesh->grel, grel);
+
+			double Hdiag = -diag * 2 * A / (MU0*Ms*Ms);
+
+			//columns of the 3x3 diagonal block of W
+			DBL3 c0 = DBL3(1, 0, 0) - gamma_dT * ROS2_Jacobian(setODE, sM1[idx], DBL3(Hdiag, 0, 0), Ms, alpha, grel);
+			DBL3 c1 = DBL3(0, 1, 0) - gamma_dT * ROS2_Jacobian(setODE, sM1[idx], DBL3(0, Hdiag, 0), Ms, alpha, grel);
+			DBL3 c2 = DBL3(0, 0, 1) - gamma_dT * ROS2_Jacobian(setODE, sM1[idx], DBL3(0, 0, Hdiag), Ms, alpha, grel);
+
+			//rows of the inverse are the cross products of pairs of columns, divided by the determinant
+			double det = c0 * (c1 ^ c2);
+
+			if (det != 0.0) ros2_prec[idx] = DBL33(c1 ^ c2, c2 ^ c0, c0 ^ c1) / det;
+			else ros2_prec[idx] = DBL33(DBL3(1, 0, 0), DBL3(0, 1, 0), DBL3(0, 0, 1));
+		}
+		else ros2_prec[idx] = DBL33(DBL3(1, 0, 0), DBL3(0, 1, 0), DBL3(0, 0, 1));
+	}
+}
+
+void DifferentialEquationFM::ROS2_Apply_Preconditioner(VEC<DBL3>& X, VEC<DBL3>& Y)
+{
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		Y[idx] = ros2_prec[idx] * X[idx];
+	}
+}
+
+double DifferentialEquationFM::ROS2_Dot(VEC<DBL3>& X, VEC<DBL3>& Y)
+{
+	double dot = 0.0;
+
+#pragma omp parallel for reduction(+:dot)
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		dot += X[idx] * Y[idx];
+	}
+
+	return dot;
+}
+
+bool DifferentialEquationFM::ROS2_Solve(VEC<DBL3>& k)
+{
+	//without exchange W is the identity so k = b is already the solution
+	if (!pMesh->ExchangeComputation_Enabled()) return true;
+
+	int n = pMesh->n.dim();
+
+	double tol = ROS2_SOLVER_TOL * ROS2_SOLVER_TOL * ROS2_Dot(k, k);
+	if (tol == 0.0) return true;
+
+	//initial guess k = P b, with initial residual r = b - W k
+#pragma omp parallel for
+	for (int idx = 0; idx < n; idx++) {
+
+		ros2_r[idx] = k[idx];
+	}
+
+	ROS2_Apply_Preconditioner(ros2_r, ros2_ph);
+	ROS2_Apply_W(ros2_ph, ros2_v);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < n; idx++) {
+
+		k[idx] = ros2_ph[idx];
+		ros2_r[idx] -= ros2_v[idx];
+		ros2_r0[idx] = ros2_r[idx];
+		ros2_p[idx] = DBL3();
+		ros2_v[idx] = DBL3();
+	}
+
+	if (ROS2_Dot(ros2_r, ros2_r) <= tol) return true;
+
+	double rho_last = 1.0, alpha = 1.0, omega = 1.0;
+
+	for (int iter = 0; iter < ROS2_SOLVER_MAXITERS; iter++) {
+
+		double rho = ROS2_Dot(ros2_r0, ros2_r);
+		if (rho == 0.0) return false;
+
+		double beta = (rho / rho_last) * (alpha / omega);
+
+#pragma omp parallel for
+		for (int idx = 0; idx < n; idx++) {
+
+			ros2_p[idx] = ros2_r[idx] + beta * (ros2_p[idx] - omega * ros2_v[idx]);
+		}
+
+		ROS2_Apply_Preconditioner(ros2_p, ros2_ph);
+		ROS2_Apply_W(ros2_ph, ros2_v);
+
+		double r0v = ROS2_Dot(ros2_r0, ros2_v);
+		if (r0v == 0.0) return false;
+		alpha = rho / r0v;
+
+#pragma omp parallel for
+		for (int idx = 0; idx < n; idx++) {
+
+			ros2_s[idx] = ros2_r[idx] - alpha * ros2_v[idx];
+		}
+
+		if (ROS2_Dot(ros2_s, ros2_s) <= tol) {
+
+#pragma omp parallel for
+			for (int idx = 0; idx < n; idx++) {
+
+				k[idx] += alpha * ros2_ph[idx];
+			}
+
+			return true;
+		}
+
+		ROS2_Apply_Preconditioner(ros2_s, ros2_sh);
+		ROS2_Apply_W(ros2_sh, ros2_t);
+
+		double tt = ROS2_Dot(ros2_t, ros2_t);
+		if (tt == 0.0) return false;
+		omega = ROS2_Dot(ros2_t, ros2_s) / tt;
+
+#pragma omp parallel for
+		for (int idx = 0; idx < n; idx++) {
+
+			k[idx] += alpha * ros2_ph[idx] + omega * ros2_sh[idx];
+			ros2_r[idx] = ros2_s[idx] - omega * ros2_t[idx];
+		}
+
+		if (ROS2_Dot(ros2_r, ros2_r) <= tol) return true;
+		if (omega == 0.0) return false;
+
+		rho_last = rho;
+	}
+
+	return false;
+}
+
+void DifferentialEquationFM::ROS2_Set_lte(void)
+{
+	new_lte_reduction();
+
+	//error estimate stage, with right hand side in sEval1 : solved in place. W is the same as for the time step just taken (dT and sM1 not changed yet).
+	if (!ros2_solver_failed) ros2_solver_failed = !ROS2_Solve(sEval1);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+			//local truncation error of the 2nd order solution
+			double _lte = GetMagnitude((sEval2[idx] - 2 * sEval3[idx] + sEval1[idx]) * (dT / 6)) / pMesh->M[idx].norm();
+			reduce_lte(_lte);
+		}
+	}
+
+	finish_lte_reduction();
+
+	//linear solver failed in this time step : force rejection so it's redone with a lower time step
+	if (ros2_solver_failed) lte_reduction.max = maximum(lte_reduction.max, 2 * err_high_fail);
+}
+
+void DifferentialEquationFM::RunROS2_Step0_withReductions(void)
+{
+	mxh_av_reduction.new_average_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//obtained average normalized torque term
+				double Mnorm = pMesh->M[idx].norm();
+				mxh_av_reduction.reduce_average((pMesh->M[idx] ^ pMesh->Heff[idx]) / (Mnorm * Mnorm));
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = equation_eval(idx);
+
+				//right hand side of error estimate stage (only used if primed)
+				sEval1[idx] = rhs - ROS2_E32 * (sEval3[idx] - sEval1[idx]) - 2 * (sEval2[idx] - sEval0[idx]);
+
+				//save evaluation for later use
+				sEval0[idx] = rhs;
+			}
+			else {
+
+				sEval0[idx] = DBL3();
+				sEval1[idx] = DBL3();
+			}
+		}
+	});
+
+	if (primed) ROS2_Set_lte();
+
+	//magnitude of average mxh torque, set in mxh_reduction.max as this will be used to set the mxh value in ODECommon
+	if (pMesh->grel.get0()) {
+
+		//only reduce for mxh if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		mxh_reduction.max = GetMagnitude(mxh_av_reduction.average());
+	}
+	else mxh_reduction.max = 0.0;
+}
+
+void DifferentialEquationFM::RunROS2_Step0(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//First evaluate RHS of set equation at the current time step
+				DBL3 rhs = equation_eval(idx);
+
+				//right hand side of error estimate stage (only used if primed)
+				sEval1[idx] = rhs - ROS2_E32 * (sEval3[idx] - sEval1[idx]) - 2 * (sEval2[idx] - sEval0[idx]);
+
+				//save evaluation for later use
+				sEval0[idx] = rhs;
+			}
+			else {
+
+				sEval0[idx] = DBL3();
+				sEval1[idx] = DBL3();
+			}
+		}
+	});
+
+	if (primed) ROS2_Set_lte();
+}
+
+void DifferentialEquationFM::RunROS2_Step0_Advance(void)
+{
+	ros2_solver_failed = false;
+
+	//work space shape is set when memory is allocated or the mesh shape changes : only periodic boundary conditions (set by demag modules) can change without notice
+	if (ros2_ph.is_pbc_x() != pMesh->M.is_pbc_x() || ros2_ph.is_pbc_y() != pMesh->M.is_pbc_y() || ros2_ph.is_pbc_z() != pMesh->M.is_pbc_z()) {
+
+		ros2_ph.set_pbc(pMesh->M.is_pbc_x(), pMesh->M.is_pbc_y(), pMesh->M.is_pbc_z());
+		ros2_sh.set_pbc(pMesh->M.is_pbc_x(), pMesh->M.is_pbc_y(), pMesh->M.is_pbc_z());
+	}
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		//Save current magnetization for later use
+		if (pMesh->M.is_not_empty(idx)) sM1[idx] = pMesh->M[idx];
+
+		//right hand side of first stage : solved in place
+		sEval2[idx] = sEval0[idx];
+	}
+
+	//first stage, with W set for the new time step
+	if (pMesh->ExchangeComputation_Enabled()) ROS2_Set_Preconditioner();
+	ros2_solver_failed = !ROS2_Solve(sEval2);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		//Now estimate magnetization for the second stage
+		if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) pMesh->M[idx] = sM1[idx] + sEval2[idx] * (dT / 2);
+	}
+}
+
+void DifferentialEquationFM::RunROS2_Step1_withReductions(void)
+{
+	dmdt_av_reduction.new_average_reduction();
+
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//Evaluate RHS of set equation at the mid-step magnetization : right hand side of second stage is F1 - k1, solved in place
+				sEval1[idx] = equation_eval(idx);
+				sEval3[idx] = sEval1[idx] - sEval2[idx];
+			}
+			else {
+
+				sEval1[idx] = DBL3();
+				sEval3[idx] = DBL3();
+			}
+		}
+	});
+
+	//second stage
+	if (!ros2_solver_failed) ros2_solver_failed = !ROS2_Solve(sEval3);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//k2, kept for the error estimate
+				sEval3[idx] += sEval2[idx];
+
+				//Now estimate magnetization using second stage
+				pMesh->M[idx] = sM1[idx] + sEval3[idx] * dT;
+
+				if (renormalize) {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+
+				//obtained average dmdt term
+				double Mnorm = pMesh->M[idx].norm();
+				dmdt_av_reduction.reduce_average((pMesh->M[idx] - sM1[idx]) / (dT * GAMMA * Mnorm * Mnorm));
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+
+	if (pMesh->grel.get0()) {
+
+		//only reduce for dmdt if grel is not zero (if it's zero this means magnetization dynamics are disabled in this mesh)
+		dmdt_reduction.max = GetMagnitude(dmdt_av_reduction.average());
+	}
+	else {
+
+		dmdt_reduction.max = 0.0;
+	}
+}
+
+void DifferentialEquationFM::RunROS2_Step1(void)
+{
+	Dispatch_Equation([&](auto equation_eval) {
+
+#pragma omp parallel for
+		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+			if (pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) {
+
+				//Evaluate RHS of set equation at the mid-step magnetization : right hand side of second stage is F1 - k1, solved in place
+				sEval1[idx] = equation_eval(idx);
+				sEval3[idx] = sEval1[idx] - sEval2[idx];
+			}
+			else {
+
+				sEval1[idx] = DBL3();
+				sEval3[idx] = DBL3();
+			}
+		}
+	});
+
+	//second stage
+	if (!ros2_solver_failed) ros2_solver_failed = !ROS2_Solve(sEval3);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			if (!pMesh->M.is_skipcell(idx)) {
+
+				//k2, kept for the error estimate
+				sEval3[idx] += sEval2[idx];
+
+				//Now estimate magnetization using second stage
+				pMesh->M[idx] = sM1[idx] + sEval3[idx] * dT;
+
+				if (renormalize) {
+
+					double Ms = pMesh->Ms;
+					pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+					pMesh->M[idx].renormalize(Ms);
+				}
+			}
+			else {
+
+				double Ms = pMesh->Ms;
+				pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms);
+				pMesh->M[idx].renormalize(Ms);
+			}
+		}
+	}
+}
+
+#endif
+#endif
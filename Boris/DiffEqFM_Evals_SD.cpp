@@ -17,6 +17,20 @@
 
 void DifferentialEquationFM::RunSD_Start(void)
 {
+	//activity mask starts with all cells active
+	if (relax_mask_threshold > 0.0) {
+
+		relax_active.assign(pMesh->n.dim(), 1);
+		relax_mxh.assign(pMesh->n.dim(), 0.0);
+	}
+	else {
+
+		relax_active.clear();
+		relax_mxh.clear();
+	}
+
+	relax_frozen = 0;
+
 	//set new magnetization vectors
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
@@ -97,7 +111,8 @@ void DifferentialEquationFM::RunSD_BB(void)
 
 		if (pMesh->M.is_not_empty(idx)) {
 
-			if (!pMesh->M.is_skipcell(idx)) {
+			//frozen cells don't change, and their effective field is not fully computed
+			if (!pMesh->M.is_skipcell(idx) && (!relax_frozen || relax_active[idx])) {
 
 				/////////////////////////
 
@@ -159,7 +174,8 @@ void DifferentialEquationFM::RunSD_Advance_withReductions(void)
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//frozen cells keep their magnetization
+		if (pMesh->M.is_not_empty(idx) && (!relax_frozen || relax_active[idx])) {
 
 			if (!pMesh->M.is_skipcell(idx)) {
 
@@ -175,6 +191,8 @@ void DifferentialEquationFM::RunSD_Advance_withReductions(void)
 				double _mxh = GetMagnitude(m ^ H) / pMesh->M[idx].norm();
 				mxh_reduction.reduce_max(_mxh);
 
+				if (relax_mxh.size()) relax_mxh[idx] = _mxh;
+
 				//The updating equation is (see https://doi.org/10.1063/1.4862839):
 
 				//m_next = m - (dT/2) * (m_next + m) x ((gamma/2)m x Heff)
@@ -211,6 +229,8 @@ void DifferentialEquationFM::RunSD_Advance_withReductions(void)
 				pMesh->M[idx].renormalize(Ms);
 			}
 		}
+		//frozen cells : their effective field is not fully computed, so use the torque they were frozen with. All cells are computed on the iterations after full sweeps.
+		else if (relax_frozen && pMesh->M.is_not_empty(idx) && !pMesh->M.is_skipcell(idx)) mxh_reduction.reduce_max(relax_mxh[idx]);
 	}
 
 	if (pMesh->grel.get0()) {
@@ -224,6 +244,8 @@ void DifferentialEquationFM::RunSD_Advance_withReductions(void)
 		mxh_reduction.max = 0.0;
 		if (calculate_dmdt) dmdt_reduction.max = 0.0;
 	}
+
+	if (relax_active.size()) Update_RelaxMask();
 }
 
 void DifferentialEquationFM::RunSD_Advance(void)
@@ -232,7 +254,8 @@ void DifferentialEquationFM::RunSD_Advance(void)
 #pragma omp parallel for
 	for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-		if (pMesh->M.is_not_empty(idx)) {
+		//frozen cells keep their magnetization
+		if (pMesh->M.is_not_empty(idx) && (!relax_frozen || relax_active[idx])) {
 
 			if (!pMesh->M.is_skipcell(idx)) {
 
@@ -256,6 +279,9 @@ void DifferentialEquationFM::RunSD_Advance(void)
 				double s = dT * GAMMA / 4.0;
 
 				DBL3 mxH = m ^ H;
+
+				if (relax_mxh.size()) relax_mxh[idx] = GetMagnitude(mxH) / Ms;
+
 				m = ((1 - s*s*(mxH*mxH)) * m - 2*s*(m ^ mxH)) / (1 + s*s*(mxH*mxH));
 
 				//set new M
@@ -272,6 +298,50 @@ void DifferentialEquationFM::RunSD_Advance(void)
 			}
 		}
 	}
+
+	if (relax_active.size()) Update_RelaxMask();
+}
+
+//set activity mask from relax_mxh after an SD step, with all cells made active every RELAXMASK_SWEEP_ITERS iterations
+//A cell is active if it, or any of its nearest neighbors in this mesh, had normalized torque above relax_mask_threshold : frozen cells next to cells which are still changing are made active again.
+//Changes due to non-local fields, periodic boundary conditions and coupling to other meshes are picked up by the periodic full sweeps.
+void DifferentialEquationFM::Update_RelaxMask(void)
+{
+	if (stageiteration % RELAXMASK_SWEEP_ITERS == 0) {
+
+		std::fill(relax_active.begin(), relax_active.end(), 1);
+		relax_frozen = 0;
+		return;
+	}
+
+	INT3 n = pMesh->n;
+
+	int frozen = 0;
+
+#pragma omp parallel for reduction(+:frozen)
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		if (pMesh->M.is_not_empty(idx)) {
+
+			int i = idx % n.x;
+			int j = (idx / n.x) % n.y;
+			int k = idx / (n.x * n.y);
+
+			auto above = [&](int cell_idx) -> bool { return relax_mxh[cell_idx] >= relax_mask_threshold; };
+
+			bool active =
+				above(idx) ||
+				(i > 0 && above(idx - 1)) || (i < n.x - 1 && above(idx + 1)) ||
+				(j > 0 && above(idx - n.x)) || (j < n.y - 1 && above(idx + n.x)) ||
+				(k > 0 && above(idx - n.x * n.y)) || (k < n.z - 1 && above(idx + n.x * n.y));
+
+			relax_active[idx] = active;
+			if (!active) frozen++;
+		}
+		else relax_active[idx] = 1;
+	}
+
+	relax_frozen = frozen;
 }
 
 #endif
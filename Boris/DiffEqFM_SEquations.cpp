@@ -21,18 +21,17 @@ void DifferentialEquationFM::GenerateThermalField(void)
 
 	if (IsNZ(grel)) {
 
-		double Temperature = pMesh->GetBaseTemperature();
+		double base_Temperature = pMesh->GetBaseTemperature();
 
-#pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n_s.dim(); idx++) {
+		prng.advance();
 
-			if (pMesh->Temp.linear_size()) Temperature = pMesh->Temp[H_Thermal.cellidx_to_position(idx)];
+		prng.fill_gauss3(H_Thermal.data(), pMesh->n_s.dim(), 0, [&](int idx) {
+
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
 
 			//do not include any damping here - this will be included in the stochastic equations
-			double Hth_const = sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel * pMesh->h_s.dim() * MU0 * pMesh->Ms.get0() * deltaT));
-				
-			H_Thermal[idx] = Hth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-		}
+			return sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel * pMesh->h_s.dim() * MU0 * pMesh->Ms.get0() * deltaT));
+		});
 	}
 }
 
@@ -48,27 +47,29 @@ void DifferentialEquationFM::GenerateThermalField_and_Torque(void)
 	
 	if (IsNZ(grel)) {
 
-		double Temperature = pMesh->GetBaseTemperature();
+		double base_Temperature = pMesh->GetBaseTemperature();
+
+		prng.advance();
 
-#pragma omp parallel for
-		for (int idx = 0; idx < pMesh->n_s.dim(); idx++) {
+		//1. Thermal Field
 
-			if (pMesh->Temp.linear_size()) Temperature = pMesh->Temp[H_Thermal.cellidx_to_position(idx)];
+		prng.fill_gauss3(H_Thermal.data(), pMesh->n_s.dim(), 0, [&](int idx) {
 
-			//1. Thermal Field
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
 
 			//do not include any damping here - this will be included in the stochastic equations
-			double Hth_const = sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel * pMesh->h_s.dim() * MU0 * pMesh->Ms.get0() * deltaT));
+			return sqrt(2 * BOLTZMANN * Temperature / (GAMMA * grel * pMesh->h_s.dim() * MU0 * pMesh->Ms.get0() * deltaT));
+		});
 
-			H_Thermal[idx] = Hth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
+		//2. Thermal Torque
 
-			//2. Thermal Torque
+		prng.fill_gauss3(Torque_Thermal.data(), pMesh->n_s.dim(), 1, [&](int idx) {
 
-			//do not include any damping here - this will be included in the stochastic equations
-			double Tth_const = sqrt(2 * BOLTZMANN * Temperature * GAMMA * grel * pMesh->Ms.get0() / (MU0 * pMesh->h_s.dim() * deltaT));
+			double Temperature = (pMesh->Temp.linear_size() ? pMesh->Temp[H_Thermal.cellidx_to_position(idx)] : base_Temperature);
 
-			Torque_Thermal[idx] = Tth_const * DBL3(prng.rand_gauss(0, 1), prng.rand_gauss(0, 1), prng.rand_gauss(0, 1));
-		}
+			//do not include any damping here - this will be included in the stochastic equations
+			return sqrt(2 * BOLTZMANN * Temperature * GAMMA * grel * pMesh->Ms.get0() / (MU0 * pMesh->h_s.dim() * deltaT));
+		});
 	}
 }
 
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "BorisLib.h"
+
+//Cayley transform updates used by the Cayley evaluation method (micromagnetic and atomistic).
+//The magnetization is advanced by a rotation obtained from the angular velocity of the set equation, so its length is kept exactly for any time step.
+//Include this in files defining the Cayley evaluation method only.
+
+//angular velocity w such that w x M is the component of the equation rhs (dM/dt) perpendicular to M
+inline DBL3 Cayley_AngularVelocity(const DBL3& M, const DBL3& rhs)
+{
+	double Mnorm2 = M * M;
+
+	if (Mnorm2 > 0.0) return (M ^ rhs) / Mnorm2;
+	else return DBL3();
+}
+
+//rotate M with angular velocity w over time step dT using the Cayley transform : M -> (I - A)^-1 (I + A) M, with A the cross product matrix of a = w * dT / 2
+//(I - A)^-1 (I + A) = I + 2 (A + A^2) / (1 + a^2), which is exactly orthogonal, and agrees with the exact rotation exp(2A) to second order
+inline DBL3 Cayley_Rotate(const DBL3& M, const DBL3& w, double dT)
+{
+	DBL3 a = w * (dT / 2);
+	DBL3 axM = a ^ M;
+
+	return M + (2.0 / (1.0 + a * a)) * (axM + (a ^ axM));
+}
@@ -16,6 +16,8 @@ int ODECommon::setODE = ODE_LLG;
 
 Equation ODECommon::equation;
 
+int ODECommon::equation_kernel = EQKERNEL_LLG;
+
 //-----------------------------------Evaluation method modifiers
 
 bool ODECommon::renormalize = true;
@@ -48,8 +50,11 @@ ODECommon::ODECommon(bool called_from_derived) :
 			VINFO(dT), VINFO(dTstoch), VINFO(time_stoch), VINFO(link_dTstoch),
 			VINFO(dTspeedup), VINFO(time_speedup), VINFO(link_dTspeedup),
 			VINFO(err_high_fail), VINFO(err_high), VINFO(err_low), VINFO(dT_increase), VINFO(dT_min), VINFO(dT_max),
-			VINFO(use_evaluation_speedup),
-			VINFO(moving_mesh), VINFO(moving_mesh_antisymmetric), VINFO(moving_mesh_threshold), VINFO(moving_mesh_dwshift)
+			VINFO(use_evaluation_speedup), VINFO(evalspeedup_extrapolation),
+			VINFO(moving_mesh), VINFO(moving_mesh_antisymmetric), VINFO(moving_mesh_threshold), VINFO(moving_mesh_dwshift),
+			VINFO(dT_multirate), VINFO(relax_mask_threshold),
+			VINFO(stepctrl_type), VINFO(lte_norm), VINFO(stoch_seed),
+			VINFO(ensemble_replicas)
 		}, {})
 {
 	//when a new ferromagnetic mesh is added this constructor is called with called_from_derived = true
@@ -72,6 +77,11 @@ void ODECommon::RepairObjectState(void)
 
 	//must remake equation: do not set eval method yet. As meshes are loaded later, they'll each make their own settings for the current evaluation method
 	SetODE((ODE_)setODE, (EVAL_)evalMethod, false);
+
+	//step size controllers use the order of the lte estimate, which is not saved but set with the evaluation method
+	err_order = Get_ErrOrder(evalMethod);
+	lte_prev = 0.0;
+	lte_prev2 = 0.0;
 }
 
 //---------------------------------------- SET-UP METHODS
@@ -174,6 +184,12 @@ BError ODECommon::SetODE(ODE_ setODE_, EVAL_ evalMethod_, bool set_eval_method)
 		break;
 	}
 
+	//the most used equations have inlined kernels, otherwise call equation through function pointer
+	if (equation == &DifferentialEquation::LLG) equation_kernel = EQKERNEL_LLG;
+	else if (equation == &DifferentialEquation::LLGStatic) equation_kernel = EQKERNEL_LLGSTATIC;
+	else if (equation == &DifferentialEquation::LLGSTT) equation_kernel = EQKERNEL_LLGSTT;
+	else equation_kernel = EQKERNEL_POINTER;
+
 	if (set_eval_method) {
 
 		error = SetEvaluationMethod(evalMethod_);
@@ -222,4 +238,17 @@ void ODECommon::Set_lte(void)
 
 		if (pODE[idx]->lte_reduction.max > lte) lte = pODE[idx]->lte_reduction.max;
 	}
-}
\ No newline at end of file
+}
+
+//---------------------------------------- GET METHODS
+
+//average magnetization of each ensemble replica in the given mesh, starting with replica 0 (held in the mesh) : empty if the mesh has no ODE solver set
+std::vector<DBL3> ODECommon::Get_Ensemble_AverageM(Mesh* pMesh_)
+{
+	for (int idx = 0; idx < pODE.size(); idx++) {
+
+		if (pODE[idx]->pMesh == pMesh_) return pODE[idx]->Get_Ensemble_AverageM();
+	}
+
+	return {};
+}
@@ -31,8 +31,10 @@ class ODECommon :
 	double, double, double, bool,
 	double, double, bool,
 	double, double, double, double, double, double, 
-	int, 
-	bool, bool, double, double>,
+	int, int, 
+	bool, bool, double, double,
+	double, double,
+	int, int, int, int>,
 	std::tuple<>>,
 	public ODECommon_Base
 {
@@ -59,6 +61,9 @@ protected:
 	//function pointer to equation to solve
 	static Equation equation;
 
+	//equation kernel for set equation (EQKERNEL_ enum) : stage loops in evaluation methods are instantiated for these
+	static int equation_kernel;
+
 	//-----------------------------------Evaluation method modifiers
 
 	//only renormalize M after solving for a time step for some equations. For LLB type equations must not renormalize.
@@ -124,6 +129,9 @@ public:
 	void QueryODE(ODE_ &setODE_, EVAL_ &evalMethod_) { setODE_ = (ODE_)setODE; evalMethod_ = (EVAL_)evalMethod; }
 	void QueryODE(ODE_ &setODE_) { setODE_ = (ODE_)setODE; }
 
+	//average magnetization of each ensemble replica in the given mesh, starting with replica 0 (held in the mesh) : empty if the mesh has no ODE solver set
+	std::vector<DBL3> Get_Ensemble_AverageM(Mesh* pMesh_);
+
 #if COMPILECUDA == 1
 	ODECommonCUDA* Get_pODECUDA(void) { return pODECUDA; }
 #endif
@@ -30,11 +30,13 @@ double ODECommon_Base::dT_last = 0.0;
 
 double ODECommon_Base::dTstoch = 0.0;
 double ODECommon_Base::time_stoch = 0.0;
+int ODECommon_Base::stoch_seed = 0;
 bool ODECommon_Base::link_dTstoch = true;
 
 double ODECommon_Base::dTspeedup = 0.0;
 double ODECommon_Base::time_speedup = 0.0;
 bool ODECommon_Base::link_dTspeedup = true;
+int ODECommon_Base::step_update = -1;
 
 //-----------------------------------Evaluation Method Data
 
@@ -46,6 +48,11 @@ int ODECommon_Base::evalStep = 0;
 
 int ODECommon_Base::use_evaluation_speedup = (int)EVALSPEEDUP_NONE;
 
+int ODECommon_Base::evalspeedup_extrapolation = (int)EVALSPEEDUPEXTRAP_NONE;
+
+double ODECommon_Base::evalspeedup_error = 0.0;
+double ODECommon_Base::evalspeedup_error_time = 0.0;
+
 //-----------------------------------mxh and dmdt
 
 double ODECommon_Base::mxh = 1.0;
@@ -65,6 +72,16 @@ double ODECommon_Base::dT_increase = RKF_DTINCREASE;
 double ODECommon_Base::dT_max = RKF_MAXDT;
 double ODECommon_Base::dT_min = RKF_MINDT;
 
+int ODECommon_Base::stepctrl_type = STEPCTRL_BANDS;
+int ODECommon_Base::lte_norm = LTENORM_MAX;
+int ODECommon_Base::err_order = RKF_ERRORDER;
+
+double ODECommon_Base::lte_prev = 0.0;
+double ODECommon_Base::lte_prev2 = 0.0;
+
+int ODECommon_Base::steps_accepted = 0;
+int ODECommon_Base::steps_rejected = 0;
+
 //-----------------------------------Special values
 
 bool ODECommon_Base::alternator = false;
@@ -73,6 +90,29 @@ bool ODECommon_Base::primed = false;
 
 int ODECommon_Base::sd_reset_consecutive_iters = 0;
 
+int ODECommon_Base::rkc_stages = 0;
+std::vector<double> ODECommon_Base::rkc_mu;
+std::vector<double> ODECommon_Base::rkc_nu;
+std::vector<double> ODECommon_Base::rkc_mus;
+std::vector<double> ODECommon_Base::rkc_gms;
+std::vector<double> ODECommon_Base::rkc_nodes;
+
+double ODECommon_Base::ncg_alpha = 0.0;
+double ODECommon_Base::ncg_dE = 0.0;
+double ODECommon_Base::ncg_beta_num = 0.0;
+double ODECommon_Base::ncg_beta_den = 0.0;
+double ODECommon_Base::ncg_beta = 0.0;
+double ODECommon_Base::ncg_energy = 0.0;
+double ODECommon_Base::ncg_energy0 = 0.0;
+double ODECommon_Base::ncg_dE0 = 0.0;
+double ODECommon_Base::ncg_alpha_lo = 0.0;
+double ODECommon_Base::ncg_alpha_hi = 0.0;
+int ODECommon_Base::ncg_evals = 0;
+
+//-----------------------------------Relaxation activity mask
+
+double ODECommon_Base::relax_mask_threshold = 0.0;
+
 //-----------------------------------Moving mesh data
 
 bool ODECommon_Base::moving_mesh = false;
@@ -80,6 +120,42 @@ bool ODECommon_Base::moving_mesh_antisymmetric = true;
 double ODECommon_Base::moving_mesh_threshold = MOVEMESH_ANTISYMMETRIC_THRESHOLD;
 double ODECommon_Base::moving_mesh_dwshift = 0.0;
 
+//-----------------------------------Multi-rate time stepping
+
+double ODECommon_Base::dT_multirate = 0.0;
+
+vector_lut<DifferentialEquation*> ODECommon_Base::multirate_pODE;
+vector_lut<Atom_DifferentialEquation*> ODECommon_Base::multirate_patom_ODE;
+
+double ODECommon_Base::multirate_dT = 0.0;
+double ODECommon_Base::multirate_dT_last = 0.0;
+double ODECommon_Base::multirate_time_stoch = 0.0;
+double ODECommon_Base::multirate_time_speedup = 0.0;
+bool ODECommon_Base::multirate_primed = false;
+
+double ODECommon_Base::multirate_dT_unlimited = 0.0;
+
+double ODECommon_Base::multirate_time_start = 0.0;
+double ODECommon_Base::multirate_time_end = 0.0;
+
+int ODECommon_Base::multirate_iteration = 0;
+int ODECommon_Base::multirate_stageiteration = 0;
+
+//-----------------------------------Ensemble runs
+
+int ODECommon_Base::ensemble_replicas = 1;
+
+double ODECommon_Base::ensemble_time = 0.0;
+double ODECommon_Base::ensemble_stagetime = 0.0;
+double ODECommon_Base::ensemble_time_stoch = 0.0;
+
+int ODECommon_Base::ensemble_iteration = 0;
+int ODECommon_Base::ensemble_stageiteration = 0;
+
+//-----------------------------------Mesh scheduling
+
+int ODECommon_Base::mesh_threads = 0;
+
 //-----------------------------------Special Properties
 
 bool ODECommon_Base::solve_spin_current = false;
@@ -146,6 +222,16 @@ BError ODECommon_Base::SwitchCUDAState(bool cudaState)
 	//are we switching to cuda?
 	if (cudaState) {
 
+		//Cayley method only available on the CPU : AHeun is the nearest method available with CUDA (same steps, without exact norm preservation)
+		//memory for the new evaluation method is allocated when the configuration is next updated (follows switching CUDA state)
+		if (evalMethod == EVAL_CAYLEY) error = SetEvaluationMethod(EVAL_AHEUN);
+
+		//RKC and ROS2 methods only available on the CPU : RK23 is the nearest method available with CUDA (second order with FSAL error estimate)
+		if (evalMethod == EVAL_RKC || evalMethod == EVAL_ROS2) error = SetEvaluationMethod(EVAL_RK23);
+
+		//NCG method only available on the CPU : SD is the nearest method available with CUDA (energy minimization for relaxation)
+		if (evalMethod == EVAL_NCG) error = SetEvaluationMethod(EVAL_SD);
+
 		if (!podeSolver->pODECUDA) {
 
 			podeSolver->pODECUDA = new ODECommonCUDA(podeSolver);
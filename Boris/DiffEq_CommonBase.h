@@ -28,6 +28,9 @@ class SuperMesh;
 class ODECommon;
 class Atom_ODECommon;
 
+class DifferentialEquation;
+class Atom_DifferentialEquation;
+
 #if COMPILECUDA == 1
 #include "DiffEq_CommonBaseCUDA.h"
 #endif
@@ -69,6 +72,8 @@ protected:
 	static double time_stoch;
 	//if set to true, dT is used instead of dT (default)
 	static bool link_dTstoch;
+	//seed for thermal field generation in stochastic equations (0 : seed from system tick count, different every time)
+	static int stoch_seed;
 
 	//used by the Check_Step_Update method to recommend if required effective field should be updated (in particular demag field) when in extreme mode (use_evaluation_speedup == EVALSPEEDUP_EXTREME):
 	//in this mode only recommend update at this step value
@@ -77,6 +82,8 @@ protected:
 	static double time_speedup;
 	//by default dTspeedup = dT, but if this flag is set to false dTspeedup can be independently set
 	static bool link_dTspeedup;
+	//Check_Step_Update value fixed for the current evaluation by Fix_Step_Update, so all modules get the same value (-1 if not fixed)
+	static int step_update;
 
 	//-----------------------------------Evaluation Method Data
 
@@ -93,6 +100,13 @@ protected:
 	//this takes on a value from EVALSPEEDUP_ enum
 	static int use_evaluation_speedup;
 
+	//field extrapolation used on skipped evaluation steps when evaluation speedup is enabled : this takes on a value from EVALSPEEDUPEXTRAP_ enum
+	static int evalspeedup_extrapolation;
+
+	//relative error of field extrapolation against full field evaluation, as reported by modules using it (maximum value reported during the time step at evalspeedup_error_time)
+	static double evalspeedup_error;
+	static double evalspeedup_error_time;
+
 	//-----------------------------------mxh and dmdt
 
 	//to avoid calculating mxh every single iteration whether it's needed or not, only calculate it if this flag is set
@@ -133,6 +147,21 @@ protected:
 	static double dT_min;
 	static double dT_max;
 
+	//step size controller used to adjust the time step from lte (STEPCTRL_ enum)
+	static int stepctrl_type;
+
+	//norm of local truncation error over cells (LTENORM_ enum)
+	static int lte_norm;
+
+	//order of the lte estimate for the set evaluation method (lte scales as dT^err_order), used by step size controllers
+	static int err_order;
+
+	//lte values (relative to err_high) of the previous 2 accepted time steps (0 if not available), used by PI and PID step size controllers
+	static double lte_prev, lte_prev2;
+
+	//number of accepted and rejected time steps for adaptive methods (since last reset)
+	static int steps_accepted, steps_rejected;
+
 	//-----------------------------------Special evaluation values
 
 	//used to alternate between past equation evaluations (e.g. for ABM)
@@ -144,6 +173,25 @@ protected:
 	//when we have to reset steepest descent keep track of it, so we can increase the reset time if we have to reset every iteration: can get stuck otherwise
 	static int sd_reset_consecutive_iters;
 
+	//RKC : number of stages in the current time step, and stage recurrence coefficients for stages 1 to rkc_stages (index is the stage number) :
+	//Y(j) = rkc_mu * Y(j-1) + rkc_nu * Y(j-2) + (1 - rkc_mu - rkc_nu) * Y(0) + dT * (rkc_mus * F(Y(j-1)) + rkc_gms * F(Y(0)))
+	static int rkc_stages;
+	static std::vector<double> rkc_mu, rkc_nu, rkc_mus, rkc_gms;
+	//RKC : stage nodes of Y(0) to Y(rkc_stages - 1), where the equation is evaluated
+	static std::vector<double> rkc_nodes;
+
+	//NCG : line search step along the current search direction (from magnetization at start of line search, saved in sM1), and values accumulated by solvers in each stage :
+	//ncg_dE : directional derivative of total energy along the search direction, ncg_beta_num and ncg_beta_den : numerator and denominator of Polak-Ribiere beta (next direction is residual + ncg_beta * previous direction)
+	static double ncg_alpha, ncg_dE, ncg_beta_num, ncg_beta_den, ncg_beta;
+	//NCG line search data : total energy (set by SuperMesh before each iteration), energy and directional derivative at start of line search, bracketing interval for the line search step, and number of evaluations in this line search
+	static double ncg_energy, ncg_energy0, ncg_dE0, ncg_alpha_lo, ncg_alpha_hi;
+	static int ncg_evals;
+
+	//-----------------------------------Relaxation activity mask
+
+	//SD relaxation in ferromagnetic meshes : cells are only updated whilst they, or any of their nearest neighbors, have normalized torque |mxh| above this threshold (disabled if zero)
+	static double relax_mask_threshold;
+
 	//-----------------------------------Moving mesh data
 
 	//use moving mesh algorithm?
@@ -158,11 +206,55 @@ protected:
 	//current dw shift as resulting from moving mesh algorithm
 	static double moving_mesh_dwshift;
 
+	//-----------------------------------Multi-rate time stepping
+
+	//time step for atomistic meshes with multi-rate time stepping : micromagnetic meshes advance with dT, and atomistic meshes sub-cycle within each micromagnetic time step starting with this time step (then adjusted by adaptive methods)
+	//disabled if zero (default) : all meshes advance together with the same time step
+	static double dT_multirate;
+
+	//-----------------------------------Ensemble runs
+
+	//number of replicas of the micromagnetic meshes magnetization and thermal field random number streams, all advanced through the same time steps sharing the meshes, their modules and demag kernels
+	//replica 0 is held in the meshes; disabled if 1 (default)
+	static int ensemble_replicas;
+
 	//-----------------------------------Special Properties
 
 	//is the currently set equation a SA version? (set by SA ODE versions, which require spin accumulation to evaluate spin torques)
 	static bool solve_spin_current;
 
+private:
+
+	//-----------------------------------Multi-rate time stepping runtime data
+
+	//ODE solvers set aside so Iterate only advances the others : atomistic solvers whilst micromagnetic meshes advance, micromagnetic solvers whilst atomistic meshes sub-cycle
+	static vector_lut<DifferentialEquation*> multirate_pODE;
+	static vector_lut<Atom_DifferentialEquation*> multirate_patom_ODE;
+
+	//time step control data of atomistic solvers, swapped in whilst they sub-cycle
+	static double multirate_dT, multirate_dT_last, multirate_time_stoch, multirate_time_speedup;
+	static bool multirate_primed;
+
+	//atomistic time step before it was limited to finish sub-cycling at the end of the micromagnetic time step
+	static double multirate_dT_unlimited;
+
+	//micromagnetic time step being sub-cycled
+	static double multirate_time_start, multirate_time_end;
+
+	//iteration counters at end of micromagnetic time step : atomistic sub-steps are not counted as iterations
+	static int multirate_iteration, multirate_stageiteration;
+
+	//-----------------------------------Ensemble runs runtime data
+
+	//time and iteration counters at the start of the time step : each replica is advanced from these
+	static double ensemble_time, ensemble_stagetime, ensemble_time_stoch;
+	static int ensemble_iteration, ensemble_stageiteration;
+
+	//-----------------------------------Mesh scheduling
+
+	//number of threads used by each solver when running evaluation method stages for different meshes concurrently (0 : run solvers one after another, each using all threads). Set by SuperMesh on initialization.
+	static int mesh_threads;
+
 private:
 
 	//----------------------------------- Runtime Iteration Helpers
@@ -172,6 +264,18 @@ private:
 	//this uses a 2 level error threshold -> above the high threshold fail, adjust step based on max_error / error ratio. Below the low error threshold increase step by a small constant factor.
 	bool SetAdaptiveTimeStep(void);
 
+	//as for SetAdaptiveTimeStep, but using the set step size controller (elementary, PI or PID), which sets the time step from lte values of the current and previous time steps
+	bool SetAdaptiveTimeStep_Controller(void);
+
+	//run evaluation method stage for all micromagnetic and atomistic solvers : concurrently, with mesh_threads threads each, if enabled and solvers are independent in this stage, else one after another
+	void Run_Stage(void (DifferentialEquation::*stage)(void), void (Atom_DifferentialEquation::*atom_stage)(void));
+
+	//seed random number generators of all solvers with stoch_seed, starting again from the first generation step
+	void Seed_Stochastic(void);
+
+	//RKC : set number of stages and their coefficients for the current time step from the largest spectral radius estimate of all solvers (time step is reduced if more than RKC_MAXSTAGES are needed)
+	void RKC_Set_Stages(void);
+
 protected:
 	
 	//----------------------------------- Runtime Iteration Helpers
@@ -231,10 +335,23 @@ public:
 	//To enable this mode you need to set use_evaluation_speedup != EVALSPEEDUP_NONE
 	int Check_Step_Update(void);
 
+	//fix Check_Step_Update value before meshes update their effective fields for an evaluation (status = true), and release it after (status = false).
+	//In extreme mode not linked to dT, Check_Step_Update also sets time_speedup : it must only be evaluated once per evaluation, also when meshes are updated concurrently.
+	void Fix_Step_Update(bool status);
+
+	//time at which the effective field is evaluated in the current evaluation step : time + c * dT, where c is the stage node of the evaluation method for the current evaluation step
+	double Get_EvalStep_Time(void);
+
+	//modules using field extrapolation report the relative error of extrapolation against a full field evaluation here
+	void Report_EvalSpeedup_Error(double error_value);
+
 	//----------------------------------- Evaluation Method and Control: DiffEq_CommonBase_Control.cpp
 
 	BError SetEvaluationMethod(EVAL_ evalMethod_);
 
+	//order of the lte estimate for given evaluation method, used by step size controllers (only meaningful for adaptive methods)
+	static int Get_ErrOrder(int evalMethod_);
+
 	void Reset(void);
 
 	void NewStage(void);
@@ -244,12 +361,80 @@ public:
 	void SetStochTimeStep(double dTstoch);
 	void SetLink_dTstoch(bool link_dTstoch);
 
+	//set seed for thermal field generation (0 for a different seed every time)
+	void SetStochSeed(int seed) { stoch_seed = seed; Seed_Stochastic(); }
+	int GetStochSeed(void) { return stoch_seed; }
+
 	void SetSpeedupTimeStep(double dTspeedup_);
 	void SetLink_dTspeedup(bool link_dTspeedup_);
 
 	void SetAdaptiveTimeStepCtrl(double err_high_fail, double err_high, double err_low, double dT_increase, double dT_min, double dT_max);
 
+	//set step size controller type (STEPCTRL_ enum) and norm of local truncation error over cells (LTENORM_ enum)
+	void SetStepControllerType(int type) { if (type >= STEPCTRL_BANDS && type < STEPCTRL_NUMENTRIES) { stepctrl_type = type; lte_prev = 0.0; lte_prev2 = 0.0; } }
+	void SetLTENorm(int norm) { if (norm >= LTENORM_MAX && norm < LTENORM_NUMENTRIES) lte_norm = norm; }
+
 	void SetEvaluationSpeedup(int status) { if (status >= EVALSPEEDUP_NONE && status < EVALSPEEDUP_NUMENTRIES) use_evaluation_speedup = status; }
+	void SetEvaluationSpeedupExtrapolation(int status) { if (status >= EVALSPEEDUPEXTRAP_NONE && status < EVALSPEEDUPEXTRAP_NUMENTRIES) evalspeedup_extrapolation = status; }
+
+	//----------------------------------- Multi-rate time stepping : DiffEq_CommonBase_MultiRate.cpp
+
+	//set atomistic time step for multi-rate time stepping (0 to disable)
+	void SetdT_MultiRate(double dT_multirate_);
+	double GetdT_MultiRate(void) { return dT_multirate; }
+
+	//use multi-rate time stepping? enabled, both micromagnetic and atomistic solvers present, and evaluation method completes each time step on its own (not ABM, SD, RK23, RKDP, RKC, NCG)
+	bool MultiRate_Active(void);
+
+	//set aside atomistic solvers so Iterate only advances micromagnetic solvers : atomistic meshes are held at their values at the start of the time step
+	void MultiRate_Begin_Micromagnetic(void);
+
+	//micromagnetic time step completed from time_start : set aside micromagnetic solvers, saving their end of step magnetization, and bring back atomistic solvers with their time step control data, starting from time_start
+	BError MultiRate_Begin_Atomistic(double time_start);
+
+	//atomistic sub-cycling reached the end of the micromagnetic time step?
+	bool MultiRate_SubCycle_Done(void);
+
+	//before each atomistic evaluation : limit time step so sub-cycling finishes at the end of the micromagnetic time step, and set micromagnetic magnetization interpolated at the evaluation time
+	void MultiRate_Prepare_Evaluation(void);
+
+	//atomistic sub-cycling finished : bring back micromagnetic solvers with their end of step magnetization and time step control data
+	void MultiRate_End(void);
+
+	//----------------------------------- Ensemble runs : DiffEq_CommonBase_Ensemble.cpp
+
+	//set number of ensemble replicas (1 to disable) : replicas 1 and up start from the current magnetization, each with its own random number stream
+	BError SetEnsembleReplicas(int replicas);
+	int GetEnsembleReplicas(void) { return ensemble_replicas; }
+
+	//use ensemble runs? more than 1 replica set, and micromagnetic solvers present
+	bool Ensemble_Active(void);
+
+	//check ensemble runs can be used with the current configuration (fixed time step evaluation methods only, no atomistic meshes, multi-rate time stepping, moving mesh, evaluation speedup or CUDA), and size replicas for any mesh changes
+	BError Ensemble_Check(void);
+
+	//save time and iteration counters at the start of the time step
+	void Ensemble_Begin(void);
+
+	//set time and iteration counters back to the start of the time step and swap replica into the meshes (replica 0 is already there)
+	void Ensemble_Begin_Replica(int replica);
+
+	//replica advanced through the time step : swap it out of the meshes
+	void Ensemble_End_Replica(int replica);
+
+	//----------------------------------- Mesh scheduling
+
+	//set number of threads used by each solver when running evaluation method stages concurrently (0 to run solvers one after another)
+	void SetMeshThreads(int mesh_threads_) { mesh_threads = mesh_threads_; }
+
+	//----------------------------------- Energy minimization
+
+	//total energy (J) at the current magnetization configuration : set before each iteration, needed for the NCG solver line search
+	void Set_TotalEnergy(double energy) { ncg_energy = energy; }
+
+	//normalized torque threshold for the SD relaxation activity mask (0 to disable) : SD solver is primed again so the mask starts with all cells active
+	void SetRelaxMaskThreshold(double threshold) { relax_mask_threshold = threshold; primed = false; }
+	double GetRelaxMaskThreshold(void) { return relax_mask_threshold; }
 
 	//----------------------------------- Moving Mesh Methods : DiffEq_CommonBase_MovingMesh.cpp
 
@@ -286,6 +471,12 @@ public:
 	DBL3 Get_AStepRelErrCtrl(void) { return DBL3(err_high_fail, err_high, err_low); }
 	DBL3 Get_AStepdTCtrl(void) { return DBL3(dT_increase, dT_min, dT_max); }
 
+	int GetStepControllerType(void) { return stepctrl_type; }
+	int GetLTENorm(void) { return lte_norm; }
+
+	//number of accepted and rejected time steps for adaptive methods since last reset
+	INT2 Get_StepStats(void) { return INT2(steps_accepted, steps_rejected); }
+
 	//----------------------------------- Status Getters
 
 	bool TimeStepSolved(void) { return available; }
@@ -293,9 +484,12 @@ public:
 	bool SolveSpinCurrent(void) { return solve_spin_current; }
 
 	int GetEvaluationSpeedup(void) { return use_evaluation_speedup; }
+	int GetEvaluationSpeedupExtrapolation(void) { return evalspeedup_extrapolation; }
 
 	//----------------------------------- Value Getters
 
 	double Get_mxh(void);
 	double Get_dmdt(void);
+
+	double Get_EvalSpeedup_Error(void) { return evalspeedup_error; }
 };
@@ -4,12 +4,37 @@
 #include "DiffEq_Common.h"
 #include "Atom_DiffEq_Common.h"
 
+#include "DiffEq.h"
+#include "Atom_DiffEq.h"
+
 //----------------------------------- Evaluation Method and Control
 
+//order of the lte estimate for given evaluation method, used by step size controllers (only meaningful for adaptive methods)
+int ODECommon_Base::Get_ErrOrder(int evalMethod_)
+{
+	switch (evalMethod_) {
+
+	case EVAL_AHEUN: return AHEUN_ERRORDER;
+	case EVAL_CAYLEY: return CAYLEY_ERRORDER;
+	case EVAL_ROS2: return ROS2_ERRORDER;
+	case EVAL_RKC: return RKC_ERRORDER;
+	case EVAL_ABM: return ABM_ERRORDER;
+	case EVAL_RK23: return RK23_ERRORDER;
+	case EVAL_RKCK: return RKCK_ERRORDER;
+	case EVAL_RKDP: return RKDP_ERRORDER;
+	default: return RKF_ERRORDER;
+	}
+}
+
 BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 {
 	BError error(__FUNCTION__);
 
+#if COMPILECUDA == 1
+	//Cayley, ROS2, RKC and NCG methods only available on the CPU
+	if ((evalMethod_ == EVAL_CAYLEY || evalMethod_ == EVAL_ROS2 || evalMethod_ == EVAL_RKC || evalMethod_ == EVAL_NCG) && podeSolver->pODECUDA) return error(BERROR_NOTAVAILABLE);
+#endif
+
 	evalMethod = evalMethod_;
 
 	//set default parameters for given evaluation method
@@ -40,6 +65,45 @@ BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 	}
 	break;
 
+	case EVAL_CAYLEY:
+	{
+		dT = CAYLEY_DEFAULT_DT;
+
+		err_high_fail = CAYLEY_RELERRFAIL;
+		err_high = CAYLEY_RELERRMAX;
+		err_low = CAYLEY_RELERRMIN;
+		dT_increase = CAYLEY_DTINCREASE;
+		dT_max = CAYLEY_MAXDT;
+		dT_min = CAYLEY_MINDT;
+	}
+	break;
+
+	case EVAL_ROS2:
+	{
+		dT = ROS2_DEFAULT_DT;
+
+		err_high_fail = ROS2_RELERRFAIL;
+		err_high = ROS2_RELERRMAX;
+		err_low = ROS2_RELERRMIN;
+		dT_increase = ROS2_DTINCREASE;
+		dT_max = ROS2_MAXDT;
+		dT_min = ROS2_MINDT;
+	}
+	break;
+
+	case EVAL_RKC:
+	{
+		dT = RKC_DEFAULT_DT;
+
+		err_high_fail = RKC_RELERRFAIL;
+		err_high = RKC_RELERRMAX;
+		err_low = RKC_RELERRMIN;
+		dT_increase = RKC_DTINCREASE;
+		dT_max = RKC_MAXDT;
+		dT_min = RKC_MINDT;
+	}
+	break;
+
 	case EVAL_RK4:
 	{
 		dT = RK4_DEFAULT_DT;
@@ -82,6 +146,15 @@ BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 	}
 	break;
 
+	case EVAL_NCG:
+	{
+		//first line search step : afterwards the first step in each search direction is set from the previous line search
+		dT = NCG_DEFAULT_DT;
+		dT_min = NCG_MINDT;
+		dT_max = NCG_MAXDT;
+	}
+	break;
+
 	default:
 	case EVAL_RKF:
 	{
@@ -126,6 +199,10 @@ BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 	//initial settings
 	dT_last = dT;
 
+	err_order = Get_ErrOrder(evalMethod);
+	lte_prev = 0.0;
+	lte_prev2 = 0.0;
+
 	mxh = 1;
 	dmdt = 1;
 
@@ -140,6 +217,9 @@ BError ODECommon_Base::SetEvaluationMethod(EVAL_ evalMethod_)
 
 	if (link_dTspeedup) dTspeedup = dT;
 
+	multirate_dT = multirate_dT_last = dT_multirate;
+	multirate_primed = false;
+
 #if COMPILECUDA == 1
 	if (podeSolver->pODECUDA) podeSolver->pODECUDA->SyncODEValues();
 	if (patom_odeSolver->pODECUDA) patom_odeSolver->pODECUDA->SyncODEValues();
@@ -159,6 +239,11 @@ void ODECommon_Base::Reset(void)
 
 	time_speedup = 0.0;
 
+	multirate_dT = multirate_dT_last = dT_multirate;
+	multirate_time_stoch = 0.0;
+	multirate_time_speedup = 0.0;
+	multirate_primed = false;
+
 	mxh = 1.0;
 	dmdt = 1.0;
 
@@ -173,6 +258,14 @@ void ODECommon_Base::Reset(void)
 
 	moving_mesh_dwshift = 0.0;
 
+	lte_prev = 0.0;
+	lte_prev2 = 0.0;
+	steps_accepted = 0;
+	steps_rejected = 0;
+
+	//with a set seed, thermal fields are the same every time the simulation is run from reset
+	Seed_Stochastic();
+
 #if COMPILECUDA == 1
 	if (podeSolver->pODECUDA) podeSolver->pODECUDA->SyncODEValues();
 	if (patom_odeSolver->pODECUDA) patom_odeSolver->pODECUDA->SyncODEValues();
@@ -192,10 +285,15 @@ void ODECommon_Base::NewStage(void)
 
 	alternator = false;
 	primed = false;
+	multirate_primed = false;
 
 	calculate_mxh = true;
 	calculate_dmdt = true;
 
+	//step size controller history is not carried over between stages
+	lte_prev = 0.0;
+	lte_prev2 = 0.0;
+
 #if COMPILECUDA == 1
 	if (podeSolver->pODECUDA) podeSolver->pODECUDA->SyncODEValues();
 	if (patom_odeSolver->pODECUDA) patom_odeSolver->pODECUDA->SyncODEValues();
@@ -214,6 +312,26 @@ void ODECommon_Base::SetdT(double dT)
 #endif
 }
 
+//seed random number generators of all solvers with stoch_seed, starting again from the first generation step
+void ODECommon_Base::Seed_Stochastic(void)
+{
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+		DifferentialEquation* pDiffEq = podeSolver->pODE[idx];
+		unsigned seed = (stoch_seed ? stoch_seed : GetSystemTickCount());
+		pDiffEq->prng.seed(seed, pDiffEq->odeId.minor);
+
+		//ensemble replicas have their own streams for the same seed
+		pDiffEq->Ensemble_Seed(seed);
+	}
+
+	for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+		Atom_DifferentialEquation* pDiffEq = patom_odeSolver->pODE[idx];
+		pDiffEq->prng.seed(stoch_seed ? stoch_seed : GetSystemTickCount(), STOCHSEED_ATOM_STREAM + pDiffEq->odeId.minor);
+	}
+}
+
 void ODECommon_Base::SetStochTimeStep(double dTstoch_)
 {
 	link_dTstoch = false;
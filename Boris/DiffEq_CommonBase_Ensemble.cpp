@@ -0,0 +1,103 @@
+#include "stdafx.h"
+#include "DiffEq_CommonBase.h"
+
+#include "DiffEq_Common.h"
+#include "Atom_DiffEq_Common.h"
+
+#include "DiffEq.h"
+#include "Atom_DiffEq.h"
+
+//----------------------------------- Ensemble runs
+
+//Replicas of the magnetization are advanced in turn through each time step in the same meshes, so all modules (including demag kernels and FFT plans) and material parameters are shared.
+//Each replica has its own magnetization, thermal field and torque, and random number stream; replicas not being advanced are held in the solvers.
+//All replicas share the same time and time step, so only fixed time step evaluation methods are allowed (scratch spaces don't carry data between time steps).
+
+//set number of ensemble replicas (1 to disable) : replicas 1 and up start from the current magnetization, each with its own random number stream
+BError ODECommon_Base::SetEnsembleReplicas(int replicas)
+{
+	BError error(CLASS_STR(ODECommon_Base));
+
+	ensemble_replicas = (replicas < 1 ? 1 : (replicas > ENSEMBLE_MAXREPLICAS ? ENSEMBLE_MAXREPLICAS : replicas));
+
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+		error = podeSolver->pODE[idx]->Ensemble_Allocate(true);
+		if (error) break;
+	}
+
+	//couldn't allocate all replicas : disable ensemble runs
+	if (error) {
+
+		ensemble_replicas = 1;
+		for (int idx = 0; idx < podeSolver->pODE.size(); idx++) podeSolver->pODE[idx]->Ensemble_Allocate(true);
+	}
+
+	return error;
+}
+
+//use ensemble runs? more than 1 replica set, and micromagnetic solvers present
+bool ODECommon_Base::Ensemble_Active(void)
+{
+	return ensemble_replicas > 1 && podeSolver->pODE.size();
+}
+
+//check ensemble runs can be used with the current configuration (fixed time step evaluation methods only, no atomistic meshes, multi-rate time stepping, moving mesh, evaluation speedup or CUDA), and size replicas for any mesh changes
+BError ODECommon_Base::Ensemble_Check(void)
+{
+	BError error(CLASS_STR(ODECommon_Base));
+
+	if (!Ensemble_Active()) return error;
+
+	//replicas share the time step and scratch spaces
+	if (evalMethod != EVAL_EULER && evalMethod != EVAL_TEULER && evalMethod != EVAL_RK4) return error(BERROR_INCORRECTCONFIG, "ensemble runs only available with the Euler, TEuler and RK4 evaluation methods");
+
+	//replicas are only held by micromagnetic solvers
+	if (patom_odeSolver->pODE.size()) return error(BERROR_INCORRECTCONFIG, "ensemble runs not available with atomistic meshes");
+	if (dT_multirate > 0.0) return error(BERROR_INCORRECTCONFIG, "ensemble runs not available with multi-rate time stepping");
+
+	//these keep data between time steps which is not replicated
+	if (use_evaluation_speedup != EVALSPEEDUP_NONE) return error(BERROR_INCORRECTCONFIG, "ensemble runs not available with evaluation speedup");
+	if (moving_mesh) return error(BERROR_INCORRECTCONFIG, "ensemble runs not available with moving mesh");
+
+#if COMPILECUDA == 1
+	if (podeSolver->pODECUDA) return error(BERROR_NOTAVAILABLE, "ensemble runs not available with CUDA");
+#endif
+
+	//mesh dimensions may have changed since replicas were set
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+		error = podeSolver->pODE[idx]->Ensemble_Allocate(false);
+		if (error) return error;
+	}
+
+	return error;
+}
+
+//save time and iteration counters at the start of the time step
+void ODECommon_Base::Ensemble_Begin(void)
+{
+	ensemble_time = time;
+	ensemble_stagetime = stagetime;
+	ensemble_iteration = iteration;
+	ensemble_stageiteration = stageiteration;
+	ensemble_time_stoch = time_stoch;
+}
+
+//set time and iteration counters back to the start of the time step and swap replica into the meshes (replica 0 is already there)
+void ODECommon_Base::Ensemble_Begin_Replica(int replica)
+{
+	time = ensemble_time;
+	stagetime = ensemble_stagetime;
+	iteration = ensemble_iteration;
+	stageiteration = ensemble_stageiteration;
+	time_stoch = ensemble_time_stoch;
+
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) podeSolver->pODE[idx]->Ensemble_Swap(replica);
+}
+
+//replica advanced through the time step : swap it out of the meshes
+void ODECommon_Base::Ensemble_End_Replica(int replica)
+{
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) podeSolver->pODE[idx]->Ensemble_Swap(replica);
+}
@@ -14,6 +14,8 @@
 //this uses a 2 level error threshold -> above the high threshold fail, adjust step based on max_error / error ratio. Below the low error threshold increase step by a small constant factor.
 bool ODECommon_Base::SetAdaptiveTimeStep(void)
 {
+	if (stepctrl_type != STEPCTRL_BANDS) return SetAdaptiveTimeStep_Controller();
+
 	//adaptive time step based on lte - is lte over acceptable relative error?
 	if (lte > err_high) {
 
@@ -28,6 +30,7 @@ bool ODECommon_Base::SetAdaptiveTimeStep(void)
 			dT *= sqrt(err_high_fail / (2 * lte));
 
 			//failed - must repeat
+			steps_rejected++;
 			available = false;
 			return false;
 		}
@@ -49,11 +52,175 @@ bool ODECommon_Base::SetAdaptiveTimeStep(void)
 	}
 
 	//good, next step
+	steps_accepted++;
+	return true;
+}
+
+//as for SetAdaptiveTimeStep, but using the set step size controller (elementary, PI or PID), which sets the time step from lte values of the current and previous time steps
+//the time step is multiplied by STEPCTRL_SAFETY * (err_high / lte)^(beta1 / k) * (err_high / lte_prev)^(beta2 / k) * (err_high / lte_prev2)^(beta3 / k), k being the order of the lte estimate
+//after any disturbance the time step recovers within a few iterations, rather than increasing slowly by a fixed multiplier
+bool ODECommon_Base::SetAdaptiveTimeStep_Controller(void)
+{
+	//lte relative to the target error (must not be zero)
+	double err = maximum(lte, 1e-6 * err_high) / err_high;
+
+	//failed - try again with smaller time step. As for SetAdaptiveTimeStep, do not redo if time step is at or below the minimum value allowed.
+	if (lte > err_high_fail && dT > dT_min) {
+
+		time -= dT;
+		stagetime -= dT;
+
+		//elementary controller without error history, and never increase a rejected time step
+		double factor = STEPCTRL_SAFETY * pow(err, -1.0 / err_order);
+		dT *= (factor < STEPCTRL_MINFACTOR ? STEPCTRL_MINFACTOR : (factor > STEPCTRL_SAFETY ? STEPCTRL_SAFETY : factor));
+
+		if (dT < dT_min) dT = dT_min;
+
+		//failed - must repeat
+		steps_rejected++;
+		available = false;
+		return false;
+	}
+
+	double beta1 = 1.0, beta2 = 0.0, beta3 = 0.0;
+
+	switch (stepctrl_type) {
+
+	case STEPCTRL_PI:
+		beta1 = STEPCTRL_PI_BETA1;
+		beta2 = STEPCTRL_PI_BETA2;
+		break;
+
+	case STEPCTRL_PID:
+		beta1 = STEPCTRL_PID_BETA1;
+		beta2 = STEPCTRL_PID_BETA2;
+		beta3 = STEPCTRL_PID_BETA3;
+		break;
+	}
+
+	//error history not available yet (first time steps) : use current error instead
+	double err_prev = (lte_prev > 0.0 ? lte_prev : err);
+	double err_prev2 = (lte_prev2 > 0.0 ? lte_prev2 : err_prev);
+
+	double factor = STEPCTRL_SAFETY * pow(err, -beta1 / err_order) * pow(err_prev, -beta2 / err_order) * pow(err_prev2, -beta3 / err_order);
+	dT *= (factor < STEPCTRL_MINFACTOR ? STEPCTRL_MINFACTOR : (factor > STEPCTRL_MAXFACTOR ? STEPCTRL_MAXFACTOR : factor));
+
+	//must stay within time step bounds
+	if (dT < dT_min) dT = dT_min;
+	if (dT > dT_max) dT = dT_max;
+
+	//error history, relative to the target error
+	lte_prev2 = err_prev;
+	lte_prev = err;
+
+	//good, next step
+	steps_accepted++;
 	return true;
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//run evaluation method stage for all micromagnetic and atomistic solvers : concurrently, with mesh_threads threads each, if enabled and solvers are independent in this stage, else one after another
+void ODECommon_Base::Run_Stage(void (DifferentialEquation::*stage)(void), void (Atom_DifferentialEquation::*atom_stage)(void))
+{
+	int num_mm = podeSolver->pODE.size();
+	int num_solvers = num_mm + patom_odeSolver->pODE.size();
+
+	//solvers are not independent for : SD and NCG (stages accumulate into common reduction values), stochastic fields not linked to time step (solvers check and update common stochastic field generation time)
+	bool independent = (evalMethod != EVAL_SD && evalMethod != EVAL_NCG && link_dTstoch);
+
+	Run_OmpTeams(num_solvers, (independent ? mesh_threads : 0), [&](int idx) {
+
+		if (idx < num_mm) (podeSolver->pODE[idx]->*stage)();
+		else (patom_odeSolver->pODE[idx - num_mm]->*atom_stage)();
+
+		return 0.0;
+	});
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//RKC : set number of stages and their coefficients for the current time step from the largest spectral radius estimate of all solvers (time step is reduced if more than RKC_MAXSTAGES are needed)
+//Second order damped RKC method of Sommeijer, Shampine and Verwer : the stability interval along the negative real axis grows as approximately 0.653 * s^2 with s stages.
+void ODECommon_Base::RKC_Set_Stages(void)
+{
+	double specrad = 0.0;
+
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+		specrad = maximum(specrad, podeSolver->pODE[idx]->RKC_SpectralRadius());
+	}
+
+	for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+
+		specrad = maximum(specrad, patom_odeSolver->pODE[idx]->RKC_SpectralRadius());
+	}
+
+	specrad *= RKC_SPECRAD_SAFETY;
+
+	int stages = 1 + (int)sqrt(1.0 + 1.54 * dT * specrad);
+	if (stages < 2) stages = 2;
+
+	if (stages > RKC_MAXSTAGES) {
+
+		//largest time step stable with maximum number of stages
+		stages = RKC_MAXSTAGES;
+		dT = ((stages - 1) * (stages - 1) - 1) / (1.54 * specrad);
+	}
+
+	//coefficients only depend on number of stages
+	if (stages == rkc_stages) return;
+
+	rkc_stages = stages;
+
+	rkc_mu.assign(stages + 1, 0.0);
+	rkc_nu.assign(stages + 1, 0.0);
+	rkc_mus.assign(stages + 1, 0.0);
+	rkc_gms.assign(stages + 1, 0.0);
+	rkc_nodes.assign(stages, 0.0);
+
+	//coefficients from Chebyshev polynomials T(j) evaluated at w0, with first and second derivatives (z, dz, d2z)
+	double s = stages;
+	double w0 = 1.0 + RKC_DAMPING / (s * s);
+	double temp1 = w0 * w0 - 1.0;
+	double temp2 = sqrt(temp1);
+	double arg = s * log(w0 + temp2);
+	double w1 = sinh(arg) * temp1 / (cosh(arg) * s * temp2 - w0 * sinh(arg));
+
+	double bjm1 = 1.0 / (4 * w0 * w0), bjm2 = bjm1;
+
+	//stage 1 : Y(1) = Y(0) + dT * rkc_mus * F(Y(0))
+	rkc_mus[1] = w1 * bjm1;
+	rkc_nodes[1] = rkc_mus[1];
+
+	double zjm1 = w0, zjm2 = 1.0, dzjm1 = 1.0, dzjm2 = 0.0, d2zjm1 = 0.0, d2zjm2 = 0.0;
+	double thjm1 = rkc_mus[1], thjm2 = 0.0;
+
+	for (int j = 2; j <= stages; j++) {
+
+		double zj = 2 * w0 * zjm1 - zjm2;
+		double dzj = 2 * w0 * dzjm1 - dzjm2 + 2 * zjm1;
+		double d2zj = 2 * w0 * d2zjm1 - d2zjm2 + 4 * dzjm1;
+
+		double bj = d2zj / (dzj * dzj);
+		double ajm1 = 1.0 - zjm1 * bjm1;
+
+		rkc_mu[j] = 2 * w0 * bj / bjm1;
+		rkc_nu[j] = -bj / bjm2;
+		rkc_mus[j] = rkc_mu[j] * w1 / w0;
+		rkc_gms[j] = -ajm1 * rkc_mus[j];
+
+		double thj = rkc_mu[j] * thjm1 + rkc_nu[j] * thjm2 + rkc_mus[j] * (1.0 - ajm1);
+		if (j < stages) rkc_nodes[j] = thj;
+
+		bjm2 = bjm1; bjm1 = bj;
+		thjm2 = thjm1; thjm1 = thj;
+		zjm2 = zjm1; zjm1 = zj;
+		dzjm2 = dzjm1; dzjm1 = dzj;
+		d2zjm2 = d2zjm1; d2zjm1 = d2zj;
+	}
+}
+
 void ODECommon_Base::Iterate(void)
 {
 	//save current dT value in case it changes (adaptive time step methods)
@@ -66,15 +233,7 @@ void ODECommon_Base::Iterate(void)
 #ifdef ODE_EVAL_COMPILATION_EULER
 		if (calculate_mxh || calculate_dmdt) {
 
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunEuler_withReductions();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunEuler_withReductions();
-			}
+			Run_Stage(&DifferentialEquation::RunEuler_withReductions, &Atom_DifferentialEquation::RunEuler_withReductions);
 
 			if (calculate_mxh) {
 
@@ -94,15 +253,7 @@ void ODECommon_Base::Iterate(void)
 		}
 		else {
 
-			for (int idx = 0; idx < (int)podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunEuler();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunEuler();
-			}
+			Run_Stage(&DifferentialEquation::RunEuler, &Atom_DifferentialEquation::RunEuler);
 		}
 
 		time += dT;
@@ -120,15 +271,7 @@ void ODECommon_Base::Iterate(void)
 
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunTEuler_Step0_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunTEuler_Step0_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunTEuler_Step0_withReductions, &Atom_DifferentialEquation::RunTEuler_Step0_withReductions);
 
 				calculate_mxh = false;
 				mxh = 0.0;
@@ -137,15 +280,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunTEuler_Step0();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunTEuler_Step0();
-				}
+				Run_Stage(&DifferentialEquation::RunTEuler_Step0, &Atom_DifferentialEquation::RunTEuler_Step0);
 			}
 
 			evalStep = 1;
@@ -155,15 +290,7 @@ void ODECommon_Base::Iterate(void)
 
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunTEuler_Step1_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunTEuler_Step1_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunTEuler_Step1_withReductions, &Atom_DifferentialEquation::RunTEuler_Step1_withReductions);
 
 				calculate_dmdt = false;
 				dmdt = 0.0;
@@ -172,15 +299,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunTEuler_Step1();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunTEuler_Step1();
-				}
+				Run_Stage(&DifferentialEquation::RunTEuler_Step1, &Atom_DifferentialEquation::RunTEuler_Step1);
 			}
 
 			evalStep = 0;
@@ -202,15 +321,7 @@ void ODECommon_Base::Iterate(void)
 
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunAHeun_Step0_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunAHeun_Step0_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunAHeun_Step0_withReductions, &Atom_DifferentialEquation::RunAHeun_Step0_withReductions);
 
 				calculate_mxh = false;
 				mxh = 0.0;
@@ -219,15 +330,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunAHeun_Step0();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunAHeun_Step0();
-				}
+				Run_Stage(&DifferentialEquation::RunAHeun_Step0, &Atom_DifferentialEquation::RunAHeun_Step0);
 			}
 
 			evalStep = 1;
@@ -237,15 +340,7 @@ void ODECommon_Base::Iterate(void)
 
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunAHeun_Step1_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunAHeun_Step1_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunAHeun_Step1_withReductions, &Atom_DifferentialEquation::RunAHeun_Step1_withReductions);
 
 				calculate_dmdt = false;
 				dmdt = 0.0;
@@ -254,15 +349,68 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+				Run_Stage(&DifferentialEquation::RunAHeun_Step1, &Atom_DifferentialEquation::RunAHeun_Step1);
+			}
 
-					podeSolver->pODE[idx]->RunAHeun_Step1();
-				}
+			evalStep = 0;
+			time += dT;
+			stagetime += dT;
+			iteration++;
+			stageiteration++;
+			available = true;
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			dT_last = dT;
+			//accumulate lte value so we can use it to adjust the time step
+			lte = 0.0;
+			podeSolver->Set_lte();
+			patom_odeSolver->Set_lte();
 
-					patom_odeSolver->pODE[idx]->RunAHeun_Step1();
-				}
+			if (!SetAdaptiveTimeStep()) {
+
+				podeSolver->Restore();
+				patom_odeSolver->Restore();
+			}
+		}
+#endif
+	}
+	break;
+
+	case EVAL_CAYLEY:
+	{
+#ifdef ODE_EVAL_COMPILATION_CAYLEY
+		if (evalStep == 0) {
+
+			if (calculate_mxh) {
+
+				Run_Stage(&DifferentialEquation::RunCayley_Step0_withReductions, &Atom_DifferentialEquation::RunCayley_Step0_withReductions);
+
+				calculate_mxh = false;
+				mxh = 0.0;
+				podeSolver->Set_mxh();
+				patom_odeSolver->Set_mxh();
+			}
+			else {
+
+				Run_Stage(&DifferentialEquation::RunCayley_Step0, &Atom_DifferentialEquation::RunCayley_Step0);
+			}
+
+			evalStep = 1;
+			available = false;
+		}
+		else {
+
+			if (calculate_dmdt) {
+
+				Run_Stage(&DifferentialEquation::RunCayley_Step1_withReductions, &Atom_DifferentialEquation::RunCayley_Step1_withReductions);
+
+				calculate_dmdt = false;
+				dmdt = 0.0;
+				podeSolver->Set_dmdt();
+				patom_odeSolver->Set_dmdt();
+			}
+			else {
+
+				Run_Stage(&DifferentialEquation::RunCayley_Step1, &Atom_DifferentialEquation::RunCayley_Step1);
 			}
 
 			evalStep = 0;
@@ -288,6 +436,78 @@ void ODECommon_Base::Iterate(void)
 	}
 	break;
 
+	case EVAL_ROS2:
+	{
+#ifdef ODE_EVAL_COMPILATION_ROS2
+		if (evalStep == 0) {
+
+			if (calculate_mxh) {
+
+				Run_Stage(&DifferentialEquation::RunROS2_Step0_withReductions, &Atom_DifferentialEquation::RunROS2_Step0_withReductions);
+
+				calculate_mxh = false;
+				mxh = 0.0;
+				podeSolver->Set_mxh();
+				patom_odeSolver->Set_mxh();
+			}
+			else {
+
+				Run_Stage(&DifferentialEquation::RunROS2_Step0, &Atom_DifferentialEquation::RunROS2_Step0);
+			}
+
+			available = false;
+
+			//ROS2 has the FSAL property (as RK23) : error estimate stage of the previous time step is solved in the first stage, so must be primed by a full pass first
+			//Magnetization is advanced below if the step has not failed, otherwise restore magnetization and set primed to false.
+			if (primed) {
+
+				dT_last = dT;
+				lte = 0.0;
+				podeSolver->Set_lte();
+				patom_odeSolver->Set_lte();
+
+				if (!SetAdaptiveTimeStep()) {
+
+					primed = false;
+					podeSolver->Restore();
+					patom_odeSolver->Restore();
+					break;
+				}
+			}
+			else primed = true;
+
+			//Advance with new stepsize
+			Run_Stage(&DifferentialEquation::RunROS2_Step0_Advance, &Atom_DifferentialEquation::RunROS2_Step0_Advance);
+
+			evalStep = 1;
+		}
+		else {
+
+			if (calculate_dmdt) {
+
+				Run_Stage(&DifferentialEquation::RunROS2_Step1_withReductions, &Atom_DifferentialEquation::RunROS2_Step1_withReductions);
+
+				calculate_dmdt = false;
+				dmdt = 0.0;
+				podeSolver->Set_dmdt();
+				patom_odeSolver->Set_dmdt();
+			}
+			else {
+
+				Run_Stage(&DifferentialEquation::RunROS2_Step1, &Atom_DifferentialEquation::RunROS2_Step1);
+			}
+
+			evalStep = 0;
+			time += dT;
+			stagetime += dT;
+			iteration++;
+			stageiteration++;
+			available = true;
+		}
+#endif
+	}
+	break;
+
 	case EVAL_ABM:
 	{
 #ifdef ODE_EVAL_COMPILATION_ABM
@@ -297,15 +517,7 @@ void ODECommon_Base::Iterate(void)
 
 				if (calculate_mxh) {
 
-					for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-						podeSolver->pODE[idx]->RunABM_Predictor_withReductions();
-					}
-
-					for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-						patom_odeSolver->pODE[idx]->RunABM_Predictor_withReductions();
-					}
+					Run_Stage(&DifferentialEquation::RunABM_Predictor_withReductions, &Atom_DifferentialEquation::RunABM_Predictor_withReductions);
 
 					calculate_mxh = false;
 
@@ -315,15 +527,7 @@ void ODECommon_Base::Iterate(void)
 				}
 				else {
 
-					for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-						podeSolver->pODE[idx]->RunABM_Predictor();
-					}
-
-					for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-						patom_odeSolver->pODE[idx]->RunABM_Predictor();
-					}
+					Run_Stage(&DifferentialEquation::RunABM_Predictor, &Atom_DifferentialEquation::RunABM_Predictor);
 				}
 
 				evalStep = 1;
@@ -333,15 +537,7 @@ void ODECommon_Base::Iterate(void)
 
 				if (calculate_dmdt) {
 
-					for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-						podeSolver->pODE[idx]->RunABM_Corrector_withReductions();
-					}
-
-					for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-						patom_odeSolver->pODE[idx]->RunABM_Corrector_withReductions();
-					}
+					Run_Stage(&DifferentialEquation::RunABM_Corrector_withReductions, &Atom_DifferentialEquation::RunABM_Corrector_withReductions);
 
 					calculate_dmdt = false;
 
@@ -351,15 +547,7 @@ void ODECommon_Base::Iterate(void)
 				}
 				else {
 
-					for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-						podeSolver->pODE[idx]->RunABM_Corrector();
-					}
-
-					for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-						patom_odeSolver->pODE[idx]->RunABM_Corrector();
-					}
+					Run_Stage(&DifferentialEquation::RunABM_Corrector, &Atom_DifferentialEquation::RunABM_Corrector);
 				}
 
 				evalStep = 0;
@@ -390,30 +578,14 @@ void ODECommon_Base::Iterate(void)
 
 			if (evalStep == 0) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunABM_TEuler0();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunABM_TEuler0();
-				}
+				Run_Stage(&DifferentialEquation::RunABM_TEuler0, &Atom_DifferentialEquation::RunABM_TEuler0);
 
 				evalStep = 1;
 				available = false;
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunABM_TEuler1();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunABM_TEuler1();
-				}
+				Run_Stage(&DifferentialEquation::RunABM_TEuler1, &Atom_DifferentialEquation::RunABM_TEuler1);
 
 				evalStep = 0;
 				available = true;
@@ -440,15 +612,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRK23_Step0_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRK23_Step0_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRK23_Step0_withReductions, &Atom_DifferentialEquation::RunRK23_Step0_withReductions);
 
 				calculate_mxh = false;
 				mxh = 0.0;
@@ -457,15 +621,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRK23_Step0();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRK23_Step0();
-				}
+				Run_Stage(&DifferentialEquation::RunRK23_Step0, &Atom_DifferentialEquation::RunRK23_Step0);
 			}
 
 			available = false;
@@ -492,49 +648,108 @@ void ODECommon_Base::Iterate(void)
 			else primed = true;
 
 			//Advance with new stepsize
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			Run_Stage(&DifferentialEquation::RunRK23_Step0_Advance, &Atom_DifferentialEquation::RunRK23_Step0_Advance);
 
-				podeSolver->pODE[idx]->RunRK23_Step0_Advance();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+			evalStep++;
+		}
+		break;
 
-				patom_odeSolver->pODE[idx]->RunRK23_Step0_Advance();
-			}
+		case 1:
+		{
+			Run_Stage(&DifferentialEquation::RunRK23_Step1, &Atom_DifferentialEquation::RunRK23_Step1);
 
 			evalStep++;
 		}
 		break;
 
-		case 1:
+		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			if (calculate_dmdt) {
 
-				podeSolver->pODE[idx]->RunRK23_Step1();
-			}
+				Run_Stage(&DifferentialEquation::RunRK23_Step2_withReductions, &Atom_DifferentialEquation::RunRK23_Step2_withReductions);
 
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				calculate_dmdt = false;
+				dmdt = 0.0;
+				podeSolver->Set_dmdt();
+				patom_odeSolver->Set_dmdt();
+			}
+			else {
 
-				patom_odeSolver->pODE[idx]->RunRK23_Step1();
+				Run_Stage(&DifferentialEquation::RunRK23_Step2, &Atom_DifferentialEquation::RunRK23_Step2);
 			}
 
-			evalStep++;
+			evalStep = 0;
+			time += dT;
+			stagetime += dT;
+			iteration++;
+			stageiteration++;
+			available = true;
 		}
 		break;
+		}
+#endif
+	}
+	break;
 
-		case 2:
-		{
-			if (calculate_dmdt) {
+	case EVAL_RKC:
+	{
+#ifdef ODE_EVAL_COMPILATION_RKC
+		if (evalStep == 0) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+			if (calculate_mxh) {
 
-					podeSolver->pODE[idx]->RunRK23_Step2_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRKC_Step0_withReductions, &Atom_DifferentialEquation::RunRKC_Step0_withReductions);
 
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+				calculate_mxh = false;
+				mxh = 0.0;
+				podeSolver->Set_mxh();
+				patom_odeSolver->Set_mxh();
+			}
+			else {
+
+				Run_Stage(&DifferentialEquation::RunRKC_Step0, &Atom_DifferentialEquation::RunRKC_Step0);
+			}
 
-					patom_odeSolver->pODE[idx]->RunRK23_Step2_withReductions();
+			available = false;
+
+			//RKC error estimate uses the equation evaluated at the end of the time step, so as for RK23 the error is calculated on this first stage -> must be primed by a full pass first
+			//If the step has failed then restore magnetization, and also set primed to false -> we must now take a full pass again before we can calculate a new stepsize.
+			if (primed) {
+
+				dT_last = dT;
+				lte = 0.0;
+				podeSolver->Set_lte();
+				patom_odeSolver->Set_lte();
+
+				if (!SetAdaptiveTimeStep()) {
+
+					primed = false;
+					podeSolver->Restore();
+					patom_odeSolver->Restore();
+					break;
 				}
+			}
+			else primed = true;
+
+			//number of stages for the new time step
+			RKC_Set_Stages();
+
+			//Advance with new stepsize
+			Run_Stage(&DifferentialEquation::RunRKC_Step0_Advance, &Atom_DifferentialEquation::RunRKC_Step0_Advance);
+
+			evalStep++;
+		}
+		else if (evalStep < rkc_stages - 1) {
+
+			Run_Stage(&DifferentialEquation::RunRKC_Step, &Atom_DifferentialEquation::RunRKC_Step);
+
+			evalStep++;
+		}
+		else {
+
+			if (calculate_dmdt) {
+
+				Run_Stage(&DifferentialEquation::RunRKC_LastStep_withReductions, &Atom_DifferentialEquation::RunRKC_LastStep_withReductions);
 
 				calculate_dmdt = false;
 				dmdt = 0.0;
@@ -543,15 +758,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRK23_Step2();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRK23_Step2();
-				}
+				Run_Stage(&DifferentialEquation::RunRKC_LastStep, &Atom_DifferentialEquation::RunRKC_LastStep);
 			}
 
 			evalStep = 0;
@@ -561,8 +768,6 @@ void ODECommon_Base::Iterate(void)
 			stageiteration++;
 			available = true;
 		}
-		break;
-		}
 #endif
 	}
 	break;
@@ -576,15 +781,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRK4_Step0_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRK4_Step0_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRK4_Step0_withReductions, &Atom_DifferentialEquation::RunRK4_Step0_withReductions);
 
 				calculate_mxh = false;
 				mxh = 0.0;
@@ -593,15 +790,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRK4_Step0();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRK4_Step0();
-				}
+				Run_Stage(&DifferentialEquation::RunRK4_Step0, &Atom_DifferentialEquation::RunRK4_Step0);
 			}
 
 			evalStep++;
@@ -611,15 +800,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRK4_Step1();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRK4_Step1();
-			}
+			Run_Stage(&DifferentialEquation::RunRK4_Step1, &Atom_DifferentialEquation::RunRK4_Step1);
 
 			evalStep++;
 		}
@@ -627,15 +808,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRK4_Step2();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRK4_Step2();
-			}
+			Run_Stage(&DifferentialEquation::RunRK4_Step2, &Atom_DifferentialEquation::RunRK4_Step2);
 
 			evalStep++;
 		}
@@ -645,15 +818,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRK4_Step3_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRK4_Step3_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRK4_Step3_withReductions, &Atom_DifferentialEquation::RunRK4_Step3_withReductions);
 
 				calculate_dmdt = false;
 				dmdt = 0.0;
@@ -662,15 +827,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRK4_Step3();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRK4_Step3();
-				}
+				Run_Stage(&DifferentialEquation::RunRK4_Step3, &Atom_DifferentialEquation::RunRK4_Step3);
 			}
 
 			evalStep = 0;
@@ -696,15 +853,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKF45_Step0_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKF45_Step0_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRKF45_Step0_withReductions, &Atom_DifferentialEquation::RunRKF45_Step0_withReductions);
 
 				calculate_mxh = false;
 				mxh = 0.0;
@@ -713,15 +862,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKF45_Step0();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKF45_Step0();
-				}
+				Run_Stage(&DifferentialEquation::RunRKF45_Step0, &Atom_DifferentialEquation::RunRKF45_Step0);
 			}
 
 			evalStep++;
@@ -731,15 +872,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKF45_Step1();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKF45_Step1();
-			}
+			Run_Stage(&DifferentialEquation::RunRKF45_Step1, &Atom_DifferentialEquation::RunRKF45_Step1);
 
 			evalStep++;
 		}
@@ -747,31 +880,15 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKF45_Step2();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKF45_Step2();
-			}
+			Run_Stage(&DifferentialEquation::RunRKF45_Step2, &Atom_DifferentialEquation::RunRKF45_Step2);
 
 			evalStep++;
 		}
-		break;
-
-		case 3:
-		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKF45_Step3();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
+		break;
 
-				patom_odeSolver->pODE[idx]->RunRKF45_Step3();
-			}
+		case 3:
+		{
+			Run_Stage(&DifferentialEquation::RunRKF45_Step3, &Atom_DifferentialEquation::RunRKF45_Step3);
 
 			evalStep++;
 		}
@@ -779,15 +896,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 4:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKF45_Step4();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKF45_Step4();
-			}
+			Run_Stage(&DifferentialEquation::RunRKF45_Step4, &Atom_DifferentialEquation::RunRKF45_Step4);
 
 			evalStep++;
 		}
@@ -797,15 +906,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKF45_Step5_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKF45_Step5_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRKF45_Step5_withReductions, &Atom_DifferentialEquation::RunRKF45_Step5_withReductions);
 
 				calculate_dmdt = false;
 				dmdt = 0.0;
@@ -814,15 +915,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKF45_Step5();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKF45_Step5();
-				}
+				Run_Stage(&DifferentialEquation::RunRKF45_Step5, &Atom_DifferentialEquation::RunRKF45_Step5);
 			}
 
 			evalStep = 0;
@@ -858,15 +951,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKCK45_Step0_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKCK45_Step0_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRKCK45_Step0_withReductions, &Atom_DifferentialEquation::RunRKCK45_Step0_withReductions);
 
 				calculate_mxh = false;
 				mxh = 0.0;
@@ -875,15 +960,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKCK45_Step0();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKCK45_Step0();
-				}
+				Run_Stage(&DifferentialEquation::RunRKCK45_Step0, &Atom_DifferentialEquation::RunRKCK45_Step0);
 			}
 
 			evalStep++;
@@ -893,15 +970,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKCK45_Step1();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKCK45_Step1();
-			}
+			Run_Stage(&DifferentialEquation::RunRKCK45_Step1, &Atom_DifferentialEquation::RunRKCK45_Step1);
 
 			evalStep++;
 		}
@@ -909,15 +978,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKCK45_Step2();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKCK45_Step2();
-			}
+			Run_Stage(&DifferentialEquation::RunRKCK45_Step2, &Atom_DifferentialEquation::RunRKCK45_Step2);
 
 			evalStep++;
 		}
@@ -925,15 +986,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 3:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKCK45_Step3();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKCK45_Step3();
-			}
+			Run_Stage(&DifferentialEquation::RunRKCK45_Step3, &Atom_DifferentialEquation::RunRKCK45_Step3);
 
 			evalStep++;
 		}
@@ -941,15 +994,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 4:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKCK45_Step4();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKCK45_Step4();
-			}
+			Run_Stage(&DifferentialEquation::RunRKCK45_Step4, &Atom_DifferentialEquation::RunRKCK45_Step4);
 
 			evalStep++;
 		}
@@ -959,15 +1004,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKCK45_Step5_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKCK45_Step5_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRKCK45_Step5_withReductions, &Atom_DifferentialEquation::RunRKCK45_Step5_withReductions);
 
 				calculate_dmdt = false;
 				dmdt = 0.0;
@@ -976,15 +1013,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKCK45_Step5();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKCK45_Step5();
-				}
+				Run_Stage(&DifferentialEquation::RunRKCK45_Step5, &Atom_DifferentialEquation::RunRKCK45_Step5);
 			}
 
 			evalStep = 0;
@@ -1020,15 +1049,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_mxh) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKDP54_Step0_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKDP54_Step0_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRKDP54_Step0_withReductions, &Atom_DifferentialEquation::RunRKDP54_Step0_withReductions);
 
 				calculate_mxh = false;
 				mxh = 0.0;
@@ -1037,15 +1058,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKDP54_Step0();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKDP54_Step0();
-				}
+				Run_Stage(&DifferentialEquation::RunRKDP54_Step0, &Atom_DifferentialEquation::RunRKDP54_Step0);
 			}
 
 			available = false;
@@ -1072,15 +1085,7 @@ void ODECommon_Base::Iterate(void)
 			else primed = true;
 
 			//Advance magnetization with new stepsize
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKDP54_Step0_Advance();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKDP54_Step0_Advance();
-			}
+			Run_Stage(&DifferentialEquation::RunRKDP54_Step0_Advance, &Atom_DifferentialEquation::RunRKDP54_Step0_Advance);
 
 			evalStep++;
 		}
@@ -1088,15 +1093,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 1:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKDP54_Step1();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKDP54_Step1();
-			}
+			Run_Stage(&DifferentialEquation::RunRKDP54_Step1, &Atom_DifferentialEquation::RunRKDP54_Step1);
 
 			evalStep++;
 		}
@@ -1104,15 +1101,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 2:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKDP54_Step2();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKDP54_Step2();
-			}
+			Run_Stage(&DifferentialEquation::RunRKDP54_Step2, &Atom_DifferentialEquation::RunRKDP54_Step2);
 
 			evalStep++;
 		}
@@ -1120,15 +1109,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 3:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKDP54_Step3();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKDP54_Step3();
-			}
+			Run_Stage(&DifferentialEquation::RunRKDP54_Step3, &Atom_DifferentialEquation::RunRKDP54_Step3);
 
 			evalStep++;
 		}
@@ -1136,15 +1117,7 @@ void ODECommon_Base::Iterate(void)
 
 		case 4:
 		{
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunRKDP54_Step4();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunRKDP54_Step4();
-			}
+			Run_Stage(&DifferentialEquation::RunRKDP54_Step4, &Atom_DifferentialEquation::RunRKDP54_Step4);
 
 			evalStep++;
 		}
@@ -1154,15 +1127,7 @@ void ODECommon_Base::Iterate(void)
 		{
 			if (calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKDP54_Step5_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKDP54_Step5_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunRKDP54_Step5_withReductions, &Atom_DifferentialEquation::RunRKDP54_Step5_withReductions);
 
 				calculate_dmdt = false;
 				dmdt = 0.0;
@@ -1171,15 +1136,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunRKDP54_Step5();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunRKDP54_Step5();
-				}
+				Run_Stage(&DifferentialEquation::RunRKDP54_Step5, &Atom_DifferentialEquation::RunRKDP54_Step5);
 			}
 
 			evalStep = 0;
@@ -1218,15 +1175,7 @@ void ODECommon_Base::Iterate(void)
 			patom_odeSolver->delta_G_sq = 0.0;
 			patom_odeSolver->delta_M_dot_delta_G = 0.0;
 
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunSD_BB();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunSD_BB();
-			}
+			Run_Stage(&DifferentialEquation::RunSD_BB, &Atom_DifferentialEquation::RunSD_BB);
 
 			//2. Set stepsize - alternate between BB values
 			if (iteration % 2) {
@@ -1306,15 +1255,7 @@ void ODECommon_Base::Iterate(void)
 			//3. set new magnetization vectors
 			if (calculate_mxh || calculate_dmdt) {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunSD_Advance_withReductions();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunSD_Advance_withReductions();
-				}
+				Run_Stage(&DifferentialEquation::RunSD_Advance_withReductions, &Atom_DifferentialEquation::RunSD_Advance_withReductions);
 
 				if (calculate_mxh) {
 
@@ -1334,15 +1275,7 @@ void ODECommon_Base::Iterate(void)
 			}
 			else {
 
-				for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-					podeSolver->pODE[idx]->RunSD_Advance();
-				}
-
-				for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-					patom_odeSolver->pODE[idx]->RunSD_Advance();
-				}
+				Run_Stage(&DifferentialEquation::RunSD_Advance, &Atom_DifferentialEquation::RunSD_Advance);
 			}
 
 			iteration++;
@@ -1355,15 +1288,7 @@ void ODECommon_Base::Iterate(void)
 			dT = dT_min;
 
 			//0. prime the SD solver
-			for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
-
-				podeSolver->pODE[idx]->RunSD_Start();
-			}
-
-			for (int idx = 0; idx < patom_odeSolver->pODE.size(); idx++) {
-
-				patom_odeSolver->pODE[idx]->RunSD_Start();
-			}
+			Run_Stage(&DifferentialEquation::RunSD_Start, &Atom_DifferentialEquation::RunSD_Start);
 
 			evalStep = 0;
 			iteration++;
@@ -1377,6 +1302,152 @@ void ODECommon_Base::Iterate(void)
 #endif
 	}
 	break;
+
+	case EVAL_NCG:
+	{
+#ifdef ODE_EVAL_COMPILATION_NCG
+		//Each iteration is a single energy and effective field evaluation at the current point of the line search, with magnetization set from sM1 along the search direction (saved in sEval0) with step ncg_alpha.
+		//Line search finishes when the weak Wolfe conditions are met (Armijo sufficient decrease and curvature conditions), after which the next search direction is set using the Polak-Ribiere+ formula.
+		//Step sizes and directions are preconditioned so the line search step has units of time, as for the SD solver.
+
+		//1. directional derivative of total energy at current point of the line search (also mxh and dmdt if needed)
+		ncg_dE = 0.0;
+
+		if (calculate_mxh || calculate_dmdt) {
+
+			Run_Stage(&DifferentialEquation::RunNCG_Evaluate_withReductions, &Atom_DifferentialEquation::RunNCG_Evaluate_withReductions);
+
+			if (calculate_mxh) {
+
+				calculate_mxh = false;
+				mxh = 0.0;
+				podeSolver->Set_mxh();
+				patom_odeSolver->Set_mxh();
+			}
+
+			if (calculate_dmdt) {
+
+				calculate_dmdt = false;
+				dmdt = 0.0;
+				podeSolver->Set_dmdt();
+				patom_odeSolver->Set_dmdt();
+			}
+		}
+		else {
+
+			Run_Stage(&DifferentialEquation::RunNCG_Evaluate, &Atom_DifferentialEquation::RunNCG_Evaluate);
+		}
+
+		//2. line search step
+		bool new_direction = !primed;
+
+		if (primed) {
+
+			ncg_evals++;
+
+			//sufficient decrease condition
+			bool armijo = (ncg_energy <= ncg_energy0 + NCG_ARMIJO * ncg_alpha * ncg_dE0 + NCG_ENERGY_EPS * fabs(ncg_energy0));
+
+			if (!armijo) {
+
+				//step too large : minimum is below this step
+				ncg_alpha_hi = ncg_alpha;
+
+				//quadratic interpolation if we only have the starting point, else bisection, keeping away from the bracket ends
+				if (ncg_alpha_lo == 0.0) {
+
+					double curvature = ncg_energy - ncg_energy0 - ncg_dE0 * ncg_alpha;
+					double alpha_q = (curvature > 0.0 ? -ncg_dE0 * ncg_alpha * ncg_alpha / (2 * curvature) : 0.5 * ncg_alpha);
+					ncg_alpha = maximum(0.1 * ncg_alpha, minimum(alpha_q, 0.5 * ncg_alpha));
+				}
+				else ncg_alpha = (ncg_alpha_lo + ncg_alpha_hi) / 2;
+			}
+			else if (ncg_dE < NCG_WOLFE * ncg_dE0) {
+
+				//curvature condition not met : energy still decreasing too steeply, so step is too small
+				ncg_alpha_lo = ncg_alpha;
+
+				if (ncg_alpha_hi > 0.0) ncg_alpha = (ncg_alpha_lo + ncg_alpha_hi) / 2;
+				else ncg_alpha *= NCG_EXPAND;
+			}
+			//both conditions met : accept current point
+			else new_direction = true;
+
+			if (!new_direction && ncg_evals >= NCG_MAXEVALS) {
+
+				//line search failed : accept current point if it decreased the energy, else go back to start of line search and restart with steepest descent
+				if (armijo) new_direction = true;
+				else {
+
+					podeSolver->Restore();
+					patom_odeSolver->Restore();
+					dT = NCG_DEFAULT_DT;
+					primed = false;
+
+					//the fields computed at the restored magnetization are needed before starting a new line search
+					iteration++;
+					stageiteration++;
+					break;
+				}
+			}
+		}
+
+		//3. new search direction from current point
+		if (new_direction) {
+
+			ncg_beta = 0.0;
+
+			//Polak-Ribiere+ beta : if not primed we have no previous direction so start with steepest descent
+			if (primed) {
+
+				ncg_beta_num = 0.0;
+				ncg_beta_den = 0.0;
+
+				Run_Stage(&DifferentialEquation::RunNCG_Beta, &Atom_DifferentialEquation::RunNCG_Beta);
+
+				if (ncg_beta_den > 0.0) ncg_beta = maximum(0.0, ncg_beta_num / ncg_beta_den);
+			}
+
+			//set new direction, saving current magnetization as the start of the line search; this also accumulates the directional derivative at the start
+			ncg_dE = 0.0;
+			Run_Stage(&DifferentialEquation::RunNCG_Direction, &Atom_DifferentialEquation::RunNCG_Direction);
+
+			//not a descent direction : restart with steepest descent
+			if (ncg_beta > 0.0 && ncg_dE >= 0.0) {
+
+				ncg_beta = 0.0;
+				ncg_dE = 0.0;
+				Run_Stage(&DifferentialEquation::RunNCG_Direction, &Atom_DifferentialEquation::RunNCG_Direction);
+			}
+
+			//first step in new direction : previous step scaled by ratio of directional derivatives (Nocedal and Wright, Numerical Optimization, 3.60), or the set starting step
+			if (primed && ncg_dE < 0.0) ncg_alpha *= ncg_dE0 / ncg_dE;
+			else ncg_alpha = dT;
+
+			if (ncg_alpha < dT_min) ncg_alpha = dT_min;
+			if (ncg_alpha > dT_max) ncg_alpha = dT_max;
+
+			ncg_energy0 = ncg_energy;
+			ncg_dE0 = ncg_dE;
+			ncg_alpha_lo = 0.0;
+			ncg_alpha_hi = 0.0;
+			ncg_evals = 0;
+
+			primed = true;
+		}
+
+		//4. set magnetization at next point of the line search
+		Run_Stage(&DifferentialEquation::RunNCG_Move, &Atom_DifferentialEquation::RunNCG_Move);
+
+		dT = ncg_alpha;
+
+		iteration++;
+		stageiteration++;
+		time += dT;
+		stagetime += dT;
+#endif
+	}
+	break;
 	}
 }
 
@@ -1388,6 +1459,9 @@ void ODECommon_Base::Iterate(void)
 //To enable this mode you need to set use_evaluation_speedup != EVALSPEEDUP_NONE
 int ODECommon_Base::Check_Step_Update(void)
 {
+	//value fixed for this evaluation
+	if (step_update >= 0) return step_update;
+
 	//must enable by setting use_evaluation_speedup != EVALSPEEDUP_NONE
 	if (use_evaluation_speedup == EVALSPEEDUP_NONE) return EVALSPEEDUPSTEP_COMPUTE_NO_SAVE;
 
@@ -1505,7 +1579,10 @@ int ODECommon_Base::Check_Step_Update(void)
 	}
 	break;
 
+	//Cayley : same evaluation steps as AHeun; ROS2 : also 2 evaluation steps, with the second at the mid-step
 	case EVAL_AHEUN:
+	case EVAL_CAYLEY:
+	case EVAL_ROS2:
 	{
 		//0: 0, 1: 1/2
 
@@ -1546,11 +1623,24 @@ int ODECommon_Base::Check_Step_Update(void)
 	break;
 
 	case EVAL_SD:
+	case EVAL_NCG:
 	{
 		return EVALSPEEDUPSTEP_COMPUTE_NO_SAVE;
 	}
 	break;
 
+	case EVAL_RKC:
+	{
+		//variable number of stages, with nodes increasing from 0 (first stage evaluated at end of previous time step, so no previous evaluation to re-use)
+
+		//Accurate : no skipping
+		//Aggressive, Extreme : evaluate on 0 only (some loss of accuracy - the exchange field, which sets the number of stages, is always computed)
+
+		if (use_evaluation_speedup == EVALSPEEDUP_ACCURATE || evalStep == 0) return EVALSPEEDUPSTEP_COMPUTE_AND_SAVE;
+		else return EVALSPEEDUPSTEP_SKIP;
+	}
+	break;
+
 	case EVAL_RKF:
 	{
 		//0: 0, 1: 1/4, 2: 3/8, 3: 12/13, 4: 1, 5: 1/2
@@ -1589,4 +1679,85 @@ int ODECommon_Base::Check_Step_Update(void)
 	}
 
 	return EVALSPEEDUPSTEP_COMPUTE_AND_SAVE;
-}
\ No newline at end of file
+}
+
+//fix Check_Step_Update value before meshes update their effective fields for an evaluation (status = true), and release it after (status = false).
+void ODECommon_Base::Fix_Step_Update(bool status)
+{
+	step_update = -1;
+	if (status) step_update = Check_Step_Update();
+}
+
+//time at which the effective field is evaluated in the current evaluation step : time + c * dT, where c is the stage node of the evaluation method for the current evaluation step
+//time is only incremented at the end of a full time step, so evaluation steps within a time step need the stage nodes of the method
+double ODECommon_Base::Get_EvalStep_Time(void)
+{
+	//TEuler, AHeun, Cayley, ABM : predictor then corrector, with corrector evaluated using predicted magnetization at end of time step
+	static double nodes_predictor_corrector[2] = { 0.0, 1.0 };
+
+	//ROS2 : second stage evaluated at mid-step
+	static double nodes_ros2[2] = { 0.0, 1.0 / 2 };
+
+	//RK23
+	static double nodes_rk23[3] = { 0.0, 1.0 / 2, 3.0 / 4 };
+
+	//RK4
+	static double nodes_rk4[4] = { 0.0, 1.0 / 2, 1.0 / 2, 1.0 };
+
+	//RKF
+	static double nodes_rkf[6] = { 0.0, 1.0 / 4, 3.0 / 8, 12.0 / 13, 1.0, 1.0 / 2 };
+
+	//RKCK
+	static double nodes_rkck[6] = { 0.0, 1.0 / 5, 3.0 / 10, 3.0 / 5, 1.0, 7.0 / 8 };
+
+	//RKDP
+	static double nodes_rkdp[6] = { 0.0, 1.0 / 5, 3.0 / 10, 4.0 / 5, 8.0 / 9, 1.0 };
+
+	switch (evalMethod) {
+
+	case EVAL_TEULER:
+	case EVAL_AHEUN:
+	case EVAL_CAYLEY:
+	case EVAL_ABM:
+		return time + nodes_predictor_corrector[evalStep] * dT;
+
+	case EVAL_ROS2:
+		return time + nodes_ros2[evalStep] * dT;
+
+	case EVAL_RK23:
+		return time + nodes_rk23[evalStep] * dT;
+
+	case EVAL_RK4:
+		return time + nodes_rk4[evalStep] * dT;
+
+	case EVAL_RKF:
+		return time + nodes_rkf[evalStep] * dT;
+
+	case EVAL_RKCK:
+		return time + nodes_rkck[evalStep] * dT;
+
+	case EVAL_RKDP:
+		return time + nodes_rkdp[evalStep] * dT;
+
+	case EVAL_RKC:
+		if (evalStep < (int)rkc_nodes.size()) return time + rkc_nodes[evalStep] * dT;
+		else return time;
+	}
+
+	//Euler, SD : single evaluation at start of time step
+	return time;
+}
+
+//modules using field extrapolation report the relative error of extrapolation against a full field evaluation here
+void ODECommon_Base::Report_EvalSpeedup_Error(double error_value)
+{
+	//keep maximum value reported in the current time step (there can be multiple modules reporting, e.g. demag modules in different meshes, which can run concurrently)
+#pragma omp critical
+	{
+		if (time != evalspeedup_error_time || error_value > evalspeedup_error) {
+
+			evalspeedup_error = error_value;
+			evalspeedup_error_time = time;
+		}
+	}
+}
@@ -0,0 +1,147 @@
+#include "stdafx.h"
+#include "DiffEq_CommonBase.h"
+
+#include "DiffEq_Common.h"
+#include "Atom_DiffEq_Common.h"
+
+#include "DiffEq.h"
+#include "Atom_DiffEq.h"
+
+//----------------------------------- Multi-rate time stepping
+
+//Micromagnetic meshes advance first with their own time step, with atomistic meshes held at their start of step values.
+//Atomistic meshes then sub-cycle from the start to the end of this time step with their own time step, with micromagnetic meshes magnetization interpolated at each atomistic evaluation time.
+//Only one set of solvers is kept in pODE at any time, so Iterate and the evaluation methods don't need to know about this.
+
+//set atomistic time step for multi-rate time stepping (0 to disable)
+void ODECommon_Base::SetdT_MultiRate(double dT_multirate_)
+{
+	dT_multirate = dT_multirate_;
+
+	multirate_dT = dT_multirate;
+	multirate_dT_last = dT_multirate;
+	multirate_primed = false;
+}
+
+//use multi-rate time stepping? enabled, both micromagnetic and atomistic solvers present, and evaluation method completes each time step on its own :
+//not for methods which carry data between time steps (ABM, SD, NCG), or accept a time step only at the start of the next one (FSAL methods RK23, RKDP, RKC)
+bool ODECommon_Base::MultiRate_Active(void)
+{
+	return dT_multirate > 0.0 && podeSolver->pODE.size() && patom_odeSolver->pODE.size() && 
+		evalMethod != EVAL_ABM && evalMethod != EVAL_SD && evalMethod != EVAL_NCG && evalMethod != EVAL_RK23 && evalMethod != EVAL_RKDP && evalMethod != EVAL_RKC;
+}
+
+//set aside atomistic solvers so Iterate only advances micromagnetic solvers : atomistic meshes are held at their values at the start of the time step
+void ODECommon_Base::MultiRate_Begin_Micromagnetic(void)
+{
+	multirate_patom_ODE = std::move(patom_odeSolver->pODE);
+	patom_odeSolver->pODE.clear();
+}
+
+//micromagnetic time step completed from time_start : set aside micromagnetic solvers, saving their end of step magnetization, and bring back atomistic solvers with their time step control data, starting from time_start
+BError ODECommon_Base::MultiRate_Begin_Atomistic(double time_start)
+{
+	BError error(CLASS_STR(ODECommon_Base));
+
+	for (int idx = 0; idx < podeSolver->pODE.size(); idx++) {
+
+		if (!error) error = podeSolver->pODE[idx]->MultiRate_Save();
+	}
+
+	//out of memory : MultiRate_End will only bring back atomistic solvers
+	if (error) return error;
+
+	multirate_pODE = std::move(podeSolver->pODE);
+	podeSolver->pODE.clear();
+
+	patom_odeSolver->pODE = std::move(multirate_patom_ODE);
+	multirate_patom_ODE.clear();
+
+	//micromagnetic time step to sub-cycle
+	multirate_time_start = time_start;
+	multirate_time_end = time;
+
+	multirate_iteration = iteration;
+	multirate_stageiteration = stageiteration;
+
+	stagetime -= time - time_start;
+	time = time_start;
+
+	//first sub-cycle uses the set atomistic time step
+	if (multirate_dT <= 0.0) multirate_dT = multirate_dT_last = dT_multirate;
+	multirate_dT_unlimited = 0.0;
+
+	std::swap(dT, multirate_dT);
+	std::swap(dT_last, multirate_dT_last);
+	std::swap(time_stoch, multirate_time_stoch);
+	std::swap(time_speedup, multirate_time_speedup);
+	std::swap(primed, multirate_primed);
+
+	return error;
+}
+
+//atomistic sub-cycling reached the end of the micromagnetic time step?
+bool ODECommon_Base::MultiRate_SubCycle_Done(void)
+{
+	//allow for rounding error
+	return time >= multirate_time_end - 1e-6 * dT_min;
+}
+
+//before each atomistic evaluation : limit time step so sub-cycling finishes at the end of the micromagnetic time step, and set micromagnetic magnetization interpolated at the evaluation time
+void ODECommon_Base::MultiRate_Prepare_Evaluation(void)
+{
+	if (evalStep == 0 && time + dT > multirate_time_end) {
+
+		//keep time step the atomistic solver would have used for the next sub-cycle
+		multirate_dT_unlimited = dT;
+		dT = multirate_time_end - time;
+	}
+
+	double fraction = (Get_EvalStep_Time() - multirate_time_start) / (multirate_time_end - multirate_time_start);
+	fraction = (fraction < 0.0 ? 0.0 : (fraction > 1.0 ? 1.0 : fraction));
+
+	for (int idx = 0; idx < multirate_pODE.size(); idx++) {
+
+		multirate_pODE[idx]->MultiRate_Interpolate(fraction);
+	}
+}
+
+//atomistic sub-cycling finished : bring back micromagnetic solvers with their end of step magnetization and time step control data
+void ODECommon_Base::MultiRate_End(void)
+{
+	//micromagnetic solvers set aside whilst atomistic meshes sub-cycled
+	if (multirate_pODE.size()) {
+
+		for (int idx = 0; idx < multirate_pODE.size(); idx++) {
+
+			multirate_pODE[idx]->MultiRate_Restore();
+		}
+
+		podeSolver->pODE = std::move(multirate_pODE);
+		multirate_pODE.clear();
+
+		//a time step limited to finish the sub-cycling is not kept for the next sub-cycling
+		if (multirate_dT_unlimited > dT) dT = multirate_dT_unlimited;
+
+		std::swap(dT, multirate_dT);
+		std::swap(dT_last, multirate_dT_last);
+		std::swap(time_stoch, multirate_time_stoch);
+		std::swap(time_speedup, multirate_time_speedup);
+		std::swap(primed, multirate_primed);
+
+		stagetime += multirate_time_end - time;
+		time = multirate_time_end;
+
+		iteration = multirate_iteration;
+		stageiteration = multirate_stageiteration;
+	}
+
+	//atomistic solvers still set aside if sub-cycling could not be started
+	if (multirate_patom_ODE.size()) {
+
+		patom_odeSolver->pODE = std::move(multirate_patom_ODE);
+		multirate_patom_ODE.clear();
+	}
+
+	available = true;
+}
@@ -23,6 +23,8 @@
 #define AHEUN_RELERRMIN	8e-5
 //When increasing the time step multiply it with this
 #define AHEUN_DTINCREASE	1.001
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define AHEUN_ERRORDER	2
 //maximum time step the method can reach
 #define AHEUN_MAXDT	1e-12
 //minimum time step the method can reach
@@ -40,6 +42,8 @@
 #define ABM_RELERRMIN	4e-5
 //When increasing the time step multiply it with this
 #define ABM_DTINCREASE	1.001
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define ABM_ERRORDER	3
 //maximum time step the method can reach
 #define ABM_MAXDT	1e-12
 //minimum time step the method can reach
@@ -56,6 +60,8 @@
 #define RK23_RELERRMIN	1e-5
 //When increasing the time step multiply it with this
 #define RK23_DTINCREASE	1.001
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define RK23_ERRORDER	3
 //maximum time step the method can reach
 #define RK23_MAXDT	2e-12
 //minimum time step the method can reach
@@ -72,6 +78,8 @@
 #define RKF_RELERRMIN	1e-5
 //When increasing the time step multiply it with this
 #define RKF_DTINCREASE	1.001
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define RKF_ERRORDER	5
 //maximum time step the method can reach
 #define RKF_MAXDT	3e-12
 //minimum time step the method can reach
@@ -88,6 +96,8 @@
 #define RKCK_RELERRMIN	1e-5
 //When increasing the time step multiply it with this
 #define RKCK_DTINCREASE	1.001
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define RKCK_ERRORDER	5
 //maximum time step the method can reach
 #define RKCK_MAXDT	3e-12
 //minimum time step the method can reach
@@ -104,6 +114,8 @@
 #define RKDP_RELERRMIN	1e-5
 //When increasing the time step multiply it with this
 #define RKDP_DTINCREASE	1.001
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define RKDP_ERRORDER	5
 //maximum time step the method can reach
 #define RKDP_MAXDT	3e-12
 //minimum time step the method can reach
@@ -115,6 +127,112 @@
 #define SD_DEFAULT_DT	1e-13
 #define SD_MAXDT	1e-11
 #define SD_MINDT	SD_DEFAULT_DT
+//with the SD relaxation activity mask set, all cells are made active every this many iterations, so frozen cells are checked with all field contributions
+#define RELAXMASK_SWEEP_ITERS	100
+
+//fixed parameters for Cayley adaptive time step (norm-preserving Heun method : the magnetization length is kept exactly so larger time steps can be used than AHeun)
+//above this relative error the evaluation has failed and will be redone with a lower time step
+#define CAYLEY_RELERRFAIL	1.5e-4
+//above this relative error the time step will be reduced
+#define CAYLEY_RELERRMAX	9e-5
+//below this relative error the time step will be increased
+#define CAYLEY_RELERRMIN	8e-5
+//When increasing the time step multiply it with this
+#define CAYLEY_DTINCREASE	1.001
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define CAYLEY_ERRORDER	2
+//maximum time step the method can reach
+#define CAYLEY_MAXDT	3e-12
+//minimum time step the method can reach
+#define CAYLEY_MINDT	1e-15
+//default dT
+#define CAYLEY_DEFAULT_DT	0.5e-13
+
+//fixed parameters for ROS2 adaptive time step (2nd order Rosenbrock-W method with FSAL 3rd order error estimate, with exchange treated implicitly in ferromagnetic meshes so the time step is not limited by exchange stiffness for small cellsizes)
+//the error estimate is for the 2nd order solution which is kept, whereas RKF45 keeps the 5th order solution : error bands are set so the accuracy is comparable to RKF45 with its default error bands
+//above this relative error the evaluation has failed and will be redone with a lower time step
+#define ROS2_RELERRFAIL	2e-6
+//above this relative error the time step will be reduced
+#define ROS2_RELERRMAX	1e-6
+//below this relative error the time step will be increased
+#define ROS2_RELERRMIN	2e-7
+//When increasing the time step multiply it with this
+#define ROS2_DTINCREASE	1.001
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define ROS2_ERRORDER	3
+//maximum time step the method can reach
+#define ROS2_MAXDT	2e-12
+//minimum time step the method can reach
+#define ROS2_MINDT	1e-15
+//default dT
+#define ROS2_DEFAULT_DT	0.5e-13
+//ROS2 method parameter, 1 / (2 + sqrt(2)) : L-stable
+#define ROS2_GAMMA	0.29289321881345248
+//ROS2 error estimate stage parameter, 6 + sqrt(2)
+#define ROS2_E32	7.4142135623730950
+//linear solver used in each stage (block Jacobi preconditioned BiCGStab) : relative residual tolerance, and maximum number of iterations (time step is rejected if not converged)
+#define ROS2_SOLVER_TOL	1e-4
+#define ROS2_SOLVER_MAXITERS	100
+
+//fixed parameters for RKC adaptive time step (Runge-Kutta-Chebyshev, 2nd order with FSAL error estimate : number of stages chosen each time step from a spectral radius estimate of the exchange operator)
+//above this relative error the evaluation has failed and will be redone with a lower time step
+#define RKC_RELERRFAIL	1e-4
+//above this relative error the time step will be reduced
+#define RKC_RELERRMAX	5e-5
+//below this relative error the time step will be increased
+#define RKC_RELERRMIN	1e-5
+//When increasing the time step multiply it with this
+#define RKC_DTINCREASE	1.01
+//order of the local error estimate (lte scales as dT^order) : used by the step size controllers
+#define RKC_ERRORDER	3
+//maximum time step the method can reach
+#define RKC_MAXDT	1e-11
+//minimum time step the method can reach
+#define RKC_MINDT	1e-15
+//default dT
+#define RKC_DEFAULT_DT	0.1e-12
+//damping parameter (stability polynomial is shifted by RKC_DAMPING / s^2 so it is kept away from 1 in magnitude)
+#define RKC_DAMPING	(2.0 / 13)
+//the spectral radius estimate only includes exchange : allow this margin for other field contributions
+#define RKC_SPECRAD_SAFETY	1.2
+//maximum number of stages : if the spectral radius needs more the time step is reduced instead
+#define RKC_MAXSTAGES	50
+
+//NCG solver (nonlinear conjugate gradient energy minimization) : the line search step is scaled as a time step, as for the SD solver
+//default dT -> first line search step, and the value it restarts from when needed
+#define NCG_DEFAULT_DT	1e-13
+//first line search step in each search direction is kept between these (line search itself can go outside this range)
+#define NCG_MAXDT	1e-10
+#define NCG_MINDT	1e-15
+//line search sufficient decrease (Armijo) and curvature (Wolfe) parameters : 0 < NCG_ARMIJO < NCG_WOLFE < 1
+#define NCG_ARMIJO	1e-4
+#define NCG_WOLFE	0.1
+//relative allowance for rounding error in the total energy when checking sufficient decrease (close to the minimum energy changes are comparable to rounding error)
+#define NCG_ENERGY_EPS	1e-12
+//multiply line search step with this whilst the minimum is not bracketed
+#define NCG_EXPAND	4.0
+//maximum number of line search evaluations in a search direction : if exceeded the solver restarts with steepest descent
+#define NCG_MAXEVALS	20
+
+//step size controllers for adaptive methods (other than the default error bands controller) : dT is multiplied by STEPCTRL_SAFETY * (err_high / lte)^(beta1 / k) * (err_high / lte_prev)^(beta2 / k) * (err_high / lte_prev2)^(beta3 / k), with k the order of the error estimate
+//safety factor, and bounds on the time step multiplier in one step (a rejected step is not increased)
+#define STEPCTRL_SAFETY	0.9
+#define STEPCTRL_MAXFACTOR	2.0
+#define STEPCTRL_MINFACTOR	0.2
+//PI controller (Gustafsson) : beta1, beta2
+#define STEPCTRL_PI_BETA1	0.7
+#define STEPCTRL_PI_BETA2	-0.4
+//PID controller (Soderlind H312PID) : beta1, beta2, beta3
+#define STEPCTRL_PID_BETA1	(1.0 / 18)
+#define STEPCTRL_PID_BETA2	(1.0 / 9)
+#define STEPCTRL_PID_BETA3	(1.0 / 18)
+
+//random number streams of atomistic solvers start from this value (micromagnetic solvers start from 0), so with the same seed set all solvers generate different thermal fields
+#define STOCHSEED_ATOM_STREAM	0x80000000
+//random number streams of ensemble replicas : replica r of a micromagnetic solver uses stream odeId + r * STOCHSEED_ENSEMBLE_STREAM (replica 0 is the solver's own stream)
+#define STOCHSEED_ENSEMBLE_STREAM	0x10000
+//maximum number of ensemble replicas (streams must stay below STOCHSEED_ATOM_STREAM)
+#define ENSEMBLE_MAXREPLICAS	4096
 
 //difficult to simulate when temperature is very close to the Curie temperature due to numerical instability, especially with stochastic equations. instead use an epsilon approach (units of Kelvin).
 #define TCURIE_EPSILON	0.5
@@ -123,7 +241,11 @@
 enum ODE_ { ODE_ERROR = -1, ODE_LLG, ODE_LLGSTT, ODE_LLB, ODE_LLBSTT, ODE_SLLG, ODE_SLLGSTT, ODE_SLLB, ODE_SLLBSTT, ODE_LLGSA, ODE_SLLGSA, ODE_LLBSA, ODE_SLLBSA, ODE_LLGSTATIC };
 
 //ODE evaluation methods enum - to keep bsm files backward compatible add new entries at the end
-enum EVAL_ { EVAL_ERROR = -1, EVAL_EULER, EVAL_TEULER, EVAL_RK4, EVAL_ABM, EVAL_RKF, EVAL_RK23, EVAL_SD, EVAL_AHEUN, EVAL_RKCK, EVAL_RKDP };
+enum EVAL_ { EVAL_ERROR = -1, EVAL_EULER, EVAL_TEULER, EVAL_RK4, EVAL_ABM, EVAL_RKF, EVAL_RK23, EVAL_SD, EVAL_AHEUN, EVAL_RKCK, EVAL_RKDP, EVAL_CAYLEY, EVAL_ROS2, EVAL_RKC, EVAL_NCG };
+
+//Equation kernels : the most used equations have inlineable versions, and evaluation method stage loops are instantiated for each of them
+//EQKERNEL_POINTER : no kernel available for set equation, call it through the equation function pointer
+enum EQKERNEL_ { EQKERNEL_POINTER = 0, EQKERNEL_LLG, EQKERNEL_LLGSTATIC, EQKERNEL_LLGSTT };
 
 //EVALSPEEDUP_NONE : evaluate all fields every step (default)
 //EVALSPEEDUP_ACCURATE : skip field evaluation but only if accuracy not "significantly" affected
@@ -131,6 +253,24 @@ enum EVAL_ { EVAL_ERROR = -1, EVAL_EULER, EVAL_TEULER, EVAL_RK4, EVAL_ABM, EVAL_
 //EVALSPEEDUP_EXTREME : only one field evaluation per time step, irrespective of how many steps the evaluation method uses
 enum EVALSPEEDUP_ { EVALSPEEDUP_NONE = 0, EVALSPEEDUP_ACCURATE, EVALSPEEDUP_AGGRESIVE, EVALSPEEDUP_EXTREME, EVALSPEEDUP_NUMENTRIES };
 
+//field used on EVALSPEEDUPSTEP_SKIP steps when evaluation speedup is enabled
+//EVALSPEEDUPEXTRAP_NONE : re-use last saved field evaluation (default)
+//EVALSPEEDUPEXTRAP_LINEAR : linear extrapolation to the evaluation step time from the last 2 saved field evaluations
+//EVALSPEEDUPEXTRAP_QUADRATIC : quadratic extrapolation to the evaluation step time from the last 3 saved field evaluations
+enum EVALSPEEDUPEXTRAP_ { EVALSPEEDUPEXTRAP_NONE = 0, EVALSPEEDUPEXTRAP_LINEAR, EVALSPEEDUPEXTRAP_QUADRATIC, EVALSPEEDUPEXTRAP_NUMENTRIES };
+
+//Step size controller for adaptive evaluation methods
+//STEPCTRL_BANDS : decrease time step above err_high, increase by fixed multiplier dT_increase below err_low (default)
+//STEPCTRL_ELEMENTARY : time step set from the current error
+//STEPCTRL_PI : time step set from the current and previous errors (PI controller)
+//STEPCTRL_PID : time step set from the current and 2 previous errors (PID controller)
+enum STEPCTRL_ { STEPCTRL_BANDS = 0, STEPCTRL_ELEMENTARY, STEPCTRL_PI, STEPCTRL_PID, STEPCTRL_NUMENTRIES };
+
+//Norm of the local truncation error over cells, used by adaptive evaluation methods
+//LTENORM_MAX : maximum cell error (default)
+//LTENORM_RMS : root-mean-square cell error
+enum LTENORM_ { LTENORM_MAX = 0, LTENORM_RMS, LTENORM_NUMENTRIES };
+
 //return values for Check_Step_Update method in DiffEq
 //EVALSPEEDUPSTEP_SKIP : do not update field, use previous calculation if available
 //EVALSPEEDUPSTEP_COMPUTE_NO_SAVE : update field and do not save calculation for next step (since at the next step we'll have to calculate field again so no point saving it)
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "BorisLib.h"
+
+//Line search updates used by the NCG (nonlinear conjugate gradient) evaluation method (micromagnetic and atomistic).
+//Search directions are perpendicular to the magnetization at the start of the line search, and are preconditioned so the line search step has units of time, as for the SD solver.
+//Include this in files defining the NCG evaluation method only.
+
+//residual (steepest descent direction) at M with effective field H : (GAMMA/2) * Ms * (component of H perpendicular to M)
+inline DBL3 NCG_Residual(const DBL3& M, const DBL3& H, double Ms)
+{
+	double Mnorm = M.norm();
+	if (!Mnorm) return DBL3();
+
+	DBL3 m = M / Mnorm;
+	return (GAMMA / 2) * Ms * (H - (H * m) * m);
+}
+
+//magnetization with norm Ms at line search step alpha, starting from M0 along search direction d : Ms * normalize(m0 + alpha * d / Ms), where m0 is M0 normalized
+inline DBL3 NCG_LinePoint(const DBL3& M0, const DBL3& d, double alpha, double Ms)
+{
+	double M0norm = M0.norm();
+	if (!M0norm || !Ms) return M0;
+
+	DBL3 m = M0 / M0norm + d * (alpha / Ms);
+	return m * (Ms / m.norm());
+}
+
+//H . dM/dalpha at magnetization M, which is at line search step alpha starting from M0 along search direction d : dM/dalpha = (d - (d.m)m) / |m0 + alpha * d / Ms|, where m is M normalized
+//multiplied by the energy gradient scaling (-MU0 * V for micromagnetic cells) this is the directional derivative of the total energy
+inline double NCG_FieldDerivative(const DBL3& M, const DBL3& H, const DBL3& M0, const DBL3& d, double alpha, double Ms)
+{
+	double Mnorm = M.norm(), M0norm = M0.norm();
+	if (!Mnorm || !M0norm || !Ms) return 0.0;
+
+	DBL3 m = M / Mnorm;
+	double length = GetMagnitude(M0 / M0norm + d * (alpha / Ms));
+
+	return (H * (d - (d * m) * m)) / length;
+}
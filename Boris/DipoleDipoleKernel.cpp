@@ -38,15 +38,15 @@ BError DipoleDipoleKernel::AllocateKernelMemory(void)
 
 //-------------------------- RUN-TIME KERNEL MULTIPLICATION
 
-//multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row)
-void DipoleDipoleKernel::KernelMultiplication_2D_line(ReIm3* pline, int i)
+//multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row). Line elements are spaced by stride in pline.
+void DipoleDipoleKernel::KernelMultiplication_2D_line(fftReIm3* pline, int i, int stride)
 {
 	//above N.y/2 use kernel symmetries to recover kernel values
 	//diagonal components are even about the N.y/2 point
 	//off-diagonal values are odd about the N.y/2 point
 
 	//j = 0
-	ReIm3 FM = pline[0];
+	fftReIm3 FM = pline[0];
 
 	int idx_start = i;
 
@@ -57,32 +57,32 @@ void DipoleDipoleKernel::KernelMultiplication_2D_line(ReIm3* pline, int i)
 	//points between 1 and N.y / 2 - 1 inclusive
 	for (int j = 1; j < N.y / 2; j++) {
 
-		ReIm3 FM_l = pline[j];
-		ReIm3 FM_h = pline[N.y - j];
+		fftReIm3 FM_l = pline[j * stride];
+		fftReIm3 FM_h = pline[(N.y - j) * stride];
 
 		int ker_index = i + j * (N.x / 2 + 1);
 
-		pline[j].x = (Kdiag[ker_index].x  * FM_l.x) + (K2D_odiag[ker_index] * FM_l.y);
-		pline[j].y = (K2D_odiag[ker_index] * FM_l.x) + (Kdiag[ker_index].y  * FM_l.y);
-		pline[j].z = (Kdiag[ker_index].z  * FM_l.z);
+		pline[j * stride].x = (Kdiag[ker_index].x  * FM_l.x) + (K2D_odiag[ker_index] * FM_l.y);
+		pline[j * stride].y = (K2D_odiag[ker_index] * FM_l.x) + (Kdiag[ker_index].y  * FM_l.y);
+		pline[j * stride].z = (Kdiag[ker_index].z  * FM_l.z);
 
-		pline[N.y - j].x = (Kdiag[ker_index].x  * FM_h.x) + (-K2D_odiag[ker_index] * FM_h.y);
-		pline[N.y - j].y = (-K2D_odiag[ker_index] * FM_h.x) + (Kdiag[ker_index].y  * FM_h.y);
-		pline[N.y - j].z = (Kdiag[ker_index].z  * FM_h.z);
+		pline[(N.y - j) * stride].x = (Kdiag[ker_index].x  * FM_h.x) + (-K2D_odiag[ker_index] * FM_h.y);
+		pline[(N.y - j) * stride].y = (-K2D_odiag[ker_index] * FM_h.x) + (Kdiag[ker_index].y  * FM_h.y);
+		pline[(N.y - j) * stride].z = (Kdiag[ker_index].z  * FM_h.z);
 	}
 
 	//j = N.y / 2
-	FM = pline[N.y / 2];
+	FM = pline[(N.y / 2) * stride];
 
 	int idx_mid = i + (N.y / 2) * (N.x / 2 + 1);
 
-	pline[N.y / 2].x = (Kdiag[idx_mid].x  * FM.x) + (K2D_odiag[idx_mid] * FM.y);
-	pline[N.y / 2].y = (K2D_odiag[idx_mid] * FM.x) + (Kdiag[idx_mid].y  * FM.y);
-	pline[N.y / 2].z = (Kdiag[idx_mid].z  * FM.z);
+	pline[(N.y / 2) * stride].x = (Kdiag[idx_mid].x  * FM.x) + (K2D_odiag[idx_mid] * FM.y);
+	pline[(N.y / 2) * stride].y = (K2D_odiag[idx_mid] * FM.x) + (Kdiag[idx_mid].y  * FM.y);
+	pline[(N.y / 2) * stride].z = (Kdiag[idx_mid].z  * FM.z);
 }
 
-//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane)
-void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
+//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane). Line elements are spaced by stride in pline.
+void DipoleDipoleKernel::KernelMultiplication_3D_line(fftReIm3* pline, int i, int j, int stride)
 {
 	//above N.z/2 and N.y/2 use kernel symmetries to recover kernel values
 	//diagonal components are even about the N.z/2 and N.y/2 points
@@ -93,7 +93,7 @@ void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j
 	if (j <= N.y / 2) {
 
 		//k = 0
-		ReIm3 FM = pline[0];
+		fftReIm3 FM = pline[0];
 
 		int idx_start = i + j * (N.x / 2 + 1);
 
@@ -104,33 +104,33 @@ void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j
 		//points between 1 and N.z /2 - 1 inclusive
 		for (int k = 1; k < N.z / 2; k++) {
 
-			ReIm3 FM_l = pline[k];
-			ReIm3 FM_h = pline[N.z - k];
+			fftReIm3 FM_l = pline[k * stride];
+			fftReIm3 FM_h = pline[(N.z - k) * stride];
 
 			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-			pline[k].x = (Kdiag[ker_index].x * FM_l.x) + (Kodiag[ker_index].x * FM_l.y) + (Kodiag[ker_index].y * FM_l.z);
-			pline[k].y = (Kodiag[ker_index].x * FM_l.x) + (Kdiag[ker_index].y * FM_l.y) + (Kodiag[ker_index].z * FM_l.z);
-			pline[k].z = (Kodiag[ker_index].y * FM_l.x) + (Kodiag[ker_index].z * FM_l.y) + (Kdiag[ker_index].z * FM_l.z);
+			pline[k * stride].x = (Kdiag[ker_index].x * FM_l.x) + (Kodiag[ker_index].x * FM_l.y) + (Kodiag[ker_index].y * FM_l.z);
+			pline[k * stride].y = (Kodiag[ker_index].x * FM_l.x) + (Kdiag[ker_index].y * FM_l.y) + (Kodiag[ker_index].z * FM_l.z);
+			pline[k * stride].z = (Kodiag[ker_index].y * FM_l.x) + (Kodiag[ker_index].z * FM_l.y) + (Kdiag[ker_index].z * FM_l.z);
 
-			pline[N.z - k].x = (Kdiag[ker_index].x * FM_h.x) + (Kodiag[ker_index].x * FM_h.y) + (-Kodiag[ker_index].y * FM_h.z);
-			pline[N.z - k].y = (Kodiag[ker_index].x * FM_h.x) + (Kdiag[ker_index].y * FM_h.y) + (-Kodiag[ker_index].z * FM_h.z);
-			pline[N.z - k].z = (-Kodiag[ker_index].y * FM_h.x) + (-Kodiag[ker_index].z * FM_h.y) + (Kdiag[ker_index].z * FM_h.z);
+			pline[(N.z - k) * stride].x = (Kdiag[ker_index].x * FM_h.x) + (Kodiag[ker_index].x * FM_h.y) + (-Kodiag[ker_index].y * FM_h.z);
+			pline[(N.z - k) * stride].y = (Kodiag[ker_index].x * FM_h.x) + (Kdiag[ker_index].y * FM_h.y) + (-Kodiag[ker_index].z * FM_h.z);
+			pline[(N.z - k) * stride].z = (-Kodiag[ker_index].y * FM_h.x) + (-Kodiag[ker_index].z * FM_h.y) + (Kdiag[ker_index].z * FM_h.z);
 		}
 
 		//k = N.z / 2
-		FM = pline[N.z / 2];
+		FM = pline[(N.z / 2) * stride];
 
 		int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-		pline[N.z / 2].x = (Kdiag[idx_mid].x * FM.x) + (Kodiag[idx_mid].x * FM.y) + (Kodiag[idx_mid].y * FM.z);
-		pline[N.z / 2].y = (Kodiag[idx_mid].x * FM.x) + (Kdiag[idx_mid].y * FM.y) + (Kodiag[idx_mid].z * FM.z);
-		pline[N.z / 2].z = (Kodiag[idx_mid].y * FM.x) + (Kodiag[idx_mid].z * FM.y) + (Kdiag[idx_mid].z * FM.z);
+		pline[(N.z / 2) * stride].x = (Kdiag[idx_mid].x * FM.x) + (Kodiag[idx_mid].x * FM.y) + (Kodiag[idx_mid].y * FM.z);
+		pline[(N.z / 2) * stride].y = (Kodiag[idx_mid].x * FM.x) + (Kdiag[idx_mid].y * FM.y) + (Kodiag[idx_mid].z * FM.z);
+		pline[(N.z / 2) * stride].z = (Kodiag[idx_mid].y * FM.x) + (Kodiag[idx_mid].z * FM.y) + (Kdiag[idx_mid].z * FM.z);
 	}
 	else {
 
 		//k = 0
-		ReIm3 FM = pline[0];
+		fftReIm3 FM = pline[0];
 
 		int idx_start = i + (N.y - j) * (N.x / 2 + 1);
 
@@ -141,28 +141,28 @@ void DipoleDipoleKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j
 		//points between 1 and N.z /2 - 1 inclusive
 		for (int k = 1; k < N.z / 2; k++) {
 
-			ReIm3 FM_l = pline[k];
-			ReIm3 FM_h = pline[N.z - k];
+			fftReIm3 FM_l = pline[k * stride];
+			fftReIm3 FM_h = pline[(N.z - k) * stride];
 
 			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-			pline[k].x = (Kdiag[ker_index].x * FM_l.x) + (-Kodiag[ker_index].x * FM_l.y) + (Kodiag[ker_index].y * FM_l.z);
-			pline[k].y = (-Kodiag[ker_index].x * FM_l.x) + (Kdiag[ker_index].y * FM_l.y) + (-Kodiag[ker_index].z * FM_l.z);
-			pline[k].z = (Kodiag[ker_index].y * FM_l.x) + (-Kodiag[ker_index].z * FM_l.y) + (Kdiag[ker_index].z * FM_l.z);
+			pline[k * stride].x = (Kdiag[ker_index].x * FM_l.x) + (-Kodiag[ker_index].x * FM_l.y) + (Kodiag[ker_index].y * FM_l.z);
+			pline[k * stride].y = (-Kodiag[ker_index].x * FM_l.x) + (Kdiag[ker_index].y * FM_l.y) + (-Kodiag[ker_index].z * FM_l.z);
+			pline[k * stride].z = (Kodiag[ker_index].y * FM_l.x) + (-Kodiag[ker_index].z * FM_l.y) + (Kdiag[ker_index].z * FM_l.z);
 
-			pline[N.z - k].x = (Kdiag[ker_index].x * FM_h.x) + (-Kodiag[ker_index].x * FM_h.y) + (-Kodiag[ker_index].y * FM_h.z);
-			pline[N.z - k].y = (-Kodiag[ker_index].x * FM_h.x) + (Kdiag[ker_index].y * FM_h.y) + (Kodiag[ker_index].z * FM_h.z);
-			pline[N.z - k].z = (-Kodiag[ker_index].y * FM_h.x) + (Kodiag[ker_index].z * FM_h.y) + (Kdiag[ker_index].z * FM_h.z);
+			pline[(N.z - k) * stride].x = (Kdiag[ker_index].x * FM_h.x) + (-Kodiag[ker_index].x * FM_h.y) + (-Kodiag[ker_index].y * FM_h.z);
+			pline[(N.z - k) * stride].y = (-Kodiag[ker_index].x * FM_h.x) + (Kdiag[ker_index].y * FM_h.y) + (Kodiag[ker_index].z * FM_h.z);
+			pline[(N.z - k) * stride].z = (-Kodiag[ker_index].y * FM_h.x) + (Kodiag[ker_index].z * FM_h.y) + (Kdiag[ker_index].z * FM_h.z);
 		}
 
 		//k = N.z / 2
-		FM = pline[N.z / 2];
+		FM = pline[(N.z / 2) * stride];
 
 		int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-		pline[N.z / 2].x = (Kdiag[idx_mid].x * FM.x) + (-Kodiag[idx_mid].x * FM.y) + (Kodiag[idx_mid].y * FM.z);
-		pline[N.z / 2].y = (-Kodiag[idx_mid].x * FM.x) + (Kdiag[idx_mid].y * FM.y) + (-Kodiag[idx_mid].z * FM.z);
-		pline[N.z / 2].z = (Kodiag[idx_mid].y * FM.x) + (-Kodiag[idx_mid].z * FM.y) + (Kdiag[idx_mid].z * FM.z);
+		pline[(N.z / 2) * stride].x = (Kdiag[idx_mid].x * FM.x) + (-Kodiag[idx_mid].x * FM.y) + (Kodiag[idx_mid].y * FM.z);
+		pline[(N.z / 2) * stride].y = (-Kodiag[idx_mid].x * FM.x) + (Kdiag[idx_mid].y * FM.y) + (-Kodiag[idx_mid].z * FM.z);
+		pline[(N.z / 2) * stride].z = (Kodiag[idx_mid].y * FM.x) + (-Kodiag[idx_mid].z * FM.y) + (Kdiag[idx_mid].z * FM.z);
 	}
 }
 
@@ -362,7 +362,7 @@ BError DipoleDipoleKernel::Calculate_DipoleDipole_Kernels_3D(bool include_self_d
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//lambda used to transform an input tensor into an output kernel
-	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<DBL3>& kernel, bool off_diagonal) -> void {
+	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<fftReal3>& kernel, bool off_diagonal) -> void {
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
@@ -0,0 +1,162 @@
+#include "stdafx.h"
+#include "EvalSpeedupExtrapolation.h"
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+
+#include "DiffEq_Defs.h"
+
+//-------------------------- HELPERS
+
+//discard saved evaluations which are not valid in the ode step starting at step_time with time step dT : made in a rejected step, or ahead of the current time (e.g. time reset)
+void EvalSpeedupExtrapolation::Discard_Invalid(double step_time, double dT)
+{
+	//a rejected step is repeated from the same time with a reduced time step
+	slots.erase(std::remove_if(slots.begin(), slots.end(), [&](int slot) {
+		return steptime_saved[slot] > step_time || (steptime_saved[slot] == step_time && dT_saved[slot] != dT);
+	}), slots.end());
+}
+
+//Lagrange extrapolation weights at eval_time for available saved evaluations (same order as slots)
+std::vector<double> EvalSpeedupExtrapolation::Get_Weights(double eval_time)
+{
+	std::vector<double> weights(slots.size(), 1.0);
+
+	for (int k = 0; k < slots.size(); k++) {
+		for (int j = 0; j < slots.size(); j++) {
+
+			if (j == k) continue;
+			weights[k] *= (eval_time - time_saved[slots[j]]) / (time_saved[slots[k]] - time_saved[slots[j]]);
+		}
+	}
+
+	return weights;
+}
+
+//-------------------------- CONFIGURATION
+
+//allocate storage for given extrapolation order (EVALSPEEDUPEXTRAP_ enum), for fields with given cellsize and rectangle. Memory freed for EVALSPEEDUPEXTRAP_NONE. Return false if out of memory.
+bool EvalSpeedupExtrapolation::Initialize(int extrapolation_order, DBL3 h, Rect rect)
+{
+	Clear();
+
+	if (extrapolation_order <= EVALSPEEDUPEXTRAP_NONE) return true;
+
+	//order + 1 points needed for extrapolation
+	int num_slots = extrapolation_order + 1;
+
+	H_saved.resize(num_slots);
+	time_saved.assign(num_slots, 0.0);
+	steptime_saved.assign(num_slots, 0.0);
+	dT_saved.assign(num_slots, 0.0);
+
+	for (int slot = 0; slot < num_slots; slot++) {
+
+		if (!H_saved[slot].resize(h, rect)) {
+
+			Clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//free memory and forget saved evaluations
+void EvalSpeedupExtrapolation::Clear(void)
+{
+	H_saved.clear();
+	H_saved.shrink_to_fit();
+
+	time_saved.clear();
+	steptime_saved.clear();
+	dT_saved.clear();
+
+	slots.clear();
+
+	extrapolation_error = -1.0;
+}
+
+//-------------------------- SAVE / EXTRAPOLATE
+
+//new full field evaluation in H, made at eval_time in the ode step starting at step_time with time step dT : calculate extrapolation error against it, then save it
+void EvalSpeedupExtrapolation::Save(VEC<DBL3>& H, double eval_time, double step_time, double dT)
+{
+	if (!Enabled()) return;
+
+	Discard_Invalid(step_time, dT);
+
+	//an evaluation saved at the same time is replaced (some methods have repeated stage nodes), so extrapolation points are always distinct
+	slots.erase(std::remove_if(slots.begin(), slots.end(), [&](int slot) { return time_saved[slot] == eval_time; }), slots.end());
+
+	//extrapolation error : only calculate if we have enough points for at least a linear extrapolation
+	if (slots.size() >= 2) {
+
+		std::vector<double> weights = Get_Weights(eval_time);
+
+		double diff_norm2 = 0.0, H_norm2 = 0.0;
+
+#pragma omp parallel for reduction(+:diff_norm2, H_norm2)
+		for (int idx = 0; idx < H.linear_size(); idx++) {
+
+			DBL3 H_extrap = DBL3();
+			for (int k = 0; k < slots.size(); k++) H_extrap += weights[k] * H_saved[slots[k]][idx];
+
+			diff_norm2 += (H_extrap - H[idx]) * (H_extrap - H[idx]);
+			H_norm2 += H[idx] * H[idx];
+		}
+
+		extrapolation_error = (H_norm2 > 0.0 ? sqrt(diff_norm2 / H_norm2) : 0.0);
+	}
+	else extrapolation_error = -1.0;
+
+	//storage slot for new evaluation : unused one if available, else overwrite oldest
+	int new_slot = 0;
+
+	if (slots.size() < H_saved.size()) {
+
+		while (std::find(slots.begin(), slots.end(), new_slot) != slots.end()) new_slot++;
+	}
+	else {
+
+		new_slot = slots.front();
+		slots.erase(slots.begin());
+	}
+
+#pragma omp parallel for
+	for (int idx = 0; idx < H.linear_size(); idx++) {
+
+		H_saved[new_slot][idx] = H[idx];
+	}
+
+	time_saved[new_slot] = eval_time;
+	steptime_saved[new_slot] = step_time;
+	dT_saved[new_slot] = dT;
+
+	slots.push_back(new_slot);
+}
+
+//set H to field extrapolated to eval_time from available saved evaluations (with a single one available it is re-used). Return false if none available (H left unchanged).
+bool EvalSpeedupExtrapolation::Extrapolate(VEC<DBL3>& H, double eval_time, double step_time, double dT)
+{
+	if (!Enabled()) return false;
+
+	Discard_Invalid(step_time, dT);
+
+	//with a single valid evaluation this reduces to re-using it
+	if (!slots.size()) return false;
+
+	std::vector<double> weights = Get_Weights(eval_time);
+
+#pragma omp parallel for
+	for (int idx = 0; idx < H.linear_size(); idx++) {
+
+		DBL3 H_extrap = DBL3();
+		for (int k = 0; k < slots.size(); k++) H_extrap += weights[k] * H_saved[slots[k]][idx];
+
+		H[idx] = H_extrap;
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Boris_Enums_Defs.h"
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+
+#include "BorisLib.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Field extrapolation for evaluation speedup
+
+//When evaluation speedup is enabled, on EVALSPEEDUPSTEP_SKIP steps the last saved field evaluation is normally re-used.
+//Instead, this keeps the last 2 or 3 saved field evaluations with their evaluation step times, and extrapolates the field to the current evaluation step time (linear or quadratic Lagrange extrapolation).
+//Each new full evaluation is first compared against the extrapolated field so the extrapolation error can be reported.
+
+class EvalSpeedupExtrapolation
+{
+
+private:
+
+	//saved field evaluations : storage slots, re-used in circular fashion
+	std::vector<VEC<DBL3>> H_saved;
+
+	//for each storage slot : evaluation step time of saved field, and time and time step of the ode step it was made in (used to discard evaluations made in rejected time steps)
+	std::vector<double> time_saved, steptime_saved, dT_saved;
+
+	//storage slots of available saved evaluations, oldest first
+	std::vector<int> slots;
+
+	//relative error of extrapolation against the last full evaluation (-1 if not available)
+	double extrapolation_error = -1.0;
+
+private:
+
+	//discard saved evaluations which are not valid in the ode step starting at step_time with time step dT : made in a rejected step, or ahead of the current time (e.g. time reset)
+	void Discard_Invalid(double step_time, double dT);
+
+	//Lagrange extrapolation weights at eval_time for available saved evaluations (same order as slots)
+	std::vector<double> Get_Weights(double eval_time);
+
+public:
+
+	//-------------------------- CONFIGURATION
+
+	//allocate storage for given extrapolation order (EVALSPEEDUPEXTRAP_ enum), for fields with given cellsize and rectangle. Memory freed for EVALSPEEDUPEXTRAP_NONE. Return false if out of memory.
+	bool Initialize(int extrapolation_order, DBL3 h, Rect rect);
+
+	//free memory and forget saved evaluations
+	void Clear(void);
+
+	//is extrapolation enabled (storage allocated)?
+	bool Enabled(void) { return H_saved.size(); }
+
+	//-------------------------- SAVE / EXTRAPOLATE
+
+	//new full field evaluation in H, made at eval_time in the ode step starting at step_time with time step dT : calculate extrapolation error against it, then save it
+	void Save(VEC<DBL3>& H, double eval_time, double step_time, double dT);
+
+	//set H to field extrapolated to eval_time from available saved evaluations (with a single one available it is re-used). Return false if none available (H left unchanged).
+	bool Extrapolate(VEC<DBL3>& H, double eval_time, double step_time, double dT);
+
+	//-------------------------- GETTERS
+
+	//relative rms error of extrapolation against the last full evaluation (-1 if not available)
+	double Get_Error(void) { return extrapolation_error; }
+};
+
+#endif
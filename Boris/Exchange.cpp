@@ -5,6 +5,7 @@
 
 #include "Mesh.h"
 #include "MeshParamsControl.h"
+#include "Modules_LocalFields.h"
 
 #if COMPILECUDA == 1
 #include "ExchangeCUDA.h"
@@ -112,19 +113,7 @@ double Exch_6ngbr_Neu::UpdateField(void)
 #pragma omp parallel for reduction(+:energy)
 		for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
-
-				double Ms = pMesh->Ms;
-				double A = pMesh->A;
-				pMesh->update_parameters_mcoarse(idx, pMesh->A, A, pMesh->Ms, Ms);
-
-				//cells marked with cmbnd are calculated using exchange coupling to other ferromagnetic meshes - see below; the delsq_neu evaluates to zero in the CMBND coupling direction.
-				DBL3 Hexch = (2 * A / (MU0*Ms*Ms)) * pMesh->M.delsq_neu(idx);
-
-				pMesh->Heff[idx] += Hexch;
-
-				energy += pMesh->M[idx] * Hexch;
-			}
+			if (pMesh->M.is_not_empty(idx)) pMesh->Heff[idx] += LocalField_FM(idx, energy);
 		}
 	}
 
@@ -163,6 +152,12 @@ double Exch_6ngbr_Neu::UpdateField(void)
 		}
 	}
 
+	return UpdateField_Finish(energy);
+}
+
+//exchange coupling to other meshes and final energy density value from energy density sum accumulated over the mesh; sets and returns module energy
+double Exch_6ngbr_Neu::UpdateField_Finish(double energy)
+{
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	/////////////////////////////// COUPLING ACROSS MULTIPLE MESHES ///////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -104,6 +104,10 @@ private:
 	//spatial scaling setting info : text with ";" separators. First field is the scaling set type (e.g. none, custom, random, jagged, etc.); The other fields are parameters for spatial generators.
 	std::string s_scaling_info = vargenerator_descriptor.get_key_from_ID(MATPVAR_NONE);
 
+	//per-cell values cache : values with spatial variation and temperature dependence already evaluated, calculated by the owning mesh at its magnetization cellsize (see update_cache). 
+	//Not saved or copied : this is empty if not calculated.
+	VEC<PType> cache;
+
 private:
 
 	//---------Output value update : CUDA helpers
@@ -253,6 +257,22 @@ public:
 	//get spatial scaling value : 1.0 if not set.
 	SType get_s_scaling_value(const DBL3& position, double stime);
 
+	//---------Per-cell values cache
+
+	//calculate cache values for cellsize h and rectangle rect if needed : spatial variation set, or temperature dependence set with non-uniform temperature (Temp not empty). Otherwise cache is freed.
+	//Values are recalculated only if cache not yet calculated, update_all is set, temperature dependence set and non-uniform temperature has changed (Temp_changed), or spatial variation equation set and stage time has changed (stime_changed).
+	//Return false if out of memory (cache freed).
+	bool update_cache(DBL3 h, Rect rect, const VEC<double>& Temp, double stime, bool update_all, bool Temp_changed, bool stime_changed);
+
+	//free cache memory
+	void clear_cache(void) { cache.clear(); }
+
+	//is the cache calculated? If so, values must be read from it using get_cached
+	bool is_cached(void) const { return cache.linear_size(); }
+
+	//get cached value at given cell index (check is_cached before!)
+	PType get_cached(int idx) const { return cache[idx]; }
+
 	//---------Set scaling equation (temperature)
 
 	//set scaling text equation
@@ -930,6 +950,48 @@ void MatP<PType, SType>::set_current(double Temperature)
 	current_value = get(Temperature);
 }
 
+//---------Per-cell values cache
+
+template <typename PType, typename SType>
+bool MatP<PType, SType>::update_cache(DBL3 h, Rect rect, const VEC<double>& Temp, double stime, bool update_all, bool Temp_changed, bool stime_changed)
+{
+	bool Temp_set = Temp.linear_size();
+
+	//cache not needed : values can be read directly
+	if (!is_sdep() && !(is_tdep() && Temp_set)) {
+
+		clear_cache();
+		return true;
+	}
+
+	if (!is_cached()) {
+
+		if (!cache.assign(h, rect, PType())) {
+
+			clear_cache();
+			return false;
+		}
+	}
+	//already calculated : only need to recalculate if values could have changed since
+	else if (!update_all && !(is_tdep() && Temp_set && Temp_changed) && !(is_s_equation_set() && stime_changed)) return true;
+
+	//same values as would be obtained with the Mesh::update_parameters_mcoarse methods
+#pragma omp parallel for
+	for (int idx = 0; idx < cache.linear_size(); idx++) {
+
+		DBL3 position = cache.cellidx_to_position(idx);
+
+		if (Temp_set) {
+
+			if (is_sdep()) cache[idx] = get(position, stime, Temp[position]);
+			else cache[idx] = get(Temp[position]);
+		}
+		else cache[idx] = get(position, stime);
+	}
+
+	return true;
+}
+
 //---------Set value
 
 template <typename PType, typename SType>
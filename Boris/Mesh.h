@@ -67,6 +67,20 @@ public:
 	//link stochastic cellsize to magnetic cellsize by default (set this to false if you want to control h_s independently)
 	bool link_stochastic = true;
 
+	//-----Material parameters per-cell values cache
+
+	//all cached values must be recalculated at the next Update_ParamsCache call (e.g. base temperature changed)
+	bool paramscache_outdated = true;
+
+	//stage time at last Update_ParamsCache call
+	double paramscache_stime = 0.0;
+
+	//temperature dependent cached values must be recalculated at the next Update_ParamsCache call (non-uniform temperature changed)
+	bool paramscache_Temp_changed = true;
+
+	//electrical (V) and thermal (Temp) cells are the same as the magnetization cells, so the update_parameters_ecoarse and update_parameters_tcoarse methods can also read from the cache (set by Update_ParamsCache)
+	bool paramscache_ecoarse = false, paramscache_tcoarse = false;
+
 	//-----Mechanical properties
 
 	//In Meshbase
@@ -214,6 +228,10 @@ public:
 	//this just sets the indicative material Tc value
 	void SetCurieTemperatureMaterial(double Tc_material) { T_Curie_material = Tc_material; }
 
+	//calculate per-cell values cache, at the magnetization cellsize, for material parameters with spatial variation or temperature dependence with non-uniform temperature (magnetization dynamics computation only).
+	//The update_parameters_mcoarse methods then read values from it instead of evaluating parameters in every cell for every module, as do the update_parameters_ecoarse and update_parameters_tcoarse methods if V and Temp have the magnetization cells.
+	void Update_ParamsCache(bool temperature_changed = false);
+
 	//----------------------------------- RUNTIME PARAMETER UPDATERS (MeshParamsControl.h)
 
 	//UPDATER M COARSENESS - PUBLIC
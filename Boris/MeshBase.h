@@ -22,6 +22,15 @@
 
 class SuperMesh;
 
+//Monte-Carlo Algorithm : minimum allowed cone angle
+#define MONTECARLO_CONEANGLEDEG_MIN		1.0
+//Monte-Carlo Algorithm : maximum allowed cone angle
+#define MONTECARLO_CONEANGLEDEG_MAX		180.0
+//Monte-Carlo Algorithm : change in cone angle per step
+#define MONTECARLO_CONEANGLEDEG_DELTA	1.0
+//Monte-Carlo Algorithm : target aceptance probability (vary cone angle to reach this)
+#define MONTECARLO_TARGETACCEPTANCE		0.5
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //	Abstract base Mesh class - implement various types of meshes using this base
@@ -203,13 +212,30 @@ public:
 	virtual void PrepareNewIterationCUDA(void) = 0;
 #endif
 
-	//Take a Monte Carlo step in this mesh if atomistic (overloaded by atomistic mesh implementation) using settings in each mesh
+	//calculate per-cell material parameter values cache where needed (overloaded by micromagnetic mesh implementation). Called at the start of UpdateModules and whenever the temperature changes.
+	//temperature_changed : the non-uniform temperature (Temp) has changed since the last call, so temperature dependent values must be recalculated.
+	virtual void Update_ParamsCache(bool temperature_changed = false) {}
+
+	//Take a Monte Carlo step in this mesh (overloaded by atomistic and ferromagnetic mesh implementations) using settings in each mesh
 	virtual void Iterate_MonteCarlo(double acceptance_rate) {}
 
+	//check currently set modules can be used with Iterate_MonteCarlo (overloaded by meshes with modules not included in Monte Carlo energy changes)
+	virtual BError Check_MonteCarlo_Modules(void) { return BError(); }
+
 #if COMPILECUDA == 1
 	virtual void Iterate_MonteCarloCUDA(double acceptance_rate) {}
 #endif
 
+	//Monte-Carlo cone angle (deg.) and last step acceptance rate (overloaded by meshes implementing Iterate_MonteCarlo)
+	virtual DBL2 Get_MonteCarlo_Params(void) { return DBL2(); }
+
+	//Monte-Carlo dipolar field handling settings, and relative rms error of the updated dipolar field (overloaded by meshes including dipolar fields in Iterate_MonteCarlo)
+	virtual void Set_MonteCarlo_Dipolar(int refresh, int radius, double threshold) {}
+	virtual int Get_MonteCarlo_Dipolar_Refresh(void) { return 0; }
+	virtual int Get_MonteCarlo_Dipolar_Radius(void) { return 0; }
+	virtual double Get_MonteCarlo_Dipolar_Threshold(void) { return 0.0; }
+	virtual double Get_MonteCarlo_Dipolar_Error(void) { return 0.0; }
+
 	//----------------------------------- OTHER CONTROL METHODS
 
 	//used by move mesh algorithm : shift mesh quantities (e.g. magnetization) by the given shift (metric units) value within this mesh. The shift is along the x-axis direction only (+ve or -ve).
@@ -273,6 +299,9 @@ public:
 	//update computational state of all modules in this mesh; return total energy density -> each module will have a contribution, so sum it
 	double UpdateModules(void);
 
+	//update several local field modules together in a single pass over the mesh where supported (overloaded by mesh implementations), marking them in module_fused (same indexing as pMod) so UpdateModules skips them; return their total energy density.
+	virtual double UpdateModules_Fused(std::vector<bool>& module_fused) { return 0.0; }
+
 	//update MOD_TRANSPORT module only if set
 	virtual void UpdateTransportSolver(void) = 0;
 
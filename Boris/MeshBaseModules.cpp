@@ -81,12 +81,20 @@ double MeshBase::UpdateModules(void)
 		SetBaseTemperature(T_equation.evaluate(pSMesh->GetStageTime()), false);
 	}
 
+	//material parameter values used by modules and the ode solver in this stage (only recalculated if needed)
+	Update_ParamsCache();
+
+	//local field modules computed together in a single pass where supported : these are skipped below
+	std::vector<bool> module_fused(pMod.size(), false);
+
 	//total energy density
-	double energy = 0;
+	double energy = UpdateModules_Fused(module_fused);
 
 	//Update effective field by adding in contributions from each set module
 	for (int idx = 0; idx < (int)pMod.size(); idx++) {
 
+		if (module_fused[idx]) continue;
+
 		//if for a module it doesn't make sense to contribute to the total energy density, then it should return zero.
 		energy += pMod[idx]->UpdateField();
 	}
@@ -17,6 +17,9 @@ void MeshBase::SetTempFromData(VEC<double>& data, const Rect& dstRect)
 	//copy values in data, as well as shape
 	Temp.copy_values(data, dstRect);
 
+	//cached material parameter values which depend on temperature must be recalculated
+	Update_ParamsCache(true);
+
 #if COMPILECUDA == 1
 	//refresh gpu memory
 	if (pMeshBaseCUDA) pMeshBaseCUDA->Temp()->copy_from_cpuvec(Temp);
@@ -373,4 +373,38 @@ void MeshParamsBase::update_parameters(PARAM_ paramID)
 		}
 	}
 	else update_param(paramID);
-}
\ No newline at end of file
+}
+
+//-------------------------Per-cell values cache
+
+//calculate per-cell values cache, at given cellsize and rectangle, for all mesh parameters which need it (see MatP::update_cache for arguments). Return false if out of memory for any (parameter then evaluated directly).
+bool MeshParamsBase::update_meshparam_cache(DBL3 h, Rect rect, const VEC<double>& Temp, double stime, bool update_all, bool Temp_changed, bool stime_changed)
+{
+	auto code = [](auto& MatP_object, DBL3 h, Rect rect, const VEC<double>& Temp, double stime, bool update_all, bool Temp_changed, bool stime_changed) -> bool {
+
+		return MatP_object.update_cache(h, rect, Temp, stime, update_all, Temp_changed, stime_changed);
+	};
+
+	bool success = true;
+
+	for (int index = 0; index < meshParams.size(); index++) {
+
+		success &= run_on_param_switch<bool>((PARAM_)meshParams.get_ID_from_index(index), code, h, rect, Temp, stime, update_all, Temp_changed, stime_changed);
+	}
+
+	return success;
+}
+
+//free per-cell values cache for all mesh parameters
+void MeshParamsBase::clear_meshparam_cache(void)
+{
+	auto code = [](auto& MatP_object) -> void {
+
+		MatP_object.clear_cache();
+	};
+
+	for (int index = 0; index < meshParams.size(); index++) {
+
+		run_on_param_switch<void>((PARAM_)meshParams.get_ID_from_index(index), code);
+	}
+}
@@ -210,4 +210,12 @@ public:
 
 	//call this to update given parameter output value to current base_temperature
 	void update_parameters(PARAM_ paramID = PARAM_ALL);
+
+	//-------------------------Per-cell values cache
+
+	//calculate per-cell values cache, at given cellsize and rectangle, for all mesh parameters which need it (see MatP::update_cache for arguments). Return false if out of memory for any (parameter then evaluated directly).
+	bool update_meshparam_cache(DBL3 h, Rect rect, const VEC<double>& Temp, double stime, bool update_all, bool Temp_changed, bool stime_changed);
+
+	//free per-cell values cache for all mesh parameters
+	void clear_meshparam_cache(void);
 };
\ No newline at end of file
@@ -9,6 +9,10 @@ void Mesh::SetBaseTemperature(double Temperature, bool clear_equation)
 {
 	if (clear_equation) T_equation.clear();
 
+	//cached parameter values depend on the base temperature
+	bool temperature_changed = (Temperature != base_temperature);
+	if (temperature_changed) paramscache_outdated = true;
+
 	//new base temperature and adjust parameter output values for new base temperature
 	base_temperature = Temperature;
 
@@ -37,6 +41,32 @@ void Mesh::SetBaseTemperature(double Temperature, bool clear_equation)
 
 	//3. electrical conductivity might also need updating so force it here - if Transport module not set then nothing happens (note elC will have zero size in this case)
 	CallModuleMethod(&Transport::CalculateElectricalConductivity, true);
+
+	//4. cached parameter values must not be used with the old base temperature (e.g. by Monte Carlo or output data before the next UpdateModules) : recalculate them now
+	if (temperature_changed && M.linear_size()) Update_ParamsCache(true);
+}
+
+//----------------------------------- PARAMETERS CACHE
+
+//calculate per-cell values cache, at the magnetization cellsize, for material parameters with spatial variation or temperature dependence with non-uniform temperature (magnetization dynamics computation only).
+void Mesh::Update_ParamsCache(bool temperature_changed)
+{
+	if (temperature_changed) paramscache_Temp_changed = true;
+
+	if (!MComputation_Enabled()) return;
+
+	double stime = pSMesh->GetStageTime();
+
+	//if out of memory for any parameter cache, then that parameter is evaluated directly in every cell as before
+	update_meshparam_cache(M.h, M.rect, Temp, stime, paramscache_outdated, paramscache_Temp_changed, stime != paramscache_stime);
+
+	paramscache_outdated = false;
+	paramscache_Temp_changed = false;
+	paramscache_stime = stime;
+
+	//cache indexes are then also electrical and thermal cell indexes
+	paramscache_ecoarse = (V.linear_size() && V.h == M.h && V.rect == M.rect);
+	paramscache_tcoarse = (Temp.linear_size() && Temp.h == M.h && Temp.rect == M.rect);
 }
 
 //----------------------------------- OTHERS
@@ -52,5 +82,8 @@ BError Mesh::copy_mesh_parameters(MeshBase& copy_this)
 	//make sure to update the spatial variation as any copied spatial variation may not have the correct cellsize now
 	update_meshparam_var();
 
+	//any cached values are no longer valid
+	clear_meshparam_cache();
+
 	return error;
 }
\ No newline at end of file
@@ -55,7 +55,12 @@ void Mesh::update_parameters_full(const DBL3& position, const double& Temperatur
 template <typename PType, typename SType, typename ... MeshParam_List>
 void Mesh::update_parameters_mcoarse_spatial(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
 {
-	if (matp.is_sdep()) {
+	if (matp.is_cached()) {
+
+		matp_value = matp.get_cached(mcell_idx);
+		update_parameters_mcoarse_spatial(mcell_idx, params...);
+	}
+	else if (matp.is_sdep()) {
 
 		DBL3 position = M.cellidx_to_position(mcell_idx);
 
@@ -72,7 +77,8 @@ void Mesh::update_parameters_mcoarse_spatial(int mcell_idx, MatP<PType, SType>&
 template <typename PType, typename SType>
 void Mesh::update_parameters_mcoarse_spatial(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value)
 {
-	if (matp.is_sdep()) matp_value = matp.get(M.cellidx_to_position(mcell_idx), pSMesh->GetStageTime());
+	if (matp.is_cached()) matp_value = matp.get_cached(mcell_idx);
+	else if (matp.is_sdep()) matp_value = matp.get(M.cellidx_to_position(mcell_idx), pSMesh->GetStageTime());
 }
 
 //SPATIAL AND TEMPERATURE DEPENDENCE - NO POSITION YET
@@ -81,7 +87,12 @@ void Mesh::update_parameters_mcoarse_spatial(int mcell_idx, MatP<PType, SType>&
 template <typename PType, typename SType, typename ... MeshParam_List>
 void Mesh::update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
 {
-	if (matp.is_sdep()) {
+	if (matp.is_cached()) {
+
+		matp_value = matp.get_cached(mcell_idx);
+		update_parameters_mcoarse_full(mcell_idx, params...);
+	}
+	else if (matp.is_sdep()) {
 
 		DBL3 position = M.cellidx_to_position(mcell_idx);
 		double Temperature = Temp[position];
@@ -107,7 +118,8 @@ void Mesh::update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& mat
 template <typename PType, typename SType>
 void Mesh::update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& matp, PType& matp_value)
 {
-	if (matp.is_sdep()) {
+	if (matp.is_cached()) matp_value = matp.get_cached(mcell_idx);
+	else if (matp.is_sdep()) {
 
 		DBL3 position = M.cellidx_to_position(mcell_idx);
 
@@ -124,6 +136,7 @@ void Mesh::update_parameters_mcoarse_full(int mcell_idx, MatP<PType, SType>& mat
 //UPDATER M COARSENESS - PUBLIC
 
 //Update parameter values if temperature dependent at the given cell index - M cell index; position not calculated
+//Parameters with a per-cell values cache calculated (see Update_ParamsCache) are read from it.
 template <typename ... MeshParam_List>
 void Mesh::update_parameters_mcoarse(int mcell_idx, MeshParam_List& ... params)
 {
@@ -148,7 +161,12 @@ void Mesh::update_parameters_mcoarse(int mcell_idx, MeshParam_List& ... params)
 template <typename PType, typename SType, typename ... MeshParam_List>
 void Mesh::update_parameters_ecoarse_spatial(int ecell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
 {
-	if (matp.is_sdep()) {
+	if (paramscache_ecoarse && matp.is_cached()) {
+
+		matp_value = matp.get_cached(ecell_idx);
+		update_parameters_ecoarse_spatial(ecell_idx, params...);
+	}
+	else if (matp.is_sdep()) {
 
 		DBL3 position = V.cellidx_to_position(ecell_idx);
 
@@ -165,7 +183,8 @@ void Mesh::update_parameters_ecoarse_spatial(int ecell_idx, MatP<PType, SType>&
 template <typename PType, typename SType>
 void Mesh::update_parameters_ecoarse_spatial(int ecell_idx, MatP<PType, SType>& matp, PType& matp_value)
 {
-	if (matp.is_sdep()) matp_value = matp.get(V.cellidx_to_position(ecell_idx), pSMesh->GetStageTime());
+	if (paramscache_ecoarse && matp.is_cached()) matp_value = matp.get_cached(ecell_idx);
+	else if (matp.is_sdep()) matp_value = matp.get(V.cellidx_to_position(ecell_idx), pSMesh->GetStageTime());
 }
 
 //SPATIAL AND TEMPERATURE DEPENDENCE - NO POSITION YET
@@ -174,7 +193,12 @@ void Mesh::update_parameters_ecoarse_spatial(int ecell_idx, MatP<PType, SType>&
 template <typename PType, typename SType, typename ... MeshParam_List>
 void Mesh::update_parameters_ecoarse_full(int ecell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
 {
-	if (matp.is_sdep()) {
+	if (paramscache_ecoarse && matp.is_cached()) {
+
+		matp_value = matp.get_cached(ecell_idx);
+		update_parameters_ecoarse_full(ecell_idx, params...);
+	}
+	else if (matp.is_sdep()) {
 
 		DBL3 position = V.cellidx_to_position(ecell_idx);
 		double Temperature = Temp[position];
@@ -200,7 +224,8 @@ void Mesh::update_parameters_ecoarse_full(int ecell_idx, MatP<PType, SType>& mat
 template <typename PType, typename SType>
 void Mesh::update_parameters_ecoarse_full(int ecell_idx, MatP<PType, SType>& matp, PType& matp_value)
 {
-	if (matp.is_sdep()) {
+	if (paramscache_ecoarse && matp.is_cached()) matp_value = matp.get_cached(ecell_idx);
+	else if (matp.is_sdep()) {
 
 		DBL3 position = V.cellidx_to_position(ecell_idx);
 
@@ -217,6 +242,7 @@ void Mesh::update_parameters_ecoarse_full(int ecell_idx, MatP<PType, SType>& mat
 //UPDATER E COARSENESS - PUBLIC
 
 //Update parameter values if temperature dependent at the given cell index - M cell index; position not calculated
+//Parameters with a per-cell values cache calculated are read from it if electrical cells are the magnetization cells.
 template <typename ... MeshParam_List>
 void Mesh::update_parameters_ecoarse(int ecell_idx, MeshParam_List& ... params)
 {
@@ -241,7 +267,12 @@ void Mesh::update_parameters_ecoarse(int ecell_idx, MeshParam_List& ... params)
 template <typename PType, typename SType, typename ... MeshParam_List>
 void Mesh::update_parameters_tcoarse_spatial(int tcell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
 {
-	if (matp.is_sdep()) {
+	if (paramscache_tcoarse && matp.is_cached() && !matp.is_tdep()) {
+
+		matp_value = matp.get_cached(tcell_idx);
+		update_parameters_tcoarse_spatial(tcell_idx, params...);
+	}
+	else if (matp.is_sdep()) {
 
 		DBL3 position = Temp.cellidx_to_position(tcell_idx);
 
@@ -258,7 +289,8 @@ void Mesh::update_parameters_tcoarse_spatial(int tcell_idx, MatP<PType, SType>&
 template <typename PType, typename SType>
 void Mesh::update_parameters_tcoarse_spatial(int tcell_idx, MatP<PType, SType>& matp, PType& matp_value)
 {
-	if (matp.is_sdep()) matp_value = matp.get(Temp.cellidx_to_position(tcell_idx), pSMesh->GetStageTime());
+	if (paramscache_tcoarse && matp.is_cached() && !matp.is_tdep()) matp_value = matp.get_cached(tcell_idx);
+	else if (matp.is_sdep()) matp_value = matp.get(Temp.cellidx_to_position(tcell_idx), pSMesh->GetStageTime());
 }
 
 //SPATIAL AND TEMPERATURE DEPENDENCE - NO POSITION YET
@@ -267,7 +299,12 @@ void Mesh::update_parameters_tcoarse_spatial(int tcell_idx, MatP<PType, SType>&
 template <typename PType, typename SType, typename ... MeshParam_List>
 void Mesh::update_parameters_tcoarse_full(int tcell_idx, MatP<PType, SType>& matp, PType& matp_value, MeshParam_List& ... params)
 {
-	if (matp.is_sdep()) {
+	if (paramscache_tcoarse && matp.is_cached() && !matp.is_tdep()) {
+
+		matp_value = matp.get_cached(tcell_idx);
+		update_parameters_tcoarse_full(tcell_idx, params...);
+	}
+	else if (matp.is_sdep()) {
 
 		DBL3 position = Temp.cellidx_to_position(tcell_idx);
 		double Temperature = Temp[tcell_idx];
@@ -293,7 +330,8 @@ void Mesh::update_parameters_tcoarse_full(int tcell_idx, MatP<PType, SType>& mat
 template <typename PType, typename SType>
 void Mesh::update_parameters_tcoarse_full(int tcell_idx, MatP<PType, SType>& matp, PType& matp_value)
 {
-	if (matp.is_sdep()) {
+	if (paramscache_tcoarse && matp.is_cached() && !matp.is_tdep()) matp_value = matp.get_cached(tcell_idx);
+	else if (matp.is_sdep()) {
 
 		DBL3 position = Temp.cellidx_to_position(tcell_idx);
 
@@ -308,6 +346,7 @@ void Mesh::update_parameters_tcoarse_full(int tcell_idx, MatP<PType, SType>& mat
 //UPDATER T COARSENESS - PUBLIC
 
 //Update parameter values if temperature dependent at the given cell index - M cell index; position not calculated
+//Parameters with a per-cell values cache calculated are read from it if thermal cells are the magnetization cells, except temperature dependent ones (the heat solver changes the temperature before the cache is next calculated).
 template <typename ... MeshParam_List>
 void Mesh::update_parameters_tcoarse(int tcell_idx, MeshParam_List& ... params)
 {
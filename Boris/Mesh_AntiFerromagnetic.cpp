@@ -157,6 +157,9 @@ BError AFMesh::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	//Mesh specific configuration
 	///////////////////////////////////////////////////////
 
+	//material parameters or mesh dimensions could have changed : cached parameter values will be recalculated when next needed
+	clear_meshparam_cache();
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE)) {
 
 		n = round(meshRect / h);
@@ -235,6 +238,8 @@ void AFMesh::UpdateConfiguration_Values(UPDATECONFIG_ cfgMessage)
 
 		//update any text equations used in mesh parameters
 		update_all_meshparam_equations();
+
+		clear_meshparam_cache();
 	}
 	else if (cfgMessage == UPDATECONFIG_TEQUATION_CLEAR) {
 
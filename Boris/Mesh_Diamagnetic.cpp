@@ -114,6 +114,9 @@ BError DiaMesh::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	//Mesh specific configuration
 	///////////////////////////////////////////////////////
 
+	//material parameters or mesh dimensions could have changed : cached parameter values will be recalculated when next needed
+	clear_meshparam_cache();
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE)) {
 
 		//resize arrays held in Mesh - if changing mesh to new size then use resize : this maps values from old mesh to new mesh size (keeping magnitudes). Otherwise assign magnetization along x in whole mesh.
@@ -177,6 +180,8 @@ void DiaMesh::UpdateConfiguration_Values(UPDATECONFIG_ cfgMessage)
 
 		//update any text equations used in mesh parameters
 		update_all_meshparam_equations();
+
+		clear_meshparam_cache();
 	}
 	else if (cfgMessage == UPDATECONFIG_TEQUATION_CLEAR) {
 
@@ -20,6 +20,7 @@ FMesh::FMesh(SuperMesh *pSMesh_) :
 			VINFO(exclude_from_multiconvdemag),
 			//Members in this derived class
 			VINFO(move_mesh_trigger), VINFO(skyShift), VINFO(exchange_couple_to_meshes),
+			VINFO(mc_cone_angledeg), VINFO(mc_acceptance_rate), VINFO(mc_dipolar_refresh), VINFO(mc_dipolar_radius), VINFO(mc_dipolar_threshold),
 			//Material Parameters
 			VINFO(grel), VINFO(alpha), VINFO(Ms), VINFO(Nxy), 
 			VINFO(A), VINFO(D), VINFO(J1), VINFO(J2), 
@@ -46,7 +47,8 @@ FMesh::FMesh(SuperMesh *pSMesh_) :
 			IINFO(SOTField), IINFO(STField),
 			IINFO(Roughness)
 		}),
-	meshODE(this)
+	meshODE(this),
+	prng(GetSystemTickCount())
 {}
 
 FMesh::FMesh(Rect meshRect_, DBL3 h_, SuperMesh *pSMesh_) :
@@ -62,6 +64,7 @@ FMesh::FMesh(Rect meshRect_, DBL3 h_, SuperMesh *pSMesh_) :
 			VINFO(exclude_from_multiconvdemag),
 			//Members in this derived class
 			VINFO(move_mesh_trigger), VINFO(skyShift), VINFO(exchange_couple_to_meshes),
+			VINFO(mc_cone_angledeg), VINFO(mc_acceptance_rate), VINFO(mc_dipolar_refresh), VINFO(mc_dipolar_radius), VINFO(mc_dipolar_threshold),
 			//Material Parameters
 			VINFO(grel), VINFO(alpha), VINFO(Ms), VINFO(Nxy),
 			VINFO(A), VINFO(D), VINFO(J1), VINFO(J2),
@@ -88,7 +91,8 @@ FMesh::FMesh(Rect meshRect_, DBL3 h_, SuperMesh *pSMesh_) :
 			IINFO(SOTField), IINFO(STField),
 			IINFO(Roughness)
 		}),
-	meshODE(this)
+	meshODE(this),
+	prng(GetSystemTickCount())
 {
 	//default settings
 	displayedPhysicalQuantity = MESHDISPLAY_MAGNETIZATION;
@@ -162,6 +166,9 @@ BError FMesh::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 	//Mesh specific configuration
 	///////////////////////////////////////////////////////
 
+	//material parameters or mesh dimensions could have changed : cached parameter values will be recalculated when next needed
+	clear_meshparam_cache();
+
 	if (ucfg::check_cfgflags(cfgMessage, UPDATECONFIG_MESHCHANGE)) {
 
 		n = round(meshRect / h);
@@ -234,6 +241,8 @@ void FMesh::UpdateConfiguration_Values(UPDATECONFIG_ cfgMessage)
 
 		//update any text equations used in mesh parameters
 		update_all_meshparam_equations();
+
+		clear_meshparam_cache();
 	}
 	else if (cfgMessage == UPDATECONFIG_TEQUATION_CLEAR) {
 
@@ -50,6 +50,7 @@ class FMesh :
 	bool,
 	//Members in this derived class
 	bool, SkyrmionTrack, bool,
+	double, double, int, int, double,
 	//Material Parameters
 	MatP<double, double>, MatP<double, double>, MatP<double, double>, MatP<DBL2, double>, 
 	MatP<double, double>, MatP<double, double>, MatP<double, double>, MatP<double, double>, 
@@ -92,12 +93,92 @@ private:
 	//object used to track one or more skyrmions in this mesh
 	SkyrmionTrack skyShift;
 
+	//with the SD relaxation activity mask : energy density contributions (exchange, interfacial DMI, uniaxial anisotropy as x, y, z) of each cell when its local fields were last computed in UpdateModules_Fused, used for frozen cells
+	std::vector<DBL3> relax_energy_cache;
+
 	//direct exchange coupling to neighboring meshes?
 	//If true this is applicable for this mesh only for cells at contacts with other ferromagnetic meshes 
 	//i.e. if two distinct meshes with the same materials are in contact, setting this flag to true will make the simulation behave as if the two materials are in the same computational mesh (provided the demag field is computed on the supermesh).
 	//this is precisely what it is intended for; if two dissimilar materials are in contact then you probably shouldn't be using this mechanism.
 	bool exchange_couple_to_meshes = false;
 
+	// MONTE-CARLO DATA
+
+	//random number generator - used by Monte Carlo methods
+	BorisRand prng;
+
+	//Monte-Carlo current cone angle (vary to reach MONTECARLO_TARGETACCEPTANCE)
+	double mc_cone_angledeg = 30.0;
+
+	//last Monte-Carlo step acceptance probability (save it so we can read it out)
+	double mc_acceptance_rate = 0.0;
+
+	//modules contributing to Monte Carlo energy changes (nullptr if not set) : set at the start of every Monte Carlo step
+	Zeeman* pmc_Zeeman = nullptr;
+	Exch_6ngbr_Neu* pmc_Exch = nullptr;
+	iDMExchange* pmc_iDM = nullptr;
+	Anisotropy_Uniaxial* pmc_AniUni = nullptr;
+	Demag_N* pmc_DemagN = nullptr;
+	Demag* pmc_Demag = nullptr;
+
+	// Demag MONTE-CARLO DATA
+
+	//with a demag module set, the demagnetizing field used for Monte-Carlo energies is obtained with a full convolution every mc_dipolar_refresh steps (or earlier if mc_dipolar_threshold is not zero and the accumulated magnetization change relative to the total exceeds it).
+	//In between, accepted moves update the field using the demag tensor between cells within mc_dipolar_radius cells (0 : no corrections). Settings as for atomistic meshes (mcdipolar command).
+	int mc_dipolar_refresh = 1;
+	int mc_dipolar_radius = 2;
+	double mc_dipolar_threshold = 0.0;
+
+	//demagnetizing field (A/m) used for Monte Carlo energies, and magnetization it was last updated for
+	std::vector<DBL3> mc_Hd, mc_M_ref;
+
+	//magnetization changes since the last demagnetizing field update, used after each checkerboard pass (also holds Heff during full convolutions)
+	std::vector<DBL3> mc_dM;
+
+	//real-space demag correction : demag tensor (as -N, so H = N * M) for each cell offset within the correction radius (zero offset excluded), self demag tensor diagonal (as -N), and radius and cellsize these were computed for
+	std::vector<DBL33> mc_dipolar_kernel;
+	std::vector<INT3> mc_dipolar_offsets;
+	DBL3 mc_dipolar_self;
+	int mc_dipolar_kernel_radius = -1;
+	DBL3 mc_dipolar_kernel_h;
+
+	//Monte Carlo steps since the last full convolution, and accumulated magnetization change since then relative to the total magnetization (mc_dipolar_Mtotal)
+	int mc_dipolar_steps = 0;
+	double mc_dipolar_change = 0.0;
+	double mc_dipolar_Mtotal = 0.0;
+
+	//relative rms error of the updated demagnetizing field, measured at the last full convolution
+	double mc_dipolar_error = 0.0;
+
+private:
+
+	//----------------------------------- MONTE-CARLO METHODS : Mesh_Ferromagnetic_MonteCarlo.cpp
+
+	//set Monte Carlo module pointers from currently set modules
+	void Setup_MonteCarlo_Modules(void);
+
+	//energy change (J) when moving the magnetization in cell idx from M_old (currently set in M) to M_new, with same magnitude
+	double Get_MonteCarlo_EnergyChange(int idx, const DBL3& M_old, const DBL3& M_new, double time);
+
+	//checkerboard parallel Metropolis sweep at base temperature
+	void Iterate_MonteCarlo_Parallel_Classic(void);
+
+	//full convolution of demagnetizing field used for Monte Carlo energies (measure error of incrementally updated field if required), and check if due
+	void MonteCarlo_Dipolar_Refresh(bool measure_error);
+	void MonteCarlo_Dipolar_CheckRefresh(void);
+
+	//free demagnetizing field memory if previously used (demag module not set)
+	void MonteCarlo_Dipolar_Free(void);
+
+	//real-space demagnetizing field corrections for all magnetization changes since the last update, obtained for each cell from changes within the correction radius : used after each checkerboard pass
+	void MonteCarlo_Dipolar_Update(void);
+
+	//set real-space demag correction kernel for current radius and cellsize
+	void MonteCarlo_Dipolar_SetKernel(void);
+
+	//cell index at offset from cell (i, j, k), with periodic boundary conditions if set : -1 if outside mesh
+	int MonteCarlo_Dipolar_OffsetIndex(int i, int j, int k, const INT3& offset);
+
 public:
 
 	//constructor taking only a SuperMesh pointer (SuperMesh is the owner) only needed for loading : all required values will be set by LoadObjectState method in ProgramState
@@ -138,6 +219,28 @@ public:
 	bool GetMoveMeshTrigger(void) { return move_mesh_trigger; }
 	void SetMoveMeshTrigger(bool status) { move_mesh_trigger = status; }
 
+	//----------------------------------- FUSED LOCAL FIELDS : Mesh_Ferromagnetic_LocalFields.cpp
+
+	//compute Zeeman, exchange, interfacial DMI and uniaxial anisotropy fields (those set, if at least 2, or any with the SD relaxation activity mask) in a single pass over the mesh, with per-module energy densities
+	double UpdateModules_Fused(std::vector<bool>& module_fused);
+
+	//----------------------------------- MONTE-CARLO METHODS : Mesh_Ferromagnetic_MonteCarlo.cpp
+
+	//Take a Monte Carlo step in this ferromagnetic mesh
+	void Iterate_MonteCarlo(double acceptance_rate);
+
+	//only Zeeman, exchange, interfacial DMI, uniaxial anisotropy and demag (mesh demag or demagnetizing factors) energy modules are included in Monte Carlo energy changes : other set energy modules result in BERROR_INCORRECTCONFIG
+	BError Check_MonteCarlo_Modules(void);
+
+	DBL2 Get_MonteCarlo_Params(void) { return DBL2(mc_cone_angledeg, mc_acceptance_rate); }
+
+	//demagnetizing field handling for Monte Carlo (see mc_dipolar_refresh)
+	void Set_MonteCarlo_Dipolar(int refresh, int radius, double threshold) { mc_dipolar_refresh = (refresh > 1 ? refresh : 1); mc_dipolar_radius = (radius > 0 ? radius : 0); mc_dipolar_threshold = (threshold > 0.0 ? threshold : 0.0); }
+	int Get_MonteCarlo_Dipolar_Refresh(void) { return mc_dipolar_refresh; }
+	int Get_MonteCarlo_Dipolar_Radius(void) { return mc_dipolar_radius; }
+	double Get_MonteCarlo_Dipolar_Threshold(void) { return mc_dipolar_threshold; }
+	double Get_MonteCarlo_Dipolar_Error(void) { return mc_dipolar_error; }
+
 	//----------------------------------- ODE METHODS IN (ANTI)FERROMAGNETIC MESH : Mesh_Ferromagnetic_ODEControl.cpp
 
 	//get rate of change of magnetization (overloaded by Ferromagnetic meshes)
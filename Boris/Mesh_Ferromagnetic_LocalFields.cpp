@@ -0,0 +1,126 @@
+#include "stdafx.h"
+#include "Mesh_Ferromagnetic.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+
+#include "SuperMesh.h"
+#include "Modules_LocalFields.h"
+
+//----------------------------------- FUSED LOCAL FIELDS : Mesh_Ferromagnetic_LocalFields.cpp
+
+//compute Zeeman, exchange, interfacial DMI and uniaxial anisotropy fields (those set, if at least 2, or any with the SD relaxation activity mask) in a single pass over the mesh, with per-module energy densities
+//Each of these modules would otherwise sweep the mesh separately, re-reading M and Heff every time; here M is read and Heff written once per cell.
+//With the SD relaxation activity mask, fields other than Zeeman are only computed in active cells (frozen cells are not updated, so their effective field is not needed until they become active again).
+//Frozen cells keep their magnetization, so their energy density contributions are those cached when their fields were last computed.
+double FMesh::UpdateModules_Fused(std::vector<bool>& module_fused)
+{
+	Zeeman* pZeeman = nullptr;
+	Exch_6ngbr_Neu* pExch = nullptr;
+	iDMExchange* piDM = nullptr;
+	Anisotropy_Uniaxial* pAniUni = nullptr;
+
+#ifdef MODULE_COMPILATION_ZEEMAN
+	pZeeman = dynamic_cast<Zeeman*>(GetModule(MOD_ZEEMAN));
+#endif
+#ifdef MODULE_COMPILATION_EXCHANGE
+	pExch = dynamic_cast<Exch_6ngbr_Neu*>(GetModule(MOD_EXCHANGE));
+#endif
+#ifdef MODULE_COMPILATION_IDMEXCHANGE
+	piDM = dynamic_cast<iDMExchange*>(GetModule(MOD_IDMEXCHANGE));
+#endif
+#ifdef MODULE_COMPILATION_ANIUNI
+	pAniUni = dynamic_cast<Anisotropy_Uniaxial*>(GetModule(MOD_ANIUNI));
+#endif
+
+	//cells to compute (nullptr for all)
+	const char* pactive = meshODE.Get_RelaxMask();
+
+	//with the activity mask enabled, keep energy density contributions of computed cells for when they are frozen
+	bool relax_mask = meshODE.RelaxMask_Enabled();
+
+	if (relax_mask) {
+
+		if (relax_energy_cache.size() != n.dim() && !malloc_vector(relax_energy_cache, n.dim())) relax_mask = false;
+	}
+	else if (relax_energy_cache.size()) {
+
+		relax_energy_cache.clear();
+		relax_energy_cache.shrink_to_fit();
+	}
+
+	//without the cache frozen cells can't be skipped
+	if (!relax_mask) pactive = nullptr;
+
+	//nothing to gain with a single module, unless the activity mask is used
+	int num_modules = (pZeeman != nullptr) + (pExch != nullptr) + (piDM != nullptr) + (pAniUni != nullptr);
+	if (num_modules < 2 && !(relax_mask && num_modules)) return 0.0;
+
+	double time = pSMesh->GetStageTime();
+
+	double energy_Zeeman = 0.0, energy_exch = 0.0, energy_iDM = 0.0, energy_aniuni = 0.0;
+
+#pragma omp parallel for reduction(+:energy_Zeeman, energy_exch, energy_iDM, energy_aniuni)
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		//Zeeman field is set in all cells (it's the first module so it sets Heff rather than adding to it)
+		DBL3 Hlocal = (pZeeman ? pZeeman->LocalField_FM(idx, energy_Zeeman, time) : DBL3());
+
+		if (M.is_not_empty(idx)) {
+
+			if (!pactive || pactive[idx]) {
+
+				double cell_exch = 0.0, cell_iDM = 0.0, cell_aniuni = 0.0;
+
+				if (pExch) Hlocal += pExch->LocalField_FM(idx, cell_exch);
+				if (piDM) Hlocal += piDM->LocalField_FM(idx, cell_iDM);
+				if (pAniUni) Hlocal += pAniUni->LocalField_FM(idx, cell_aniuni);
+
+				if (relax_mask) relax_energy_cache[idx] = DBL3(cell_exch, cell_iDM, cell_aniuni);
+
+				energy_exch += cell_exch;
+				energy_iDM += cell_iDM;
+				energy_aniuni += cell_aniuni;
+			}
+			else {
+
+				energy_exch += relax_energy_cache[idx].x;
+				energy_iDM += relax_energy_cache[idx].y;
+				energy_aniuni += relax_energy_cache[idx].z;
+			}
+		}
+
+		if (pZeeman) Heff[idx] = Hlocal;
+		else Heff[idx] += Hlocal;
+	}
+
+	//exchange coupling to other meshes and final energy density values
+	double energy = 0.0;
+
+	if (pZeeman) {
+
+		energy += pZeeman->UpdateField_Finish(energy_Zeeman);
+		module_fused[pMod.get_index_from_ID(MOD_ZEEMAN)] = true;
+	}
+
+	if (pExch) {
+
+		energy += pExch->UpdateField_Finish(energy_exch);
+		module_fused[pMod.get_index_from_ID(MOD_EXCHANGE)] = true;
+	}
+
+	if (piDM) {
+
+		energy += piDM->UpdateField_Finish(energy_iDM);
+		module_fused[pMod.get_index_from_ID(MOD_IDMEXCHANGE)] = true;
+	}
+
+	if (pAniUni) {
+
+		energy += pAniUni->UpdateField_Finish(energy_aniuni);
+		module_fused[pMod.get_index_from_ID(MOD_ANIUNI)] = true;
+	}
+
+	return energy;
+}
+
+#endif
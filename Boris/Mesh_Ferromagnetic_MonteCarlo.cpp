@@ -0,0 +1,417 @@
+#include "stdafx.h"
+#include "Mesh_Ferromagnetic.h"
+
+#ifdef MESH_COMPILATION_FERROMAGNETIC
+
+#include "SuperMesh.h"
+#include "Modules_LocalFields.h"
+#include "DemagTFunc.h"
+
+//----------------------------------- MONTE-CARLO METHODS : Mesh_Ferromagnetic_MonteCarlo.cpp
+
+//Monte Carlo Metropolis for micromagnetic cells : each cell magnetization is a macrospin with moment M * V, moved in a cone around its current direction.
+//Temperature dependence of material parameters (e.g. Ms, A, K1 renormalized using the set Curie temperature) is included through the parameters at the base temperature.
+//Energy contributions from Zeeman, exchange, interfacial DMI, uniaxial anisotropy and demagnetizing factors modules are included, using the same local field kernels as the fused local fields computation.
+//The mesh demag module is included through a demagnetizing field obtained with a full convolution every mc_dipolar_refresh steps, updated in between using the demag tensor between cells within mc_dipolar_radius cells, as for atomistic meshes.
+//Other energy modules (supermesh demag, bulk DMI, surface exchange, cubic anisotropy, roughness, magneto-elastic, magneto-optical) are not supported : a Monte Carlo stage cannot be run with them set (see Check_MonteCarlo_Modules).
+//Only Metropolis moves are used : there are no heat-bath moves.
+
+//Take a Monte Carlo step in this ferromagnetic mesh
+void FMesh::Iterate_MonteCarlo(double acceptance_rate)
+{
+	//Not applicable at zero temperature, and not with energy modules missing from energy changes (simulation cannot be started in this case)
+	if (IsZ(base_temperature) || Check_MonteCarlo_Modules()) return;
+
+	Setup_MonteCarlo_Modules();
+
+	//full demagnetizing field convolution if due
+	MonteCarlo_Dipolar_CheckRefresh();
+
+	Iterate_MonteCarlo_Parallel_Classic();
+
+	///////////////////////////////////////////////////////////////
+	// ADAPTIVE CONE ANGLE
+
+	if (acceptance_rate < 0 || acceptance_rate > 1) acceptance_rate = MONTECARLO_TARGETACCEPTANCE;
+
+	//adaptive cone angle, as for atomistic meshes
+	if (mc_acceptance_rate < acceptance_rate) {
+
+		//acceptance probability too low : decrease cone angle
+		mc_cone_angledeg -= MONTECARLO_CONEANGLEDEG_DELTA;
+		if (mc_cone_angledeg < MONTECARLO_CONEANGLEDEG_MIN) mc_cone_angledeg = MONTECARLO_CONEANGLEDEG_MIN;
+	}
+	else {
+
+		//acceptance probability too high : increase cone angle
+		mc_cone_angledeg += MONTECARLO_CONEANGLEDEG_DELTA;
+		if (mc_cone_angledeg > MONTECARLO_CONEANGLEDEG_MAX) mc_cone_angledeg = MONTECARLO_CONEANGLEDEG_MAX;
+	}
+}
+
+//only Zeeman, exchange, interfacial DMI, uniaxial anisotropy and demag (mesh demag or demagnetizing factors) energy modules are included in Monte Carlo energy changes : other set energy modules result in BERROR_INCORRECTCONFIG
+BError FMesh::Check_MonteCarlo_Modules(void)
+{
+	BError error(std::string(CLASS_STR(FMesh)) + "(" + (*pSMesh).key_from_meshId(meshId) + ")");
+
+	//modules which contribute to the energy but have no Monte Carlo energy change implemented. Spin torque fields, transport and heat modules are not energy terms so are allowed.
+	MOD_ unsupported_modules[] = { MOD_SDEMAG_DEMAG, MOD_DMEXCHANGE, MOD_SURFEXCHANGE, MOD_ANICUBI, MOD_ROUGHNESS, MOD_MELASTIC, MOD_MOPTICAL };
+
+	for (MOD_ modID : unsupported_modules) {
+
+		if (IsModuleSet(modID)) return error(BERROR_INCORRECTCONFIG);
+	}
+
+	return error;
+}
+
+//set Monte Carlo module pointers from currently set modules
+void FMesh::Setup_MonteCarlo_Modules(void)
+{
+	pmc_Zeeman = nullptr;
+	pmc_Exch = nullptr;
+	pmc_iDM = nullptr;
+	pmc_AniUni = nullptr;
+	pmc_DemagN = nullptr;
+	pmc_Demag = nullptr;
+
+#ifdef MODULE_COMPILATION_ZEEMAN
+	pmc_Zeeman = dynamic_cast<Zeeman*>(GetModule(MOD_ZEEMAN));
+#endif
+#ifdef MODULE_COMPILATION_EXCHANGE
+	pmc_Exch = dynamic_cast<Exch_6ngbr_Neu*>(GetModule(MOD_EXCHANGE));
+#endif
+#ifdef MODULE_COMPILATION_IDMEXCHANGE
+	pmc_iDM = dynamic_cast<iDMExchange*>(GetModule(MOD_IDMEXCHANGE));
+#endif
+#ifdef MODULE_COMPILATION_ANIUNI
+	pmc_AniUni = dynamic_cast<Anisotropy_Uniaxial*>(GetModule(MOD_ANIUNI));
+#endif
+#ifdef MODULE_COMPILATION_DEMAG_N
+	pmc_DemagN = dynamic_cast<Demag_N*>(GetModule(MOD_DEMAG_N));
+#endif
+#ifdef MODULE_COMPILATION_DEMAG
+	pmc_Demag = dynamic_cast<Demag*>(GetModule(MOD_DEMAG));
+#endif
+}
+
+//energy change (J) when moving the magnetization in cell idx from M_old (currently set in M) to M_new, with same magnitude
+//Exchange, DMI and demag energies are quadratic in M, so the energy change is taken as -mu0 * V * (M_new - M_old) . (H_old + H_new) / 2, where H_old, H_new are the fields at idx with M_old and M_new set.
+//This includes the change in neighboring cells energies without having to evaluate them, but is only exact if the stencil coupling idx to its neighbors is symmetric, i.e. for uniform A, D, Ms away from boundaries.
+//At iDMI boundary cells (non-homogeneous Neumann boundary conditions) and with spatially varying A, D or Ms it is an approximation to the change in total energy.
+//Anisotropy energy change is obtained directly from the cell energy density.
+//The mesh demag field at idx with M_new set differs from the stored field (for M_old) only by the self demag field change, since the other cells don't change.
+double FMesh::Get_MonteCarlo_EnergyChange(int idx, const DBL3& M_old, const DBL3& M_new, double time)
+{
+	//anisotropy energy densities with M_old and M_new set (energy densities accumulated by the other kernels are not needed)
+	double energy_old = 0.0, energy_new = 0.0, energy_unused = 0.0;
+
+	DBL3 H_old, H_new;
+
+	if (pmc_Exch) H_old += pmc_Exch->LocalField_FM(idx, energy_unused);
+	if (pmc_iDM) H_old += pmc_iDM->LocalField_FM(idx, energy_unused);
+	if (pmc_AniUni) pmc_AniUni->LocalField_FM(idx, energy_old);
+	if (pmc_DemagN) H_old += pmc_DemagN->LocalField_FM(idx, energy_unused);
+
+	M[idx] = M_new;
+
+	if (pmc_Exch) H_new += pmc_Exch->LocalField_FM(idx, energy_unused);
+	if (pmc_iDM) H_new += pmc_iDM->LocalField_FM(idx, energy_unused);
+	if (pmc_AniUni) pmc_AniUni->LocalField_FM(idx, energy_new);
+	if (pmc_DemagN) H_new += pmc_DemagN->LocalField_FM(idx, energy_unused);
+
+	M[idx] = M_old;
+
+	if (mc_Hd.size()) {
+
+		H_old += mc_Hd[idx];
+		H_new += mc_Hd[idx] + (mc_dipolar_self & (M_new - M_old));
+	}
+
+	//Zeeman field doesn't depend on M
+	DBL3 H_Zeeman = (pmc_Zeeman ? pmc_Zeeman->LocalField_FM(idx, energy_unused, time) : DBL3());
+
+	return h.dim() * (-MU0 * (M_new - M_old) * (H_Zeeman + (H_old + H_new) / 2) + energy_new - energy_old);
+}
+
+//checkerboard parallel Metropolis sweep at base temperature : cells of one color only have neighbors of the other color, so all cells of one color can be moved in parallel
+void FMesh::Iterate_MonteCarlo_Parallel_Classic(void)
+{
+	//number of moves in this step : one per each non-empty cell
+	int num_moves = M.get_nonempty_cells();
+
+	double time = pSMesh->GetStageTime();
+
+	//recalculate it
+	mc_acceptance_rate = 0.0;
+
+	///////////////////////////////////////////////////////////////
+	// PARALLEL MONTE-CARLO METROPOLIS
+
+	//red-black : two passes will be taken
+	int rb = 0;
+	while (rb < 2) {
+
+		double acceptance_rate = 0.0;
+
+#pragma omp parallel for reduction(+:acceptance_rate)
+		for (int idx_jk = 0; idx_jk < n.y * n.z; idx_jk++) {
+
+			int j = idx_jk % n.y;
+			int k = (idx_jk / n.y) % n.z;
+
+			//red_nudge = true for odd rows and even planes or for even rows and odd planes - have to keep index on the checkerboard pattern
+			bool red_nudge = (((j % 2) == 1 && (k % 2) == 0) || (((j % 2) == 0 && (k % 2) == 1)));
+
+			//For red pass (first) i starts from red_nudge. For black pass (second) i starts from !red_nudge.
+			for (int i = (1 - rb) * red_nudge + rb * (!red_nudge); i < n.x; i += 2) {
+
+				int idx = i + j * n.x + k * n.x*n.y;
+
+				//only consider non-empty cells which are not fixed
+				if (M.is_not_empty(idx) && !M.is_skipcell(idx)) {
+
+					DBL3 M_old = M[idx];
+
+					//obtain rotated magnetization in a cone around the current direction
+					double theta_rot = prng.rand() * mc_cone_angledeg * PI / 180.0;
+					double phi_rot = prng.rand() * 2 * PI;
+					DBL3 M_new = relrotate_polar(M_old, theta_rot, phi_rot);
+
+					//M_new has same length as M_old, but reset length anyway to avoid floating point error creep
+					M_new = M_new.normalized() * M_old.norm();
+
+					double energy_change = Get_MonteCarlo_EnergyChange(idx, M_old, M_new, time);
+
+					//Compute acceptance probability
+					double P_accept = exp(-energy_change / (BOLTZMANN * base_temperature));
+
+					if (prng.rand() <= P_accept) {
+
+						//accept move : set new magnetization
+						M[idx] = M_new;
+						acceptance_rate += 1.0 / num_moves;
+					}
+				}
+			}
+		}
+
+		mc_acceptance_rate += acceptance_rate;
+		rb++;
+
+		//demagnetizing field corrections for moves accepted in this pass, before the next pass uses the field
+		if (mc_Hd.size()) MonteCarlo_Dipolar_Update();
+	}
+}
+
+//----------------------------------- DEMAG FIELD FOR MONTE-CARLO
+
+//full convolution of demagnetizing field used for Monte Carlo energies (measure error of incrementally updated field if required)
+//the demag module adds its field to Heff, so Heff is held in mc_dM (recomputed at the next update) during the convolution and restored after : Heff and module energies saved during Monte Carlo stages are as before the step, except the demag energy which is for the current magnetization
+void FMesh::MonteCarlo_Dipolar_Refresh(bool measure_error)
+{
+	unsigned N = n.dim();
+
+	if (mc_Hd.size() != N) {
+
+		if (!malloc_vector(mc_Hd, N) || !malloc_vector(mc_M_ref, N) || !malloc_vector(mc_dM, N)) {
+
+			//out of memory : demag contribution not included
+			mc_Hd.clear();
+			mc_M_ref.clear();
+			mc_dM.clear();
+			return;
+		}
+
+		//no previous field to compare with
+		measure_error = false;
+	}
+
+	MonteCarlo_Dipolar_SetKernel();
+
+	//demag module adds its field to Heff : hold Heff in mc_dM, and start from zero field
+#pragma omp parallel for
+	for (int idx = 0; idx < N; idx++) {
+
+		mc_dM[idx] = Heff[idx];
+		Heff[idx] = DBL3();
+	}
+
+	pmc_Demag->UpdateField_NoSpeedup();
+
+	double error_num = 0.0, error_den = 0.0, Mtotal = 0.0;
+
+#pragma omp parallel for reduction(+:error_num, error_den, Mtotal)
+	for (int idx = 0; idx < N; idx++) {
+
+		if (M.is_not_empty(idx)) {
+
+			if (measure_error) {
+
+				error_num += (Heff[idx] - mc_Hd[idx]) * (Heff[idx] - mc_Hd[idx]);
+				error_den += Heff[idx] * Heff[idx];
+			}
+
+			Mtotal += M[idx].norm();
+		}
+
+		mc_Hd[idx] = Heff[idx];
+		mc_M_ref[idx] = M[idx];
+
+		//restore effective field
+		Heff[idx] = mc_dM[idx];
+	}
+
+	if (measure_error) mc_dipolar_error = (error_den > 0.0 ? sqrt(error_num / error_den) : 0.0);
+
+	mc_dipolar_Mtotal = Mtotal;
+	mc_dipolar_steps = 0;
+	mc_dipolar_change = 0.0;
+}
+
+//check if full convolution of demagnetizing field is due, before a Monte Carlo step
+void FMesh::MonteCarlo_Dipolar_CheckRefresh(void)
+{
+	if (!pmc_Demag) {
+
+		MonteCarlo_Dipolar_Free();
+		return;
+	}
+
+	if (mc_Hd.size() != n.dim() || mc_dipolar_steps >= mc_dipolar_refresh || (mc_dipolar_threshold > 0.0 && mc_dipolar_change >= mc_dipolar_threshold)) {
+
+		MonteCarlo_Dipolar_Refresh(true);
+	}
+
+	mc_dipolar_steps++;
+}
+
+//free demagnetizing field memory if previously used (demag module not set)
+void FMesh::MonteCarlo_Dipolar_Free(void)
+{
+	if (mc_Hd.size()) {
+
+		mc_Hd.clear();
+		mc_Hd.shrink_to_fit();
+		mc_M_ref.clear();
+		mc_M_ref.shrink_to_fit();
+		mc_dM.clear();
+		mc_dM.shrink_to_fit();
+	}
+
+	mc_dipolar_error = 0.0;
+}
+
+//set real-space demag correction kernel for current radius and cellsize
+void FMesh::MonteCarlo_Dipolar_SetKernel(void)
+{
+	if (mc_dipolar_kernel_radius == mc_dipolar_radius && mc_dipolar_kernel_h == h) return;
+
+	mc_dipolar_kernel.clear();
+	mc_dipolar_offsets.clear();
+
+	DemagTFunc dtf;
+
+	//demag tensor only depends on ratios of distances and cellsizes
+	DBL3 h_norm = h / h.maxdim();
+
+	//self demag tensor is diagonal for a cuboid cell
+	mc_dipolar_self = dtf.SelfDemag(h_norm);
+
+	int radius = mc_dipolar_radius;
+
+	for (int k = -radius; k <= radius; k++) {
+		for (int j = -radius; j <= radius; j++) {
+			for (int i = -radius; i <= radius; i++) {
+
+				//spherical cutoff, excluding the cell itself
+				if ((i == 0 && j == 0 && k == 0) || i * i + j * j + k * k > radius * radius) continue;
+
+				DBL3 dist = DBL3(i, j, k) & h_norm;
+
+				//diagonal (xx, yy, zz) and off-diagonal (xy, xz, yz) components
+				DBL3 Ddiag = dtf.Ldia_single(dist, h_norm);
+				DBL3 Dodiag = dtf.Lodia_single(dist, h_norm);
+
+				mc_dipolar_kernel.push_back(DBL33(DBL3(Ddiag.x, Dodiag.x, Dodiag.y), DBL3(Dodiag.x, Ddiag.y, Dodiag.z), DBL3(Dodiag.y, Dodiag.z, Ddiag.z)));
+				mc_dipolar_offsets.push_back(INT3(i, j, k));
+			}
+		}
+	}
+
+	mc_dipolar_kernel_radius = mc_dipolar_radius;
+	mc_dipolar_kernel_h = h;
+}
+
+//cell index at offset from cell (i, j, k), with periodic boundary conditions if set : -1 if outside mesh
+int FMesh::MonteCarlo_Dipolar_OffsetIndex(int i, int j, int k, const INT3& offset)
+{
+	i += offset.i;
+	j += offset.j;
+	k += offset.k;
+
+	if (i < 0 || i >= n.x) {
+
+		if (!M.is_pbc_x()) return -1;
+		i = (i % (int)n.x + n.x) % n.x;
+	}
+
+	if (j < 0 || j >= n.y) {
+
+		if (!M.is_pbc_y()) return -1;
+		j = (j % (int)n.y + n.y) % n.y;
+	}
+
+	if (k < 0 || k >= n.z) {
+
+		if (!M.is_pbc_z()) return -1;
+		k = (k % (int)n.z + n.z) % n.z;
+	}
+
+	return i + j * n.x + k * n.x * n.y;
+}
+
+//real-space demagnetizing field corrections for all magnetization changes since the last update, obtained for each cell from changes within the correction radius : used after each checkerboard pass
+void FMesh::MonteCarlo_Dipolar_Update(void)
+{
+	double change = 0.0;
+
+#pragma omp parallel for reduction(+:change)
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		mc_dM[idx] = M[idx] - mc_M_ref[idx];
+		mc_M_ref[idx] = M[idx];
+
+		change += mc_dM[idx].norm();
+	}
+
+	if (mc_dipolar_Mtotal > 0.0) mc_dipolar_change += change / mc_dipolar_Mtotal;
+
+	if (!change) return;
+
+	//demag tensor is the same for opposite offsets, so each cell can gather the corrections from its neighbors
+#pragma omp parallel for
+	for (int idx = 0; idx < n.dim(); idx++) {
+
+		if (M.is_not_empty(idx)) {
+
+			int i = idx % n.x;
+			int j = (idx / n.x) % n.y;
+			int k = idx / (n.x * n.y);
+
+			//self demag field change
+			DBL3 dH = mc_dipolar_self & mc_dM[idx];
+
+			for (int oidx = 0; oidx < mc_dipolar_offsets.size(); oidx++) {
+
+				int cell_idx = MonteCarlo_Dipolar_OffsetIndex(i, j, k, mc_dipolar_offsets[oidx]);
+
+				if (cell_idx >= 0 && !mc_dM[cell_idx].IsNull()) dH += mc_dipolar_kernel[oidx] * mc_dM[cell_idx];
+			}
+
+			mc_Hd[idx] += dH;
+		}
+	}
+}
+
+#endif
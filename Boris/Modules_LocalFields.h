@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Boris_Enums_Defs.h"
+
+#include "Mesh.h"
+#include "MeshParamsControl.h"
+
+#include "Zeeman.h"
+#include "Exchange.h"
+#include "iDMExchange.h"
+#include "Anisotropy.h"
+#include "Demag_N.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Local field kernels for ferromagnetic meshes
+
+//Effective field contribution at a single cell for modules which only need M at the cell and its nearest neighbors.
+//These are used by the modules' own UpdateField methods, and by FMesh::UpdateModules_Fused which computes several such modules together in a single pass over the mesh.
+//Each kernel returns the field contribution and accumulates the unnormalized energy density sum in energy, as used by the respective UpdateField_Finish method.
+//Only include in .cpp files which need the kernels.
+
+#ifdef MODULE_COMPILATION_ZEEMAN
+
+//Zeeman field at cell idx (all cells, including empty ones), with time the stage time used if the field is set using an equation
+inline DBL3 Zeeman::LocalField_FM(int idx, double& energy, double time)
+{
+	double cHA = pMesh->cHA;
+	pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
+
+	DBL3 H;
+
+	if (!H_equation.is_set()) H = cHA * Ha;
+	else {
+
+		//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
+		DBL3 relpos = DBL3(idx % pMesh->n.x + 0.5, (idx / pMesh->n.x) % pMesh->n.y + 0.5, idx / (pMesh->n.x*pMesh->n.y) + 0.5) & pMesh->h;
+		H = cHA * H_equation.evaluate_vector(relpos.x, relpos.y, relpos.z, time);
+	}
+
+	energy += pMesh->M[idx] * H;
+
+	return H;
+}
+
+#endif
+
+#ifdef MODULE_COMPILATION_EXCHANGE
+
+//direct exchange field at non-empty cell idx
+inline DBL3 Exch_6ngbr_Neu::LocalField_FM(int idx, double& energy)
+{
+	double Ms = pMesh->Ms;
+	double A = pMesh->A;
+	pMesh->update_parameters_mcoarse(idx, pMesh->A, A, pMesh->Ms, Ms);
+
+	//cells marked with cmbnd are calculated using exchange coupling to other ferromagnetic meshes - see UpdateField_Finish; the delsq_neu evaluates to zero in the CMBND coupling direction.
+	DBL3 Hexch = (2 * A / (MU0*Ms*Ms)) * pMesh->M.delsq_neu(idx);
+
+	energy += pMesh->M[idx] * Hexch;
+
+	return Hexch;
+}
+
+#endif
+
+#ifdef MODULE_COMPILATION_IDMEXCHANGE
+
+//direct exchange and interfacial DMI field at non-empty cell idx
+inline DBL3 iDMExchange::LocalField_FM(int idx, double& energy)
+{
+	double Ms = pMesh->Ms;
+	double A = pMesh->A;
+	double D = pMesh->D;
+	pMesh->update_parameters_mcoarse(idx, pMesh->A, A, pMesh->D, D, pMesh->Ms, Ms);
+
+	double Aconst = 2 * A / (MU0 * Ms * Ms);
+	double Dconst = -2 * D / (MU0 * Ms * Ms);
+
+	DBL3 Hexch;
+
+	if (pMesh->M.is_plane_interior(idx)) {
+
+		//interior point : can use cheaper neu versions
+
+		//direct exchange contribution
+		Hexch = Aconst * pMesh->M.delsq_neu(idx);
+
+		//Dzyaloshinskii-Moriya interfacial exchange contribution
+
+		//Differentials of M components (we only need 4, not all 9 so this could be optimised). First index is the differential direction, second index is the M component
+		DBL33 Mdiff = pMesh->M.grad_neu(idx);
+
+		//Hdm, ex = -2D / (mu0*Ms) * (dmz / dx, dmz / dy, -dmx / dx - dmy / dy)
+		Hexch += Dconst * DBL3(Mdiff.x.z, Mdiff.y.z, -Mdiff.x.x - Mdiff.y.y);
+	}
+	else {
+
+		//Non-homogeneous Neumann boundary conditions apply when using DMI. Required to ensure Brown's condition is fulfilled, i.e. m x h -> 0 when relaxing.
+		DBL3 bnd_dm_dx = (D / (2 * A)) * DBL3(pMesh->M[idx].z, 0, -pMesh->M[idx].x);
+		DBL3 bnd_dm_dy = (D / (2 * A)) * DBL3(0, pMesh->M[idx].z, -pMesh->M[idx].y);
+		DBL33 bnd_nneu = DBL33(bnd_dm_dx, bnd_dm_dy, DBL3());
+
+		//direct exchange contribution
+		//cells marked with cmbnd are calculated using exchange coupling to other ferromagnetic meshes - see UpdateField_Finish; the delsq_nneu evaluates to zero in the CMBND coupling direction.
+		Hexch = Aconst * pMesh->M.delsq_nneu(idx, bnd_nneu);
+
+		//Dzyaloshinskii-Moriya interfacial exchange contribution
+
+		//Differentials of M components (we only need 4, not all 9 so this could be optimised). First index is the differential direction, second index is the M component
+		//For cmbnd cells grad_nneu does not evaluate to zero in the CMBND coupling direction, but sided differentials are used - when setting values at CMBND cells for exchange coupled meshes must correct for this.
+		DBL33 Mdiff = pMesh->M.grad_nneu(idx, bnd_nneu);
+
+		//Hdm, ex = -2D / (mu0*Ms) * (dmz / dx, dmz / dy, -dmx / dx - dmy / dy)
+		Hexch += Dconst * DBL3(Mdiff.x.z, Mdiff.y.z, -Mdiff.x.x - Mdiff.y.y);
+	}
+
+	energy += pMesh->M[idx] * Hexch;
+
+	return Hexch;
+}
+
+#endif
+
+#ifdef MODULE_COMPILATION_ANIUNI
+
+//uniaxial anisotropy field at non-empty cell idx
+inline DBL3 Anisotropy_Uniaxial::LocalField_FM(int idx, double& energy)
+{
+	double Ms = pMesh->Ms;
+	double K1 = pMesh->K1;
+	double K2 = pMesh->K2;
+	DBL3 mcanis_ea1 = pMesh->mcanis_ea1;
+
+	pMesh->update_parameters_mcoarse(idx, pMesh->Ms, Ms, pMesh->K1, K1, pMesh->K2, K2, pMesh->mcanis_ea1, mcanis_ea1);
+
+	//calculate m.ea dot product
+	double dotprod = (pMesh->M[idx] * mcanis_ea1) / Ms;
+
+	//update energy (E/V) = K1 * sin^2(theta) + K2 * sin^4(theta) = K1 * [ 1 - dotprod*dotprod ] + K2 * [1 - dotprod * dotprod]^2
+	energy += (K1 + K2 * (1 - dotprod * dotprod)) * (1 - dotprod * dotprod);
+
+	//anisotropy field
+	return (2 / (MU0*Ms)) * dotprod * (K1 + 2 * K2 * (1 - dotprod * dotprod)) * mcanis_ea1;
+}
+
+#endif
+
+#ifdef MODULE_COMPILATION_DEMAG_N
+
+//demagnetizing field at non-empty cell idx, using demagnetizing factors
+inline DBL3 Demag_N::LocalField_FM(int idx, double& energy)
+{
+	//Nxy shouldn't have a temperature (or spatial) dependence so not using update_parameters_mcoarse here
+	DBL2 Nxy = pMesh->Nxy;
+
+	DBL3 Hdemag = DBL3(-Nxy.x * pMesh->M[idx].x, -Nxy.y * pMesh->M[idx].y, -(1 - Nxy.x - Nxy.y) * pMesh->M[idx].z);
+
+	energy += pMesh->M[idx] * Hdemag;
+
+	return Hdemag;
+}
+
+#endif
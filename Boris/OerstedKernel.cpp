@@ -16,19 +16,19 @@ BError OerstedKernel::AllocateKernelMemory(void)
 
 //-------------------------- RUN-TIME KERNEL MULTIPLICATION
 
-void OerstedKernel::KernelMultiplication_2D(VEC<ReIm3>& In, VEC<ReIm3>& Out)
+void OerstedKernel::KernelMultiplication_2D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out)
 {
 	//2D not used for Oersted module
 }
 
-void OerstedKernel::KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>& Out)
+void OerstedKernel::KernelMultiplication_3D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out)
 {
 	//Full multiplication without use of kernel symmetries : testing only
 	/*
 #pragma omp parallel for
 	for (int index = 0; index < (N.x / 2 + 1) * N.y * N.z; index++) {
 
-		ReIm3 FM = In[index];
+		fftReIm3 FM = In[index];
 
 		Out[index].x = !((KOe[index].x * FM.y) + (KOe[index].y * FM.z));
 		Out[index].y = !((KOe[index].x * FM.x * (-1)) + (KOe[index].z * FM.z));
@@ -37,8 +37,8 @@ void OerstedKernel::KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>& Out)
 	*/
 }
 
-//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given idx_start (this must be an index in the first xy plane)
-void OerstedKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
+//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given idx_start (this must be an index in the first xy plane). Line elements are spaced by stride in pline.
+void OerstedKernel::KernelMultiplication_3D_line(fftReIm3* pline, int i, int j, int stride)
 {
 	//above N.z/2 and N.y/2 use kernel symmetries to recover kernel values
 	//Kxy is odd about N.z/2 and even about N.y/2
@@ -48,7 +48,7 @@ void OerstedKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
 	if (j <= N.y / 2) {
 
 		//k = 0
-		ReIm3 FM = pline[0];
+		fftReIm3 FM = pline[0];
 
 		int idx_start = i + j * (N.x / 2 + 1);
 
@@ -59,33 +59,33 @@ void OerstedKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
 		//points between 1 and N.z /2 - 1 inclusive
 		for (int k = 1; k < N.z / 2; k++) {
 
-			ReIm3 FM_l = pline[k];
-			ReIm3 FM_h = pline[N.z - k];
+			fftReIm3 FM_l = pline[k * stride];
+			fftReIm3 FM_h = pline[(N.z - k) * stride];
 
 			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-			pline[k].x = !((KOe[ker_index].x * FM_l.y) + (KOe[ker_index].y * FM_l.z));
-			pline[k].y = !((-KOe[ker_index].x * FM_l.x) + (KOe[ker_index].z * FM_l.z));
-			pline[k].z = !((-KOe[ker_index].y * FM_l.x) + (-KOe[ker_index].z * FM_l.y));
+			pline[k * stride].x = !((KOe[ker_index].x * FM_l.y) + (KOe[ker_index].y * FM_l.z));
+			pline[k * stride].y = !((-KOe[ker_index].x * FM_l.x) + (KOe[ker_index].z * FM_l.z));
+			pline[k * stride].z = !((-KOe[ker_index].y * FM_l.x) + (-KOe[ker_index].z * FM_l.y));
 
-			pline[N.z - k].x = !((-KOe[ker_index].x * FM_h.y) + (KOe[ker_index].y * FM_h.z));
-			pline[N.z - k].y = !((KOe[ker_index].x * FM_h.x) + (KOe[ker_index].z * FM_h.z));
-			pline[N.z - k].z = !((-KOe[ker_index].y * FM_h.x) + (-KOe[ker_index].z * FM_h.y));
+			pline[(N.z - k) * stride].x = !((-KOe[ker_index].x * FM_h.y) + (KOe[ker_index].y * FM_h.z));
+			pline[(N.z - k) * stride].y = !((KOe[ker_index].x * FM_h.x) + (KOe[ker_index].z * FM_h.z));
+			pline[(N.z - k) * stride].z = !((-KOe[ker_index].y * FM_h.x) + (-KOe[ker_index].z * FM_h.y));
 		}
 
 		//k = N.z / 2
-		FM = pline[N.z / 2];
+		FM = pline[(N.z / 2) * stride];
 
 		int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-		pline[N.z / 2].x = !((KOe[idx_mid].x * FM.y) + (KOe[idx_mid].y * FM.z));
-		pline[N.z / 2].y = !((-KOe[idx_mid].x * FM.x) + (KOe[idx_mid].z * FM.z));
-		pline[N.z / 2].z = !((-KOe[idx_mid].y * FM.x) + (-KOe[idx_mid].z * FM.y));
+		pline[(N.z / 2) * stride].x = !((KOe[idx_mid].x * FM.y) + (KOe[idx_mid].y * FM.z));
+		pline[(N.z / 2) * stride].y = !((-KOe[idx_mid].x * FM.x) + (KOe[idx_mid].z * FM.z));
+		pline[(N.z / 2) * stride].z = !((-KOe[idx_mid].y * FM.x) + (-KOe[idx_mid].z * FM.y));
 	}
 	else {
 
 		//k = 0
-		ReIm3 FM = pline[0];
+		fftReIm3 FM = pline[0];
 
 		int idx_start = i + (N.y - j) * (N.x / 2 + 1);
 
@@ -96,28 +96,28 @@ void OerstedKernel::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
 		//points between 1 and N.z /2 - 1 inclusive
 		for (int k = 1; k < N.z / 2; k++) {
 
-			ReIm3 FM_l = pline[k];
-			ReIm3 FM_h = pline[N.z - k];
+			fftReIm3 FM_l = pline[k * stride];
+			fftReIm3 FM_h = pline[(N.z - k) * stride];
 
 			int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-			pline[k].x = !((KOe[ker_index].x * FM_l.y) + (-KOe[ker_index].y * FM_l.z));
-			pline[k].y = !((-KOe[ker_index].x * FM_l.x) + (KOe[ker_index].z * FM_l.z));
-			pline[k].z = !((KOe[ker_index].y * FM_l.x) + (-KOe[ker_index].z * FM_l.y));
+			pline[k * stride].x = !((KOe[ker_index].x * FM_l.y) + (-KOe[ker_index].y * FM_l.z));
+			pline[k * stride].y = !((-KOe[ker_index].x * FM_l.x) + (KOe[ker_index].z * FM_l.z));
+			pline[k * stride].z = !((KOe[ker_index].y * FM_l.x) + (-KOe[ker_index].z * FM_l.y));
 
-			pline[N.z - k].x = !((-KOe[ker_index].x * FM_h.y) + (-KOe[ker_index].y * FM_h.z));
-			pline[N.z - k].y = !((KOe[ker_index].x * FM_h.x) + (KOe[ker_index].z * FM_h.z));
-			pline[N.z - k].z = !((KOe[ker_index].y * FM_h.x) + (-KOe[ker_index].z * FM_h.y));
+			pline[(N.z - k) * stride].x = !((-KOe[ker_index].x * FM_h.y) + (-KOe[ker_index].y * FM_h.z));
+			pline[(N.z - k) * stride].y = !((KOe[ker_index].x * FM_h.x) + (KOe[ker_index].z * FM_h.z));
+			pline[(N.z - k) * stride].z = !((KOe[ker_index].y * FM_h.x) + (-KOe[ker_index].z * FM_h.y));
 		}
 
 		//k = N.z / 2
-		FM = pline[N.z / 2];
+		FM = pline[(N.z / 2) * stride];
 
 		int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-		pline[N.z / 2].x = !((KOe[idx_mid].x * FM.y) + (-KOe[idx_mid].y * FM.z));
-		pline[N.z / 2].y = !((-KOe[idx_mid].x * FM.x) + (KOe[idx_mid].z * FM.z));
-		pline[N.z / 2].z = !((KOe[idx_mid].y * FM.x) + (-KOe[idx_mid].z * FM.y));
+		pline[(N.z / 2) * stride].x = !((KOe[idx_mid].x * FM.y) + (-KOe[idx_mid].y * FM.z));
+		pline[(N.z / 2) * stride].y = !((-KOe[idx_mid].x * FM.x) + (KOe[idx_mid].z * FM.z));
+		pline[(N.z / 2) * stride].z = !((KOe[idx_mid].y * FM.x) + (-KOe[idx_mid].z * FM.y));
 	}
 }
 
@@ -175,7 +175,7 @@ BError OerstedKernel::Calculate_Oersted_Kernels_3D(void)
 		FFTW_PATIENT);
 
 	//lambda used to transform an input real tensor into an output real kernel
-	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<DBL3>& kernel) -> void {
+	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<fftReal3>& kernel) -> void {
 
 		//-------------- FFT REAL TENSOR
 
@@ -23,7 +23,7 @@ class OerstedKernel :
 private:
 
 	//Kernels for 3D Oersted field : Kxy, Kxz, Kyz (imaginary parts only, real parts are zero)
-	VEC<DBL3> KOe;
+	VEC<fftReal3> KOe;
 
 private:
 
@@ -57,20 +57,20 @@ protected:
 	//-------------------------- RUN-TIME KERNEL MULTIPLICATION
 
 	//Called by Convolute_2D/Convolute_3D methods in Convolution class : define pointwise multiplication of In with Kernels and set result in Out
-	void KernelMultiplication_2D(VEC<ReIm3>& In, VEC<ReIm3>& Out);
-	void KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>& Out);
+	void KernelMultiplication_2D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out);
+	void KernelMultiplication_3D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out);
 
 	//multiple input spaces version, used when not embedding the kenel multiplication
-	void KernelMultiplication_2D(std::vector<VEC<ReIm3>*>& Incol, VEC<ReIm3>& Out) {}
-	void KernelMultiplication_3D(std::vector<VEC<ReIm3>*>& Incol, VEC<ReIm3>& Out) {}
+	void KernelMultiplication_2D(std::vector<VEC<fftReIm3>*>& Incol, VEC<fftReIm3>& Out) {}
+	void KernelMultiplication_3D(std::vector<VEC<fftReIm3>*>& Incol, VEC<fftReIm3>& Out) {}
 
 	//kernel multiplications for a single line : used for embedding
 
-	//multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row)
-	void KernelMultiplication_2D_line(ReIm3* pline, int i) {}
+	//multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row). Line elements are spaced by stride in pline.
+	void KernelMultiplication_2D_line(fftReIm3* pline, int i, int stride) {}
 
-	//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane)
-	void KernelMultiplication_3D_line(ReIm3* pline, int i, int j);
+	//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane). Line elements are spaced by stride in pline.
+	void KernelMultiplication_3D_line(fftReIm3* pline, int i, int j, int stride);
 };
 
 #endif
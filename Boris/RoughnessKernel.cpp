@@ -45,10 +45,10 @@ BError RoughnessKernel<Owner>::AllocateKernelMemory(void)
 
 //-------------------------- RUN-TIME KERNEL MULTIPLICATION
 
-template void RoughnessKernel<Roughness>::KernelMultiplication_2D(VEC<ReIm3>& In, VEC<ReIm3>& Out);
+template void RoughnessKernel<Roughness>::KernelMultiplication_2D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out);
 
 template <typename Owner>
-void RoughnessKernel<Owner>::KernelMultiplication_2D(VEC<ReIm3>& In, VEC<ReIm3>& Out)
+void RoughnessKernel<Owner>::KernelMultiplication_2D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out)
 {
 	//Full multiplication without use of kernel symmetries : testing only
 	/*
@@ -57,7 +57,7 @@ void RoughnessKernel<Owner>::KernelMultiplication_2D(VEC<ReIm3>& In, VEC<ReIm3>&
 #pragma omp parallel for
 		for (int index = 0; index < (N.x / 2 + 1)*N.y; index++) {
 
-			ReIm3 FM = In[index];
+			fftReIm3 FM = In[index];
 
 			Out[index].x = Kdiag[index].x  * FM.x;
 			Out[index].y = Kdiag[index].y  * FM.y;
@@ -69,7 +69,7 @@ void RoughnessKernel<Owner>::KernelMultiplication_2D(VEC<ReIm3>& In, VEC<ReIm3>&
 #pragma omp parallel for
 		for (int index = 0; index < (N.x / 2 + 1)*N.y; index++) {
 
-			ReIm3 FM = In[index];
+			fftReIm3 FM = In[index];
 
 			Out[index].x = K2D_odiag[index] * FM.x;
 			Out[index].y = ReIm();
@@ -79,10 +79,10 @@ void RoughnessKernel<Owner>::KernelMultiplication_2D(VEC<ReIm3>& In, VEC<ReIm3>&
 	*/
 }
 
-template void RoughnessKernel<Roughness>::KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>& Out);
+template void RoughnessKernel<Roughness>::KernelMultiplication_3D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out);
 
 template <typename Owner>
-void RoughnessKernel<Owner>::KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>& Out)
+void RoughnessKernel<Owner>::KernelMultiplication_3D(VEC<fftReIm3>& In, VEC<fftReIm3>& Out)
 {
 	//Full multiplication without use of kernel symmetries : testing only
 	/*
@@ -91,7 +91,7 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>&
 #pragma omp parallel for
 		for (int index = 0; index < (N.x / 2 + 1)*N.y*N.z; index++) {
 
-			ReIm3 FM = In[index];
+			fftReIm3 FM = In[index];
 
 			Out[index].x = Kdiag[index].x * FM.x;
 			Out[index].y = Kdiag[index].y * FM.y;
@@ -103,7 +103,7 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>&
 #pragma omp parallel for
 		for (int index = 0; index < (N.x / 2 + 1)*N.y*N.z; index++) {
 
-			ReIm3 FM = In[index];
+			fftReIm3 FM = In[index];
 
 			Out[index].x = Kodiag[index].x * FM.x;
 			Out[index].y = Kodiag[index].y * FM.y;
@@ -113,11 +113,11 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D(VEC<ReIm3>& In, VEC<ReIm3>&
 	*/
 }
 
-template void RoughnessKernel<Roughness>::KernelMultiplication_2D_line(ReIm3* pline, int i);
+template void RoughnessKernel<Roughness>::KernelMultiplication_2D_line(fftReIm3* pline, int i, int stride);
 
-//multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row)
+//multiply kernels in line along y direction (so use stride of (N.x/2 + 1) to read from kernels), starting at given i index (this must be an index in the first x row). Line elements are spaced by stride in pline.
 template <typename Owner>
-void RoughnessKernel<Owner>::KernelMultiplication_2D_line(ReIm3* pline, int i)
+void RoughnessKernel<Owner>::KernelMultiplication_2D_line(fftReIm3* pline, int i, int stride)
 {
 	//above N.y/2 use kernel symmetries to recover kernel values
 	//diagonal components are even about the N.y/2 point
@@ -126,7 +126,7 @@ void RoughnessKernel<Owner>::KernelMultiplication_2D_line(ReIm3* pline, int i)
 	if (!pOwner->off_diagonal_convolution) {
 
 		//j = 0
-		ReIm3 FM = pline[0];
+		fftReIm3 FM = pline[0];
 
 		int idx_start = i;
 
@@ -137,33 +137,33 @@ void RoughnessKernel<Owner>::KernelMultiplication_2D_line(ReIm3* pline, int i)
 		//points between 1 and N.y / 2 + 1 inclusive
 		for (int j = 1; j <= N.y / 2; j++) {
 
-			ReIm3 FM_l = pline[j];
-			ReIm3 FM_h = pline[N.y - j];
+			fftReIm3 FM_l = pline[j * stride];
+			fftReIm3 FM_h = pline[(N.y - j) * stride];
 
 			int ker_index = i + j * (N.x / 2 + 1);
 
-			pline[j].x = Kdiag[ker_index].x  * FM_l.x;
-			pline[j].y = Kdiag[ker_index].y  * FM_l.y;
-			pline[j].z = Kdiag[ker_index].z  * FM_l.z;
+			pline[j * stride].x = Kdiag[ker_index].x  * FM_l.x;
+			pline[j * stride].y = Kdiag[ker_index].y  * FM_l.y;
+			pline[j * stride].z = Kdiag[ker_index].z  * FM_l.z;
 
-			pline[N.y - j].x = Kdiag[ker_index].x  * FM_h.x;
-			pline[N.y - j].y = Kdiag[ker_index].y  * FM_h.y;
-			pline[N.y - j].z = Kdiag[ker_index].z  * FM_h.z;
+			pline[(N.y - j) * stride].x = Kdiag[ker_index].x  * FM_h.x;
+			pline[(N.y - j) * stride].y = Kdiag[ker_index].y  * FM_h.y;
+			pline[(N.y - j) * stride].z = Kdiag[ker_index].z  * FM_h.z;
 		}
 
 		//j = N.y / 2
-		FM = pline[N.y / 2];
+		FM = pline[(N.y / 2) * stride];
 
 		int idx_mid = i + (N.y / 2) * (N.x / 2 + 1);
 
-		pline[N.y / 2].x = Kdiag[idx_mid].x  * FM.x;
-		pline[N.y / 2].y = Kdiag[idx_mid].y  * FM.y;
-		pline[N.y / 2].z = Kdiag[idx_mid].z  * FM.z;
+		pline[(N.y / 2) * stride].x = Kdiag[idx_mid].x  * FM.x;
+		pline[(N.y / 2) * stride].y = Kdiag[idx_mid].y  * FM.y;
+		pline[(N.y / 2) * stride].z = Kdiag[idx_mid].z  * FM.z;
 	}
 	else {
 
 		//j = 0
-		ReIm3 FM = pline[0];
+		fftReIm3 FM = pline[0];
 
 		int idx_start = i;
 
@@ -174,36 +174,36 @@ void RoughnessKernel<Owner>::KernelMultiplication_2D_line(ReIm3* pline, int i)
 		//points between 1 and N.y / 2 + 1 inclusive
 		for (int j = 1; j <= N.y / 2; j++) {
 
-			ReIm3 FM_l = pline[j];
-			ReIm3 FM_h = pline[N.y - j];
+			fftReIm3 FM_l = pline[j * stride];
+			fftReIm3 FM_h = pline[(N.y - j) * stride];
 
 			int ker_index = i + j * (N.x / 2 + 1);
 
-			pline[j].x = K2D_odiag[ker_index] * FM_l.x;
-			pline[j].y = ReIm();
-			pline[j].z = ReIm();
+			pline[j * stride].x = K2D_odiag[ker_index] * FM_l.x;
+			pline[j * stride].y = ReIm();
+			pline[j * stride].z = ReIm();
 
-			pline[N.y - j].x = -K2D_odiag[ker_index] * FM_h.x;
-			pline[N.y - j].y = ReIm();
-			pline[N.y - j].z = ReIm();
+			pline[(N.y - j) * stride].x = -K2D_odiag[ker_index] * FM_h.x;
+			pline[(N.y - j) * stride].y = ReIm();
+			pline[(N.y - j) * stride].z = ReIm();
 		}
 
 		//j = N.y / 2
-		FM = pline[N.y / 2];
+		FM = pline[(N.y / 2) * stride];
 
 		int idx_mid = i + (N.y / 2) * (N.x / 2 + 1);
 
-		pline[N.y / 2].x = K2D_odiag[idx_mid] * FM.x;
-		pline[N.y / 2].y = ReIm();
-		pline[N.y / 2].z = ReIm();
+		pline[(N.y / 2) * stride].x = K2D_odiag[idx_mid] * FM.x;
+		pline[(N.y / 2) * stride].y = ReIm();
+		pline[(N.y / 2) * stride].z = ReIm();
 	}
 }
 
-template void RoughnessKernel<Roughness>::KernelMultiplication_3D_line(ReIm3* pline, int i, int j);
+template void RoughnessKernel<Roughness>::KernelMultiplication_3D_line(fftReIm3* pline, int i, int j, int stride);
 
-//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane)
+//multiply kernels in line along z direction (so use stride of (N.x/2 + 1) * N.y to read from kernels), starting at given i and j indexes (these must be an indexes in the first xy plane). Line elements are spaced by stride in pline.
 template <typename Owner>
-void RoughnessKernel<Owner>::KernelMultiplication_3D_line(ReIm3* pline, int i, int j)
+void RoughnessKernel<Owner>::KernelMultiplication_3D_line(fftReIm3* pline, int i, int j, int stride)
 {
 	//above N.z/2 and N.y/2 use kernel symmetries to recover kernel values
 	//diagonal components are even about the N.z/2 and N.y/2 points
@@ -216,7 +216,7 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D_line(ReIm3* pline, int i, i
 		if (j <= N.y / 2) {
 
 			//k = 0
-			ReIm3 FM = pline[0];
+			fftReIm3 FM = pline[0];
 
 			int idx_start = i + j * (N.x / 2 + 1);
 
@@ -227,33 +227,33 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D_line(ReIm3* pline, int i, i
 			//points between 1 and N.z /2 - 1 inclusive
 			for (int k = 1; k < N.z / 2; k++) {
 
-				ReIm3 FM_l = pline[k];
-				ReIm3 FM_h = pline[N.z - k];
+				fftReIm3 FM_l = pline[k * stride];
+				fftReIm3 FM_h = pline[(N.z - k) * stride];
 
 				int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-				pline[k].x = Kdiag[ker_index].x * FM_l.x;
-				pline[k].y = Kdiag[ker_index].y * FM_l.y;
-				pline[k].z = Kdiag[ker_index].z * FM_l.z;
+				pline[k * stride].x = Kdiag[ker_index].x * FM_l.x;
+				pline[k * stride].y = Kdiag[ker_index].y * FM_l.y;
+				pline[k * stride].z = Kdiag[ker_index].z * FM_l.z;
 
-				pline[N.z - k].x = Kdiag[ker_index].x * FM_h.x;
-				pline[N.z - k].y = Kdiag[ker_index].y * FM_h.y;
-				pline[N.z - k].z = Kdiag[ker_index].z * FM_h.z;
+				pline[(N.z - k) * stride].x = Kdiag[ker_index].x * FM_h.x;
+				pline[(N.z - k) * stride].y = Kdiag[ker_index].y * FM_h.y;
+				pline[(N.z - k) * stride].z = Kdiag[ker_index].z * FM_h.z;
 			}
 
 			//k = N.z / 2
-			FM = pline[N.z / 2];
+			FM = pline[(N.z / 2) * stride];
 
 			int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-			pline[N.z / 2].x = Kdiag[idx_mid].x * FM.x;
-			pline[N.z / 2].y = Kdiag[idx_mid].y * FM.y;
-			pline[N.z / 2].z = Kdiag[idx_mid].z * FM.z;
+			pline[(N.z / 2) * stride].x = Kdiag[idx_mid].x * FM.x;
+			pline[(N.z / 2) * stride].y = Kdiag[idx_mid].y * FM.y;
+			pline[(N.z / 2) * stride].z = Kdiag[idx_mid].z * FM.z;
 		}
 		else {
 
 			//k = 0
-			ReIm3 FM = pline[0];
+			fftReIm3 FM = pline[0];
 
 			int idx_start = i + (N.y - j) * (N.x / 2 + 1);
 
@@ -264,28 +264,28 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D_line(ReIm3* pline, int i, i
 			//points between 1 and N.z /2 - 1 inclusive
 			for (int k = 1; k < N.z / 2; k++) {
 
-				ReIm3 FM_l = pline[k];
-				ReIm3 FM_h = pline[N.z - k];
+				fftReIm3 FM_l = pline[k * stride];
+				fftReIm3 FM_h = pline[(N.z - k) * stride];
 
 				int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-				pline[k].x = Kdiag[ker_index].x * FM_l.x;
-				pline[k].y = Kdiag[ker_index].y * FM_l.y;
-				pline[k].z = Kdiag[ker_index].z * FM_l.z;
+				pline[k * stride].x = Kdiag[ker_index].x * FM_l.x;
+				pline[k * stride].y = Kdiag[ker_index].y * FM_l.y;
+				pline[k * stride].z = Kdiag[ker_index].z * FM_l.z;
 
-				pline[N.z - k].x = Kdiag[ker_index].x * FM_h.x;
-				pline[N.z - k].y = Kdiag[ker_index].y * FM_h.y;
-				pline[N.z - k].z = Kdiag[ker_index].z * FM_h.z;
+				pline[(N.z - k) * stride].x = Kdiag[ker_index].x * FM_h.x;
+				pline[(N.z - k) * stride].y = Kdiag[ker_index].y * FM_h.y;
+				pline[(N.z - k) * stride].z = Kdiag[ker_index].z * FM_h.z;
 			}
 
 			//k = N.z / 2
-			FM = pline[N.z / 2];
+			FM = pline[(N.z / 2) * stride];
 
 			int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-			pline[N.z / 2].x = Kdiag[idx_mid].x * FM.x;
-			pline[N.z / 2].y = Kdiag[idx_mid].y * FM.y;
-			pline[N.z / 2].z = Kdiag[idx_mid].z * FM.z;
+			pline[(N.z / 2) * stride].x = Kdiag[idx_mid].x * FM.x;
+			pline[(N.z / 2) * stride].y = Kdiag[idx_mid].y * FM.y;
+			pline[(N.z / 2) * stride].z = Kdiag[idx_mid].z * FM.z;
 		}
 	}
 	else {
@@ -293,7 +293,7 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D_line(ReIm3* pline, int i, i
 		if (j <= N.y / 2) {
 
 			//k = 0
-			ReIm3 FM = pline[0];
+			fftReIm3 FM = pline[0];
 
 			int idx_start = i + j * (N.x / 2 + 1);
 
@@ -304,33 +304,33 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D_line(ReIm3* pline, int i, i
 			//points between 1 and N.z /2 - 1 inclusive
 			for (int k = 1; k < N.z / 2; k++) {
 
-				ReIm3 FM_l = pline[k];
-				ReIm3 FM_h = pline[N.z - k];
+				fftReIm3 FM_l = pline[k * stride];
+				fftReIm3 FM_h = pline[(N.z - k) * stride];
 
 				int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-				pline[k].x = Kodiag[ker_index].x * FM_l.x;
-				pline[k].y = Kodiag[ker_index].y * FM_l.y;
-				pline[k].z = Kodiag[ker_index].z * FM_l.z;
+				pline[k * stride].x = Kodiag[ker_index].x * FM_l.x;
+				pline[k * stride].y = Kodiag[ker_index].y * FM_l.y;
+				pline[k * stride].z = Kodiag[ker_index].z * FM_l.z;
 
-				pline[N.z - k].x = Kodiag[ker_index].x * FM_h.x;
-				pline[N.z - k].y = -Kodiag[ker_index].y * FM_h.y;
-				pline[N.z - k].z = -Kodiag[ker_index].z * FM_h.z;
+				pline[(N.z - k) * stride].x = Kodiag[ker_index].x * FM_h.x;
+				pline[(N.z - k) * stride].y = -Kodiag[ker_index].y * FM_h.y;
+				pline[(N.z - k) * stride].z = -Kodiag[ker_index].z * FM_h.z;
 			}
 
 			//k = N.z / 2
-			FM = pline[N.z / 2];
+			FM = pline[(N.z / 2) * stride];
 
 			int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-			pline[N.z / 2].x = Kodiag[idx_mid].x * FM.x;
-			pline[N.z / 2].y = Kodiag[idx_mid].y * FM.y;
-			pline[N.z / 2].z = Kodiag[idx_mid].z * FM.z;
+			pline[(N.z / 2) * stride].x = Kodiag[idx_mid].x * FM.x;
+			pline[(N.z / 2) * stride].y = Kodiag[idx_mid].y * FM.y;
+			pline[(N.z / 2) * stride].z = Kodiag[idx_mid].z * FM.z;
 		}
 		else {
 
 			//k = 0
-			ReIm3 FM = pline[0];
+			fftReIm3 FM = pline[0];
 
 			int idx_start = i + (N.y - j) * (N.x / 2 + 1);
 
@@ -341,28 +341,28 @@ void RoughnessKernel<Owner>::KernelMultiplication_3D_line(ReIm3* pline, int i, i
 			//points between 1 and N.z /2 - 1 inclusive
 			for (int k = 1; k < N.z / 2; k++) {
 
-				ReIm3 FM_l = pline[k];
-				ReIm3 FM_h = pline[N.z - k];
+				fftReIm3 FM_l = pline[k * stride];
+				fftReIm3 FM_h = pline[(N.z - k) * stride];
 
 				int ker_index = idx_start + k * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-				pline[k].x = -Kodiag[ker_index].x * FM_l.x;
-				pline[k].y = Kodiag[ker_index].y * FM_l.y;
-				pline[k].z = -Kodiag[ker_index].z * FM_l.z;
+				pline[k * stride].x = -Kodiag[ker_index].x * FM_l.x;
+				pline[k * stride].y = Kodiag[ker_index].y * FM_l.y;
+				pline[k * stride].z = -Kodiag[ker_index].z * FM_l.z;
 
-				pline[N.z - k].x = -Kodiag[ker_index].x * FM_h.x;
-				pline[N.z - k].y = -Kodiag[ker_index].y * FM_h.y;
-				pline[N.z - k].z = Kodiag[ker_index].z * FM_h.z;
+				pline[(N.z - k) * stride].x = -Kodiag[ker_index].x * FM_h.x;
+				pline[(N.z - k) * stride].y = -Kodiag[ker_index].y * FM_h.y;
+				pline[(N.z - k) * stride].z = Kodiag[ker_index].z * FM_h.z;
 			}
 
 			//k = N.z / 2
-			FM = pline[N.z / 2];
+			FM = pline[(N.z / 2) * stride];
 
 			int idx_mid = idx_start + (N.z / 2) * (N.x / 2 + 1) * (N.y / 2 + 1);
 
-			pline[N.z / 2].x = -Kodiag[idx_mid].x * FM.x;
-			pline[N.z / 2].y = Kodiag[idx_mid].y * FM.y;
-			pline[N.z / 2].z = -Kodiag[idx_mid].z * FM.z;
+			pline[(N.z / 2) * stride].x = -Kodiag[idx_mid].x * FM.x;
+			pline[(N.z / 2) * stride].y = Kodiag[idx_mid].y * FM.y;
+			pline[(N.z / 2) * stride].z = -Kodiag[idx_mid].z * FM.z;
 		}
 	}
 }
@@ -570,7 +570,7 @@ BError RoughnessKernel<Owner>::Calculate_Roughness_Kernels_3D(void)
 	//-------------- FFT REAL TENSOR INTO REAL KERNELS
 
 	//lambda used to transform an input tensor into an output kernel
-	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<DBL3>& kernel, bool off_diagonal) -> void {
+	auto tensor_to_kernel = [&](VEC<DBL3>& tensor, VEC<fftReal3>& kernel, bool off_diagonal) -> void {
 
 		//1. FFTs along x
 		for (int k = 0; k < N.z; k++) {
@@ -319,6 +319,126 @@ Rect SDemag::get_convolution_rect(SDemag_Demag* demag_demag)
 	return Rect();
 }
 
+//------------------ Helpers for multi-layered convolution computation
+
+//set layer_threads for multi-layered convolution, depending on number of layers, their size and number of threads available
+void SDemag::set_layer_scheduling(void)
+{
+	layer_threads = 0;
+
+	int num_threads = omp_get_max_threads();
+	int num_layers = pSDemag_Demag.size();
+
+	if (num_layers < 2 || num_threads < 2) return;
+
+	//the x fft stage has the fewest lines (n.y * n.z, same for all layers) : if every thread gets at least 4 full blocks of lines here then each layer keeps all threads busy on its own
+	int layer_lines = n_common.y * n_common.z;
+	if (layer_lines >= 4 * FFT_BLOCK_LINES * num_threads) return;
+
+	//split threads between layers : with more layers than threads each layer gets a single thread
+	layer_threads = maximum(1, num_threads / num_layers);
+}
+
+//run method(idx) for all layers idx (concurrently if layer_threads is set, else in order, reversed if reverse_order) and return the sum of method outputs
+template <typename Method>
+double SDemag::Run_Layers(Method method, bool reverse_order)
+{
+	int num_layers = pSDemag_Demag.size();
+
+	return Run_OmpTeams(num_layers, layer_threads, [&](int idx) { return method(reverse_order ? num_layers - 1 - idx : idx); });
+}
+
+//transfer in (if needed) and forward fft for given layer
+void SDemag::Forward_FFT_Layer(int idx)
+{
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	if (pSDemag_Demag[idx]->pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+
+		if (pSDemag_Demag[idx]->do_transfer) {
+
+			//transfer from M to common meshing
+			pSDemag_Demag[idx]->transfer.transfer_in_averaged();
+
+			//do forward FFT
+			pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
+		}
+		else {
+
+			pSDemag_Demag[idx]->ForwardFFT_AveragedInputs(pSDemag_Demag[idx]->pMesh->M, pSDemag_Demag[idx]->pMesh->M2);
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	else {
+
+		if (pSDemag_Demag[idx]->do_transfer) {
+
+			//transfer from M to common meshing
+			pSDemag_Demag[idx]->transfer.transfer_in();
+
+			//do forward FFT
+			pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
+		}
+		else {
+
+			pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->pMesh->M);
+		}
+	}
+}
+
+//inverse fft for given layer and return its energy contribution : output set in the layer Hdemag if save_Hdemag, else added to Heff (directly, or with a later call to Transfer_Out_Layer)
+double SDemag::Inverse_FFT_Layer(int idx, bool save_Hdemag)
+{
+	SDemag_Demag* pDemag = pSDemag_Demag[idx];
+
+	double energy_layer = 0.0;
+
+	if (pDemag->do_transfer) {
+
+		//do inverse FFT, output in Hdemag, or in transfer to be transferred to Heff later
+		if (save_Hdemag) energy_layer = pDemag->InverseFFT(pDemag->transfer, pDemag->Hdemag, true);
+		else energy_layer = pDemag->InverseFFT(pDemag->transfer, pDemag->transfer, true);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	else if (pDemag->pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+
+		if (save_Hdemag) energy_layer = pDemag->InverseFFT_AveragedInputs(pDemag->pMesh->M, pDemag->pMesh->M2, pDemag->Hdemag, true);
+		else energy_layer = pDemag->InverseFFT_AveragedInputs_DuplicatedOutputs(pDemag->pMesh->M, pDemag->pMesh->M2, pDemag->pMesh->Heff, pDemag->pMesh->Heff2, false);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	else {
+
+		if (save_Hdemag) energy_layer = pDemag->InverseFFT(pDemag->pMesh->M, pDemag->Hdemag, true);
+		else energy_layer = pDemag->InverseFFT(pDemag->pMesh->M, pDemag->pMesh->Heff, false);
+	}
+
+	return (energy_layer / pDemag->non_empty_cells) * pDemag->energy_density_weight;
+}
+
+//add output from inverse fft to Heff for given layer if transfer used
+void SDemag::Transfer_Out_Layer(int idx)
+{
+	if (!pSDemag_Demag[idx]->do_transfer) return;
+
+	//transfer to Heff in each mesh
+	if (pSDemag_Demag[idx]->pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) pSDemag_Demag[idx]->transfer.transfer_out_duplicated();
+	else pSDemag_Demag[idx]->transfer.transfer_out();
+}
+
 //-------------------Setters
 
 //change between demag calculation types : super-mesh (status = false) or multilayered (status = true)
@@ -444,8 +564,17 @@ BError SDemag::Initialize(void)
 	if (!use_multilayered_convolution) {
 
 		//make sure to allocate memory for Hdemag if we need it
-		if (pSMesh->GetEvaluationSpeedup()) Hdemag.resize(pSMesh->h_fm, pSMesh->sMeshRect_fm);
-		else Hdemag.clear();
+		if (pSMesh->GetEvaluationSpeedup()) {
+
+			Hdemag.resize(pSMesh->h_fm, pSMesh->sMeshRect_fm);
+
+			if (!Hdemag_extrapolation.Initialize(pSMesh->GetEvaluationSpeedupExtrapolation(), pSMesh->h_fm, pSMesh->sMeshRect_fm)) return error(BERROR_OUTOFMEMORY_CRIT);
+		}
+		else {
+
+			Hdemag.clear();
+			Hdemag_extrapolation.Clear();
+		}
 	}
 
 	Hdemag_calculated = false;
@@ -513,6 +642,8 @@ BError SDemag::Initialize(void)
 				total_nonempty_volume += pSMesh->pMesh[idx]->Get_NonEmpty_Magnetic_Volume();
 			}
 		}
+
+		set_layer_scheduling();
 	}
 
 	return error;
@@ -632,6 +763,7 @@ BError SDemag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 		//if memory needs to be allocated for Hdemag, it will be done through Initialize 
 		Hdemag.clear();
+		Hdemag_extrapolation.Clear();
 		Hdemag_calculated = false;
 
 		if (!use_multilayered_convolution) {
@@ -763,6 +895,13 @@ double SDemag::UpdateField(void)
 
 					Hdemag_calculated = true;
 
+					//keep evaluation for extrapolation on skipped steps if enabled, and report extrapolation error
+					if (Hdemag_extrapolation.Enabled()) {
+
+						Hdemag_extrapolation.Save(Hdemag, pSMesh->Get_EvalStep_Time(), pSMesh->GetTime(), pSMesh->GetTimeStep());
+						if (Hdemag_extrapolation.Get_Error() >= 0.0) pSMesh->Report_EvalSpeedup_Error(Hdemag_extrapolation.Get_Error());
+					}
+
 					//finish off energy value
 					energy *= -MU0 / (2 * non_empty_cells);
 				}
@@ -809,6 +948,11 @@ double SDemag::UpdateField(void)
 					return energy;
 				}
 			}
+			else if (Hdemag_extrapolation.Enabled()) {
+
+				//skipped step : extrapolate Hdemag to this evaluation step time from previous evaluations instead of re-using the last one
+				Hdemag_extrapolation.Extrapolate(Hdemag, pSMesh->Get_EvalStep_Time(), pSMesh->GetTime(), pSMesh->GetTimeStep());
+			}
 
 			if (!antiferromagnetic_meshes_present) {
 
@@ -867,6 +1011,9 @@ double SDemag::UpdateField(void)
 
 	else {
 
+		//layers are run concurrently if set in layer_threads (see set_layer_scheduling), with a full synchronisation between forward ffts, kernel multiplications and inverse ffts
+		//outputs are transferred to Heff after all inverse ffts : different layers can belong to the same mesh
+
 		///////////////////////////////////////////////////////////////////////////////////////////////
 		////////////////////////////////// EVAL SPEEDUP - MULTILAYERED ////////////////////////////////
 		///////////////////////////////////////////////////////////////////////////////////////////////
@@ -882,161 +1029,41 @@ double SDemag::UpdateField(void)
 				//calculate field required
 
 				//Forward FFT for all ferromagnetic meshes
-				for (int idx = 0; idx < pSDemag_Demag.size(); idx++) {
-
-					///////////////////////////////////////////////////////////////////////////////////////////////
-					//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
-					///////////////////////////////////////////////////////////////////////////////////////////////
-
-					if (pSDemag_Demag[idx]->pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-						if (pSDemag_Demag[idx]->do_transfer) {
-
-							//transfer from M to common meshing
-							pSDemag_Demag[idx]->transfer.transfer_in_averaged();
-
-							//do forward FFT
-							pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
-						}
-						else {
-
-							pSDemag_Demag[idx]->ForwardFFT_AveragedInputs(pSDemag_Demag[idx]->pMesh->M, pSDemag_Demag[idx]->pMesh->M2);
-						}
-					}
-
-					///////////////////////////////////////////////////////////////////////////////////////////////
-					///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
-					///////////////////////////////////////////////////////////////////////////////////////////////
-
-					else {
+				Run_Layers([&](int idx) { Forward_FFT_Layer(idx); return 0.0; });
 
-						if (pSDemag_Demag[idx]->do_transfer) {
-
-							//transfer from M to common meshing
-							pSDemag_Demag[idx]->transfer.transfer_in();
-
-							//do forward FFT
-							pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
-						}
-						else {
-
-							pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->pMesh->M);
-						}
-					}
-				}
-		
 				//Kernel multiplications for multiple inputs. Reverse loop ordering improves cache use at both ends.
-				for (int idx = pSDemag_Demag.size() - 1; idx >= 0; idx--) {
-
-					pSDemag_Demag[idx]->KernelMultiplication_MultipleInputs(FFT_Spaces_Input);
-				}
+				Run_Layers([&](int idx) { pSDemag_Demag[idx]->KernelMultiplication_MultipleInputs(FFT_Spaces_Input); return 0.0; }, true);
 
 				if (update_type == EVALSPEEDUPSTEP_COMPUTE_AND_SAVE) {
 
 					//calculate field and save it for next time : we'll need to use it (expecting update_type = EVALSPEEDUPSTEP_SKIP next time)
 
-					energy = 0;
-
-					//Inverse FFT
-					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
-
-						///////////////////////////////////////////////////////////////////////////////////////////////
-						//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
-						///////////////////////////////////////////////////////////////////////////////////////////////
-
-						if (pSDemag_Demag[idx_mesh]->pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								//do inverse FFT and accumulate energy
-								energy += (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->transfer, pSDemag_Demag[idx_mesh]->Hdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells) * pSDemag_Demag[idx_mesh]->energy_density_weight;
-							}
-							else {
-
-								//do inverse FFT and accumulate energy
-								energy += (pSDemag_Demag[idx_mesh]->InverseFFT_AveragedInputs(
-									pSDemag_Demag[idx_mesh]->pMesh->M, pSDemag_Demag[idx_mesh]->pMesh->M2,
-									pSDemag_Demag[idx_mesh]->Hdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells) * pSDemag_Demag[idx_mesh]->energy_density_weight;
-							}
-						}
-
-						///////////////////////////////////////////////////////////////////////////////////////////////
-						///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
-						///////////////////////////////////////////////////////////////////////////////////////////////
-
-						else {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								//do inverse FFT and accumulate energy
-								energy += (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->transfer, pSDemag_Demag[idx_mesh]->Hdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells) * pSDemag_Demag[idx_mesh]->energy_density_weight;
-							}
-							else {
-
-								//do inverse FFT and accumulate energy
-								energy += (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->pMesh->M, pSDemag_Demag[idx_mesh]->Hdemag, true) / pSDemag_Demag[idx_mesh]->non_empty_cells) * pSDemag_Demag[idx_mesh]->energy_density_weight;
-							}
-						}
-					}
+					//Inverse FFT and accumulate energy
+					energy = Run_Layers([&](int idx) { return Inverse_FFT_Layer(idx, true); });
 
 					//finish off energy value
 					energy *= -MU0 / 2;
 
 					Hdemag_calculated = true;
-				}
-				else {
-
-					//calculate field but do not save it for next time : we'll need to recalculate it again (expecting update_type != EVALSPEEDUPSTEP_SKIP again next time : EVALSPEEDUPSTEP_COMPUTE_NO_SAVE or EVALSPEEDUPSTEP_COMPUTE_AND_SAVE)
 
-					energy = 0;
-
-					//Inverse FFT
+					//keep evaluations for extrapolation on skipped steps if enabled, and report extrapolation errors (largest of all layers kept)
 					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
 
-						///////////////////////////////////////////////////////////////////////////////////////////////
-						//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
-						///////////////////////////////////////////////////////////////////////////////////////////////
-
-						if (pSDemag_Demag[idx_mesh]->pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
-
-								//do inverse FFT and accumulate energy
-								energy += (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->transfer, pSDemag_Demag[idx_mesh]->transfer, true) / pSDemag_Demag[idx_mesh]->non_empty_cells) * pSDemag_Demag[idx_mesh]->energy_density_weight;
-
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out_duplicated();
-							}
-							else {
-
-								//do inverse FFT and accumulate energy
-								energy += (pSDemag_Demag[idx_mesh]->InverseFFT_AveragedInputs_DuplicatedOutputs(
-									pSDemag_Demag[idx_mesh]->pMesh->M, pSDemag_Demag[idx_mesh]->pMesh->M2, 
-									pSDemag_Demag[idx_mesh]->pMesh->Heff, pSDemag_Demag[idx_mesh]->pMesh->Heff2, false) / pSDemag_Demag[idx_mesh]->non_empty_cells) * pSDemag_Demag[idx_mesh]->energy_density_weight;
-							}
-						}
-
-						///////////////////////////////////////////////////////////////////////////////////////////////
-						///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
-						///////////////////////////////////////////////////////////////////////////////////////////////
-
-						else {
+						if (!pSDemag_Demag[idx_mesh]->Hdemag_extrapolation.Enabled()) continue;
 
-							if (pSDemag_Demag[idx_mesh]->do_transfer) {
+						pSDemag_Demag[idx_mesh]->Hdemag_extrapolation.Save(pSDemag_Demag[idx_mesh]->Hdemag, pSMesh->Get_EvalStep_Time(), pSMesh->GetTime(), pSMesh->GetTimeStep());
+						if (pSDemag_Demag[idx_mesh]->Hdemag_extrapolation.Get_Error() >= 0.0) pSMesh->Report_EvalSpeedup_Error(pSDemag_Demag[idx_mesh]->Hdemag_extrapolation.Get_Error());
+					}
+				}
+				else {
 
-								//do inverse FFT and accumulate energy
-								energy += (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->transfer, pSDemag_Demag[idx_mesh]->transfer, true) / pSDemag_Demag[idx_mesh]->non_empty_cells) * pSDemag_Demag[idx_mesh]->energy_density_weight;
+					//calculate field but do not save it for next time : we'll need to recalculate it again (expecting update_type != EVALSPEEDUPSTEP_SKIP again next time : EVALSPEEDUPSTEP_COMPUTE_NO_SAVE or EVALSPEEDUPSTEP_COMPUTE_AND_SAVE)
 
-								//transfer to Heff in each mesh
-								pSDemag_Demag[idx_mesh]->transfer.transfer_out();
-							}
-							else {
+					//Inverse FFT and accumulate energy
+					energy = Run_Layers([&](int idx) { return Inverse_FFT_Layer(idx, false); });
 
-								//do inverse FFT and accumulate energy
-								energy += (pSDemag_Demag[idx_mesh]->InverseFFT(pSDemag_Demag[idx_mesh]->pMesh->M, pSDemag_Demag[idx_mesh]->pMesh->Heff, false) / pSDemag_Demag[idx_mesh]->non_empty_cells) * pSDemag_Demag[idx_mesh]->energy_density_weight;
-							}
-						}
-					}
+					//transfer to Heff in each mesh
+					for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) Transfer_Out_Layer(idx_mesh);
 
 					//finish off energy value
 					energy *= -MU0 / 2;
@@ -1048,6 +1075,17 @@ double SDemag::UpdateField(void)
 					return energy;
 				}
 			}
+			else {
+
+				//skipped step : extrapolate Hdemag to this evaluation step time from previous evaluations instead of re-using the last one, if enabled
+				for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
+
+					if (pSDemag_Demag[idx_mesh]->Hdemag_extrapolation.Enabled()) {
+
+						pSDemag_Demag[idx_mesh]->Hdemag_extrapolation.Extrapolate(pSDemag_Demag[idx_mesh]->Hdemag, pSMesh->Get_EvalStep_Time(), pSMesh->GetTime(), pSMesh->GetTimeStep());
+					}
+				}
+			}
 
 			//add contribution to Heff in each mesh
 			for (int idx_mesh = 0; idx_mesh < pSDemag_Demag.size(); idx_mesh++) {
@@ -1108,104 +1146,16 @@ double SDemag::UpdateField(void)
 			//don't use evaluation speedup, so no need to use Hdemag in SDemag_Demag modules (this won't have memory allocated anyway)
 			
 			//Forward FFT for all ferromagnetic meshes
-			for (int idx = 0; idx < pSDemag_Demag.size(); idx++) {
-
-				///////////////////////////////////////////////////////////////////////////////////////////////
-				//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
-				///////////////////////////////////////////////////////////////////////////////////////////////
-
-				if (pSDemag_Demag[idx]->pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-					if (pSDemag_Demag[idx]->do_transfer) {
-
-						//transfer from M to common meshing
-						pSDemag_Demag[idx]->transfer.transfer_in_averaged();
-
-						//do forward FFT
-						pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
-					}
-					else {
-
-						pSDemag_Demag[idx]->ForwardFFT_AveragedInputs(pSDemag_Demag[idx]->pMesh->M, pSDemag_Demag[idx]->pMesh->M2);
-					}
-				}
-
-				///////////////////////////////////////////////////////////////////////////////////////////////
-				///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
-				///////////////////////////////////////////////////////////////////////////////////////////////
-
-				else {
-
-					if (pSDemag_Demag[idx]->do_transfer) {
-
-						//transfer from M to common meshing
-						pSDemag_Demag[idx]->transfer.transfer_in();
-
-						//do forward FFT
-						pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->transfer);
-					}
-					else {
-
-						pSDemag_Demag[idx]->ForwardFFT(pSDemag_Demag[idx]->pMesh->M);
-					}
-				}
-			}
+			Run_Layers([&](int idx) { Forward_FFT_Layer(idx); return 0.0; });
 
 			//Kernel multiplications for multiple inputs. Reverse loop ordering improves cache use at both ends.
-			for (int idx = pSDemag_Demag.size() - 1; idx >= 0; idx--) {
-
-				pSDemag_Demag[idx]->KernelMultiplication_MultipleInputs(FFT_Spaces_Input);
-			}
-
-			energy = 0;
-
-			//Inverse FFT
-			for (int idx = 0; idx < pSDemag_Demag.size(); idx++) {
-
-				///////////////////////////////////////////////////////////////////////////////////////////////
-				//////////////////////////////////// ANTIFERROMAGNETIC MESH ///////////////////////////////////
-				///////////////////////////////////////////////////////////////////////////////////////////////
-
-				if (pSDemag_Demag[idx]->pMesh->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
-
-					if (pSDemag_Demag[idx]->do_transfer) {
-
-						//do inverse FFT and accumulate energy
-						energy += (pSDemag_Demag[idx]->InverseFFT(pSDemag_Demag[idx]->transfer, pSDemag_Demag[idx]->transfer, true) / pSDemag_Demag[idx]->non_empty_cells) * pSDemag_Demag[idx]->energy_density_weight;
+			Run_Layers([&](int idx) { pSDemag_Demag[idx]->KernelMultiplication_MultipleInputs(FFT_Spaces_Input); return 0.0; }, true);
 
-						//transfer to Heff in each mesh
-						pSDemag_Demag[idx]->transfer.transfer_out_duplicated();
-					}
-					else {
+			//Inverse FFT and accumulate energy
+			energy = Run_Layers([&](int idx) { return Inverse_FFT_Layer(idx, false); });
 
-						//do inverse FFT and accumulate energy
-						energy += (pSDemag_Demag[idx]->InverseFFT_AveragedInputs_DuplicatedOutputs(
-							pSDemag_Demag[idx]->pMesh->M, pSDemag_Demag[idx]->pMesh->M2,
-							pSDemag_Demag[idx]->pMesh->Heff, pSDemag_Demag[idx]->pMesh->Heff2, false) / pSDemag_Demag[idx]->non_empty_cells) * pSDemag_Demag[idx]->energy_density_weight;
-					}
-				}
-
-				///////////////////////////////////////////////////////////////////////////////////////////////
-				///////////////////////////////////// OTHER MAGNETIC MESH /////////////////////////////////////
-				///////////////////////////////////////////////////////////////////////////////////////////////
-
-				else {
-
-					if (pSDemag_Demag[idx]->do_transfer) {
-
-						//do inverse FFT and accumulate energy
-						energy += (pSDemag_Demag[idx]->InverseFFT(pSDemag_Demag[idx]->transfer, pSDemag_Demag[idx]->transfer, true) / pSDemag_Demag[idx]->non_empty_cells) * pSDemag_Demag[idx]->energy_density_weight;
-
-						//transfer to Heff in each mesh
-						pSDemag_Demag[idx]->transfer.transfer_out();
-					}
-					else {
-
-						//do inverse FFT and accumulate energy
-						energy += (pSDemag_Demag[idx]->InverseFFT(pSDemag_Demag[idx]->pMesh->M, pSDemag_Demag[idx]->pMesh->Heff, false) / pSDemag_Demag[idx]->non_empty_cells) * pSDemag_Demag[idx]->energy_density_weight;
-					}
-				}
-			}
+			//transfer to Heff in each mesh
+			for (int idx = 0; idx < pSDemag_Demag.size(); idx++) Transfer_Out_Layer(idx);
 
 			//finish off energy value
 			energy *= -MU0 / 2;
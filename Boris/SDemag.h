@@ -66,7 +66,7 @@ private:
 
 	//collect FFT input spaces : after Forward FFT the ffts of M from the individual meshes will be found here
 	//These are used as inputs to kernel multiplications. Same order as pSDemag_Demag.
-	std::vector<VEC<ReIm3>*> FFT_Spaces_Input;
+	std::vector<VEC<fftReIm3>*> FFT_Spaces_Input;
 
 	//collection of rectangles of meshes, same ordering as for pSDemag_Demag and FFT_Spaces, used in multi-layered convolution
 	//these are not necessarily the rectangles of the input M meshes, but are the rectangles of the transfer meshes (M -> transfer -> convolution)
@@ -100,9 +100,16 @@ private:
 	//This mode needs to be enabled by the user, and can be much faster than the default mode. The default mode is to re-evaluate the demag field at every step.
 	VEC<DBL3> Hdemag;
 
+	//previous Hdemag evaluations used to extrapolate Hdemag on skipped steps (supermesh convolution), if enabled for evaluation speedup (otherwise the last Hdemag evaluation is re-used)
+	EvalSpeedupExtrapolation Hdemag_extrapolation;
+
 	//when using the evaluation speedup method we must ensure we have a previous Hdemag evaluation available; this flag applies to both supermesh and multilayered convolution
 	bool Hdemag_calculated = false;
 
+	//multilayered convolution scheduling : if the ffts of a single layer are too small to keep all threads busy, the forward ffts, kernel multiplications and inverse ffts are run concurrently for all layers, with threads split between layers.
+	//This is the number of threads used by each layer when running layers concurrently (0 : run layers one after another, each using all threads). Set on initialization.
+	int layer_threads = 0;
+
 private:
 
 	//------------------ Helpers for multi-layered convolution control
@@ -135,6 +142,24 @@ private:
 	//Set PBC settings for M in all meshes
 	BError Set_Magnetic_PBC(void);
 
+	//------------------ Helpers for multi-layered convolution computation
+
+	//set layer_threads for multi-layered convolution, depending on number of layers, their size and number of threads available
+	void set_layer_scheduling(void);
+
+	//run method(idx) for all layers idx (concurrently if layer_threads is set, else in order, reversed if reverse_order) and return the sum of method outputs
+	template <typename Method>
+	double Run_Layers(Method method, bool reverse_order = false);
+
+	//transfer in (if needed) and forward fft for given layer
+	void Forward_FFT_Layer(int idx);
+
+	//inverse fft for given layer and return its energy contribution : output set in the layer Hdemag if save_Hdemag, else added to Heff (directly, or with a later call to Transfer_Out_Layer)
+	double Inverse_FFT_Layer(int idx, bool save_Hdemag);
+
+	//add output from inverse fft to Heff for given layer if transfer used
+	void Transfer_Out_Layer(int idx);
+
 public:
 
 	SDemag(SuperMesh *pSMesh_);
@@ -135,8 +135,17 @@ BError SDemag_Demag::Initialize(void)
 	if (error) return error;
 	
 	//make sure to allocate memory for Hdemag if we need it
-	if (pMesh->pSMesh->GetEvaluationSpeedup()) Hdemag.resize(pSDemag->get_convolution_rect(this) / pSDemag->n_common, pSDemag->get_convolution_rect(this));
-	else Hdemag.clear();
+	if (pMesh->pSMesh->GetEvaluationSpeedup()) {
+
+		Hdemag.resize(pSDemag->get_convolution_rect(this) / pSDemag->n_common, pSDemag->get_convolution_rect(this));
+
+		if (!Hdemag_extrapolation.Initialize(pMesh->pSMesh->GetEvaluationSpeedupExtrapolation(), Hdemag.h, Hdemag.rect)) return error(BERROR_OUTOFMEMORY_CRIT);
+	}
+	else {
+
+		Hdemag.clear();
+		Hdemag_extrapolation.Clear();
+	}
 
 	pSDemag->Hdemag_calculated = false;
 
@@ -200,6 +209,7 @@ BError SDemag_Demag::UpdateConfiguration(UPDATECONFIG_ cfgMessage)
 
 	//if memory needs to be allocated for Hdemag, it will be done through Initialize 
 	Hdemag.clear();
+	Hdemag_extrapolation.Clear();
 	pSDemag->Hdemag_calculated = false;
 
 	if (layer_number_2d >= 0) {
@@ -12,6 +12,7 @@ class SDemag;
 
 #include "Convolution.h"
 #include "DemagKernelCollection.h"
+#include "EvalSpeedupExtrapolation.h"
 
 #if COMPILECUDA == 1
 #include "SDemagCUDA_Demag.h"
@@ -69,6 +70,9 @@ private:
 	//This mode needs to be enabled by the user, and can be much faster than the default mode. The default mode is to re-evaluate the demag field at every step.
 	VEC<DBL3> Hdemag;
 
+	//previous Hdemag evaluations used to extrapolate Hdemag on skipped steps, if enabled for evaluation speedup (otherwise the last Hdemag evaluation is re-used)
+	EvalSpeedupExtrapolation Hdemag_extrapolation;
+
 	//number of non-empty cells in transfer
 	int non_empty_cells;
 
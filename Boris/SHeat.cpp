@@ -147,6 +147,12 @@ double SHeat::UpdateField(void)
 	//3. update the magnetic dT that will be used next time around to increment the heat solver by
 	magnetic_dT = pSMesh->GetTimeStep();
 
+	//4. temperature has changed : cached material parameter values which depend on it must be recalculated before the magnetization equation is evaluated
+	for (int idx = 0; idx < pSMesh->size(); idx++) {
+
+		if ((*pSMesh)[idx]->IsModuleSet(MOD_HEAT)) (*pSMesh)[idx]->Update_ParamsCache(true);
+	}
+
 	//no contribution to total energy density
 	return 0.0;
 }
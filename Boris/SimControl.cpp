@@ -121,6 +121,25 @@ void Simulation::RunSimulation(void)
 #endif
 	}
 
+	//evaluation method must be implemented for all meshes with an ODE (ROS2 : ferromagnetic meshes only)
+	if (!initialization_error) initialization_error = err_hndl.qcall(error, &SuperMesh::Check_ODE_EvalMethod, &SMesh);
+
+	//ensemble runs : fixed time step evaluation methods in micromagnetic meshes only, without CUDA
+	if (!initialization_error) initialization_error = err_hndl.qcall(error, &SuperMesh::Check_Ensemble, &SMesh);
+
+	//Monte-Carlo stages in the schedule : energy changes must include all set energy modules (micromagnetic meshes don't use Monte-Carlo with CUDA enabled)
+	if (!initialization_error && !cudaEnabled) {
+
+		for (int stageIdx = 0; stageIdx < simStages.size(); stageIdx++) {
+
+			if (simStages[stageIdx].stage_type() == SS_MONTECARLO) {
+
+				initialization_error = err_hndl.qcall(error, &SuperMesh::Check_MonteCarlo_Modules, &SMesh);
+				break;
+			}
+		}
+	}
+
 	if (initialization_error) {
 
 		BD.DisplayConsoleError("Failed to initialize simulation.");
@@ -55,6 +55,12 @@ void Simulation::Load_Startup_Flags(void)
 				if (bdin.getline(line, FILEROWCHARS)) OmpThreads = ToNum(std::string(line));
 				if (OmpThreads == 0 || OmpThreads > omp_get_num_procs()) OmpThreads = omp_get_num_procs();
 			}
+
+			//Demag kernel cache size limit (MB)
+			if (std::string(line) == STRINGIFY(kernelcache_size_MB)) {
+
+				if (bdin.getline(line, FILEROWCHARS)) kernelcache_size_MB = ToNum(std::string(line));
+			}
 		}
 
 		bdin.close();
@@ -98,6 +104,10 @@ void Simulation::Save_Startup_Flags(void)
 		if (OmpThreads == omp_get_num_procs()) bdout << 0 << std::endl;
 		else bdout << OmpThreads << std::endl;
 
+		//Demag kernel cache size limit (MB)
+		bdout << STRINGIFY(kernelcache_size_MB) << std::endl;
+		bdout << kernelcache_size_MB << std::endl;
+
 		bdout.close();
 	}
 }
\ No newline at end of file
@@ -435,18 +435,34 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 	commands[CMD_ODE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>ode</b>";
 	commands[CMD_ODE].descr = "[tc0,0.5,0.5,1/tc]Show interactive list of available and currently set ODEs and evaluation methods.";
 
+	commands.insert(CMD_PREWARMFFTW, CommandSpecifier(CMD_PREWARMFFTW), "prewarmfftw");
+	commands[CMD_PREWARMFFTW].usage = "[tc0,0.5,0,1/tc]USAGE : <b>prewarmfftw</b> <i>sizes (sizes ...)</i>";
+	commands[CMD_PREWARMFFTW].descr = "[tc0,0.5,0.5,1/tc]Make fft plans for convolution with given mesh sizes, specified as nx ny nz (as many as needed), and store them in the fftw wisdom file in Boris Data directory. Later simulations using these mesh sizes will initialize their convolution faster.";
+
+	commands.insert(CMD_KERNELCACHE, CommandSpecifier(CMD_KERNELCACHE), "kernelcache");
+	commands[CMD_KERNELCACHE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>kernelcache</b> <i>size</i>";
+	commands[CMD_KERNELCACHE].limits = { { int(0), Any() } };
+	commands[CMD_KERNELCACHE].descr = "[tc0,0.5,0.5,1/tc]Set maximum total size (MB) of demag kernel cache kept in Boris Data directory : demag kernels are loaded from the cache if already calculated for the same geometry, with least recently used kernels deleted first when the size is exceeded. Set zero to disable.";
+	commands[CMD_KERNELCACHE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>size</i>";
+
 	commands.insert(CMD_EVALSPEEDUP, CommandSpecifier(CMD_EVALSPEEDUP), "evalspeedup");
 	commands[CMD_EVALSPEEDUP].usage = "[tc0,0.5,0,1/tc]USAGE : <b>evalspeedup</b> <i>status</i>";
 	commands[CMD_EVALSPEEDUP].limits = { { int(EVALSPEEDUP_NONE), int(EVALSPEEDUP_NUMENTRIES) - 1 } };
 	commands[CMD_EVALSPEEDUP].descr = "[tc0,0.5,0.5,1/tc]<b>!!!Experimental!!!</b>Status levels: 0 (no speedup), 1 (accurate), 2 (aggressive), 3 (extreme).";
 
+	commands.insert(CMD_EVALSPEEDUPEXTRAP, CommandSpecifier(CMD_EVALSPEEDUPEXTRAP), "evalspeedupextrap");
+	commands[CMD_EVALSPEEDUPEXTRAP].usage = "[tc0,0.5,0,1/tc]USAGE : <b>evalspeedupextrap</b> <i>order</i>";
+	commands[CMD_EVALSPEEDUPEXTRAP].limits = { { int(EVALSPEEDUPEXTRAP_NONE), int(EVALSPEEDUPEXTRAP_NUMENTRIES) - 1 } };
+	commands[CMD_EVALSPEEDUPEXTRAP].descr = "[tc0,0.5,0.5,1/tc]Set field used by evaluation speedup on skipped steps: 0 (re-use last demag field evaluation), 1 (linear extrapolation in time from last 2 evaluations), 2 (quadratic extrapolation in time from last 3 evaluations). The relative error of extrapolation against full evaluations is available in the <i>evalspeeduperr</i> output data.";
+	commands[CMD_EVALSPEEDUPEXTRAP].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>order</i>";
+
 	commands.insert(CMD_SETODE, CommandSpecifier(CMD_SETODE), "setode");
 	commands[CMD_SETODE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setode</b> <i>equation evaluation</i>";
 	commands[CMD_SETODE].descr = "[tc0,0.5,0.5,1/tc]Set differential equation to solve in both micromagnetic and atomistic meshes, and method used to solve it (same method is applied to micromagnetic and atomistic meshes).";
 
 	commands.insert(CMD_SETODEEVAL, CommandSpecifier(CMD_SETODEEVAL), "setodeeval");
 	commands[CMD_SETODEEVAL].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setodeeval</b> <i>evaluation</i>";
-	commands[CMD_SETODEEVAL].descr = "[tc0,0.5,0.5,1/tc]Set differential equation method used to solve it (same method is applied to micromagnetic and atomistic meshes).";
+	commands[CMD_SETODEEVAL].descr = "[tc0,0.5,0.5,1/tc]Set differential equation method used to solve it (same method is applied to micromagnetic and atomistic meshes). ROS2 (Rosenbrock-W with implicit exchange) is only implemented for ferromagnetic meshes : a simulation cannot be run with it if antiferromagnetic, diamagnetic or atomistic meshes are present. ROS2 is never selected by default : on a fine-cell domain wall problem with demag it was less accurate than RKF45 at the same error settings (time step held at its 1 fs minimum), so compare against RKF45 before using it.";
 
 	commands.insert(CMD_SETATOMODE, CommandSpecifier(CMD_SETATOMODE), "setatomode");
 	commands[CMD_SETATOMODE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setatomode</b> <i>equation evaluation</i>";
@@ -459,6 +475,19 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 	commands[CMD_SETDT].unit = "s";
 	commands[CMD_SETDT].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>dT</i>";
 
+	commands.insert(CMD_SETDTMULTIRATE, CommandSpecifier(CMD_SETDTMULTIRATE), "setdtmultirate");
+	commands[CMD_SETDTMULTIRATE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setdtmultirate</b> <i>value</i>";
+	commands[CMD_SETDTMULTIRATE].limits = { { double(0.0), double(MAXTIMESTEP) } };
+	commands[CMD_SETDTMULTIRATE].descr = "[tc0,0.5,0.5,1/tc]Set time-step for atomistic meshes with multi-rate time stepping in multiscale simulations: micromagnetic meshes advance with their own time-step, and atomistic meshes sub-cycle within it starting with this time-step (adjusted by adaptive time-step methods), with micromagnetic magnetization interpolated in time. Set 0 to disable (default), so all meshes advance with the same time-step. Not used with the ABM, RK23, RKDP, RKC, SD and NCG evaluation methods.";
+	commands[CMD_SETDTMULTIRATE].unit = "s";
+	commands[CMD_SETDTMULTIRATE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>dT</i>";
+
+	commands.insert(CMD_RELAXMASK, CommandSpecifier(CMD_RELAXMASK), "relaxmask");
+	commands[CMD_RELAXMASK].usage = "[tc0,0.5,0,1/tc]USAGE : <b>relaxmask</b> <i>threshold</i>";
+	commands[CMD_RELAXMASK].limits = { { double(0.0), Any() } };
+	commands[CMD_RELAXMASK].descr = "[tc0,0.5,0.5,1/tc]Set normalized torque threshold for the relaxation activity mask, used with the SD evaluation method in ferromagnetic meshes: cells are only updated whilst they, or any of their nearest neighbors, have |mxh| above the threshold, and the exchange, interfacial DMI and uniaxial anisotropy fields are only computed in these cells (energy densities of frozen cells are kept from when they were last computed). Other modules, including any other local modules (e.g. bulk DMI, cubic anisotropy, surface exchange), are still computed in all cells. All cells are checked periodically (every 100 iterations) : the reported mxh uses the torque of frozen cells from when they were last computed, and is exact on iterations after these full checks. Set a threshold below the mxh stopping condition value. Set 0 to disable (default).";
+	commands[CMD_RELAXMASK].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>threshold</i>";
+
 	commands.insert(CMD_ASTEPCTRL, CommandSpecifier(CMD_ASTEPCTRL), "astepctrl");
 	commands[CMD_ASTEPCTRL].usage = "[tc0,0.5,0,1/tc]USAGE : <b>astepctrl</b> <i>err_fail err_high err_low dT_incr dT_min dT_max</i>";
 	commands[CMD_ASTEPCTRL].limits = { 
@@ -470,6 +499,12 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 		{double(MINTIMESTEP), double(MAXTIMESTEP)} };
 	commands[CMD_ASTEPCTRL].descr = "[tc0,0.5,0.5,1/tc]Set parameters for adaptive time step control: err_fail - repeat step above this, err_high - decrease dT above this, err_low - increase dT below this, dT_incr - increase dT using fixed multiplier, dT_min, dT_max - dT bounds.";
 
+	commands.insert(CMD_ASTEPCTRLTYPE, CommandSpecifier(CMD_ASTEPCTRLTYPE), "astepctrltype");
+	commands[CMD_ASTEPCTRLTYPE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>astepctrltype</b> <i>type (norm)</i>";
+	commands[CMD_ASTEPCTRLTYPE].limits = { { int(STEPCTRL_BANDS), int(STEPCTRL_NUMENTRIES) - 1 }, { int(LTENORM_MAX), int(LTENORM_NUMENTRIES) - 1 } };
+	commands[CMD_ASTEPCTRLTYPE].descr = "[tc0,0.5,0.5,1/tc]Set step size controller for adaptive time step methods: 0 (error bands as set with astepctrl - default), 1 (elementary controller), 2 (PI controller), 3 (PID controller). Controllers 1 to 3 set the time step from the error of the current (and previous) time steps, targeting err_high, and repeat steps above err_fail, with err_low and dT_incr not used. Optionally also set norm of local truncation error over cells: 0 (maximum - default), 1 (root-mean-square), CPU only. Number of accepted and rejected time steps is available in the <i>stepstats</i> output data.";
+	commands[CMD_ASTEPCTRLTYPE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>type norm</i>";
+
 	commands.insert(CMD_SHOWDATA, CommandSpecifier(CMD_SHOWDATA), "showdata");
 	commands[CMD_SHOWDATA].usage = "[tc0,0.5,0,1/tc]USAGE : <b>showdata</b> <i>dataname (meshname, (rectangle))</i>";
 	commands[CMD_SHOWDATA].descr = "[tc0,0.5,0.5,1/tc]Show value(s) for dataname. If applicable specify meshname and rectangle (m) in mesh. If not specified and required, active mesh is used with entire mesh rectangle.";
@@ -917,6 +952,18 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 	commands[CMD_LINKDTSTOCHASTIC].limits = { { int(0), int(1) } };
 	commands[CMD_LINKDTSTOCHASTIC].descr = "[tc0,0.5,0.5,1/tc]Links stochastic time-step to ODE time-step if set, else stochastic time-step is independently controlled.";
 
+	commands.insert(CMD_STOCHSEED, CommandSpecifier(CMD_STOCHSEED), "stochseed");
+	commands[CMD_STOCHSEED].usage = "[tc0,0.5,0,1/tc]USAGE : <b>stochseed</b> <i>seed</i>";
+	commands[CMD_STOCHSEED].limits = { { int(0), Any() } };
+	commands[CMD_STOCHSEED].descr = "[tc0,0.5,0.5,1/tc]Set seed for thermal field generation with stochastic equations (CPU only). With a set seed thermal fields are the same every time the simulation is run from reset, irrespective of the number of threads used. Set 0 for a different seed every time (default).";
+	commands[CMD_STOCHSEED].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>seed</i>";
+
+	commands.insert(CMD_ENSEMBLE, CommandSpecifier(CMD_ENSEMBLE), "ensemble");
+	commands[CMD_ENSEMBLE].usage = "[tc0,0.5,0,1/tc]USAGE : <b>ensemble</b> <i>replicas</i>";
+	commands[CMD_ENSEMBLE].limits = { { int(1), int(ENSEMBLE_MAXREPLICAS) } };
+	commands[CMD_ENSEMBLE].descr = "[tc0,0.5,0.5,1/tc]Set number of ensemble replicas for stochastic micromagnetic simulations : each replica has its own magnetization and thermal field random number stream, starting from the current magnetization, and all replicas advance through each time step in turn, sharing the meshes with all their modules (e.g. demag kernels) and material parameters. The mesh configuration is always that of replica 0. Only the Euler, TEuler and RK4 evaluation methods can be used, without atomistic meshes, multi-rate time stepping, evaluation speedup or moving mesh, and not with CUDA enabled. Heat and transport solvers cannot be used. Set replicas 1 to disable (default). Average magnetization for each replica can be saved using the <M>ens output data.";
+	commands[CMD_ENSEMBLE].return_descr = "[tc0,0.5,0,1/tc]Script return values: <i>replicas</i>";
+
 	commands.insert(CMD_SETDTSPEEDUP, CommandSpecifier(CMD_SETDTSPEEDUP), "setdtspeedup");
 	commands[CMD_SETDTSPEEDUP].usage = "[tc0,0.5,0,1/tc]USAGE : <b>setdtspeedup</b> <i>value</i>";
 	commands[CMD_SETDTSPEEDUP].limits = { { double(MINTIMESTEP), double(MAXTIMESTEP) } };
@@ -1172,6 +1219,21 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 	commands[CMD_MCCONSTRAIN].descr = "[tc0,0.5,0.5,1/tc]Set value 0 to revert to classic Monte-Carlo Metropolis for ASD. Set a unit vector direction value (x y z) to switch to constrained Monte Carlo as described in PRB 82, 054415 (2010). If meshname not specified setting is applied to all atomistic meshes.";
 	commands[CMD_MCCONSTRAIN].limits = { { DBL3(), Any() }, {Any(), Any()} };
 
+	commands.insert(CMD_MCTEMPERING, CommandSpecifier(CMD_MCTEMPERING), "mctempering");
+	commands[CMD_MCTEMPERING].usage = "[tc0,0.5,0,1/tc]USAGE : <b>mctempering</b> <i>replicas (Tmax (meshname))</i>";
+	commands[CMD_MCTEMPERING].descr = "[tc0,0.5,0.5,1/tc]Set parallel tempering (replica exchange) for Monte-Carlo in atomistic meshes : replicas of the spin configuration are held at temperatures geometrically spaced from the base temperature up to Tmax (K), each advanced with the set Monte-Carlo algorithm, with swaps attempted between neighbouring temperatures every step. With the parallel classic algorithm (default) replicas are advanced concurrently, threads being split between replicas, each replica with its own random number stream; with the constrained, serial or cluster algorithms replicas are advanced one after the other. The mesh configuration is always that of the base temperature replica. Set replicas 1 to disable (default). Not available with CUDA enabled. If meshname not specified setting is applied to all atomistic meshes. Without parameters shows temperature, energy (J), average normalized moment and cone angle for each replica. Temperature, energy and average normalized moment for each replica can be saved using the MCptobs output data.";
+	commands[CMD_MCTEMPERING].limits = { { int(1), int(256) }, { double(0.0), Any() }, {Any(), Any()} };
+
+	commands.insert(CMD_MCCLUSTER, CommandSpecifier(CMD_MCCLUSTER), "mccluster");
+	commands[CMD_MCCLUSTER].usage = "[tc0,0.5,0,1/tc]USAGE : <b>mccluster</b> <i>value (meshname)</i>";
+	commands[CMD_MCCLUSTER].descr = "[tc0,0.5,0.5,1/tc]Change Monte-Carlo algorithm type for ASD. 0: single spin moves (default) 1: Wolff cluster moves; clusters are built from isotropic exchange bonds and reflected in the plane perpendicular to a random direction, with the cluster reflection accepted using the energy change of remaining contributions (anisotropy, Zeeman, DMI). Reduces decorrelation times close to the Curie temperature. Replaces constrained Monte-Carlo if set. Not available with CUDA enabled. If meshname not specified setting is applied to all atomistic meshes.";
+	commands[CMD_MCCLUSTER].limits = { { int(0), int(1) }, {Any(), Any()} };
+
+	commands.insert(CMD_MCDIPOLAR, CommandSpecifier(CMD_MCDIPOLAR), "mcdipolar");
+	commands[CMD_MCDIPOLAR].usage = "[tc0,0.5,0,1/tc]USAGE : <b>mcdipolar</b> <i>refresh (radius (threshold (meshname)))</i>";
+	commands[CMD_MCDIPOLAR].descr = "[tc0,0.5,0.5,1/tc]Set dipolar field handling for Monte-Carlo in atomistic meshes with dipole-dipole or demag modules enabled, and in ferromagnetic meshes with the demag module enabled. The full dipolar field is computed every refresh Monte-Carlo steps (default 1), or earlier if threshold is not zero and the accumulated moment change relative to the total moment exceeds it. In between, accepted moves update the dipolar field in cells within radius cells (default 2) using point dipole fields (atomistic meshes) or the demag tensor between cells (ferromagnetic meshes). The relative rms error of the updated field, measured at each full computation, is available as MCdiperr output data. If meshname not specified setting is applied to all atomistic and ferromagnetic meshes. Without parameters shows settings and errors. Note, Monte-Carlo in ferromagnetic meshes uses Metropolis moves only (no heat-bath moves), and includes Zeeman, exchange, interfacial DMI, uniaxial anisotropy, demag and demag_N modules only : a Monte-Carlo stage cannot be run with any other energy module enabled in a ferromagnetic mesh (e.g. sdemag, DMexchange, anicubi).";
+	commands[CMD_MCDIPOLAR].limits = { { int(1), Any() }, { int(0), int(10) }, { double(0.0), Any() }, {Any(), Any()} };
+
 	commands.insert(CMD_SHAPEMOD_ROT, CommandSpecifier(CMD_SHAPEMOD_ROT), "shape_rotation");
 	commands[CMD_SHAPEMOD_ROT].usage = "[tc0,0.5,0,1/tc]USAGE : <b>shape_rotation</b> <i>psi theta phi</i>";
 	commands[CMD_SHAPEMOD_ROT].descr = "[tc0,0.5,0.5,1/tc]Set modifier for shape generator commands: rotation using psi (around y), theta (around x) and phi (around z) in degrees.";
@@ -1623,6 +1685,8 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 	dataDescriptor.push_back("heat_dT", DatumSpecifier("heat dT : ", 1, "s"), DATA_HEATDT);
 	dataDescriptor.push_back("mxh", DatumSpecifier("|mxh| : ", 1), DATA_MXH);
 	dataDescriptor.push_back("dmdt", DatumSpecifier("|dm/dt| : ", 1), DATA_DMDT);
+	dataDescriptor.push_back("evalspeeduperr", DatumSpecifier("Extrapolation error : ", 1), DATA_EVALSPEEDUPERR);
+	dataDescriptor.push_back("stepstats", DatumSpecifier("Accepted, rejected steps : ", 2), DATA_STEPSTATS);
 	dataDescriptor.push_back("Ha", DatumSpecifier("Applied Field : ", 3, "A/m", false), DATA_HA);
 	dataDescriptor.push_back("<M>", DatumSpecifier("<M> : ", 3, "A/m", false, false), DATA_AVM);
 	dataDescriptor.push_back("<Mxsq>", DatumSpecifier("<Mxsq> : ", 1, "A/m", false, false), DATA_AVMXSQ);
@@ -1634,6 +1698,10 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 	dataDescriptor.push_back("My_mm", DatumSpecifier("My_mm : ", 2, "A/m", false, false), DATA_MY_MINMAX);
 	dataDescriptor.push_back("Mz_mm", DatumSpecifier("Mz_mm : ", 2, "A/m", false, false), DATA_MZ_MINMAX);
 	dataDescriptor.push_back("MCparams", DatumSpecifier("MCparams : ", 2, "", false), DATA_MONTECARLOPARAMS);
+	dataDescriptor.push_back("MCptswap", DatumSpecifier("MCptswap : ", 1, "", false), DATA_MCPTSWAP);
+	dataDescriptor.push_back("MCdiperr", DatumSpecifier("MCdiperr : ", 1, "", false), DATA_MCDIPOLARERROR);
+	dataDescriptor.push_back("MCptobs", DatumSpecifier("MCptobs : ", 3, "", false), DATA_MCPTOBSERVABLES);
+	dataDescriptor.push_back("<M>ens", DatumSpecifier("<M>ens : ", 3, "A/m", false), DATA_ENSEMBLEM);
 	dataDescriptor.push_back("<Jc>", DatumSpecifier("<Jc> : ", 3, "A/m^2", false, false), DATA_JC);
 	dataDescriptor.push_back("<Jsx>", DatumSpecifier("<Jsx> : ", 3, "A/s", false, false), DATA_JSX);
 	dataDescriptor.push_back("<Jsy>", DatumSpecifier("<Jsy> : ", 3, "A/s", false, false), DATA_JSY);
@@ -1728,20 +1796,24 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 	odeEvalHandles.push_back("RKCK45", EVAL_RKCK);
 	odeEvalHandles.push_back("RKDP54", EVAL_RKDP);
 	odeEvalHandles.push_back("SDesc", EVAL_SD);
+	odeEvalHandles.push_back("Cayley", EVAL_CAYLEY);
+	odeEvalHandles.push_back("ROS2", EVAL_ROS2);
+	odeEvalHandles.push_back("RKC", EVAL_RKC);
+	odeEvalHandles.push_back("NCG", EVAL_NCG);
 
 	//Allowed evaluation methods for given ODE
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP), ODE_LLG);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP, EVAL_SD), ODE_LLGSTATIC);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP), ODE_LLGSTT);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP, EVAL_CAYLEY, EVAL_ROS2), ODE_LLG);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP, EVAL_SD, EVAL_CAYLEY, EVAL_ROS2, EVAL_RKC, EVAL_NCG), ODE_LLGSTATIC);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP, EVAL_CAYLEY, EVAL_ROS2), ODE_LLGSTT);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP), ODE_LLB);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP), ODE_LLBSTT);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP), ODE_LLGSA);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP, EVAL_CAYLEY, EVAL_ROS2), ODE_LLGSA);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_RK4, EVAL_ABM, EVAL_RK23, EVAL_RKF, EVAL_RKCK, EVAL_RKDP), ODE_LLBSA);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN), ODE_SLLG);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN), ODE_SLLGSTT);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_CAYLEY), ODE_SLLG);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_CAYLEY), ODE_SLLGSTT);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN), ODE_SLLB);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN), ODE_SLLBSTT);
-	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN), ODE_SLLGSA);
+	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN, EVAL_CAYLEY), ODE_SLLGSA);
 	odeAllowedEvals.push_back(make_vector(EVAL_EULER, EVAL_TEULER, EVAL_AHEUN), ODE_SLLBSA);
 
 	odeDefaultEval.push_back(EVAL_RKF, ODE_LLG);
@@ -1842,6 +1914,15 @@ Simulation::Simulation(int Program_Version, std::string server_port_, std::strin
 	//Load options for startup first
 	Load_Startup_Flags();
 
+	//load fftw wisdom so fft plans for previously used transform sizes don't have to be remade from scratch
+	ConvolutionData::Load_FFTW_Wisdom(GetUserDocumentsPath() + boris_data_directory);
+
+#if defined MODULE_COMPILATION_DEMAG || defined MODULE_COMPILATION_SDEMAG
+	//demag kernels saved in this directory so they don't have to be recalculated for a previously used geometry
+	DemagKernelCache::Set_Cache_Directory(GetUserDocumentsPath() + boris_data_directory + "KernelCache/");
+	DemagKernelCache::Set_Cache_Size_Limit(kernelcache_size_MB);
+#endif
+
 	//---------------------------------------------------------------- SERVER START
 
 	//start network sockets thread to listen for incoming messages
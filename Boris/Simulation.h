@@ -60,6 +60,8 @@
 #include "Atom_Mesh.h"
 #include "SuperMesh.h"
 
+#include "DemagKernelCache.h"
+
 
 #if COMPILECUDA == 1
 #include "BorisCUDALib.h"
@@ -131,6 +133,9 @@ private:
 	//number of threads to use for OpenMP (0 means determine maximum available and set that)
 	int OmpThreads = 0;
 
+	//maximum total size (MB) of demag kernel cache files kept in Boris Data directory (0 disables the kernel cache)
+	int kernelcache_size_MB = DEMAGKERNELCACHE_DEFAULTSIZEMB;
+
 	//Default netsocks server port
 	std::string server_port = DEFAULT_PORT;
 	//default server receiver sleep time : lower value improves server responsivity but increase CPU load for server thread.
@@ -492,6 +497,10 @@ private:
 
 	void Print_Threads(void);
 
+	//---------------------------------------------------- DEMAG KERNEL CACHE
+
+	void Print_KernelCacheStatus(void);
+
 	//---------------------------------------------------- SCRIPT SERVER INFO
 
 	void Print_ServerInfo(void);
@@ -546,6 +555,10 @@ private:
 	void Print_MCSettings(void);
 	std::string Build_MCSettings_ListLine(int meshIndex);
 
+	//show parallel tempering settings and replicas for atomistic meshes
+	void Print_MCTempering(void);
+	void Print_MCDipolar(void);
+
 	//---------------------------------------------------- SHAPE MODIFIERS
 
 	void Print_ShapeSettings(void);
@@ -144,6 +144,18 @@ Any Simulation::GetDataValue(DatumConfig dConfig)
 	}
 	break;
 
+	case DATA_EVALSPEEDUPERR:
+	{
+		return Any(SMesh.Get_EvalSpeedup_Error());
+	}
+	break;
+
+	case DATA_STEPSTATS:
+	{
+		return Any(SMesh.Get_StepStats());
+	}
+	break;
+
 	case DATA_DT:
 	{
 		return Any(SMesh.GetTimeStep());
@@ -272,12 +284,62 @@ Any Simulation::GetDataValue(DatumConfig dConfig)
 	break;
 
 	case DATA_MONTECARLOPARAMS:
+	{
+		return Any(SMesh[dConfig.meshName]->Get_MonteCarlo_Params());
+	}
+	break;
+
+	case DATA_MCPTSWAP:
 	{
 		if (SMesh[dConfig.meshName]->is_atomistic()) {
 
-			return Any(dynamic_cast<Atom_Mesh*>(SMesh[dConfig.meshName])->Get_MonteCarlo_Params());
+			return Any(dynamic_cast<Atom_Mesh*>(SMesh[dConfig.meshName])->Get_MonteCarlo_Tempering_SwapRate());
 		}
-		else return Any(DBL2());
+		else return Any(0.0);
+	}
+	break;
+
+	case DATA_MCDIPOLARERROR:
+	{
+		return Any(SMesh[dConfig.meshName]->Get_MonteCarlo_Dipolar_Error());
+	}
+	break;
+
+	case DATA_MCPTOBSERVABLES:
+	{
+		//temperature, energy and |<m>| for each parallel tempering replica (zero before the first step), so one column per value when saved
+		if (SMesh[dConfig.meshName]->is_atomistic()) {
+
+			Atom_Mesh* paMesh = dynamic_cast<Atom_Mesh*>(SMesh[dConfig.meshName]);
+
+			std::vector<DBL4> observables = paMesh->Get_MonteCarlo_Tempering_Observables();
+
+			std::string values;
+			for (int ridx = 0; ridx < paMesh->Get_MonteCarlo_Tempering_Replicas(); ridx++) {
+
+				DBL3 value = (ridx < observables.size() ? DBL3(observables[ridx].i, observables[ridx].j, observables[ridx].k) : DBL3());
+				values += (ridx ? ", " : "") + ToString(value);
+			}
+
+			return Any(values);
+		}
+		else return Any(ToString(DBL3()));
+	}
+	break;
+
+	case DATA_ENSEMBLEM:
+	{
+		//average magnetization for each ensemble replica, so one column per component when saved
+		std::vector<DBL3> averages = SMesh.Get_Ensemble_AverageM(dConfig.meshName);
+
+		std::string values;
+		for (int ridx = 0; ridx < SMesh.GetEnsembleReplicas(); ridx++) {
+
+			DBL3 value = (ridx < averages.size() ? averages[ridx] : DBL3());
+			values += (ridx ? ", " : "") + ToString(value);
+		}
+
+		return Any(values);
 	}
 	break;
 
@@ -662,7 +724,17 @@ void Simulation::SaveData_DiskWrite(const std::string& row_text)
 					if (!dataDescriptor(saveDataList[idx].datumId).boxless)
 						bdout << " (" << ToString(saveDataList[idx].rectangle, "m") << ")";
 
-					for (int tabs = 0; tabs < dataDescriptor(saveDataList[idx].datumId).components; tabs++)
+					int components = dataDescriptor(saveDataList[idx].datumId).components;
+
+					//parallel tempering observables have components for each replica
+					if (saveDataList[idx].datumId == DATA_MCPTOBSERVABLES && SMesh.contains(saveDataList[idx].meshName) && SMesh[saveDataList[idx].meshName]->is_atomistic())
+						components *= dynamic_cast<Atom_Mesh*>(SMesh[saveDataList[idx].meshName])->Get_MonteCarlo_Tempering_Replicas();
+
+					//ensemble average magnetization has components for each replica
+					if (saveDataList[idx].datumId == DATA_ENSEMBLEM)
+						components *= SMesh.GetEnsembleReplicas();
+
+					for (int tabs = 0; tabs < components; tabs++)
 						bdout << '\t';
 				}
 
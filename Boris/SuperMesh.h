@@ -25,6 +25,9 @@
 
 
 
+//meshes with fewer cells than this per thread don't keep all threads busy on their own : independent meshes are then evaluated concurrently, each on a subset of threads (see SuperMesh::Set_Mesh_Scheduling)
+#define MESHSCHEDULING_CELLSPERTHREAD	4096
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //	
 //	This is a container of simulation meshes and modules which span two or more meshes (supermesh modules).
@@ -160,6 +163,12 @@ private:
 	//different meshes have different weights when contributing to the total energy density -> ratio of their non-empty volume to total non-empty volume
 	//this vector is calculated at initialization and has same size as pMesh vector
 	std::vector<double> energy_density_weights;
+	//total non-empty volume of all meshes, calculated at initialization : total energy is total_energy_density * total_nonempty_volume
+	double total_nonempty_volume = 0.0;
+
+	//mesh scheduling : if meshes are too small to keep all threads busy on their own, their modules are updated concurrently, with threads split between meshes.
+	//This is the number of threads used by each mesh when running meshes concurrently (0 : run meshes one after another, each using all threads). Set on initialization.
+	int mesh_threads = 0;
 
 public:
 
@@ -237,9 +246,22 @@ public:
 	BError InitializeAllModulesCUDA(void);
 #endif
 
+	//set mesh_threads depending on number of meshes, their size and number of threads available (also sets it in ODE solvers)
+	void Set_Mesh_Scheduling(void);
+
+	//run method(idx) for all meshes idx (concurrently if mesh_threads is set, else in order) and return the sum of method outputs
+	template <typename Method>
+	double Run_Meshes(Method method);
+
 	//called by Simulation to advance simulation by a time step
 	void AdvanceTime(void);
 
+	//advance time with multi-rate time stepping : micromagnetic meshes advance with their own time step, then atomistic meshes sub-cycle within it with a separate time step
+	void AdvanceTime_MultiRate(void);
+
+	//advance time with ensemble runs : each replica advances through the same time step in turn, sharing all modules in the meshes
+	void AdvanceTime_Ensemble(void);
+
 	//Similar to AdvanceTime but only computes effective fields and does not run the ODE solver
 	void ComputeFields(void);
 
@@ -252,9 +274,12 @@ public:
 	void UpdateTransportSolverCUDA(void);
 #endif
 
-	//Take a Monte Carlo step over all atomistic meshes using settings in each mesh; increase the iterations counters.
+	//Take a Monte Carlo step over all atomistic and ferromagnetic meshes using settings in each mesh; increase the iterations counters.
 	void Iterate_MonteCarlo(double acceptance_rate);
 
+	//check set modules in all meshes can be used with Iterate_MonteCarlo
+	BError Check_MonteCarlo_Modules(void);
+
 #if COMPILECUDA == 1
 	void Iterate_MonteCarloCUDA(double acceptance_rate);
 #endif
@@ -278,14 +303,38 @@ public:
 	//set the time step for the magnetization solver
 	void SetTimeStep(double dT);
 
+	//set the time step for atomistic meshes with multi-rate time stepping (0 disables it)
+	void SetTimeStep_MultiRate(double dT_multirate);
+	double GetTimeStep_MultiRate(void);
+
+	//set number of ensemble replicas (1 to disable)
+	BError SetEnsembleReplicas(int replicas);
+	int GetEnsembleReplicas(void);
+
+	//average magnetization of each ensemble replica in the named mesh, starting with replica 0 (held in the mesh)
+	std::vector<DBL3> Get_Ensemble_AverageM(std::string meshName);
+
+	//set normalized torque threshold for the SD relaxation activity mask in ferromagnetic meshes (0 disables it)
+	void SetRelaxMaskThreshold(double threshold);
+	double GetRelaxMaskThreshold(void);
+
 	//set parameters for adaptive time step control
 	void SetAdaptiveTimeStepCtrl(double err_fail, double err_high, double err_low, double dT_incr, double dT_min, double dT_max);
 
+	//set step size controller (STEPCTRL_ enum) and norm of local truncation error over cells (LTENORM_ enum) for adaptive time step control
+	void SetStepControllerType(int type, int norm);
+	int GetStepControllerType(void);
+	int GetLTENorm(void);
+
 	void SetStochTimeStep(double dTstoch);
 	double GetStochTimeStep(void);
 	void SetLink_dTstoch(bool flag);
 	bool GetLink_dTstoch(void);
 
+	//set seed for thermal field generation (0 for a different seed every time)
+	void SetStochSeed(int seed);
+	int GetStochSeed(void);
+
 	void SetSpeedupTimeStep(double dTspeedup);
 	double GetSpeedupTimeStep(void);
 	void SetLink_dTspeedup(bool flag);
@@ -296,15 +345,32 @@ public:
 	//check evaluation speedup settings in ode solver
 	int GetEvaluationSpeedup(void);
 
+	//set field extrapolation used on skipped evaluation steps (EVALSPEEDUPEXTRAP_ enum) in ode solver
+	void SetEvaluationSpeedupExtrapolation(int status);
+	//check field extrapolation setting for evaluation speedup in ode solver
+	int GetEvaluationSpeedupExtrapolation(void);
+
 	//is the current time step fully finished? - most evaluation schemes need multiple sub-steps
 	bool CurrentTimeStepSolved(void);
 
 	//check in ODECommon the type of field update we need to do depending on the ODE evaluation step
 	int Check_Step_Update(void);
 
+	//time at which the effective field is evaluated in the current evaluation step (ODECommon)
+	double Get_EvalStep_Time(void);
+
+	//report relative error of field extrapolation against full field evaluation to ODECommon
+	void Report_EvalSpeedup_Error(double error_value);
+
 	//check if ODE solver needs spin accumulation solved
 	bool SolveSpinCurrent(void);
 
+	//check the set evaluation methods are implemented for all meshes with an ODE (ROS2 is only implemented for ferromagnetic meshes)
+	BError Check_ODE_EvalMethod(void);
+
+	//check ensemble runs can be used with the current configuration (not with heat or transport solvers), and size replicas for any mesh changes
+	BError Check_Ensemble(void);
+
 	void SetMoveMeshAntisymmetric(bool antisymmetric);
 	void SetMoveMeshThreshold(double threshold);
 
@@ -331,9 +397,14 @@ public:
 	double Get_mxh(void);
 	double Get_dmdt(void);
 
+	double Get_EvalSpeedup_Error(void);
+
 	DBL3 Get_AStepRelErrCtrl(void);
 	DBL3 Get_AStepdTCtrl(void);
 
+	//number of accepted and rejected time steps for adaptive methods since last reset
+	INT2 Get_StepStats(void);
+
 	bool IsMovingMeshSet(void);
 	int GetId_of_MoveMeshTrigger(void);
 	double Get_dwshift(void);
@@ -354,6 +425,15 @@ public:
 	//switch to constrained Monnte-Carlo (true) or classical (false) in given mesh - all if meshName is the supermesh handle; if constrained, then use cmc_n direction.
 	BError Set_MonteCarlo_Constrained(bool status, DBL3 cmc_n, std::string meshName);
 
+	//set parallel tempering with given number of replicas (1 to disable), at temperatures geometrically spaced from base temperature up to Tmax, in given mesh - all if meshName is the supermesh handle
+	BError Set_MonteCarlo_Tempering(int replicas, double Tmax, std::string meshName);
+
+	//switch to Wolff cluster Monte-Carlo (true) or single spin Monte-Carlo (false) in given mesh - all if meshName is the supermesh handle. Cluster Monte-Carlo replaces constrained Monte-Carlo if set.
+	BError Set_MonteCarlo_Cluster(bool status, std::string meshName);
+
+	//set dipolar field handling for Monte-Carlo in given mesh - all if meshName is the supermesh handle : full convolution every refresh steps (or earlier if the relative moment change exceeds threshold, if not zero), with real-space corrections within radius cells in between
+	BError Set_MonteCarlo_Dipolar(int refresh, int radius, double threshold, std::string meshName);
+
 	//--------------------------------------------------------- MESH HANDLING - COMPONENTS : SuperMeshMeshes.cpp
 
 	//Add a new mesh of given type, name and dimensions
@@ -168,8 +168,10 @@ BError SuperMesh::SwitchCUDAState(bool cudaState, int cudaDeviceSelect)
 			pSMeshCUDA = new SuperMeshCUDA(this);
 		}
 
-		//Monte-Carlo serial mode not possible with cuda on
+		//Monte-Carlo serial mode, parallel tempering and cluster mode not possible with cuda on
 		Set_MonteCarlo_Serial(false, superMeshHandle);
+		Set_MonteCarlo_Tempering(1, 0.0, superMeshHandle);
+		Set_MonteCarlo_Cluster(false, superMeshHandle);
 	}
 	else {
 
@@ -71,12 +71,70 @@ void SuperMesh::SetTimeStep(double dT)
 	odeSolver.SetdT(dT); 
 }
 
+//set the time step for atomistic meshes with multi-rate time stepping (0 disables it)
+void SuperMesh::SetTimeStep_MultiRate(double dT_multirate)
+{
+	odeSolver.SetdT_MultiRate(dT_multirate);
+}
+
+double SuperMesh::GetTimeStep_MultiRate(void)
+{
+	return odeSolver.GetdT_MultiRate();
+}
+
+//set number of ensemble replicas (1 to disable)
+BError SuperMesh::SetEnsembleReplicas(int replicas)
+{
+	return odeSolver.SetEnsembleReplicas(replicas);
+}
+
+int SuperMesh::GetEnsembleReplicas(void)
+{
+	return odeSolver.GetEnsembleReplicas();
+}
+
+//average magnetization of each ensemble replica in the named mesh, starting with replica 0 (held in the mesh)
+std::vector<DBL3> SuperMesh::Get_Ensemble_AverageM(std::string meshName)
+{
+	if (!contains(meshName) || pMesh[meshName]->is_atomistic()) return {};
+
+	return odeSolver.Get_Ensemble_AverageM(dynamic_cast<Mesh*>(pMesh[meshName]));
+}
+
+//set normalized torque threshold for the SD relaxation activity mask in ferromagnetic meshes (0 disables it)
+void SuperMesh::SetRelaxMaskThreshold(double threshold)
+{
+	odeSolver.SetRelaxMaskThreshold(threshold);
+}
+
+double SuperMesh::GetRelaxMaskThreshold(void)
+{
+	return odeSolver.GetRelaxMaskThreshold();
+}
+
 //set parameters for adaptive time step control
 void SuperMesh::SetAdaptiveTimeStepCtrl(double err_fail, double err_high, double err_low, double dT_incr, double dT_min, double dT_max) 
 { 
 	odeSolver.SetAdaptiveTimeStepCtrl(err_fail, err_high, err_low, dT_incr, dT_min, dT_max); 
 }
 
+//set step size controller (STEPCTRL_ enum) and norm of local truncation error over cells (LTENORM_ enum) for adaptive time step control
+void SuperMesh::SetStepControllerType(int type, int norm)
+{
+	odeSolver.SetStepControllerType(type);
+	odeSolver.SetLTENorm(norm);
+}
+
+int SuperMesh::GetStepControllerType(void)
+{
+	return odeSolver.GetStepControllerType();
+}
+
+int SuperMesh::GetLTENorm(void)
+{
+	return odeSolver.GetLTENorm();
+}
+
 void SuperMesh::SetStochTimeStep(double dTstoch) 
 { 
 	odeSolver.SetStochTimeStep(dTstoch);
@@ -97,6 +155,16 @@ bool SuperMesh::GetLink_dTstoch(void)
 	return odeSolver.GetLink_dTstoch(); 
 }
 
+void SuperMesh::SetStochSeed(int seed)
+{
+	odeSolver.SetStochSeed(seed);
+}
+
+int SuperMesh::GetStochSeed(void)
+{
+	return odeSolver.GetStochSeed();
+}
+
 void SuperMesh::SetSpeedupTimeStep(double dTspeedup)
 {
 	odeSolver.SetSpeedupTimeStep(dTspeedup);
@@ -131,6 +199,20 @@ int SuperMesh::GetEvaluationSpeedup(void)
 	return odeSolver.GetEvaluationSpeedup();
 }
 
+//set field extrapolation used on skipped evaluation steps (EVALSPEEDUPEXTRAP_ enum) in ode solver
+void SuperMesh::SetEvaluationSpeedupExtrapolation(int status)
+{
+	odeSolver.SetEvaluationSpeedupExtrapolation(status);
+
+	UpdateConfiguration(UPDATECONFIG_ODE_SOLVER);
+}
+
+//check field extrapolation setting for evaluation speedup in ode solver
+int SuperMesh::GetEvaluationSpeedupExtrapolation(void)
+{
+	return odeSolver.GetEvaluationSpeedupExtrapolation();
+}
+
 //is the current time step fully finished? - most evaluation schemes need multiple sub-steps
 bool SuperMesh::CurrentTimeStepSolved(void)
 {
@@ -143,12 +225,71 @@ int SuperMesh::Check_Step_Update(void)
 	return odeSolver.Check_Step_Update();
 }
 
+//time at which the effective field is evaluated in the current evaluation step (ODECommon)
+double SuperMesh::Get_EvalStep_Time(void)
+{
+	return odeSolver.Get_EvalStep_Time();
+}
+
+//report relative error of field extrapolation against full field evaluation to ODECommon
+void SuperMesh::Report_EvalSpeedup_Error(double error_value)
+{
+	odeSolver.Report_EvalSpeedup_Error(error_value);
+}
+
 //check if ODE solver needs spin accumulation solved
 bool SuperMesh::SolveSpinCurrent(void)
 { 
 	return odeSolver.SolveSpinCurrent();
 }
 
+//check the set evaluation methods are implemented for all meshes with an ODE (ROS2 is only implemented for ferromagnetic meshes)
+BError SuperMesh::Check_ODE_EvalMethod(void)
+{
+	BError error(CLASS_STR(SuperMesh));
+
+	ODE_ setODE, setAtomODE;
+	EVAL_ evalMethod, atom_evalMethod;
+	odeSolver.QueryODE(setODE, evalMethod);
+	atom_odeSolver.QueryODE(setAtomODE, atom_evalMethod);
+
+	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+		std::string meshName = pMesh.get_key_from_index(idx);
+
+		if (pMesh[idx]->is_atomistic()) {
+
+			if (atom_evalMethod == EVAL_ROS2) return error(BERROR_INCORRECTCONFIG, "ROS2 evaluation method not available for atomistic mesh " + meshName + " : only implemented for ferromagnetic meshes");
+		}
+		else if (pMesh[idx]->GetMeshType() == MESH_ANTIFERROMAGNETIC) {
+
+			if (evalMethod == EVAL_ROS2) return error(BERROR_INCORRECTCONFIG, "ROS2 evaluation method not available for antiferromagnetic mesh " + meshName + " : only implemented for ferromagnetic meshes");
+		}
+		else if (pMesh[idx]->GetMeshType() == MESH_DIAMAGNETIC) {
+
+			if (evalMethod == EVAL_ROS2) return error(BERROR_INCORRECTCONFIG, "ROS2 evaluation method not available for diamagnetic mesh " + meshName + " : only implemented for ferromagnetic meshes");
+		}
+	}
+
+	return error;
+}
+
+//check ensemble runs can be used with the current configuration, and size replicas for any mesh changes
+BError SuperMesh::Check_Ensemble(void)
+{
+	BError error(CLASS_STR(SuperMesh));
+
+	if (!odeSolver.Ensemble_Active()) return error;
+
+	//heat and transport solvers advance their own state every time effective fields are updated, so with replicas stepped in turn they would advance once per replica
+	if (IsSuperMeshModuleSet(MODS_SHEAT)) return error(BERROR_INCORRECTCONFIG, "ensemble runs not available with the heat solver");
+	if (IsSuperMeshModuleSet(MODS_STRANSPORT)) return error(BERROR_INCORRECTCONFIG, "ensemble runs not available with the transport solver");
+
+	error = odeSolver.Ensemble_Check();
+
+	return error;
+}
+
 void SuperMesh::SetMoveMeshAntisymmetric(bool antisymmetric) 
 { 
 	odeSolver.SetMoveMeshAntisymmetric(antisymmetric); 
@@ -236,6 +377,11 @@ double SuperMesh::Get_dmdt(void)
 	return odeSolver.Get_dmdt(); 
 }
 
+double SuperMesh::Get_EvalSpeedup_Error(void)
+{
+	return odeSolver.Get_EvalSpeedup_Error();
+}
+
 DBL3 SuperMesh::Get_AStepRelErrCtrl(void) 
 { 
 	return odeSolver.Get_AStepRelErrCtrl();
@@ -246,6 +392,11 @@ DBL3 SuperMesh::Get_AStepdTCtrl(void)
 	return odeSolver.Get_AStepdTCtrl();
 }
 
+INT2 SuperMesh::Get_StepStats(void)
+{
+	return odeSolver.Get_StepStats();
+}
+
 bool SuperMesh::IsMovingMeshSet(void) 
 { 
 	return odeSolver.IsMovingMeshSet();
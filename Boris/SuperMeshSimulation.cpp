@@ -9,7 +9,7 @@ BError SuperMesh::InitializeAllModules(void)
 	
 	energy_density_weights.assign(pMesh.size(), 0.0);
 
-	double total_nonempty_volume = 0.0;
+	total_nonempty_volume = 0.0;
 
 	//1. initialize individual mesh modules
 	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
@@ -34,6 +34,9 @@ BError SuperMesh::InitializeAllModules(void)
 		}
 	}
 
+	//4. decide if meshes should be run concurrently
+	Set_Mesh_Scheduling();
+
 	return error;
 }
 
@@ -52,7 +55,7 @@ BError SuperMesh::InitializeAllModulesCUDA(void)
 
 	energy_density_weights.assign(pMesh.size(), 0.0);
 
-	double total_nonempty_volume = 0.0;
+	total_nonempty_volume = 0.0;
 
 	//1. initialize individual mesh modules
 	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
@@ -81,10 +84,50 @@ BError SuperMesh::InitializeAllModulesCUDA(void)
 }
 #endif
 
+//set mesh_threads depending on number of meshes, their size and number of threads available (also sets it in ODE solvers)
+void SuperMesh::Set_Mesh_Scheduling(void)
+{
+	mesh_threads = 0;
+
+	int num_threads = omp_get_max_threads();
+	int num_meshes = pMesh.size();
+
+	if (num_meshes >= 2 && num_threads >= 2) {
+
+		//the largest mesh must also be too small to keep all threads busy, otherwise running it on a subset of threads would slow it down
+		int max_cells = 0;
+		for (int idx = 0; idx < num_meshes; idx++) max_cells = maximum(max_cells, (int)pMesh[idx]->n.dim());
+
+		//split threads between meshes : with more meshes than threads each mesh gets a single thread
+		if (max_cells < MESHSCHEDULING_CELLSPERTHREAD * num_threads) mesh_threads = maximum(1, num_threads / num_meshes);
+	}
+
+	odeSolver.SetMeshThreads(mesh_threads);
+}
+
+//run method(idx) for all meshes idx (concurrently if mesh_threads is set, else in order) and return the sum of method outputs
+template <typename Method>
+double SuperMesh::Run_Meshes(Method method)
+{
+	return Run_OmpTeams(pMesh.size(), mesh_threads, method);
+}
+
 void SuperMesh::AdvanceTime(void)
 {
-	//Currently micromagnetic and atomistic meshes must have the same ODE evaluation method set, with the same time-step.
-	//In the future this will be changed to allow better performance, as it's possible in a multiscale simulation some micromagnetics meshes can be evaluated with a larger time-step compared to atomistic ones.
+	//Micromagnetic and atomistic meshes must have the same ODE evaluation method set, with the same time-step.
+	//With multi-rate time stepping enabled, atomistic meshes can instead sub-cycle with a smaller time-step within the micromagnetic time-step.
+	if (odeSolver.MultiRate_Active()) {
+
+		AdvanceTime_MultiRate();
+		return;
+	}
+
+	//Ensemble runs : all replicas advance through the same time step
+	if (odeSolver.Ensemble_Active()) {
+
+		AdvanceTime_Ensemble();
+		return;
+	}
 
 	//moving mesh algorithm, if enabled
 	odeSolver.MovingMeshAlgorithm(this);
@@ -92,18 +135,13 @@ void SuperMesh::AdvanceTime(void)
 	do {
 
 		//prepare meshes for new iteration (typically involves setting some state flag)
-		for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+		Run_Meshes([&](int idx) { pMesh[idx]->PrepareNewIteration(); return 0.0; });
 
-			pMesh[idx]->PrepareNewIteration();
-		}
+		//same field update recommendation for all modules in this evaluation (meshes may be updated concurrently)
+		odeSolver.Fix_Step_Update(true);
 
-		total_energy_density = 0.0;
-
-		//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh
-		for (int idx = 0; idx < (int)pMesh.size(); idx++) {
-
-			total_energy_density += (pMesh[idx]->UpdateModules() * energy_density_weights[idx]);
-		}
+		//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh : these run after all meshes have been updated)
+		total_energy_density = Run_Meshes([&](int idx) { return pMesh[idx]->UpdateModules() * energy_density_weights[idx]; });
 
 		//update effective field for super-mesh modules
 		for (int idx = 0; idx < (int)pSMod.size(); idx++) {
@@ -112,12 +150,126 @@ void SuperMesh::AdvanceTime(void)
 			total_energy_density += pSMod[idx]->UpdateField();
 		}
 
+		odeSolver.Fix_Step_Update(false);
+
+		//total energy is needed by energy minimization methods (NCG line search)
+		odeSolver.Set_TotalEnergy(total_energy_density * total_nonempty_volume);
+
 		//iterate ODE evaluation method - ODE solvers are called separately in the magnetic meshes. This is why the same evaluation method must be used in all the magnetic meshes, with the same time step.
 		odeSolver.Iterate();
 
 	} while (!odeSolver.TimeStepSolved());
 }
 
+//advance time with multi-rate time stepping : micromagnetic meshes advance with their own time step, then atomistic meshes sub-cycle within it with a separate time step
+void SuperMesh::AdvanceTime_MultiRate(void)
+{
+	//moving mesh algorithm, if enabled
+	odeSolver.MovingMeshAlgorithm(this);
+
+	double time_start = odeSolver.GetTime();
+
+	//1. Micromagnetic meshes : atomistic meshes are held at their start of time step values (coupling to them through super-mesh modules and exchange coupling is first order)
+
+	odeSolver.MultiRate_Begin_Micromagnetic();
+
+	double energy_density_mm = 0.0;
+
+	do {
+
+		Run_Meshes([&](int idx) { if (!pMesh[idx]->is_atomistic()) pMesh[idx]->PrepareNewIteration(); return 0.0; });
+
+		odeSolver.Fix_Step_Update(true);
+
+		energy_density_mm = Run_Meshes([&](int idx) { return (pMesh[idx]->is_atomistic() ? 0.0 : pMesh[idx]->UpdateModules() * energy_density_weights[idx]); });
+
+		for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+
+			pSMod[idx]->UpdateField();
+		}
+
+		odeSolver.Fix_Step_Update(false);
+
+		odeSolver.Iterate();
+
+	} while (!odeSolver.TimeStepSolved());
+
+	//2. Atomistic meshes sub-cycle from the start to the end of the micromagnetic time step, with micromagnetic meshes magnetization interpolated at each evaluation time
+
+	BError error = odeSolver.MultiRate_Begin_Atomistic(time_start);
+
+	double energy_density_atom = 0.0, energy_density_smod = 0.0;
+
+	while (!error && !odeSolver.MultiRate_SubCycle_Done()) {
+
+		do {
+
+			odeSolver.MultiRate_Prepare_Evaluation();
+
+			Run_Meshes([&](int idx) { if (pMesh[idx]->is_atomistic()) pMesh[idx]->PrepareNewIteration(); return 0.0; });
+
+			odeSolver.Fix_Step_Update(true);
+
+			energy_density_atom = Run_Meshes([&](int idx) { return (pMesh[idx]->is_atomistic() ? pMesh[idx]->UpdateModules() * energy_density_weights[idx] : 0.0); });
+
+			energy_density_smod = 0.0;
+
+			for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+
+				energy_density_smod += pSMod[idx]->UpdateField();
+			}
+
+			odeSolver.Fix_Step_Update(false);
+
+			odeSolver.Iterate();
+
+		} while (!odeSolver.TimeStepSolved());
+	}
+
+	//micromagnetic meshes magnetization and effective field set back to end of time step values (super-mesh modules also added to their effective field during sub-cycling)
+	odeSolver.MultiRate_End();
+
+	//out of memory : continue without multi-rate time stepping
+	if (error) odeSolver.SetdT_MultiRate(0.0);
+
+	total_energy_density = energy_density_mm + energy_density_atom + energy_density_smod;
+}
+
+//advance time with ensemble runs : each replica advances through the same time step in turn, sharing all modules in the meshes
+void SuperMesh::AdvanceTime_Ensemble(void)
+{
+	odeSolver.Ensemble_Begin();
+
+	//replica 0 advances last, so effective fields and energies left in the meshes are those of the magnetization held in the meshes
+	for (int replica = odeSolver.GetEnsembleReplicas() - 1; replica >= 0; replica--) {
+
+		odeSolver.Ensemble_Begin_Replica(replica);
+
+		do {
+
+			Run_Meshes([&](int idx) { pMesh[idx]->PrepareNewIteration(); return 0.0; });
+
+			odeSolver.Fix_Step_Update(true);
+
+			total_energy_density = Run_Meshes([&](int idx) { return pMesh[idx]->UpdateModules() * energy_density_weights[idx]; });
+
+			for (int idx = 0; idx < (int)pSMod.size(); idx++) {
+
+				total_energy_density += pSMod[idx]->UpdateField();
+			}
+
+			odeSolver.Fix_Step_Update(false);
+
+			odeSolver.Set_TotalEnergy(total_energy_density * total_nonempty_volume);
+
+			odeSolver.Iterate();
+
+		} while (!odeSolver.TimeStepSolved());
+
+		odeSolver.Ensemble_End_Replica(replica);
+	}
+}
+
 #if COMPILECUDA == 1
 void SuperMesh::AdvanceTimeCUDA(void)
 {
@@ -154,18 +306,10 @@ void SuperMesh::AdvanceTimeCUDA(void)
 void SuperMesh::ComputeFields(void)
 {
 	//prepare meshes for new iteration (typically involves setting some state flag)
-	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
-
-		pMesh[idx]->PrepareNewIteration();
-	}
-
-	total_energy_density = 0.0;
-
-	//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh
-	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+	Run_Meshes([&](int idx) { pMesh[idx]->PrepareNewIteration(); return 0.0; });
 
-		total_energy_density += pMesh[idx]->UpdateModules();
-	}
+	//first update the effective fields in all the meshes (skipping any that have been calculated on the super-mesh : these run after all meshes have been updated)
+	total_energy_density = Run_Meshes([&](int idx) { return pMesh[idx]->UpdateModules(); });
 
 	//update effective field for super-mesh modules
 	for (int idx = 0; idx < (int)pSMod.size(); idx++) {
@@ -232,13 +376,26 @@ void SuperMesh::UpdateTransportSolverCUDA(void)
 }
 #endif
 
-//Take a Monte Carlo step over all atomistic meshes using settings in each mesh; increase the iterations counters.
+//check set modules in all meshes can be used with Iterate_MonteCarlo
+BError SuperMesh::Check_MonteCarlo_Modules(void)
+{
+	BError error(CLASS_STR(SuperMesh));
+
+	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
+
+		if (!error) error = pMesh[idx]->Check_MonteCarlo_Modules();
+	}
+
+	return error;
+}
+
+//Take a Monte Carlo step over all atomistic and ferromagnetic meshes using settings in each mesh; increase the iterations counters.
 void SuperMesh::Iterate_MonteCarlo(double acceptance_rate)
 {
 	for (int idx = 0; idx < (int)pMesh.size(); idx++) {
 
-		//Iterate Monte Carlo Metropolis algorithm for atomistic meshes only
-		if (pMesh[idx]->is_atomistic()) pMesh[idx]->Iterate_MonteCarlo(acceptance_rate);
+		//Iterate Monte Carlo Metropolis algorithm (meshes which don't implement it do nothing)
+		pMesh[idx]->Iterate_MonteCarlo(acceptance_rate);
 	}
 
 	//Increment iterations counters only (stage and global iterations)
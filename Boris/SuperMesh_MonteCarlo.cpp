@@ -48,7 +48,12 @@ BError SuperMesh::Set_MonteCarlo_Constrained(bool status, DBL3 cmc_n, std::strin
 
 			if (pMesh[idx]->is_atomistic()) {
 
-				if (status && !cmc_n.IsNull()) dynamic_cast<Atom_Mesh*>(pMesh[idx])->Set_MonteCarlo_Constrained(cmc_n);
+				if (status && !cmc_n.IsNull()) {
+
+					//constrained and cluster Monte-Carlo are exclusive
+					dynamic_cast<Atom_Mesh*>(pMesh[idx])->Set_MonteCarlo_Cluster(false);
+					dynamic_cast<Atom_Mesh*>(pMesh[idx])->Set_MonteCarlo_Constrained(cmc_n);
+				}
 				else dynamic_cast<Atom_Mesh*>(pMesh[idx])->Set_MonteCarlo_Constrained(DBL3());
 			}
 		}
@@ -58,9 +63,109 @@ BError SuperMesh::Set_MonteCarlo_Constrained(bool status, DBL3 cmc_n, std::strin
 		//named mesh only
 		if (!pMesh[meshName]->is_atomistic()) return error(BERROR_INCORRECTCONFIG);
 
-		if (status && !cmc_n.IsNull()) dynamic_cast<Atom_Mesh*>(pMesh[meshName])->Set_MonteCarlo_Constrained(cmc_n);
+		if (status && !cmc_n.IsNull()) {
+
+			//constrained and cluster Monte-Carlo are exclusive
+			dynamic_cast<Atom_Mesh*>(pMesh[meshName])->Set_MonteCarlo_Cluster(false);
+			dynamic_cast<Atom_Mesh*>(pMesh[meshName])->Set_MonteCarlo_Constrained(cmc_n);
+		}
 		else dynamic_cast<Atom_Mesh*>(pMesh[meshName])->Set_MonteCarlo_Constrained(DBL3());
 	}
 
 	return error;
 }
+
+//set parallel tempering with given number of replicas (1 to disable), at temperatures geometrically spaced from base temperature up to Tmax, in given mesh - all if meshName is the supermesh handle
+BError SuperMesh::Set_MonteCarlo_Tempering(int replicas, double Tmax, std::string meshName)
+{
+	BError error(__FUNCTION__);
+
+	if (!contains(meshName) && meshName != superMeshHandle) return error(BERROR_INCORRECTNAME);
+
+	//parallel tempering only possible with cuda off
+	if (cudaEnabled && replicas > 1) return error(BERROR_INCORRECTCONFIG);
+
+	if (meshName == superMeshHandle) {
+
+		//all atomistic meshes
+		for (int idx = 0; idx < pMesh.size(); idx++) {
+
+			if (pMesh[idx]->is_atomistic()) {
+
+				dynamic_cast<Atom_Mesh*>(pMesh[idx])->Set_MonteCarlo_Tempering(replicas, Tmax);
+			}
+		}
+	}
+	else {
+
+		//named mesh only
+		if (!pMesh[meshName]->is_atomistic()) return error(BERROR_INCORRECTCONFIG);
+
+		dynamic_cast<Atom_Mesh*>(pMesh[meshName])->Set_MonteCarlo_Tempering(replicas, Tmax);
+	}
+
+	return error;
+}
+
+//switch to Wolff cluster Monte-Carlo (true) or single spin Monte-Carlo (false) in given mesh - all if meshName is the supermesh handle. Cluster Monte-Carlo replaces constrained Monte-Carlo if set.
+BError SuperMesh::Set_MonteCarlo_Cluster(bool status, std::string meshName)
+{
+	BError error(__FUNCTION__);
+
+	if (!contains(meshName) && meshName != superMeshHandle) return error(BERROR_INCORRECTNAME);
+
+	//cluster mode only possible with cuda off
+	if (cudaEnabled && status == true) return error(BERROR_INCORRECTCONFIG);
+
+	if (meshName == superMeshHandle) {
+
+		//all atomistic meshes
+		for (int idx = 0; idx < pMesh.size(); idx++) {
+
+			if (pMesh[idx]->is_atomistic()) {
+
+				if (status) dynamic_cast<Atom_Mesh*>(pMesh[idx])->Set_MonteCarlo_Constrained(DBL3());
+				dynamic_cast<Atom_Mesh*>(pMesh[idx])->Set_MonteCarlo_Cluster(status);
+			}
+		}
+	}
+	else {
+
+		//named mesh only
+		if (!pMesh[meshName]->is_atomistic()) return error(BERROR_INCORRECTCONFIG);
+
+		if (status) dynamic_cast<Atom_Mesh*>(pMesh[meshName])->Set_MonteCarlo_Constrained(DBL3());
+		dynamic_cast<Atom_Mesh*>(pMesh[meshName])->Set_MonteCarlo_Cluster(status);
+	}
+
+	return error;
+}
+
+//set dipolar field handling for Monte-Carlo in given mesh - all if meshName is the supermesh handle : full convolution every refresh steps (or earlier if the relative moment change exceeds threshold, if not zero), with real-space corrections within radius cells in between
+BError SuperMesh::Set_MonteCarlo_Dipolar(int refresh, int radius, double threshold, std::string meshName)
+{
+	BError error(__FUNCTION__);
+
+	if (!contains(meshName) && meshName != superMeshHandle) return error(BERROR_INCORRECTNAME);
+
+	if (meshName == superMeshHandle) {
+
+		//all atomistic and ferromagnetic meshes
+		for (int idx = 0; idx < pMesh.size(); idx++) {
+
+			if (pMesh[idx]->is_atomistic() || pMesh[idx]->GetMeshType() == MESH_FERROMAGNETIC) {
+
+				pMesh[idx]->Set_MonteCarlo_Dipolar(refresh, radius, threshold);
+			}
+		}
+	}
+	else {
+
+		//named mesh only
+		if (!pMesh[meshName]->is_atomistic() && pMesh[meshName]->GetMeshType() != MESH_FERROMAGNETIC) return error(BERROR_INCORRECTCONFIG);
+
+		pMesh[meshName]->Set_MonteCarlo_Dipolar(refresh, radius, threshold);
+	}
+
+	return error;
+}
@@ -5,6 +5,7 @@
 
 #include "Mesh.h"
 #include "MeshParamsControl.h"
+#include "Modules_LocalFields.h"
 
 #include "SuperMesh.h"
 
@@ -147,12 +148,7 @@ double Zeeman::UpdateField(void)
 #pragma omp parallel for reduction(+:energy)
 			for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-				double cHA = pMesh->cHA;
-				pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
-
-				pMesh->Heff[idx] = (cHA * Ha);
-
-				energy += pMesh->M[idx] * (cHA * Ha);
+				pMesh->Heff[idx] = LocalField_FM(idx, energy, 0.0);
 			}
 		}
 	}
@@ -193,28 +189,19 @@ double Zeeman::UpdateField(void)
 		else {
 
 #pragma omp parallel for reduction(+:energy)
-			for (int j = 0; j < pMesh->n.y; j++) {
-				for (int k = 0; k < pMesh->n.z; k++) {
-					for (int i = 0; i < pMesh->n.x; i++) {
-
-						int idx = i + j * pMesh->n.x + k * pMesh->n.x*pMesh->n.y;
-
-						//on top of spatial dependence specified through an equation, also allow spatial dependence through the cHA parameter
-						double cHA = pMesh->cHA;
-						pMesh->update_parameters_mcoarse(idx, pMesh->cHA, cHA);
-
-						DBL3 relpos = DBL3(i + 0.5, j + 0.5, k + 0.5) & pMesh->h;
-						DBL3 H = H_equation.evaluate_vector(relpos.x, relpos.y, relpos.z, time);
-
-						pMesh->Heff[idx] = (cHA * H);
+			for (int idx = 0; idx < pMesh->n.dim(); idx++) {
 
-						energy += pMesh->M[idx] * (cHA * H);
-					}
-				}
+				pMesh->Heff[idx] = LocalField_FM(idx, energy, time);
 			}
 		}
 	}
 
+	return UpdateField_Finish(energy);
+}
+
+//final energy density value from energy density sum accumulated over the mesh; sets and returns module energy
+double Zeeman::UpdateField_Finish(double energy)
+{
 	if (pMesh->M.get_nonempty_cells()) energy *= -MU0 / pMesh->M.get_nonempty_cells();
 	else energy = 0;
 
@@ -60,6 +60,14 @@ public:
 
 	double UpdateField(void);
 
+	//-------------------Local field kernel : Modules_LocalFields.h
+
+	//Zeeman field at cell idx in a ferromagnetic mesh, accumulating energy density sum (time is the stage time)
+	DBL3 LocalField_FM(int idx, double& energy, double time);
+
+	//final energy density value from energy density sum accumulated over the mesh; sets and returns module energy
+	double UpdateField_Finish(double energy);
+
 	//-------------------Energy density methods
 
 	double GetEnergyDensity(Rect& avRect);
@@ -5,6 +5,7 @@
 
 #include "Mesh.h"
 #include "MeshParamsControl.h"
+#include "Modules_LocalFields.h"
 
 #if COMPILECUDA == 1
 #include "iDMExchangeCUDA.h"
@@ -100,61 +101,10 @@ double iDMExchange::UpdateField(void)
 
 	if (pMesh->GetMeshType() == MESH_FERROMAGNETIC) {
 
-#pragma omp parallel for reduction(+:energy) 
+#pragma omp parallel for reduction(+:energy)
 		for (int idx = 0; idx < n.dim(); idx++) {
 
-			if (pMesh->M.is_not_empty(idx)) {
-
-				double Ms = pMesh->Ms;
-				double A = pMesh->A;
-				double D = pMesh->D;
-				pMesh->update_parameters_mcoarse(idx, pMesh->A, A, pMesh->D, D, pMesh->Ms, Ms);
-
-				double Aconst = 2 * A / (MU0 * Ms * Ms);
-				double Dconst = -2 * D / (MU0 * Ms * Ms);
-
-				DBL3 Hexch;
-
-				if (pMesh->M.is_plane_interior(idx)) {
-
-					//interior point : can use cheaper neu versions
-
-					//direct exchange contribution
-					Hexch = Aconst * pMesh->M.delsq_neu(idx);
-
-					//Dzyaloshinskii-Moriya interfacial exchange contribution
-
-					//Differentials of M components (we only need 4, not all 9 so this could be optimised). First index is the differential direction, second index is the M component
-					DBL33 Mdiff = pMesh->M.grad_neu(idx);
-
-					//Hdm, ex = -2D / (mu0*Ms) * (dmz / dx, dmz / dy, -dmx / dx - dmy / dy)
-					Hexch += Dconst * DBL3(Mdiff.x.z, Mdiff.y.z, -Mdiff.x.x - Mdiff.y.y);
-				}
-				else {
-
-					//Non-homogeneous Neumann boundary conditions apply when using DMI. Required to ensure Brown's condition is fulfilled, i.e. m x h -> 0 when relaxing.
-					DBL3 bnd_dm_dx = (D / (2 * A)) * DBL3(pMesh->M[idx].z, 0, -pMesh->M[idx].x);
-					DBL3 bnd_dm_dy = (D / (2 * A)) * DBL3(0, pMesh->M[idx].z, -pMesh->M[idx].y);
-					DBL33 bnd_nneu = DBL33(bnd_dm_dx, bnd_dm_dy, DBL3());
-
-					//direct exchange contribution
-					//cells marked with cmbnd are calculated using exchange coupling to other ferromagnetic meshes - see below; the delsq_nneu evaluates to zero in the CMBND coupling direction.
-					Hexch = Aconst * pMesh->M.delsq_nneu(idx, bnd_nneu);
-
-					//Dzyaloshinskii-Moriya interfacial exchange contribution
-
-					//Differentials of M components (we only need 4, not all 9 so this could be optimised). First index is the differential direction, second index is the M component
-					//For cmbnd cells grad_nneu does not evaluate to zero in the CMBND coupling direction, but sided differentials are used - when setting values at CMBND cells for exchange coupled meshes must correct for this.
-					DBL33 Mdiff = pMesh->M.grad_nneu(idx, bnd_nneu);
-
-					//Hdm, ex = -2D / (mu0*Ms) * (dmz / dx, dmz / dy, -dmx / dx - dmy / dy)
-					Hexch += Dconst * DBL3(Mdiff.x.z, Mdiff.y.z, -Mdiff.x.x - Mdiff.y.y);
-				}
-
-				pMesh->Heff[idx] += Hexch;
-
-				energy += pMesh->M[idx] * Hexch;
-			}
+			if (pMesh->M.is_not_empty(idx)) pMesh->Heff[idx] += LocalField_FM(idx, energy);
 		}
 	}
 
@@ -272,6 +222,12 @@ double iDMExchange::UpdateField(void)
 		}
 	}
 
+	return UpdateField_Finish(energy);
+}
+
+//exchange coupling to other meshes and final energy density value from energy density sum accumulated over the mesh; sets and returns module energy
+double iDMExchange::UpdateField_Finish(double energy)
+{
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	/////////////////////////////// COUPLING ACROSS MULTIPLE MESHES ///////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
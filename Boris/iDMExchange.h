@@ -46,6 +46,14 @@ public:
 
 	double UpdateField(void);
 
+	//-------------------Local field kernel : Modules_LocalFields.h
+
+	//exchange and interfacial DMI field at non-empty cell idx in a ferromagnetic mesh, accumulating energy density sum
+	DBL3 LocalField_FM(int idx, double& energy);
+
+	//exchange coupling to other meshes and final energy density value from energy density sum accumulated over the mesh; sets and returns module energy
+	double UpdateField_Finish(double energy);
+
 	//-------------------Energy density methods
 
 	double GetEnergyDensity(Rect& avRect);
@@ -14,6 +14,7 @@
 #include "Funcs_Aux_Linux.h"
 #include "Funcs_Net_Windows.h"
 #include "Funcs_Net_Linux.h"
+#include "Funcs_Omp.h"
 
 //CIRCULAR INCLUSION CHECK : PASSED 
 
@@ -78,6 +79,8 @@
 
 #include "Funcs_Aux_base.h"
 
+#include "Funcs_Omp.h"
+
 #include "Funcs_Aux_Windows.h"
 -> Funcs_Aux_base
 -> Types_VAL
@@ -79,3 +79,132 @@ public:
 		return z0 * std + mean;
 	}
 };
+
+
+//Counter-based pseudo-random number generator (Philox4x32-10, from J. K. Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11 (2011)).
+//Random numbers are a function of (seed, stream) key and (index, step, sub-stream) counter only, with no state kept between calls, so values for a given index don't depend on the number of threads or the order in which they are generated.
+//Typical use : generate random values for all cells in a mesh, with index the cell index, step incremented (advance) every time all cells are generated, and sub-stream to distinguish different quantities generated at the same step.
+
+class BorisRandCB {
+
+private:
+
+	//key : seed and stream
+	unsigned key0, key1;
+
+	//number of times advance was called since seeding
+	unsigned long long step;
+
+private:
+
+	//Philox4x32-10 : 4 random 32 bit values from counter (index, step, substream)
+	void philox4x32(unsigned index, unsigned substream, unsigned& r0, unsigned& r1, unsigned& r2, unsigned& r3) const
+	{
+		unsigned c0 = index, c1 = (unsigned)step, c2 = (unsigned)(step >> 32), c3 = substream;
+		unsigned k0 = key0, k1 = key1;
+
+		for (int round = 0; round < 10; round++) {
+
+			unsigned long long p0 = (unsigned long long)0xD2511F53 * c0;
+			unsigned long long p1 = (unsigned long long)0xCD9E8D57 * c2;
+
+			unsigned n0 = (unsigned)(p1 >> 32) ^ c1 ^ k0;
+			unsigned n1 = (unsigned)p1;
+			unsigned n2 = (unsigned)(p0 >> 32) ^ c3 ^ k1;
+			unsigned n3 = (unsigned)p0;
+
+			c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+
+			//Weyl sequence key schedule
+			k0 += (unsigned)0x9E3779B9;
+			k1 += (unsigned)0xBB67AE85;
+		}
+
+		r0 = c0; r1 = c1; r2 = c2; r3 = c3;
+	}
+
+	//uniform floating point value in the open interval (0, 1) from 32 bit value
+	static double uniform_open(unsigned r) { return ((double)r + 0.5) * (1.0 / 4294967296.0); }
+
+public:
+
+	BorisRandCB(unsigned seed, unsigned stream = 0)
+	{
+		this->seed(seed, stream);
+	}
+
+	//set key, and start again from step 0
+	void seed(unsigned seed, unsigned stream = 0)
+	{
+		key0 = seed;
+		key1 = stream;
+		step = 0;
+	}
+
+	//next step : values for all indexes change
+	void advance(void) { step++; }
+
+	//floating point value in the open interval (0, 1) for given index (and sub-stream) at the current step
+	double rand(unsigned index, unsigned substream = 0) const
+	{
+		unsigned r0, r1, r2, r3;
+		philox4x32(index, substream, r0, r1, r2, r3);
+
+		return uniform_open(r0);
+	}
+
+	//fill values[0] to values[n - 1] with 3 Gaussian distributed components (zero mean, unit standard deviation) multiplied by scale(idx), where idx is the values index : VType constructible from 3 doubles (e.g. DBL3)
+	//each value uses one Philox4x32 evaluation (index idx, sub-stream substream at the current step), with 2 Box-Muller transforms giving 4 Gaussian values, of which 3 are used
+	//values are done in blocks : random integers for the block first, then Box-Muller transforms, so both loops can be vectorized by the compiler. Blocks are done in parallel.
+	template <typename VType, typename Scale>
+	void fill_gauss3(VType* values, int n, unsigned substream, Scale scale) const
+	{
+		const int block_size = 64;
+		int num_blocks = (n + block_size - 1) / block_size;
+
+#pragma omp parallel for
+		for (int block = 0; block < num_blocks; block++) {
+
+			unsigned r0[block_size], r1[block_size], r2[block_size], r3[block_size];
+			double g0[block_size], g1[block_size], g2[block_size];
+
+			int start = block * block_size;
+			int count = (n - start < block_size ? n - start : block_size);
+
+			for (int i = 0; i < count; i++) {
+
+				philox4x32(start + i, substream, r0[i], r1[i], r2[i], r3[i]);
+			}
+
+			//Box-Muller transforms : separate loops for each function, so vectorized versions of log, sin and cos can be used (a combined sincos is not vectorized)
+			for (int i = 0; i < count; i++) {
+
+				g0[i] = sqrt(-2.0 * log(uniform_open(r0[i])));
+				g2[i] = sqrt(-2.0 * log(uniform_open(r2[i])));
+			}
+
+			for (int i = 0; i < count; i++) {
+
+				g1[i] = g0[i] * sin(TWO_PI * uniform_open(r1[i]));
+			}
+
+			for (int i = 0; i < count; i++) {
+
+				g0[i] *= cos(TWO_PI * uniform_open(r1[i]));
+				g2[i] *= cos(TWO_PI * uniform_open(r3[i]));
+			}
+
+			for (int i = 0; i < count; i++) {
+
+				values[start + i] = scale(start + i) * VType(g0[i], g1[i], g2[i]);
+			}
+		}
+	}
+
+	//as above without scaling
+	template <typename VType>
+	void fill_gauss3(VType* values, int n, unsigned substream = 0) const
+	{
+		fill_gauss3(values, n, substream, [](int idx) { return 1.0; });
+	}
+};
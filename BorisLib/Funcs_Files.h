@@ -6,6 +6,8 @@
 #include <sstream>
 #include <fstream>
 #include <vector>
+#include <filesystem>
+#include <random>
 
 #include "Funcs_Conv.h"
 #include "Funcs_Strings.h"
@@ -221,6 +223,32 @@ int ReadBinaryVector(std::string filename, VType &data)
 ///////////////////////////////////////////////////////////////////////////////
 // WRITING
 
+//unique temporary file name next to fileName : write to it, then move it into place with MoveFileReplace, so other processes never read a partially written file
+inline std::string GetTemporaryFileName(const std::string& fileName)
+{
+	std::random_device rd;
+
+	std::stringstream ss;
+	ss << std::hex << rd() << rd();
+
+	return fileName + "." + ss.str() + ".tmp";
+}
+
+//move tempFileName to fileName, replacing fileName if it exists (atomic on the same file system). On failure tempFileName is deleted. Return true if successful.
+inline bool MoveFileReplace(const std::string& tempFileName, const std::string& fileName)
+{
+	std::error_code ec;
+	std::filesystem::rename(tempFileName, fileName, ec);
+
+	if (ec) {
+
+		std::filesystem::remove(tempFileName, ec);
+		return false;
+	}
+
+	return true;
+}
+
 inline bool SaveTextToFile(std::string filename, std::string text)
 {
 	bool success = false;
@@ -0,0 +1,43 @@
+//OpenMP helper functions
+
+#pragma once
+
+#include <omp.h>
+
+//Run method(idx) for idx = 0 .. count - 1 and return the sum of method outputs.
+//team_threads > 0 : run concurrently in teams of team_threads threads each, where method runs its own omp parallel loops (nested parallelism) on its team.
+//team_threads = 0 : run in order on the calling thread.
+template <typename Method>
+double Run_OmpTeams(int count, int team_threads, Method method)
+{
+	double total = 0.0;
+
+	if (team_threads <= 0 || count < 2) {
+
+		for (int idx = 0; idx < count; idx++) {
+
+			total += method(idx);
+		}
+
+		return total;
+	}
+
+	//inner omp parallel loops only run with their own threads if nested parallelism is enabled
+	int max_active_levels = omp_get_max_active_levels();
+	omp_set_max_active_levels(2);
+
+	int num_teams = (count < omp_get_max_threads() / team_threads ? count : omp_get_max_threads() / team_threads);
+	if (num_teams < 1) num_teams = 1;
+
+#pragma omp parallel for num_threads(num_teams) schedule(dynamic) reduction(+:total)
+	for (int idx = 0; idx < count; idx++) {
+
+		omp_set_num_threads(team_threads);
+
+		total += method(idx);
+	}
+
+	omp_set_max_active_levels(max_active_levels);
+
+	return total;
+}
@@ -24,6 +24,9 @@ struct __ReIm {
 	//copy constructor
 	__ReIm(const __ReIm &copyThis) { Re = copyThis.Re; Im = copyThis.Im; }
 
+	//type conversion constructor
+	template <typename CVType> __ReIm(const __ReIm<CVType> &convThis) { Re = (Type)convThis.Re; Im = (Type)convThis.Im; }
+
 	//assignment operator
 	__ReIm& operator=(const __ReIm &rhs) { Re = rhs.Re; Im = rhs.Im; return *this; }
 
@@ -128,6 +131,9 @@ struct __ReIm3 {
 	//copy constructor
 	__ReIm3(const __ReIm3 &copyThis) { x = copyThis.x; y = copyThis.y; z = copyThis.z; }
 
+	//type conversion constructor
+	template <typename CVType> __ReIm3(const __ReIm3<CVType> &convThis) { x = convThis.x; y = convThis.y; z = convThis.z; }
+
 	//assignment operator
 	__ReIm3& operator=(const __ReIm3 &rhs) { x = rhs.x; y = rhs.y; z = rhs.z; return *this; }
 
@@ -0,0 +1,66 @@
+from NetSocks import NSClient
+import time
+import math
+
+#Benchmark of the ROS2 evaluation method against RKF45 on a fine-cell domain wall problem, where exchange stiffness limits the explicit time step.
+#Head-to-head domain wall along x in a 200 nm x 1 nm x 1 nm strip with 0.25 nm cells, uniaxial anisotropy along x, demag included, driven by a field along the easy axis.
+#Each method uses its default error bands with the PI step size controller.
+#Accuracy is checked against a reference RK4 run with a fixed 0.1 fs time step : for each method the number of accepted and rejected steps, mean accepted dT, wall time and final <M> error are reported.
+#Result on a CPU build (1 thread, stand-in FFT routines instead of fftw, so wall times are indicative only), 0.5 ps :
+#RKF45 : 438 accepted, 3 rejected, mean dT 1.14 fs, 161 s, |<M> - <M>ref| about 1 A/m (display precision)
+#ROS2  : 499 accepted, 3 rejected, dT held at its 1 fs minimum, 69 s, |<M> - <M>ref| about 24 A/m
+#ROS2 finishes sooner only because its time step is held at the minimum with its error target missed : its error is over 20 times larger, so it is not an improvement over RKF45 on this problem.
+
+ns = NSClient()
+ns.configure(True, False)
+
+#edit as needed
+sim_time = 0.5e-12
+cellsize = 0.25e-9
+Hdrive = 2e4
+
+def run(method):
+
+    ns.default()
+    ns.addmodule('permalloy', 'aniuni')
+
+    ns.meshrect([0, 0, 0, 200e-9, 1e-9, 1e-9])
+    ns.cellsize([cellsize, cellsize, cellsize])
+
+    ns.setparam('permalloy', 'K1', 5e5)
+    ns.setparam('permalloy', 'ea1', [1, 0, 0])
+    ns.setparam('permalloy', 'damping', 0.02)
+
+    ns.dwall('x', 'y', 5e-9, 100e-9)
+
+    ns.setode('LLG', method)
+    ns.astepctrltype(2)
+    if method == 'RK4': ns.setdt(1e-16)
+
+    ns.setstage('Hxyz')
+    ns.editstagevalue(0, [Hdrive, 0, 0])
+    ns.editstagestop(0, 'time', sim_time)
+    ns.iterupdate(0)
+
+    start = time.time()
+    ns.Run()
+    wall_time = time.time() - start
+
+    return ns.showdata('stepstats'), ns.showdata('<M>'), wall_time
+
+_, M_ref, _ = run('RK4')
+
+results = []
+
+for method in ['RKF45', 'ROS2']:
+
+    stepstats, M, wall_time = run(method)
+    M_error = math.sqrt(sum([(M[i] - M_ref[i])**2 for i in range(3)]))
+
+    results.append([method, stepstats[0], stepstats[1], sim_time / stepstats[0], wall_time, M_error])
+
+print('method\taccepted\trejected\tmean dT (s)\twall time (s)\t|<M> - <M>ref| (A/m)')
+
+for result in results:
+
+    print('%s\t%d\t%d\t%.3e\t%.2f\t%.3e' % tuple(result))
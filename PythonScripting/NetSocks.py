@@ -786,6 +786,9 @@ class NSClient:
     def astepctrl(self, err_fail = '', err_high = '', err_low = '', dT_incr = '', dT_min = '', dT_max = ''):
     	return self.SendCommand("astepctrl", [err_fail, err_high, err_low, dT_incr, dT_min, dT_max])
     
+    def astepctrltype(self, type = '', norm = ''):
+    	return self.SendCommand("astepctrltype", [type, norm])
+    
     def atomicmoment(self, ub_multiple = '', meshname = ''):
     	return self.SendCommand("atomicmoment", [ub_multiple, meshname])
     
@@ -1119,6 +1122,9 @@ class NSClient:
     def electrodes(self):
     	return self.SendCommand("electrodes")
     
+    def ensemble(self, replicas = ''):
+    	return self.SendCommand("ensemble", [replicas])
+    
     def equationconstants(self, name = '', value = ''):
     	return self.SendCommand("equationconstants", [name, value])
     
@@ -1131,6 +1137,9 @@ class NSClient:
     def evalspeedup(self, status = ''):
     	return self.SendCommand("evalspeedup", [status])
     
+    def evalspeedupextrap(self, order = ''):
+    	return self.SendCommand("evalspeedupextrap", [order])
+    
     def exchangecoupledmeshes(self, status = '', meshname = ''):
     	return self.SendCommand("exchangecoupledmeshes", [status, meshname])
     
@@ -1170,6 +1179,9 @@ class NSClient:
     def iterupdate(self, iterations = ''):
     	return self.SendCommand("iterupdate", [iterations])
     
+    def kernelcache(self, size = ''):
+    	return self.SendCommand("kernelcache", [size])
+    
     def linkdtspeedup(self, flag = ''):
     	return self.SendCommand("linkdtspeedup", [flag])
     
@@ -1215,15 +1227,24 @@ class NSClient:
     def materialsdatabase(self, mdbname = ''):
     	return self.SendCommand("materialsdatabase", [mdbname])
     
+    def mccluster(self, value = '', meshname = ''):
+    	return self.SendCommand("mccluster", [value, meshname])
+    
     def mcconstrain(self, value = '', meshname = ''):
     	return self.SendCommand("mcconstrain", [value, meshname])
     
+    def mcdipolar(self, refresh = '', radius = '', threshold = '', meshname = ''):
+    	return self.SendCommand("mcdipolar", [refresh, radius, threshold, meshname])
+    
     def mcellsize(self, value = ''):
     	return self.SendCommand("mcellsize", [value])
     
     def mcserial(self, value = '', meshname = ''):
     	return self.SendCommand("mcserial", [value, meshname])
     
+    def mctempering(self, replicas = '', Tmax = '', meshname = ''):
+    	return self.SendCommand("mctempering", [replicas, Tmax, meshname])
+    
     def memory(self):
     	return self.SendCommand("memory")
     
@@ -1287,6 +1308,9 @@ class NSClient:
     def preparemovingmesh(self, meshname = ''):
     	return self.SendCommand("preparemovingmesh", [meshname])
     
+    def prewarmfftw(self, sizes = ''):
+    	return self.SendCommand("prewarmfftw", [sizes])
+    
     def random(self, meshname = '', seed = ''):
     	return self.SendCommand("random", [meshname, seed])
     
@@ -1299,6 +1323,9 @@ class NSClient:
     def refreshscreen(self):
     	return self.SendCommand("refreshscreen")
     
+    def relaxmask(self, threshold = ''):
+    	return self.SendCommand("relaxmask", [threshold])
+    
     def renamemesh(self, old_name = '', new_name = ''):
     	return self.SendCommand("renamemesh", [old_name, new_name])
     
@@ -1398,6 +1425,9 @@ class NSClient:
     def setdt(self, value = ''):
     	return self.SendCommand("setdt", [value])
     
+    def setdtmultirate(self, value = ''):
+    	return self.SendCommand("setdtmultirate", [value])
+    
     def setdtspeedup(self, value = ''):
     	return self.SendCommand("setdtspeedup", [value])
     
@@ -1554,6 +1584,9 @@ class NSClient:
     def stochastic(self):
     	return self.SendCommand("stochastic")
     
+    def stochseed(self, seed = ''):
+    	return self.SendCommand("stochseed", [seed])
+    
     def stop(self):
     	return self.SendCommand("stop")
     